@@ -0,0 +1,282 @@
+#include "abb.h"
+#include <string.h>
+
+/* Definicion de las estructuras del árbol. Cada nodo conoce a su padre, así
+ * el rebalanceo y el iterador suben sin recursión ni pila */
+typedef struct abb_nodo abb_nodo_t;
+struct abb_nodo {
+    abb_nodo_t *izq;
+    abb_nodo_t *der;
+    abb_nodo_t *padre;
+    size_t hash;
+    const char *clave;
+    void *dato;
+    int altura;     // De la hoja más lejana, contando al nodo
+};
+
+struct abb {
+    abb_nodo_t *raiz;
+    size_t cantidad;
+    const alocador_t *alocador;
+};
+
+struct abb_iter {
+    abb_nodo_t *actual;     // NULL al final
+    const alocador_t *alocador;
+};
+
+/* Funciones auxiliares */
+
+static int altura(const abb_nodo_t *nodo) {
+    return (nodo ? nodo->altura : 0);
+}
+
+static void actualizar_altura(abb_nodo_t *nodo) {
+    int izq = altura(nodo->izq), der = altura(nodo->der);
+    nodo->altura = 1 + (izq > der ? izq : der);
+}
+
+/* Compara (hash, clave) con la del nodo, como strcmp */
+static int comparar(size_t hash, const char *clave, const abb_nodo_t *nodo) {
+    if (hash != nodo->hash)
+        return (hash < nodo->hash ? -1 : 1);
+    return strcmp(clave, nodo->clave);
+}
+
+/* Pone a nuevo en el lugar de viejo como hijo de padre, o como raíz */
+static void reemplazar_hijo(abb_t *abb, abb_nodo_t *padre, abb_nodo_t *viejo, abb_nodo_t *nuevo) {
+    if (!padre)
+        abb->raiz = nuevo;
+    else if (padre->izq == viejo)
+        padre->izq = nuevo;
+    else
+        padre->der = nuevo;
+    if (nuevo)
+        nuevo->padre = padre;
+}
+
+static abb_nodo_t *rotar_izquierda(abb_t *abb, abb_nodo_t *nodo) {
+    abb_nodo_t *der = nodo->der;
+    nodo->der = der->izq;
+    if (der->izq)
+        der->izq->padre = nodo;
+    reemplazar_hijo(abb, nodo->padre, nodo, der);
+    der->izq = nodo;
+    nodo->padre = der;
+    actualizar_altura(nodo);
+    actualizar_altura(der);
+    return der;
+}
+
+static abb_nodo_t *rotar_derecha(abb_t *abb, abb_nodo_t *nodo) {
+    abb_nodo_t *izq = nodo->izq;
+    nodo->izq = izq->der;
+    if (izq->der)
+        izq->der->padre = nodo;
+    reemplazar_hijo(abb, nodo->padre, nodo, izq);
+    izq->der = nodo;
+    nodo->padre = izq;
+    actualizar_altura(nodo);
+    actualizar_altura(izq);
+    return izq;
+}
+
+/* Balancea el subárbol del nodo y devuelve su nueva raíz */
+static abb_nodo_t *balancear(abb_t *abb, abb_nodo_t *nodo) {
+    int balance = altura(nodo->izq) - altura(nodo->der);
+    if (balance > 1) {
+        if (altura(nodo->izq->izq) < altura(nodo->izq->der))
+            rotar_izquierda(abb, nodo->izq);
+        return rotar_derecha(abb, nodo);
+    }
+    if (balance < -1) {
+        if (altura(nodo->der->der) < altura(nodo->der->izq))
+            rotar_derecha(abb, nodo->der);
+        return rotar_izquierda(abb, nodo);
+    }
+    actualizar_altura(nodo);
+    return nodo;
+}
+
+/* Rebalancea desde el nodo hasta la raíz, después de agregar o sacar un hijo */
+static void rebalancear_hasta_raiz(abb_t *abb, abb_nodo_t *nodo) {
+    while (nodo)
+        nodo = balancear(abb, nodo)->padre;
+}
+
+static abb_nodo_t *minimo(abb_nodo_t *nodo) {
+    while (nodo && nodo->izq)
+        nodo = nodo->izq;
+    return nodo;
+}
+
+/* Devuelve el nodo siguiente en orden, o NULL si era el último */
+static abb_nodo_t *sucesor(abb_nodo_t *nodo) {
+    if (nodo->der)
+        return minimo(nodo->der);
+    while (nodo->padre && nodo->padre->der == nodo)
+        nodo = nodo->padre;
+    return nodo->padre;
+}
+
+static abb_nodo_t *buscar(const abb_t *abb, size_t hash, const char *clave, size_t *sondeos) {
+    abb_nodo_t *actual = abb->raiz;
+    int comparacion;
+    while (actual) {
+        if (sondeos)
+            (*sondeos)++;
+        comparacion = comparar(hash, clave, actual);
+        if (!comparacion)
+            return actual;
+        actual = (comparacion < 0 ? actual->izq : actual->der);
+    }
+    return NULL;
+}
+
+/* Primitivas del árbol */
+
+abb_t *abb_crear_con_alocador(const alocador_t *alocador) {
+    abb_t *nuevo = alocador_reservar(alocador, sizeof(*nuevo));
+    if (!nuevo)
+        return NULL;
+    nuevo->raiz = NULL;
+    nuevo->cantidad = 0;
+    nuevo->alocador = alocador;
+    return nuevo;
+}
+
+bool abb_guardar(abb_t *abb, size_t hash, const char *clave, void *dato, void **anterior) {
+    abb_nodo_t *padre = NULL, *actual = abb->raiz, *nuevo;
+    int comparacion = 0;
+
+    if (anterior)
+        *anterior = NULL;
+    while (actual) {
+        comparacion = comparar(hash, clave, actual);
+        if (!comparacion) {
+            if (anterior)
+                *anterior = actual->dato;
+            actual->clave = clave;
+            actual->dato = dato;
+            return true;
+        }
+        padre = actual;
+        actual = (comparacion < 0 ? actual->izq : actual->der);
+    }
+    nuevo = alocador_reservar(abb->alocador, sizeof(*nuevo));
+    if (!nuevo)
+        return false;
+    nuevo->izq = NULL;
+    nuevo->der = NULL;
+    nuevo->padre = padre;
+    nuevo->hash = hash;
+    nuevo->clave = clave;
+    nuevo->dato = dato;
+    nuevo->altura = 1;
+    if (!padre)
+        abb->raiz = nuevo;
+    else if (comparacion < 0)
+        padre->izq = nuevo;
+    else
+        padre->der = nuevo;
+    rebalancear_hasta_raiz(abb, padre);
+    abb->cantidad++;
+    return true;
+}
+
+void *abb_obtener(const abb_t *abb, size_t hash, const char *clave, size_t *sondeos) {
+    abb_nodo_t *nodo = buscar(abb, hash, clave, sondeos);
+    return (nodo ? nodo->dato : NULL);
+}
+
+void *abb_borrar(abb_t *abb, size_t hash, const char *clave) {
+    abb_nodo_t *nodo = buscar(abb, hash, clave, NULL), *reemplazo, *hijo, *padre;
+    void *dato;
+    if (!nodo)
+        return NULL;
+    dato = nodo->dato;
+
+    /* Con dos hijos se le pasa el par del sucesor, que tiene a lo sumo uno, y se saca ese */
+    if (nodo->izq && nodo->der) {
+        reemplazo = minimo(nodo->der);
+        nodo->hash = reemplazo->hash;
+        nodo->clave = reemplazo->clave;
+        nodo->dato = reemplazo->dato;
+        nodo = reemplazo;
+    }
+    hijo = (nodo->izq ? nodo->izq : nodo->der);
+    padre = nodo->padre;
+    reemplazar_hijo(abb, padre, nodo, hijo);
+    alocador_liberar(abb->alocador, nodo, sizeof(*nodo));
+    rebalancear_hasta_raiz(abb, padre);
+    abb->cantidad--;
+    return dato;
+}
+
+size_t abb_cantidad(const abb_t *abb) {
+    return abb->cantidad;
+}
+
+size_t abb_memoria(const abb_t *abb) {
+    return sizeof(*abb) + abb->cantidad * sizeof(abb_nodo_t);
+}
+
+void abb_iterar(abb_t *abb, bool (*visitar)(void *dato, void *extra), void *extra) {
+    for (abb_nodo_t *actual = minimo(abb->raiz); actual; actual = sucesor(actual)) {
+        if (!visitar(actual->dato, extra))
+            return;
+    }
+}
+
+void abb_destruir(abb_t *abb, void destruir_dato(void *)) {
+    abb_nodo_t *actual, *izq, *der;
+    if (!abb)
+        return;
+    /* Rota a la derecha hasta que el nodo no tenga hijo izquierdo, y entonces
+     * lo libera: es lineal y no usa recursión ni los punteros al padre */
+    actual = abb->raiz;
+    while (actual) {
+        if ((izq = actual->izq)) {
+            actual->izq = izq->der;
+            izq->der = actual;
+            actual = izq;
+            continue;
+        }
+        der = actual->der;
+        if (destruir_dato)
+            destruir_dato(actual->dato);
+        alocador_liberar(abb->alocador, actual, sizeof(*actual));
+        actual = der;
+    }
+    alocador_liberar(abb->alocador, abb, sizeof(*abb));
+}
+
+/* Primitivas del iterador */
+
+abb_iter_t *abb_iter_crear(const abb_t *abb) {
+    abb_iter_t *iter = alocador_reservar(abb->alocador, sizeof(*iter));
+    if (!iter)
+        return NULL;
+    iter->actual = minimo(abb->raiz);
+    iter->alocador = abb->alocador;
+    return iter;
+}
+
+bool abb_iter_avanzar(abb_iter_t *iter) {
+    if (abb_iter_al_final(iter))
+        return false;
+    iter->actual = sucesor(iter->actual);
+    return true;
+}
+
+void *abb_iter_ver_actual(const abb_iter_t *iter) {
+    return (abb_iter_al_final(iter) ? NULL : iter->actual->dato);
+}
+
+bool abb_iter_al_final(const abb_iter_t *iter) {
+    return (!iter->actual);
+}
+
+void abb_iter_destruir(abb_iter_t *iter) {
+    alocador_liberar(iter->alocador, iter, sizeof(*iter));
+}
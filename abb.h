@@ -0,0 +1,83 @@
+#ifndef ABB_H
+#define ABB_H
+
+#include "alocador.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+/* Árbol binario de búsqueda balanceado (AVL) de pares (clave, dato),
+ * ordenado primero por el hash completo de la clave y después por la clave.
+ * Guardar, borrar y obtener son O(log n) aunque todas las claves tengan el
+ * mismo hash. Las claves no se copian: cada una debe seguir siendo válida
+ * mientras esté en el árbol.
+ */
+
+/* Declaraciones de estructuras */
+typedef struct abb abb_t;
+typedef struct abb_iter abb_iter_t;
+
+/* Crea un árbol que pide su memoria, la de sus nodos y la de sus iteradores
+ * al alocador, que debe vivir al menos tanto como el árbol y sus iteradores.
+ * Devuelve NULL en caso de error.
+ * Post: devuelve un árbol vacío.
+ */
+abb_t *abb_crear_con_alocador(const alocador_t *alocador);
+
+/* Guarda el par (clave, dato). Si la clave ya estaba, reemplaza la clave y el
+ * dato sin pedir memoria y devuelve el dato anterior en anterior (si no es
+ * NULL); si no, anterior queda en NULL. Devuelve false si no pudo guardarlo.
+ * Pre: el árbol fue creado, hash es el hash completo de clave.
+ */
+bool abb_guardar(abb_t *abb, size_t hash, const char *clave, void *dato, void **anterior);
+
+/* Devuelve el dato de la clave, o NULL si no está. Si sondeos no es NULL, le
+ * suma la cantidad de claves recorridas.
+ * Pre: el árbol fue creado, hash es el hash completo de clave.
+ */
+void *abb_obtener(const abb_t *abb, size_t hash, const char *clave, size_t *sondeos);
+
+/* Saca la clave del árbol y devuelve su dato, o NULL si no estaba.
+ * Pre: el árbol fue creado, hash es el hash completo de clave.
+ */
+void *abb_borrar(abb_t *abb, size_t hash, const char *clave);
+
+/* Devuelve la cantidad de pares del árbol.
+ * Pre: el árbol fue creado.
+ */
+size_t abb_cantidad(const abb_t *abb);
+
+/* Devuelve los bytes que ocupan el árbol y sus nodos, sin contar claves ni datos.
+ * Pre: el árbol fue creado.
+ */
+size_t abb_memoria(const abb_t *abb);
+
+/* Llama a visitar con cada dato, en orden, mientras devuelva true.
+ * Pre: el árbol fue creado.
+ */
+void abb_iterar(abb_t *abb, bool (*visitar)(void *dato, void *extra), void *extra);
+
+/* Destruye el árbol. Si se recibe destruir_dato, la llama para cada dato.
+ * Post: se liberaron el árbol y sus nodos.
+ */
+void abb_destruir(abb_t *abb, void destruir_dato(void *));
+
+/* Primitivas del iterador, recorre los datos en orden */
+
+/* Crea un iterador en el primer dato. Devuelve NULL en caso de error.
+ * Pre: el árbol fue creado y no se modifica mientras exista el iterador.
+ */
+abb_iter_t *abb_iter_crear(const abb_t *abb);
+
+// Avanza al siguiente dato, devuelve false si ya estaba al final
+bool abb_iter_avanzar(abb_iter_t *iter);
+
+// Devuelve el dato actual, o NULL si el iterador está al final
+void *abb_iter_ver_actual(const abb_iter_t *iter);
+
+// Devuelve true si el iterador está al final
+bool abb_iter_al_final(const abb_iter_t *iter);
+
+// Destruye el iterador
+void abb_iter_destruir(abb_iter_t *iter);
+
+#endif // ABB_H
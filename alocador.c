@@ -0,0 +1,60 @@
+#include "alocador.h"
+#include <stdlib.h>
+#include <string.h>
+
+/* Alocador estándar */
+
+static void *estandar_reservar(void *contexto, size_t tam) {
+    (void) contexto;
+    return malloc(tam);
+}
+
+static void *estandar_redimensionar(void *contexto, void *bloque, size_t tam_anterior, size_t tam) {
+    (void) contexto;
+    (void) tam_anterior;
+    return realloc(bloque, tam);
+}
+
+static void *estandar_reservar_ceros(void *contexto, size_t tam) {
+    (void) contexto;
+    return calloc(1, tam);
+}
+
+static void estandar_liberar(void *contexto, void *bloque, size_t tam) {
+    (void) contexto;
+    (void) tam;
+    free(bloque);
+}
+
+static const alocador_t ESTANDAR = {
+    estandar_reservar, estandar_redimensionar, estandar_liberar, NULL, estandar_reservar_ceros
+};
+
+/* Primitivas del alocador */
+
+const alocador_t *alocador_estandar(void) {
+    return &ESTANDAR;
+}
+
+void *alocador_reservar(const alocador_t *alocador, size_t tam) {
+    return alocador->reservar(alocador->contexto, tam);
+}
+
+void *alocador_reservar_ceros(const alocador_t *alocador, size_t tam) {
+    void *bloque;
+    if (alocador->reservar_ceros)
+        return alocador->reservar_ceros(alocador->contexto, tam);
+    bloque = alocador->reservar(alocador->contexto, tam);
+    if (bloque)
+        memset(bloque, 0, tam);
+    return bloque;
+}
+
+void *alocador_redimensionar(const alocador_t *alocador, void *bloque, size_t tam_anterior, size_t tam) {
+    return alocador->redimensionar(alocador->contexto, bloque, tam_anterior, tam);
+}
+
+void alocador_liberar(const alocador_t *alocador, void *bloque, size_t tam) {
+    if (bloque)
+        alocador->liberar(alocador->contexto, bloque, tam);
+}
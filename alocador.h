@@ -0,0 +1,45 @@
+#ifndef ALOCADOR_H
+#define ALOCADOR_H
+
+#include <stddef.h>
+
+/* Interfaz para que las estructuras pidan su memoria a un alocador propio
+ * (una arena, memoria local a un nodo NUMA, páginas grandes) en lugar de
+ * malloc. Liberar y redimensionar reciben el tamaño con el que se reservó
+ * el bloque, así el alocador no necesita guardarlo y puede llevar la cuenta
+ * exacta de los bytes en uso.
+ */
+typedef struct alocador {
+    /* Devuelve un bloque de tam bytes, o NULL si no hay memoria */
+    void *(*reservar)(void *contexto, size_t tam);
+    /* Cambia el tamaño del bloque de tam_anterior a tam bytes, como realloc.
+     * Si falla devuelve NULL y el bloque original sigue siendo válido. */
+    void *(*redimensionar)(void *contexto, void *bloque, size_t tam_anterior, size_t tam);
+    /* Libera el bloque de tam bytes */
+    void (*liberar)(void *contexto, void *bloque, size_t tam);
+    /* Se le pasa a todas las funciones */
+    void *contexto;
+    /* Opcional: devuelve un bloque de tam bytes en cero, o NULL si no hay
+     * memoria. Sirve para alocadores que reciben memoria ya en cero del
+     * sistema y no necesitan tocarla. Si es NULL se usa reservar y memset. */
+    void *(*reservar_ceros)(void *contexto, size_t tam);
+} alocador_t;
+
+/* Devuelve el alocador que usa malloc, realloc y free */
+const alocador_t *alocador_estandar(void);
+
+/* Reserva tam bytes con el alocador. Devuelve NULL en caso de error. */
+void *alocador_reservar(const alocador_t *alocador, size_t tam);
+
+/* Reserva tam bytes en cero con el alocador. Devuelve NULL en caso de error. */
+void *alocador_reservar_ceros(const alocador_t *alocador, size_t tam);
+
+/* Cambia el tamaño del bloque, que puede ser NULL con tam_anterior 0.
+ * Devuelve NULL en caso de error, sin liberar el bloque original.
+ */
+void *alocador_redimensionar(const alocador_t *alocador, void *bloque, size_t tam_anterior, size_t tam);
+
+/* Libera el bloque de tam bytes, si no es NULL */
+void alocador_liberar(const alocador_t *alocador, void *bloque, size_t tam);
+
+#endif // ALOCADOR_H
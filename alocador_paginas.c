@@ -0,0 +1,138 @@
+#define _DEFAULT_SOURCE
+#include "alocador_paginas.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <linux/mempolicy.h>
+#include <sys/syscall.h>
+#endif
+#define TAM_PAGINA_GRANDE ((size_t) 2 << 20)
+#define MAX_NODOS_NUMA 64
+
+/* Las políticas viven en memoria estática, el contexto apunta a una de ellas */
+static const alocador_numa_t POLITICAS[] = { ALOCADOR_NUMA_PRIMER_TOQUE, ALOCADOR_NUMA_INTERCALADO };
+
+/* Funciones auxiliares */
+
+static bool es_grande(size_t tam) {
+    return tam >= TAM_PAGINA_GRANDE;
+}
+
+static size_t redondear_a_pagina_grande(size_t tam) {
+    return (tam + TAM_PAGINA_GRANDE - 1) & ~(TAM_PAGINA_GRANDE - 1);
+}
+
+/* Devuelve la máscara de nodos NUMA en línea, o 0 si no se puede saber */
+static unsigned long nodos_en_linea(void) {
+    FILE *archivo = fopen("/sys/devices/system/node/online", "r");
+    unsigned long mascara = 0;
+    unsigned desde, hasta;
+    int separador;
+
+    if (!archivo)
+        return 0;
+    /* El formato es una lista de rangos, por ejemplo "0-1,3" */
+    while (fscanf(archivo, "%u", &desde) == 1) {
+        hasta = desde;
+        separador = fgetc(archivo);
+        if (separador == '-') {
+            if (fscanf(archivo, "%u", &hasta) != 1)
+                break;
+            separador = fgetc(archivo);
+        }
+        for (; desde <= hasta && desde < MAX_NODOS_NUMA; desde++)
+            mascara |= 1ul << desde;
+        if (separador != ',')
+            break;
+    }
+    fclose(archivo);
+    return mascara;
+}
+
+static void intercalar(void *bloque, size_t tam) {
+#if defined(__linux__) && defined(SYS_mbind)
+    unsigned long mascara = nodos_en_linea();
+    /* Con un solo nodo no hay nada que intercalar. Si mbind falla, el bloque
+     * queda con la política por omisión. */
+    if (mascara & (mascara - 1))
+        syscall(SYS_mbind, bloque, tam, MPOL_INTERLEAVE, &mascara, (unsigned long) MAX_NODOS_NUMA + 1, 0);
+#else
+    (void) bloque;
+    (void) tam;
+#endif
+}
+
+/* Pide con mmap un bloque alineado a 2MB, ya en cero */
+static void *mapear(const alocador_numa_t *numa, size_t tam) {
+    size_t largo = redondear_a_pagina_grande(tam), sobrante;
+    char *base, *alineado;
+
+    /* Se pide una página grande de más para poder alinear y se recortan los bordes */
+    base = mmap(NULL, largo + TAM_PAGINA_GRANDE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (base == MAP_FAILED)
+        return NULL;
+    alineado = (char *) (((uintptr_t) base + TAM_PAGINA_GRANDE - 1) & ~(uintptr_t) (TAM_PAGINA_GRANDE - 1));
+    if (alineado > base)
+        munmap(base, (size_t) (alineado - base));
+    sobrante = (size_t) (base + largo + TAM_PAGINA_GRANDE - (alineado + largo));
+    if (sobrante)
+        munmap(alineado + largo, sobrante);
+#ifdef MADV_HUGEPAGE
+    madvise(alineado, largo, MADV_HUGEPAGE);
+#endif
+    if (*numa == ALOCADOR_NUMA_INTERCALADO)
+        intercalar(alineado, largo);
+    return alineado;
+}
+
+/* Funciones del alocador */
+
+static void *paginas_reservar(void *contexto, size_t tam) {
+    return (es_grande(tam) ? mapear(contexto, tam) : malloc(tam));
+}
+
+static void *paginas_reservar_ceros(void *contexto, size_t tam) {
+    return (es_grande(tam) ? mapear(contexto, tam) : calloc(1, tam));
+}
+
+static void paginas_liberar(void *contexto, void *bloque, size_t tam) {
+    (void) contexto;
+    if (es_grande(tam))
+        munmap(bloque, redondear_a_pagina_grande(tam));
+    else
+        free(bloque);
+}
+
+static void *paginas_redimensionar(void *contexto, void *bloque, size_t tam_anterior, size_t tam) {
+    void *nuevo;
+
+    if (!bloque)
+        return paginas_reservar(contexto, tam);
+    if (!es_grande(tam_anterior) && !es_grande(tam))
+        return realloc(bloque, tam);
+    /* Si el bloque ya tiene lugar, no hace falta moverlo */
+    if (es_grande(tam_anterior) && es_grande(tam) &&
+        redondear_a_pagina_grande(tam) == redondear_a_pagina_grande(tam_anterior))
+        return bloque;
+    nuevo = paginas_reservar(contexto, tam);
+    if (!nuevo)
+        return NULL;
+    memcpy(nuevo, bloque, tam < tam_anterior ? tam : tam_anterior);
+    paginas_liberar(contexto, bloque, tam_anterior);
+    return nuevo;
+}
+
+/* Primitivas del alocador de páginas grandes */
+
+void alocador_paginas_grandes(alocador_t *alocador, alocador_numa_t numa) {
+    alocador->reservar = paginas_reservar;
+    alocador->redimensionar = paginas_redimensionar;
+    alocador->liberar = paginas_liberar;
+    alocador->reservar_ceros = paginas_reservar_ceros;
+    alocador->contexto = (void *) &POLITICAS[numa];
+}
@@ -0,0 +1,32 @@
+#ifndef ALOCADOR_PAGINAS_H
+#define ALOCADOR_PAGINAS_H
+
+#include "alocador.h"
+
+/* Alocador para tablas grandes: los bloques de al menos una página grande
+ * (2MB), como el arreglo de baldes de un hash de millones de claves, se piden
+ * con mmap alineados a 2MB y con madvise(MADV_HUGEPAGE), así el kernel los
+ * respalda con páginas grandes transparentes y cada acceso aleatorio usa
+ * muchas menos entradas de la TLB. Los bloques chicos van a malloc.
+ *
+ * En máquinas con varios nodos NUMA, los bloques grandes pueden intercalarse
+ * entre todos los nodos (mbind con MPOL_INTERLEAVE), o quedar en el nodo del
+ * hilo que toca cada página por primera vez. Como la memoria de mmap ya
+ * viene en cero, reservar en cero no toca las páginas y el primer toque es
+ * el del hilo que las usa.
+ *
+ * Si el sistema no tiene páginas grandes transparentes o NUMA, los bloques
+ * igual se reservan con páginas normales.
+ */
+
+typedef enum {
+    ALOCADOR_NUMA_PRIMER_TOQUE,   // Cada página queda en el nodo del hilo que la toca primero
+    ALOCADOR_NUMA_INTERCALADO     // Las páginas se reparten entre todos los nodos
+} alocador_numa_t;
+
+/* Completa alocador con el alocador de páginas grandes con la política NUMA
+ * dada. No necesita destruirse.
+ */
+void alocador_paginas_grandes(alocador_t *alocador, alocador_numa_t numa);
+
+#endif // ALOCADOR_PAGINAS_H
@@ -0,0 +1,647 @@
+/*
+ * bench.c
+ * Microbenchmarks de la tabla de hash: insertar, obtener (aciertos y fallos),
+ * iterar y borrar, para distintas distribuciones de claves y tamaños. Imprime
+ * una fila por operación en CSV o JSON. Las redimensiones se ven en la cola
+ * (p999 y máximo) de insertar y borrar.
+ *
+ * Uso: ./bench [-n 1000,10000,...] [-d secuencial,aleatoria,urls,zipf] [-f csv|json] [-s semilla]
+ *              [-m estandar|paginas|intercalada] [-e encadenado|filtro|swiss|cuckoo|lineal|compacto|u64]
+ *
+ * Con -e se elige el motor: la tabla con listas de hash.h, la misma con el
+ * filtro de búsquedas fallidas activado, la de grupos de hash_swiss.h, la de
+ * baldes cuckoo de hash_cuckoo.h, la de hashing lineal de hash_lineal.h, la
+ * ordenada de hash_compacto.h, o hash_u64.h, que usa como clave el número
+ * del que sale cada cadena (así se comparan los mismos identificadores con y
+ * sin pasar por cadenas). Todos se llaman a través de punteros a función, así
+ * el costo de la llamada es el mismo.
+ *
+ * Con -m paginas el hash usa el alocador de páginas grandes, y con -m
+ * intercalada además reparte sus bloques grandes entre los nodos NUMA. En
+ * Linux, cada fila incluye los fallos de la TLB de datos por operación
+ * (-1 si perf_event_open no está disponible).
+ */
+#define _DEFAULT_SOURCE
+#include "alocador_paginas.h"
+#include "hash.h"
+#include "hash_compacto.h"
+#include "hash_cuckoo.h"
+#include "hash_lineal.h"
+#include "hash_swiss.h"
+#include "hash_u64.h"
+#include "histograma.h"
+#include "reloj.h"
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
+
+#define LATENCIA_MAXIMA 10000000000u
+#define DIGITOS_LATENCIA 3
+#define ZIPF_THETA 0.99
+#define LARGO_MAX_CLAVE 96
+#define TAMS_POR_OMISION "1000,10000,100000,1000000"
+#define DISTRIBUCIONES_POR_OMISION "secuencial,aleatoria,urls,zipf"
+
+/* ******************************************************************
+ *                        DEFINICIONES
+ * *****************************************************************/
+
+typedef enum { SECUENCIAL, ALEATORIA, URLS, ZIPF, CANT_DISTRIBUCIONES } distribucion_t;
+
+static const char *NOMBRES_DISTRIBUCION[] = { "secuencial", "aleatoria", "urls", "zipf" };
+
+/* Claves de una corrida, todas en un único bloque, y el número del que sale cada una */
+typedef struct claves {
+    char **claves;
+    char *bloque;
+    uint64_t *ids;
+    size_t cantidad;
+} claves_t;
+
+typedef struct salida {
+    bool json;
+    bool primera_fila;
+} salida_t;
+
+/* ******************************************************************
+ *                        FUNCIONES AUXILIARES
+ * *****************************************************************/
+
+static uint64_t aleatorio_estado;
+
+static uint64_t aleatorio(void) {
+    aleatorio_estado ^= aleatorio_estado << 13;
+    aleatorio_estado ^= aleatorio_estado >> 7;
+    aleatorio_estado ^= aleatorio_estado << 17;
+    return aleatorio_estado;
+}
+
+static double aleatorio_uniforme(void) {
+    return (double) (aleatorio() >> 11) / (double) (UINT64_C(1) << 53);
+}
+
+/* Costo de medir una operación vacía, se descuenta de cada medición */
+static uint64_t costo_reloj;
+
+static long rss_pico_kb(void) {
+    struct rusage uso;
+    getrusage(RUSAGE_SELF, &uso);
+    return uso.ru_maxrss;
+}
+
+/* Generador Zipfian de Gray et al., "Quickly generating billion-record
+ * synthetic databases" (SIGMOD 1994). Devuelve rangos en [0, n). */
+typedef struct zipf {
+    size_t n;
+    double zetan, alfa, eta, umbral;
+} zipf_t;
+
+static void zipf_crear(zipf_t *zipf, size_t n) {
+    double zeta2 = 1.0 + pow(0.5, ZIPF_THETA);
+    zipf->n = n;
+    zipf->zetan = 0;
+    for (size_t i = 1; i <= n; i++)
+        zipf->zetan += 1.0 / pow((double) i, ZIPF_THETA);
+    zipf->alfa = 1.0 / (1.0 - ZIPF_THETA);
+    zipf->eta = (1.0 - pow(2.0 / (double) n, 1.0 - ZIPF_THETA)) / (1.0 - zeta2 / zipf->zetan);
+    zipf->umbral = 1.0 + pow(0.5, ZIPF_THETA);
+}
+
+static size_t zipf_siguiente(const zipf_t *zipf) {
+    double u = aleatorio_uniforme(), uz = u * zipf->zetan;
+    size_t rango;
+    if (uz < 1.0)
+        return 0;
+    if (uz < zipf->umbral)
+        return 1;
+    rango = (size_t) ((double) zipf->n * pow(zipf->eta * u - zipf->eta + 1.0, zipf->alfa));
+    return (rango < zipf->n ? rango : zipf->n - 1);
+}
+
+/* Escribe la clave i de la distribución y deja en id el número del que sale.
+ * Las claves de fallo usan otro espacio de valores, así nunca coinciden con
+ * las guardadas (los id aleatorios, con probabilidad despreciable). */
+static int escribir_clave(char *destino, uint64_t *id, distribucion_t distribucion, size_t i, bool fallo) {
+    unsigned long long valor;
+    switch (distribucion) {
+    case ALEATORIA:
+        valor = (unsigned long long) aleatorio();
+        *id = valor;
+        return sprintf(destino, "%c%016llx", fallo ? 'f' : 'k', valor);
+    case URLS:
+        valor = (unsigned long long) aleatorio();
+        *id = valor ^ i;
+        return sprintf(destino, "https://www.ejemplo.com.ar/%s/catalogo/%llu/producto?id=%08llx&ref=%zu",
+                       fallo ? "fallos" : "tienda", valor % 1000, valor >> 32, i);
+    default:
+        *id = fallo ? i + 2000000000u : i;
+        return sprintf(destino, "%08zu", fallo ? i + 2000000000u : i);
+    }
+}
+
+static void claves_destruir(claves_t *claves) {
+    free(claves->claves);
+    free(claves->bloque);
+    free(claves->ids);
+}
+
+static bool claves_crear(claves_t *claves, distribucion_t distribucion, size_t n, bool fallo) {
+    char temporal[LARGO_MAX_CLAVE];
+    uint64_t id;
+    size_t bytes = 0;
+    uint64_t estado = aleatorio_estado;
+
+    /* Primero se calcula el tamaño del bloque con la misma secuencia aleatoria */
+    for (size_t i = 0; i < n; i++)
+        bytes += (size_t) escribir_clave(temporal, &id, distribucion, i, fallo) + 1;
+    aleatorio_estado = estado;
+
+    claves->cantidad = n;
+    claves->claves = malloc(n * sizeof(char *));
+    claves->bloque = malloc(bytes);
+    claves->ids = malloc(n * sizeof(uint64_t));
+    if (!claves->claves || !claves->bloque || !claves->ids) {
+        claves_destruir(claves);
+        return false;
+    }
+    bytes = 0;
+    for (size_t i = 0; i < n; i++) {
+        claves->claves[i] = claves->bloque + bytes;
+        bytes += (size_t) escribir_clave(claves->claves[i], &claves->ids[i], distribucion, i, fallo) + 1;
+    }
+    return true;
+}
+
+/* Permutación aleatoria de [0, n) */
+static size_t *permutacion_crear(size_t n) {
+    size_t *permutacion = malloc(n * sizeof(size_t));
+    if (!permutacion)
+        return NULL;
+    for (size_t i = 0; i < n; i++)
+        permutacion[i] = i;
+    for (size_t i = n; i > 1; i--) {
+        size_t j = (size_t) (aleatorio() % i), aux = permutacion[i - 1];
+        permutacion[i - 1] = permutacion[j];
+        permutacion[j] = aux;
+    }
+    return permutacion;
+}
+
+/* ******************************************************************
+ *                        MEDICIONES
+ * *****************************************************************/
+
+/* Contador de fallos de lectura en la TLB de datos, -1 si no está disponible */
+static int contador_tlb = -1;
+
+static void tlb_abrir(void) {
+#if defined(__linux__) && defined(SYS_perf_event_open)
+    struct perf_event_attr atributos;
+    memset(&atributos, 0, sizeof(atributos));
+    atributos.size = sizeof(atributos);
+    atributos.type = PERF_TYPE_HW_CACHE;
+    atributos.config = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                       (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    atributos.disabled = 1;
+    atributos.exclude_kernel = 1;
+    atributos.exclude_hv = 1;
+    contador_tlb = (int) syscall(SYS_perf_event_open, &atributos, 0, -1, -1, 0);
+#endif
+}
+
+/* Empieza a contar los fallos de la TLB desde cero */
+static void tlb_iniciar(void) {
+#ifdef __linux__
+    if (contador_tlb != -1) {
+        ioctl(contador_tlb, PERF_EVENT_IOC_RESET, 0);
+        ioctl(contador_tlb, PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+}
+
+/* Deja de contar y devuelve los fallos de la TLB por operación, o -1 */
+static double tlb_por_operacion(uint64_t ops) {
+#ifdef __linux__
+    uint64_t fallos;
+    if (contador_tlb != -1) {
+        ioctl(contador_tlb, PERF_EVENT_IOC_DISABLE, 0);
+        if (read(contador_tlb, &fallos, sizeof(fallos)) == sizeof(fallos))
+            return (ops ? (double) fallos / (double) ops : 0);
+    }
+#endif
+    (void) ops;
+    return -1;
+}
+
+/* Motor de tabla de hash a medir, con primitivas sobre un puntero genérico.
+ * Las operaciones reciben la clave i de claves, y cada motor usa la cadena o
+ * el número según su tipo de clave. */
+typedef struct motor {
+    const char *nombre;
+    void *(*crear)(const alocador_t *alocador);
+    bool (*guardar)(void *tabla, const claves_t *claves, size_t i, void *dato);
+    void *(*obtener)(void *tabla, const claves_t *claves, size_t i);
+    void *(*borrar)(void *tabla, const claves_t *claves, size_t i);
+    void (*destruir)(void *tabla);
+    void *(*iter_crear)(void *tabla);
+    bool (*iter_al_final)(void *iter);
+    size_t (*iter_ver_actual)(void *iter);   // Algo que depende de la clave actual, para sumarlo
+    bool (*iter_avanzar)(void *iter);
+    void (*iter_destruir)(void *iter);
+} motor_t;
+
+static void *encadenado_crear(const alocador_t *alocador) { return hash_crear_con_alocador(NULL, alocador); }
+static void *filtro_crear(const alocador_t *alocador) {
+    hash_t *hash = hash_crear_con_alocador(NULL, alocador);
+    if (hash && !hash_activar_filtro(hash)) {
+        hash_destruir(hash);
+        return NULL;
+    }
+    return hash;
+}
+static bool encadenado_guardar(void *tabla, const claves_t *claves, size_t i, void *dato) {
+    return hash_guardar(tabla, claves->claves[i], dato);
+}
+static void *encadenado_obtener(void *tabla, const claves_t *claves, size_t i) {
+    return hash_obtener(tabla, claves->claves[i]);
+}
+static void *encadenado_borrar(void *tabla, const claves_t *claves, size_t i) {
+    return hash_borrar(tabla, claves->claves[i]);
+}
+static void encadenado_destruir(void *tabla) { hash_destruir(tabla); }
+static void *encadenado_iter_crear(void *tabla) { return hash_iter_crear(tabla); }
+static bool encadenado_iter_al_final(void *iter) { return hash_iter_al_final(iter); }
+static size_t encadenado_iter_ver_actual(void *iter) { return (size_t) hash_iter_ver_actual(iter); }
+static bool encadenado_iter_avanzar(void *iter) { return hash_iter_avanzar(iter); }
+static void encadenado_iter_destruir(void *iter) { hash_iter_destruir(iter); }
+
+static void *swiss_crear(const alocador_t *alocador) { return hash_swiss_crear_con_alocador(NULL, alocador); }
+static bool swiss_guardar(void *tabla, const claves_t *claves, size_t i, void *dato) {
+    return hash_swiss_guardar(tabla, claves->claves[i], dato);
+}
+static void *swiss_obtener(void *tabla, const claves_t *claves, size_t i) {
+    return hash_swiss_obtener(tabla, claves->claves[i]);
+}
+static void *swiss_borrar(void *tabla, const claves_t *claves, size_t i) {
+    return hash_swiss_borrar(tabla, claves->claves[i]);
+}
+static void swiss_destruir(void *tabla) { hash_swiss_destruir(tabla); }
+static void *swiss_iter_crear(void *tabla) { return hash_swiss_iter_crear(tabla); }
+static bool swiss_iter_al_final(void *iter) { return hash_swiss_iter_al_final(iter); }
+static size_t swiss_iter_ver_actual(void *iter) { return (size_t) hash_swiss_iter_ver_actual(iter); }
+static bool swiss_iter_avanzar(void *iter) { return hash_swiss_iter_avanzar(iter); }
+static void swiss_iter_destruir(void *iter) { hash_swiss_iter_destruir(iter); }
+
+static void *cuckoo_crear(const alocador_t *alocador) { return hash_cuckoo_crear_con_alocador(NULL, alocador); }
+static bool cuckoo_guardar(void *tabla, const claves_t *claves, size_t i, void *dato) {
+    return hash_cuckoo_guardar(tabla, claves->claves[i], dato);
+}
+static void *cuckoo_obtener(void *tabla, const claves_t *claves, size_t i) {
+    return hash_cuckoo_obtener(tabla, claves->claves[i]);
+}
+static void *cuckoo_borrar(void *tabla, const claves_t *claves, size_t i) {
+    return hash_cuckoo_borrar(tabla, claves->claves[i]);
+}
+static void cuckoo_destruir(void *tabla) { hash_cuckoo_destruir(tabla); }
+static void *cuckoo_iter_crear(void *tabla) { return hash_cuckoo_iter_crear(tabla); }
+static bool cuckoo_iter_al_final(void *iter) { return hash_cuckoo_iter_al_final(iter); }
+static size_t cuckoo_iter_ver_actual(void *iter) { return (size_t) hash_cuckoo_iter_ver_actual(iter); }
+static bool cuckoo_iter_avanzar(void *iter) { return hash_cuckoo_iter_avanzar(iter); }
+static void cuckoo_iter_destruir(void *iter) { hash_cuckoo_iter_destruir(iter); }
+
+static void *lineal_crear(const alocador_t *alocador) { return hash_lineal_crear_con_alocador(NULL, alocador); }
+static bool lineal_guardar(void *tabla, const claves_t *claves, size_t i, void *dato) {
+    return hash_lineal_guardar(tabla, claves->claves[i], dato);
+}
+static void *lineal_obtener(void *tabla, const claves_t *claves, size_t i) {
+    return hash_lineal_obtener(tabla, claves->claves[i]);
+}
+static void *lineal_borrar(void *tabla, const claves_t *claves, size_t i) {
+    return hash_lineal_borrar(tabla, claves->claves[i]);
+}
+static void lineal_destruir(void *tabla) { hash_lineal_destruir(tabla); }
+static void *lineal_iter_crear(void *tabla) { return hash_lineal_iter_crear(tabla); }
+static bool lineal_iter_al_final(void *iter) { return hash_lineal_iter_al_final(iter); }
+static size_t lineal_iter_ver_actual(void *iter) { return (size_t) hash_lineal_iter_ver_actual(iter); }
+static bool lineal_iter_avanzar(void *iter) { return hash_lineal_iter_avanzar(iter); }
+static void lineal_iter_destruir(void *iter) { hash_lineal_iter_destruir(iter); }
+
+static void *compacto_crear(const alocador_t *alocador) { return hash_compacto_crear_con_alocador(NULL, alocador); }
+static bool compacto_guardar(void *tabla, const claves_t *claves, size_t i, void *dato) {
+    return hash_compacto_guardar(tabla, claves->claves[i], dato);
+}
+static void *compacto_obtener(void *tabla, const claves_t *claves, size_t i) {
+    return hash_compacto_obtener(tabla, claves->claves[i]);
+}
+static void *compacto_borrar(void *tabla, const claves_t *claves, size_t i) {
+    return hash_compacto_borrar(tabla, claves->claves[i]);
+}
+static void compacto_destruir(void *tabla) { hash_compacto_destruir(tabla); }
+static void *compacto_iter_crear(void *tabla) { return hash_compacto_iter_crear(tabla); }
+static bool compacto_iter_al_final(void *iter) { return hash_compacto_iter_al_final(iter); }
+static size_t compacto_iter_ver_actual(void *iter) { return (size_t) hash_compacto_iter_ver_actual(iter); }
+static bool compacto_iter_avanzar(void *iter) { return hash_compacto_iter_avanzar(iter); }
+static void compacto_iter_destruir(void *iter) { hash_compacto_iter_destruir(iter); }
+
+static void *u64_crear(const alocador_t *alocador) { return hash_u64_crear_con_alocador(NULL, alocador); }
+static bool u64_guardar(void *tabla, const claves_t *claves, size_t i, void *dato) {
+    return hash_u64_guardar(tabla, claves->ids[i], dato);
+}
+static void *u64_obtener(void *tabla, const claves_t *claves, size_t i) {
+    return hash_u64_obtener(tabla, claves->ids[i]);
+}
+static void *u64_borrar(void *tabla, const claves_t *claves, size_t i) {
+    return hash_u64_borrar(tabla, claves->ids[i]);
+}
+static void u64_destruir(void *tabla) { hash_u64_destruir(tabla); }
+static void *u64_iter_crear(void *tabla) { return hash_u64_iter_crear(tabla); }
+static bool u64_iter_al_final(void *iter) { return hash_u64_iter_al_final(iter); }
+static size_t u64_iter_ver_actual(void *iter) { return (size_t) hash_u64_iter_ver_actual(iter); }
+static bool u64_iter_avanzar(void *iter) { return hash_u64_iter_avanzar(iter); }
+static void u64_iter_destruir(void *iter) { hash_u64_iter_destruir(iter); }
+
+static const motor_t MOTORES[] = {
+    { "encadenado", encadenado_crear, encadenado_guardar, encadenado_obtener, encadenado_borrar,
+      encadenado_destruir, encadenado_iter_crear, encadenado_iter_al_final, encadenado_iter_ver_actual,
+      encadenado_iter_avanzar, encadenado_iter_destruir },
+    { "filtro", filtro_crear, encadenado_guardar, encadenado_obtener, encadenado_borrar,
+      encadenado_destruir, encadenado_iter_crear, encadenado_iter_al_final, encadenado_iter_ver_actual,
+      encadenado_iter_avanzar, encadenado_iter_destruir },
+    { "swiss", swiss_crear, swiss_guardar, swiss_obtener, swiss_borrar, swiss_destruir, swiss_iter_crear,
+      swiss_iter_al_final, swiss_iter_ver_actual, swiss_iter_avanzar, swiss_iter_destruir },
+    { "cuckoo", cuckoo_crear, cuckoo_guardar, cuckoo_obtener, cuckoo_borrar, cuckoo_destruir, cuckoo_iter_crear,
+      cuckoo_iter_al_final, cuckoo_iter_ver_actual, cuckoo_iter_avanzar, cuckoo_iter_destruir },
+    { "lineal", lineal_crear, lineal_guardar, lineal_obtener, lineal_borrar, lineal_destruir, lineal_iter_crear,
+      lineal_iter_al_final, lineal_iter_ver_actual, lineal_iter_avanzar, lineal_iter_destruir },
+    { "compacto", compacto_crear, compacto_guardar, compacto_obtener, compacto_borrar, compacto_destruir,
+      compacto_iter_crear, compacto_iter_al_final, compacto_iter_ver_actual, compacto_iter_avanzar,
+      compacto_iter_destruir },
+    { "u64", u64_crear, u64_guardar, u64_obtener, u64_borrar, u64_destruir, u64_iter_crear, u64_iter_al_final,
+      u64_iter_ver_actual, u64_iter_avanzar, u64_iter_destruir },
+};
+#define CANT_MOTORES (sizeof(MOTORES) / sizeof(MOTORES[0]))
+
+static const motor_t *motor = &MOTORES[0];
+
+/* Alocador de los hashes del benchmark */
+static alocador_t alocador_bench;
+static const char *nombre_memoria = "estandar";
+
+static void imprimir_fila(salida_t *salida, distribucion_t distribucion, size_t n, const char *operacion,
+                          uint64_t ops, double ns_op, const uint64_t p[4], uint64_t max, double tlb_op) {
+    if (salida->json) {
+        printf("%s\n  {\"distribucion\": \"%s\", \"n\": %zu, \"memoria\": \"%s\", \"motor\": \"%s\", \"operacion\": \"%s\", "
+               "\"ops\": %llu, \"ns_op\": %.1f, \"p50_ns\": %llu, \"p90_ns\": %llu, \"p99_ns\": %llu, "
+               "\"p999_ns\": %llu, \"max_ns\": %llu, \"dtlb_fallos_op\": %.3f, \"rss_pico_kb\": %ld}",
+               salida->primera_fila ? "" : ",", NOMBRES_DISTRIBUCION[distribucion], n, nombre_memoria, motor->nombre,
+               operacion, (unsigned long long) ops, ns_op, (unsigned long long) p[0], (unsigned long long) p[1],
+               (unsigned long long) p[2], (unsigned long long) p[3], (unsigned long long) max, tlb_op,
+               rss_pico_kb());
+    } else {
+        printf("%s,%zu,%s,%s,%s,%llu,%.1f,%llu,%llu,%llu,%llu,%llu,%.3f,%ld\n",
+               NOMBRES_DISTRIBUCION[distribucion], n, nombre_memoria, motor->nombre, operacion, (unsigned long long) ops, ns_op,
+               (unsigned long long) p[0], (unsigned long long) p[1], (unsigned long long) p[2],
+               (unsigned long long) p[3], (unsigned long long) max, tlb_op, rss_pico_kb());
+    }
+    salida->primera_fila = false;
+    fflush(stdout);
+}
+
+static void imprimir_histograma(salida_t *salida, distribucion_t distribucion, size_t n, const char *operacion,
+                                const histograma_t *histograma) {
+    double tlb_op = tlb_por_operacion(histograma_cantidad(histograma));
+    uint64_t p[4];
+    p[0] = histograma_percentil(histograma, 50);
+    p[1] = histograma_percentil(histograma, 90);
+    p[2] = histograma_percentil(histograma, 99);
+    p[3] = histograma_percentil(histograma, 99.9);
+    imprimir_fila(salida, distribucion, n, operacion, histograma_cantidad(histograma),
+                  histograma_media(histograma), p, histograma_maximo(histograma), tlb_op);
+}
+
+/* Imprime la operación y vacía el histograma para la siguiente */
+static void imprimir_fase(salida_t *salida, distribucion_t distribucion, size_t n, const char *operacion,
+                          histograma_t *latencias) {
+    imprimir_histograma(salida, distribucion, n, operacion, latencias);
+    histograma_reiniciar(latencias);
+}
+
+/* ******************************************************************
+ *                        BENCHMARKS
+ * *****************************************************************/
+
+static bool bench_correr(salida_t *salida, distribucion_t distribucion, size_t n, uint64_t semilla) {
+    claves_t claves, fallos;
+    size_t *orden;
+    zipf_t zipf = { 0, 0, 0, 0, 0 };
+    void *tabla, *iter;
+    histograma_t *latencias;
+    uint64_t inicio;
+    size_t i, j;
+    volatile size_t suma = 0;
+
+    aleatorio_estado = semilla;
+    if (!claves_crear(&claves, distribucion, n, false))
+        return false;
+    if (!claves_crear(&fallos, distribucion, n, true) || !(orden = permutacion_crear(n))) {
+        claves_destruir(&claves);
+        return false;
+    }
+    if (distribucion == ZIPF)
+        zipf_crear(&zipf, n);
+    tabla = motor->crear(&alocador_bench);
+    latencias = histograma_crear(LATENCIA_MAXIMA, DIGITOS_LATENCIA);
+    if (!tabla || !latencias) {
+        if (tabla)
+            motor->destruir(tabla);
+        if (latencias)
+            histograma_destruir(latencias);
+        free(orden);
+        claves_destruir(&claves);
+        claves_destruir(&fallos);
+        return false;
+    }
+
+    /* Insertar, incluyendo las redimensiones, que se ven en la cola */
+    tlb_iniciar();
+    for (i = 0; i < n; i++) {
+        inicio = reloj_ns();
+        motor->guardar(tabla, &claves, i, claves.claves[i]);
+        reloj_registrar(latencias, inicio, costo_reloj);
+    }
+    imprimir_fase(salida, distribucion, n, "insertar", latencias);
+
+    /* Obtener claves guardadas, en orden aleatorio o con sesgo Zipfian */
+    tlb_iniciar();
+    for (i = 0; i < n; i++) {
+        j = (distribucion == ZIPF ? orden[zipf_siguiente(&zipf)] : orden[i]);
+        inicio = reloj_ns();
+        suma += (size_t) motor->obtener(tabla, &claves, j);
+        reloj_registrar(latencias, inicio, costo_reloj);
+    }
+    imprimir_fase(salida, distribucion, n, "obtener_acierto", latencias);
+
+    /* Obtener claves que no están */
+    tlb_iniciar();
+    for (i = 0; i < n; i++) {
+        inicio = reloj_ns();
+        suma += (size_t) motor->obtener(tabla, &fallos, i);
+        reloj_registrar(latencias, inicio, costo_reloj);
+    }
+    imprimir_fase(salida, distribucion, n, "obtener_fallo", latencias);
+
+    /* Recorrer toda la tabla con el iterador, cada avance es una operación */
+    tlb_iniciar();
+    inicio = reloj_ns();
+    iter = motor->iter_crear(tabla);
+    while (iter) {
+        reloj_registrar(latencias, inicio, costo_reloj);
+        if (motor->iter_al_final(iter))
+            break;
+        inicio = reloj_ns();
+        suma += motor->iter_ver_actual(iter);
+        motor->iter_avanzar(iter);
+    }
+    if (!iter) {
+        histograma_destruir(latencias);
+        motor->destruir(tabla);
+        free(orden);
+        claves_destruir(&claves);
+        claves_destruir(&fallos);
+        return false;
+    }
+    motor->iter_destruir(iter);
+    imprimir_fase(salida, distribucion, n, "iterar", latencias);
+
+    /* Borrar todo en orden aleatorio, incluyendo las redimensiones para achicar */
+    tlb_iniciar();
+    for (i = 0; i < n; i++) {
+        inicio = reloj_ns();
+        suma += (size_t) motor->borrar(tabla, &claves, orden[i]);
+        reloj_registrar(latencias, inicio, costo_reloj);
+    }
+    imprimir_fase(salida, distribucion, n, "borrar", latencias);
+
+    histograma_destruir(latencias);
+    motor->destruir(tabla);
+    free(orden);
+    claves_destruir(&claves);
+    claves_destruir(&fallos);
+    return true;
+}
+
+/* ******************************************************************
+ *                        PROGRAMA PRINCIPAL
+ * *****************************************************************/
+
+static bool distribucion_de_nombre(const char *nombre, size_t largo, distribucion_t *distribucion) {
+    for (int d = 0; d < CANT_DISTRIBUCIONES; d++) {
+        if (strlen(NOMBRES_DISTRIBUCION[d]) == largo && !strncmp(nombre, NOMBRES_DISTRIBUCION[d], largo)) {
+            *distribucion = (distribucion_t) d;
+            return true;
+        }
+    }
+    return false;
+}
+
+/* Valida la lista de tamaños de -n: números separados por comas */
+static bool tams_validos(const char *tams) {
+    char *fin_n;
+    for (const char *t = tams; *t; t = fin_n + 1) {
+        strtoull(t, &fin_n, 10);
+        if (fin_n == t || (*fin_n != ',' && *fin_n))
+            return false;
+        if (!*fin_n)
+            break;
+    }
+    return true;
+}
+
+static bool motor_de_nombre(const char *nombre) {
+    for (size_t m = 0; m < CANT_MOTORES; m++) {
+        if (!strcmp(nombre, MOTORES[m].nombre)) {
+            motor = &MOTORES[m];
+            return true;
+        }
+    }
+    return false;
+}
+
+int main(int argc, char *argv[]) {
+    const char *tams = TAMS_POR_OMISION, *distribuciones = DISTRIBUCIONES_POR_OMISION;
+    salida_t salida = { false, true };
+    uint64_t semilla = 88172645463325252u;
+    distribucion_t distribucion;
+    const char *d, *fin_d;
+    char *fin_n;
+    size_t n;
+
+    alocador_bench = *alocador_estandar();
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (!strcmp(argv[i], "-n"))
+            tams = argv[i + 1];
+        else if (!strcmp(argv[i], "-d"))
+            distribuciones = argv[i + 1];
+        else if (!strcmp(argv[i], "-f"))
+            salida.json = !strcmp(argv[i + 1], "json");
+        else if (!strcmp(argv[i], "-s"))
+            semilla = strtoull(argv[i + 1], NULL, 10) | 1;
+        else if (!strcmp(argv[i], "-m") && strcmp(argv[i + 1], "estandar")) {
+            if (!strcmp(argv[i + 1], "paginas")) {
+                alocador_paginas_grandes(&alocador_bench, ALOCADOR_NUMA_PRIMER_TOQUE);
+            } else if (!strcmp(argv[i + 1], "intercalada")) {
+                alocador_paginas_grandes(&alocador_bench, ALOCADOR_NUMA_INTERCALADO);
+            } else {
+                fprintf(stderr, "Memoria desconocida: %s\n", argv[i + 1]);
+                return 1;
+            }
+            nombre_memoria = argv[i + 1];
+        }
+        else if (!strcmp(argv[i], "-e") && !motor_de_nombre(argv[i + 1])) {
+            fprintf(stderr, "Motor desconocido: %s\n", argv[i + 1]);
+            return 1;
+        }
+    }
+
+    if (!tams_validos(tams)) {
+        fprintf(stderr, "Tamaños inválidos: %s\nUso: %s [-n 1000,10000,...]\n", tams, argv[0]);
+        return 1;
+    }
+
+    costo_reloj = reloj_calibrar();
+    tlb_abrir();
+    if (salida.json)
+        printf("[");
+    else
+        printf("distribucion,n,memoria,motor,operacion,ops,ns_op,p50_ns,p90_ns,p99_ns,p999_ns,max_ns,dtlb_fallos_op,rss_pico_kb\n");
+
+    for (d = distribuciones; *d; d = (*fin_d ? fin_d + 1 : fin_d)) {
+        fin_d = strchr(d, ',');
+        if (!fin_d)
+            fin_d = d + strlen(d);
+        if (!distribucion_de_nombre(d, (size_t) (fin_d - d), &distribucion)) {
+            fprintf(stderr, "Distribución desconocida: %.*s\n", (int) (fin_d - d), d);
+            return 1;
+        }
+        for (const char *t = tams; *t; t = (*fin_n == ',' ? fin_n + 1 : fin_n)) {
+            n = (size_t) strtoull(t, &fin_n, 10);
+            if (n && !bench_correr(&salida, distribucion, n, semilla)) {
+                fprintf(stderr, "Sin memoria para n = %zu\n", n);
+                return 1;
+            }
+        }
+    }
+    if (salida.json)
+        printf("\n]\n");
+    return 0;
+}
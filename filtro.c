@@ -0,0 +1,101 @@
+#include "filtro.h"
+#include "hash_funciones.h"
+#include <string.h>
+#define PALABRAS_POR_BLOQUE 8
+#define BITS_POR_HASH 12    // Con 8 bits prendidos por hash, da menos de 0,5% de falsos positivos
+#define TAM_LINEA 64
+
+/* Un bloque ocupa exactamente una línea de cache */
+typedef struct bloque {
+    uint64_t palabras[PALABRAS_POR_BLOQUE];
+} bloque_t;
+
+struct filtro {
+    bloque_t *bloques;      // Alineados a TAM_LINEA dentro de memoria
+    void *memoria;          // Lo que se pidió al alocador
+    size_t cant_bloques;
+    size_t capacidad;
+    const alocador_t *alocador;
+};
+
+/* Multiplicadores impares para elegir el bit de cada palabra a partir de la
+ * mitad baja del hash, como en los filtros de bloques de Parquet */
+static const uint32_t SALES[PALABRAS_POR_BLOQUE] = {
+    0x47b6137bu, 0x44974d91u, 0x8824ad5bu, 0xa2b7289du,
+    0x705495c7u, 0x2df1424bu, 0x9efc4947u, 0x5c6bfb31u
+};
+
+/* Funciones auxiliares */
+
+/* La mitad alta del hash elige el bloque, sin dividir */
+static bloque_t *bloque_de(const filtro_t *filtro, uint64_t hash) {
+    return &filtro->bloques[(size_t) (((hash >> 32) * filtro->cant_bloques) >> 32)];
+}
+
+/* Bit de la palabra i que le corresponde al hash */
+static uint64_t mascara(uint64_t hash, size_t i) {
+    uint32_t bajo = (uint32_t) hash;
+    return (uint64_t) 1 << ((uint32_t) (bajo * SALES[i]) >> 26);
+}
+
+static size_t bytes_memoria(const filtro_t *filtro) {
+    return filtro->cant_bloques * sizeof(bloque_t) + TAM_LINEA - 1;
+}
+
+/* Primitivas del filtro */
+
+filtro_t *filtro_crear_con_alocador(size_t capacidad, const alocador_t *alocador) {
+    filtro_t *filtro = alocador_reservar(alocador, sizeof(*filtro));
+    if (!filtro)
+        return NULL;
+    filtro->cant_bloques = (capacidad * BITS_POR_HASH + 8 * sizeof(bloque_t) - 1) / (8 * sizeof(bloque_t));
+    if (!filtro->cant_bloques)
+        filtro->cant_bloques = 1;
+    filtro->capacidad = capacidad;
+    filtro->alocador = alocador;
+    filtro->memoria = alocador_reservar_ceros(alocador, bytes_memoria(filtro));
+    if (!filtro->memoria) {
+        alocador_liberar(alocador, filtro, sizeof(*filtro));
+        return NULL;
+    }
+    filtro->bloques = (bloque_t *) (((uintptr_t) filtro->memoria + TAM_LINEA - 1) & ~(uintptr_t) (TAM_LINEA - 1));
+    return filtro;
+}
+
+void filtro_agregar(filtro_t *filtro, uint64_t hash) {
+    bloque_t *bloque;
+    hash = hash_mezclar64(hash);
+    bloque = bloque_de(filtro, hash);
+    for (size_t i = 0; i < PALABRAS_POR_BLOQUE; i++)
+        bloque->palabras[i] |= mascara(hash, i);
+}
+
+bool filtro_puede_contener(const filtro_t *filtro, uint64_t hash) {
+    const bloque_t *bloque;
+    uint64_t faltantes = 0;
+    hash = hash_mezclar64(hash);
+    bloque = bloque_de(filtro, hash);
+    /* Sin cortar antes, así el compilador puede vectorizar las 8 palabras */
+    for (size_t i = 0; i < PALABRAS_POR_BLOQUE; i++)
+        faltantes |= mascara(hash, i) & ~bloque->palabras[i];
+    return !faltantes;
+}
+
+void filtro_limpiar(filtro_t *filtro) {
+    memset(filtro->bloques, 0, filtro->cant_bloques * sizeof(bloque_t));
+}
+
+size_t filtro_capacidad(const filtro_t *filtro) {
+    return filtro->capacidad;
+}
+
+size_t filtro_memoria(const filtro_t *filtro) {
+    return sizeof(*filtro) + bytes_memoria(filtro);
+}
+
+void filtro_destruir(filtro_t *filtro) {
+    if (!filtro)
+        return;
+    alocador_liberar(filtro->alocador, filtro->memoria, bytes_memoria(filtro));
+    alocador_liberar(filtro->alocador, filtro, sizeof(*filtro));
+}
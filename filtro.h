@@ -0,0 +1,56 @@
+#ifndef FILTRO_H
+#define FILTRO_H
+
+#include "alocador.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* Filtro de Bloom por bloques: cada hash elige un bloque de 64 bytes (una
+ * línea de cache) y prende un bit en cada una de sus 8 palabras, así agregar
+ * y consultar tocan una sola línea. Puede dar falsos positivos, nunca falsos
+ * negativos. No se puede sacar un hash: para olvidar los sacados del
+ * conjunto se lo limpia y se vuelven a agregar los que quedan.
+ */
+
+/* Declaraciones de estructuras */
+typedef struct filtro filtro_t;
+
+/* Crea un filtro vacío dimensionado para capacidad hashes, que pide su
+ * memoria al alocador. Devuelve NULL en caso de error.
+ * Post: devuelve un filtro vacío.
+ */
+filtro_t *filtro_crear_con_alocador(size_t capacidad, const alocador_t *alocador);
+
+/* Agrega el hash al filtro.
+ * Pre: el filtro fue creado.
+ */
+void filtro_agregar(filtro_t *filtro, uint64_t hash);
+
+/* Devuelve false si el hash seguro no se agregó desde la última limpieza, y
+ * true si puede haberse agregado.
+ * Pre: el filtro fue creado.
+ */
+bool filtro_puede_contener(const filtro_t *filtro, uint64_t hash);
+
+/* Deja el filtro vacío, con la misma capacidad.
+ * Pre: el filtro fue creado.
+ */
+void filtro_limpiar(filtro_t *filtro);
+
+/* Devuelve la cantidad de hashes para la que se dimensionó el filtro.
+ * Pre: el filtro fue creado.
+ */
+size_t filtro_capacidad(const filtro_t *filtro);
+
+/* Devuelve los bytes que ocupa el filtro.
+ * Pre: el filtro fue creado.
+ */
+size_t filtro_memoria(const filtro_t *filtro);
+
+/* Destruye el filtro.
+ * Post: se liberó la memoria del filtro.
+ */
+void filtro_destruir(filtro_t *filtro);
+
+#endif // FILTRO_H
@@ -1,5 +1,9 @@
 #include "hash.h"
+#include "abb.h"
+#include "filtro.h"
 #include "lista.h"
+#include "reloj.h"
+#include "rueda.h"
 #include <stdlib.h>
 #include <string.h>
 #define TAM_INICIAL 67
@@ -7,19 +11,55 @@
 #define FACTOR_CARGA_MIN 0.3
 #define FACTOR_ACHIQUE 3
 #define FACTOR_AGRANDAMIENTO 3
+#define PERCENTIL_CADENAS 0.99
+#define UMBRAL_ARBOL 8      // Una lista con más claves se convierte en árbol
+#define UMBRAL_LISTA 6      // Un árbol con menos claves vuelve a ser lista
+
+/* Contadores de estadísticas, solo si se compila con -DHASH_ESTADISTICAS.
+ * Se actualizan también desde las primitivas que reciben un hash constante,
+ * que siempre apunta a un hash reservado por su alocador. */
+#ifdef HASH_ESTADISTICAS
+#define CONTAR(hash, campo, n) (((hash_t *) (hash))->contadores.campo += (n))
+#else
+#define CONTAR(hash, campo, n) ((void) (n))
+#endif
 
 /* Definiciones de estructuras de la tabla de hash */
 
 struct hash {
     lista_t **datos;
+    abb_t **arboles;       // Baldes convertidos en árbol, NULL si no hay ninguno
+    size_t cantidad_arboles;
     size_t cantidad;
     size_t tam;
     hash_destruir_dato_t destruir_dato;
+    alocador_t alocador;   // El que recibió el hash al crearse
+    alocador_t contado;    // Pasa por alocador sumando en bytes, lo usan la tabla, las listas y la rueda
+    size_t bytes;          // Bytes pedidos al alocador que siguen en uso
+    rueda_t *rueda;        // Vencimientos de las claves con TTL, se crea con la primera
+    hash_reloj_t reloj;
+    struct cache *cache;   // NULL si el hash no tiene capacidad acotada
+    internador_t *internador;  // NULL si cada nodo tiene su propia copia de la clave
+    bool claves_prestadas;     // Las claves son del llamador, no se copian ni se liberan
+    filtro_t *filtro;          // Descarta búsquedas fallidas, NULL si no se activó
+    size_t borrados_filtro;    // Claves borradas que el filtro todavía no olvidó
+#ifdef HASH_ESTADISTICAS
+    struct contadores {
+        size_t redimensiones;
+        uint64_t ns_redimension;
+        size_t aciertos;
+        size_t fallos;
+        size_t sondeos_aciertos;
+        size_t sondeos_fallos;
+        size_t descartes_filtro;
+    } contadores;
+#endif
 };
 
 struct hash_iter {
     const hash_t *hash;
     lista_iter_t *lista_iter;
+    abb_iter_t *arbol_iter;   // En lugar de lista_iter si el balde es un árbol
     size_t pos;
 };
 
@@ -27,25 +67,53 @@ struct hash_iter {
 typedef struct nodo {
     char *clave;
     void *dato;
+    rueda_entrada_t *vencimiento;   // NULL si la clave no expira
+    struct nodo *cache_ant;         // Vecino más reciente en el orden del cache
+    struct nodo *cache_sig;         // Vecino menos reciente en el orden del cache
+    bool referenciado;              // Bit de referencia de CLOCK
 } nodo_t;
 
+/* Orden de uso de las claves de un hash con capacidad acotada. Es una lista
+ * doblemente enlazada a través de los propios nodos, del más reciente al menos
+ * reciente. Con CLOCK el orden es el de inserción y la aguja es el final. */
+typedef struct cache {
+    hash_politica_t politica;
+    size_t max_claves;
+    size_t max_bytes;
+    size_t bytes;
+    hash_tam_dato_t tam_dato;
+    nodo_t *mas_reciente;
+    nodo_t *menos_reciente;
+} cache_t;
+
 /* Funciones del nodo */
 
-static nodo_t* nodo_crear(const char *clave, void *dato) {
+static nodo_t* nodo_crear(hash_t *hash, const char *clave, void *dato) {
     /* Todo nodo debe tener una clave, no se crean nodos vacios */
     if (!clave) return NULL;
-    nodo_t *nuevo = malloc(sizeof(*nuevo));
+    size_t largo = (hash->claves_prestadas ? 0 : strlen(clave) + 1);
+    nodo_t *nuevo = alocador_reservar(&hash->contado, sizeof(*nuevo));
     if (!nuevo)
         return NULL;
-    /* Reservar espacio para la clave */
-    nuevo->clave = malloc((strlen(clave)+1)*sizeof(char));
+    /* Usar la copia del internador o la clave prestada, o reservar espacio para la clave y copiarla */
+    if (hash->internador) {
+        nuevo->clave = (char *) internador_internar(hash->internador, clave);
+    } else if (hash->claves_prestadas) {
+        nuevo->clave = (char *) clave;
+    } else {
+        nuevo->clave = alocador_reservar(&hash->contado, largo * sizeof(char));
+        if (nuevo->clave)
+            memcpy(nuevo->clave, clave, largo);
+    }
     if (!(nuevo->clave)) {
-        free(nuevo);
+        alocador_liberar(&hash->contado, nuevo, sizeof(*nuevo));
         return NULL;
     }
-    /* Copiar la clave y guardar el dato */
-    strcpy(nuevo->clave, clave);
     nuevo->dato = dato;
+    nuevo->vencimiento = NULL;
+    nuevo->cache_ant = NULL;
+    nuevo->cache_sig = NULL;
+    nuevo->referenciado = false;
     return nuevo;
 }
 
@@ -61,30 +129,151 @@ static void *nodo_ver_dato(nodo_t *nodo) {
     return (nodo_esta_vacio(nodo)? NULL: nodo->dato);
 }
 
-static void nodo_destruir(nodo_t *nodo, hash_destruir_dato_t destruir_dato) {
+/* Funciones del orden de uso del cache */
+
+/* Bytes que ocupa el par (clave, dato) en el presupuesto del cache */
+static size_t cache_bytes_nodo(const cache_t *cache, const nodo_t *nodo) {
+    return strlen(nodo->clave) + 1 + (cache->tam_dato ? cache->tam_dato(nodo->dato) : 0);
+}
+
+static bool cache_contiene(const cache_t *cache, const nodo_t *nodo) {
+    return (nodo->cache_ant || cache->mas_reciente == nodo);
+}
+
+static void cache_enlazar_al_frente(cache_t *cache, nodo_t *nodo) {
+    nodo->cache_ant = NULL;
+    nodo->cache_sig = cache->mas_reciente;
+    if (cache->mas_reciente)
+        cache->mas_reciente->cache_ant = nodo;
+    else
+        cache->menos_reciente = nodo;
+    cache->mas_reciente = nodo;
+}
+
+static void cache_desenlazar(cache_t *cache, nodo_t *nodo) {
+    if (nodo->cache_ant)
+        nodo->cache_ant->cache_sig = nodo->cache_sig;
+    else
+        cache->mas_reciente = nodo->cache_sig;
+    if (nodo->cache_sig)
+        nodo->cache_sig->cache_ant = nodo->cache_ant;
+    else
+        cache->menos_reciente = nodo->cache_ant;
+    nodo->cache_ant = NULL;
+    nodo->cache_sig = NULL;
+}
+
+/* Registra un uso de la clave: LRU la mueve al frente, CLOCK solo marca el bit */
+static void cache_usar(cache_t *cache, nodo_t *nodo) {
+    if (cache->politica == HASH_CACHE_CLOCK) {
+        nodo->referenciado = true;
+    } else if (cache->mas_reciente != nodo) {
+        cache_desenlazar(cache, nodo);
+        cache_enlazar_al_frente(cache, nodo);
+    }
+}
+
+static bool cache_excedido(const cache_t *cache, size_t cantidad) {
+    return ((cache->max_claves && cantidad > cache->max_claves) ||
+            (cache->max_bytes && cache->bytes > cache->max_bytes));
+}
+
+static void nodo_destruir(hash_t *hash, nodo_t *nodo, hash_destruir_dato_t destruir_dato) {
     if (!nodo) return;
+    if (nodo->vencimiento)
+        rueda_quitar(hash->rueda, nodo->vencimiento);
+    if (hash->cache && cache_contiene(hash->cache, nodo)) {
+        hash->cache->bytes -= cache_bytes_nodo(hash->cache, nodo);
+        cache_desenlazar(hash->cache, nodo);
+    }
     if (destruir_dato)
         destruir_dato(nodo->dato);
-    free(nodo->clave);
-    free(nodo);
+    if (hash->internador)
+        internador_soltar(hash->internador, nodo->clave);
+    else if (!hash->claves_prestadas)
+        alocador_liberar(&hash->contado, nodo->clave, strlen(nodo->clave) + 1);
+    alocador_liberar(&hash->contado, nodo, sizeof(*nodo));
+}
+
+/* Devuelve true si el nodo tiene TTL y su vencimiento ya pasó */
+static bool nodo_vencido(const hash_t *hash, const nodo_t *nodo) {
+    if (!nodo->vencimiento)
+        return false;
+    return (rueda_entrada_vencimiento(nodo->vencimiento) <= hash->reloj());
 }
 
 /* Funciones auxiliares */
 
+/* Reloj por omisión: milisegundos de un reloj monótono */
+static uint64_t hash_reloj_monotono(void) {
+    return reloj_ns() / 1000000u;
+}
+
+/* Funciones del alocador contado, cuyo contexto es el hash */
+
+static void *contado_reservar(void *contexto, size_t tam) {
+    hash_t *hash = contexto;
+    void *bloque = alocador_reservar(&hash->alocador, tam);
+    if (bloque)
+        hash->bytes += tam;
+    return bloque;
+}
+
+static void *contado_redimensionar(void *contexto, void *bloque, size_t tam_anterior, size_t tam) {
+    hash_t *hash = contexto;
+    void *nuevo = alocador_redimensionar(&hash->alocador, bloque, tam_anterior, tam);
+    if (nuevo)
+        hash->bytes = hash->bytes - tam_anterior + tam;
+    return nuevo;
+}
+
+static void *contado_reservar_ceros(void *contexto, size_t tam) {
+    hash_t *hash = contexto;
+    void *bloque = alocador_reservar_ceros(&hash->alocador, tam);
+    if (bloque)
+        hash->bytes += tam;
+    return bloque;
+}
+
+static void contado_liberar(void *contexto, void *bloque, size_t tam) {
+    hash_t *hash = contexto;
+    alocador_liberar(&hash->alocador, bloque, tam);
+    hash->bytes -= tam;
+}
+
 /* Crea una estructura hash nueva con un tamaño dado */
-static hash_t *hash_crear_tam_variable(hash_destruir_dato_t destruir_dato, size_t tam) {
-    hash_t *nuevo = malloc(sizeof(*nuevo));
-    lista_t **datos = calloc(tam, sizeof(*datos));
-    if (!nuevo || !datos){
-        free(nuevo);
-        free(datos);
+static hash_t *hash_crear_tam_variable(hash_destruir_dato_t destruir_dato, size_t tam, const alocador_t *alocador) {
+    hash_t *nuevo = alocador_reservar(alocador, sizeof(*nuevo));
+    if (!nuevo)
+        return NULL;
+    nuevo->alocador = *alocador;
+    nuevo->contado.reservar = contado_reservar;
+    nuevo->contado.redimensionar = contado_redimensionar;
+    nuevo->contado.liberar = contado_liberar;
+    nuevo->contado.contexto = nuevo;
+    nuevo->contado.reservar_ceros = contado_reservar_ceros;
+    nuevo->bytes = sizeof(*nuevo);
+    nuevo->datos = alocador_reservar_ceros(&nuevo->contado, tam * sizeof(lista_t *));
+    if (!nuevo->datos) {
+        alocador_liberar(alocador, nuevo, sizeof(*nuevo));
         return NULL;
     }
     /* Caso general */
-    nuevo->datos = datos;
     nuevo->tam = tam;
+    nuevo->arboles = NULL;
+    nuevo->cantidad_arboles = 0;
     nuevo->cantidad = 0;
     nuevo->destruir_dato = destruir_dato;
+    nuevo->rueda = NULL;
+    nuevo->reloj = hash_reloj_monotono;
+    nuevo->cache = NULL;
+    nuevo->internador = NULL;
+    nuevo->claves_prestadas = false;
+    nuevo->filtro = NULL;
+    nuevo->borrados_filtro = 0;
+#ifdef HASH_ESTADISTICAS
+    memset(&nuevo->contadores, 0, sizeof(nuevo->contadores));
+#endif
     return nuevo;
 }
 
@@ -102,7 +291,7 @@ static void destruir_lista_con_iter(hash_t * hash, lista_iter_t * iter, size_t i
 static bool crear_lista_con_iter(hash_t * hash, lista_iter_t ** iter, size_t indice) {
     lista_iter_t *nuevo_iter;
     if (!hash->datos[indice]) {
-        hash->datos[indice] = lista_crear();
+        hash->datos[indice] = lista_crear_con_alocador(&hash->contado);
         if (!hash->datos[indice])
             return false;
     }
@@ -115,87 +304,258 @@ static bool crear_lista_con_iter(hash_t * hash, lista_iter_t ** iter, size_t ind
     return true;
 }
 
-/* Compara las claves, evitando pasarle NULL a strcmp, devuelve true si son iguales */
-static bool comparar_claves(const char * clave1, const char * clave2) {
+/* Compara las claves, evitando pasarle NULL a strcmp, devuelve true si son iguales.
+ * Con internador las dos son copias canónicas y alcanza con comparar punteros.
+ * Si no, el mismo puntero (frecuente con claves prestadas) evita el strcmp */
+static bool comparar_claves(const hash_t * hash, const char * clave1, const char * clave2) {
     if (!clave1 || !clave2)
         return false;
+    else if (hash->internador || clave1 == clave2)
+        return clave1 == clave2;
     else
         return !strcmp(clave1, clave2);
 }
 
-/* Busca la clave en la lista, devuelve true si la encuentra, false en caso contrario.
+/* Devuelve la clave con la que se busca en las listas: con internador es la
+ * copia canónica, o NULL si no está internada y por lo tanto no está en el hash */
+static const char *clave_buscada(const hash_t * hash, const char * clave) {
+    if (!hash->internador || !clave)
+        return clave;
+    return internador_buscar(hash->internador, clave);
+}
+
+typedef struct busqueda {
+    const hash_t *hash;
+    const char *clave;
+    size_t sondeos;
+} busqueda_t;
+
+static bool coincide_clave(void *dato, void *extra) {
+    busqueda_t *busqueda = extra;
+    busqueda->sondeos++;
+    return comparar_claves(busqueda->hash, busqueda->clave, nodo_ver_clave(dato));
+}
+
+/* Busca la clave, que tiene esa etiqueta, en la lista. Devuelve true si la
+ * encuentra, false en caso contrario. Solo se comparan (y cuentan como
+ * sondeos) las claves con la misma etiqueta.
  * Deja el iterador en la clave si la encontró o al final en caso contrario.
  */
-static bool buscar_clave_lista(const char * clave, lista_iter_t * iter) {
-    char *clave_lista;
-    /* Mientras se pueda avanzar, buscamos la clave */
-    do {
-        clave_lista = nodo_ver_clave(lista_iter_ver_actual(iter));
-        if (comparar_claves(clave, clave_lista))
-            return true;
-    } while (lista_iter_avanzar(iter));
+static bool buscar_clave_lista(const hash_t * hash, const char * clave, uint8_t etiqueta, lista_iter_t * iter) {
+    busqueda_t busqueda = { hash, clave, 0 };
+    if (lista_iter_buscar(iter, etiqueta, coincide_clave, &busqueda)) {
+        CONTAR(hash, aciertos, 1);
+        CONTAR(hash, sondeos_aciertos, busqueda.sondeos);
+        return true;
+    }
+    CONTAR(hash, fallos, 1);
+    CONTAR(hash, sondeos_fallos, busqueda.sondeos);
     return false;
 }
 
-/* Devuelve el indice a una lista distinta de NULL en la tabla de hash */
-static size_t buscar_lista_hash(const hash_t * hash, size_t inicio) {
+/* Devuelve el árbol del balde, o NULL si el balde es una lista o está vacío */
+static abb_t *arbol_del_balde(const hash_t * hash, size_t indice) {
+    return (hash->arboles ? hash->arboles[indice] : NULL);
+}
+
+/* Devuelve el indice a un balde no vacío, lista o árbol, en la tabla de hash */
+static size_t buscar_balde_hash(const hash_t * hash, size_t inicio) {
     size_t i;
 
     for (i = inicio; i < hash->tam; i++) {
-        if (hash->datos[i])
+        if (hash->datos[i] || arbol_del_balde(hash, i))
             return i;
     }
     return hash->tam;
 }
 
-/* Actualiza el iterador de la lista, asumiendo que la posición ya fue actualizada */
+/* Devuelve la cantidad de claves del balde */
+static size_t largo_balde(const hash_t * hash, size_t indice) {
+    if (hash->datos[indice])
+        return lista_largo(hash->datos[indice]);
+    return (arbol_del_balde(hash, indice) ? abb_cantidad(hash->arboles[indice]) : 0);
+}
+
+/* Actualiza el iterador del balde, asumiendo que la posición ya fue actualizada */
 static bool actualizar_lista_iter(hash_iter_t * iter) {
-    if (hash_iter_al_final(iter)) {
-        iter->lista_iter = NULL;
-    } else {
+    iter->lista_iter = NULL;
+    iter->arbol_iter = NULL;
+    if (hash_iter_al_final(iter))
+        return true;
+    if (iter->hash->datos[iter->pos])
         iter->lista_iter = lista_iter_crear(iter->hash->datos[iter->pos]);
-        if (!iter->lista_iter) {
-            return false;
-        }
-    }
-    return true;
+    else
+        iter->arbol_iter = abb_iter_crear(iter->hash->arboles[iter->pos]);
+    return (iter->lista_iter || iter->arbol_iter);
 }
 
 /* Destruye los nodos de la lista y la lista */
-static void hash_lista_destruir(lista_t * lista, hash_destruir_dato_t destruir_dato) {
+static void hash_lista_destruir(hash_t * hash, lista_t * lista) {
     while (!lista_esta_vacia(lista)) {
-        nodo_destruir(lista_borrar_primero(lista), destruir_dato);
+        nodo_destruir(hash, lista_borrar_primero(lista), hash->destruir_dato);
     }
     lista_destruir(lista, NULL);
 }
 
-/* Destruye las listas de la tabla de hash */
+static bool destruir_nodo_visitado(void *dato, void *extra) {
+    hash_t *hash = extra;
+    nodo_destruir(hash, dato, hash->destruir_dato);
+    return true;
+}
+
+static void liberar_arboles(hash_t * hash) {
+    alocador_liberar(&hash->contado, hash->arboles, hash->tam * sizeof(abb_t *));
+    hash->arboles = NULL;
+    hash->cantidad_arboles = 0;
+}
+
+/* Destruye las listas y los árboles de la tabla de hash */
 static void hash_listas_destruir(hash_t * hash) {
     size_t i = 0;
 
-    while ((i = buscar_lista_hash(hash, i)) != hash->tam) {
-        hash_lista_destruir(hash->datos[i], hash->destruir_dato);
-        hash->datos[i] = NULL;
+    while ((i = buscar_balde_hash(hash, i)) != hash->tam) {
+        if (hash->datos[i]) {
+            hash_lista_destruir(hash, hash->datos[i]);
+            hash->datos[i] = NULL;
+        } else {
+            /* El árbol solo recorre sus propios nodos, no las claves que se liberan */
+            abb_iterar(hash->arboles[i], destruir_nodo_visitado, hash);
+            abb_destruir(hash->arboles[i], NULL);
+            hash->arboles[i] = NULL;
+        }
     }
-}
-
-/* Devuelve clave actual, ese dato no se puede modificar ni liberar */
-static void *hash_iter_ver_dato(const hash_iter_t *iter) {
-	if (hash_iter_al_final(iter))
-		return NULL;
-    /* La clave está dentro del nodo dentro del nodo de la lista apuntado por lista_iter */
-    /* lista_iter va a apuntar a algo válido, por lo que ninguna función va a devolver NULL */
-    return nodo_ver_dato(lista_iter_ver_actual(iter->lista_iter));
+    liberar_arboles(hash);
 }
 
 /* Función de hash:
  * Implementación sencilla de la función de hash de K&R */
-static size_t hash_conseguir_indice(const hash_t *hash, const char *clave) {
+static size_t hash_funcion(const char *clave) {
     size_t hashval;
 
     for (hashval = 0; *clave != '\0'; clave++)
         hashval = *clave + 31 * hashval;
-	return hashval % hash->tam;
+    return hashval;
+}
+
+/* Etiqueta que acompaña al nodo en su lista. Sale de los bits altos del hash
+ * mezclado, porque los bajos son casi los mismos en todo el balde */
+static uint8_t etiqueta_de(size_t hash_clave) {
+    return (uint8_t) (((uint64_t) hash_clave * 0x9E3779B97F4A7C15u) >> 56);
+}
+
+/* Funciones de los baldes convertidos en árbol. Con muchas colisiones (por
+ * ejemplo, claves elegidas a propósito) una lista larga haría cada búsqueda
+ * lineal; como árbol, ordenado por el hash completo y la clave, es logarítmica */
+
+/* Busca la clave en un árbol, devuelve su nodo o NULL si no está */
+static nodo_t *buscar_clave_arbol(const hash_t * hash, const abb_t * arbol, size_t hash_clave, const char * clave) {
+    size_t sondeos = 0;
+    nodo_t *nodo = abb_obtener(arbol, hash_clave, clave, &sondeos);
+    if (nodo) {
+        CONTAR(hash, aciertos, 1);
+        CONTAR(hash, sondeos_aciertos, sondeos);
+    } else {
+        CONTAR(hash, fallos, 1);
+        CONTAR(hash, sondeos_fallos, sondeos);
+    }
+    return nodo;
+}
+
+static bool agregar_al_arbol(void *dato, void *extra) {
+    nodo_t *nodo = dato;
+    return abb_guardar(extra, hash_funcion(nodo->clave), nodo->clave, nodo, NULL);
+}
+
+static bool agregar_a_lista(void *dato, void *extra) {
+    return lista_insertar_ultimo_con_etiqueta(extra, dato, etiqueta_de(hash_funcion(nodo_ver_clave(dato))));
+}
+
+/* Convierte la lista del índice en un árbol. Si no hay memoria la deja como
+ * lista, que sigue siendo correcta aunque más lenta */
+static void convertir_en_arbol(hash_t * hash, size_t indice) {
+    lista_t *lista = hash->datos[indice];
+    abb_t *arbol;
+
+    if (!hash->arboles && !(hash->arboles = alocador_reservar_ceros(&hash->contado, hash->tam * sizeof(abb_t *))))
+        return;
+    arbol = abb_crear_con_alocador(&hash->contado);
+    if (arbol)
+        lista_iterar(lista, agregar_al_arbol, arbol);
+    if (!arbol || abb_cantidad(arbol) != lista_largo(lista)) {
+        abb_destruir(arbol, NULL);
+        if (!hash->cantidad_arboles)
+            liberar_arboles(hash);
+        return;
+    }
+    lista_destruir(lista, NULL);
+    hash->datos[indice] = NULL;
+    hash->arboles[indice] = arbol;
+    hash->cantidad_arboles++;
+}
+
+/* Convierte el árbol del índice en una lista, o lo destruye si quedó vacío.
+ * Si no hay memoria lo deja como árbol */
+static void convertir_en_lista(hash_t * hash, size_t indice) {
+    abb_t *arbol = hash->arboles[indice];
+    lista_t *lista = NULL;
+
+    if (abb_cantidad(arbol)) {
+        if (!(lista = lista_crear_con_alocador(&hash->contado)))
+            return;
+        abb_iterar(arbol, agregar_a_lista, lista);
+        if (lista_largo(lista) != abb_cantidad(arbol)) {
+            lista_destruir(lista, NULL);
+            return;
+        }
+    }
+    abb_destruir(arbol, NULL);
+    hash->arboles[indice] = NULL;
+    hash->datos[indice] = lista;
+    if (!--(hash->cantidad_arboles))
+        liberar_arboles(hash);
+}
+
+/* Funciones del filtro de búsquedas fallidas */
+
+/* El filtro se dimensiona para la cantidad de claves con la que la tabla
+ * actual se agranda */
+static size_t capacidad_filtro(const hash_t * hash) {
+    size_t capacidad = hash->tam * (FACTOR_CARGA_MAX + 1);
+    return (hash->cantidad > capacidad ? hash->cantidad : capacidad);
+}
+
+/* Devuelve false si la clave seguro no está en el hash */
+static bool filtro_permite(const hash_t * hash, size_t hash_clave) {
+    if (!hash->filtro || filtro_puede_contener(hash->filtro, hash_clave))
+        return true;
+    CONTAR(hash, fallos, 1);
+    CONTAR(hash, descartes_filtro, 1);
+    return false;
+}
+
+static bool agregar_al_filtro(void *dato, void *extra) {
+    filtro_agregar(extra, hash_funcion(nodo_ver_clave(dato)));
+    return true;
+}
+
+/* Arma un filtro nuevo con las claves actuales, dimensionado para la tabla
+ * actual, y olvida las borradas. Si no hay memoria sigue el anterior, que es
+ * correcto aunque dé más falsos positivos */
+static bool filtro_rearmar(hash_t * hash) {
+    filtro_t *nuevo = filtro_crear_con_alocador(capacidad_filtro(hash), &hash->contado);
+    size_t i = 0;
+    if (!nuevo)
+        return false;
+    for (; (i = buscar_balde_hash(hash, i)) != hash->tam; i++) {
+        if (hash->datos[i])
+            lista_iterar(hash->datos[i], agregar_al_filtro, nuevo);
+        else
+            abb_iterar(hash->arboles[i], agregar_al_filtro, nuevo);
+    }
+    filtro_destruir(hash->filtro);
+    hash->filtro = nuevo;
+    hash->borrados_filtro = 0;
+    return true;
 }
 
 /* Funciones de redimensionamiento del hash */
@@ -213,148 +573,479 @@ static bool debe_achicar(const hash_t * hash) {
         return false;
 }
 
-static bool hash_redimensionar(hash_t * hash, size_t tam_nuevo) {
-    hash_t * nuevo_hash = hash_crear_tam_variable(hash->destruir_dato, tam_nuevo);
-    hash_iter_t * iter = hash_iter_crear(hash);
-    if (!nuevo_hash || !iter) {
-        free(nuevo_hash);
-        free(iter);
+/* Datos para crear las listas de la tabla nueva al redimensionar */
+typedef struct tabla_nueva {
+    lista_t **datos;
+    size_t tam;
+    bool ok;
+    const alocador_t *alocador;
+} tabla_nueva_t;
+
+/* Crea la lista de la tabla nueva que va a recibir al nodo, si todavía no
+ * existe, y le reserva lugar para él */
+static bool crear_lista_destino(void *dato, void *extra) {
+    tabla_nueva_t *tabla = extra;
+    size_t indice = hash_funcion(nodo_ver_clave(dato)) % tabla->tam;
+    if ((!tabla->datos[indice] && !(tabla->datos[indice] = lista_crear_con_alocador(tabla->alocador)))
+        || !lista_reservar(tabla->datos[indice], 1)) {
+        tabla->ok = false;
         return false;
     }
+    return true;
+}
 
-    /* Se guardan los elementos del hash viejo en el nuevo */
-    do {
-        if (!hash_guardar(nuevo_hash, hash_iter_ver_actual(iter), hash_iter_ver_dato(iter)))
-            break;
-    } while (hash_iter_avanzar(iter));
-
-    hash_iter_destruir(iter);
-
-    /* Si se copiaron todos los elementos, entonces terminó bien el while */
-    if (hash->cantidad == nuevo_hash->cantidad) {
-        /* Se destruyen las listas y la tabla, que son las cosas que se reemplazan */
-        /* Los datos NO deben que destruirse, por eso se le saca la función destruir_dato temporalmente */
-        hash->destruir_dato = NULL;
-        hash_listas_destruir(hash);
-        free(hash->datos);
-        /* Se reemplaza por la nueva tabla, el nuevo tamaño y la función destruir_dato */
-        hash->datos = nuevo_hash->datos;
-        hash->tam = tam_nuevo;
-        hash->destruir_dato = nuevo_hash->destruir_dato;
-        free(nuevo_hash); // Solo se elimina nuevo_hash como cascarón de la tabla nueva que se creó
-        return true;
-    } else {
-        /* Si falló se destruye todo el hash nuevo, excepto los datos */
-        nuevo_hash->destruir_dato = NULL;
-        hash_destruir(nuevo_hash);
+/* Pasa el nodo de un árbol al principio de su lista en la tabla nueva, que
+ * ya tiene el lugar reservado */
+static bool mover_a_lista_destino(void *dato, void *extra) {
+    tabla_nueva_t *tabla = extra;
+    size_t hash_clave = hash_funcion(nodo_ver_clave(dato));
+    lista_insertar_primero_con_etiqueta(tabla->datos[hash_clave % tabla->tam], dato, etiqueta_de(hash_clave));
+    return true;
+}
+
+/* Mueve los nodos a una tabla de tam_nuevo listas. Los nodos no se copian,
+ * así sus claves, datos y vencimientos siguen siendo los mismos. Los árboles
+ * se deshacen y después se vuelven a convertir las listas que quedaron largas */
+static bool hash_redimensionar(hash_t * hash, size_t tam_nuevo) {
+    tabla_nueva_t tabla = { alocador_reservar_ceros(&hash->contado, tam_nuevo * sizeof(lista_t *)), tam_nuevo, true,
+                            &hash->contado };
+    size_t i = 0;
+    nodo_t *nodo;
+#ifdef HASH_ESTADISTICAS
+    uint64_t inicio = reloj_ns();
+#endif
+    if (!tabla.datos)
+        return false;
+
+    /* Primero se crean todas las listas necesarias con el lugar reservado,
+     * así mover los nodos no puede fallar */
+    while (tabla.ok && (i = buscar_balde_hash(hash, i)) != hash->tam) {
+        if (hash->datos[i])
+            lista_iterar(hash->datos[i], crear_lista_destino, &tabla);
+        else
+            abb_iterar(hash->arboles[i], crear_lista_destino, &tabla);
+        i++;
+    }
+    if (!tabla.ok) {
+        for (i = 0; i < tam_nuevo; i++)
+            lista_destruir(tabla.datos[i], NULL);
+        alocador_liberar(&hash->contado, tabla.datos, tam_nuevo * sizeof(lista_t *));
         return false;
     }
+
+    /* Se mueven los nodos y se destruyen las listas y árboles viejos, que quedan vacíos */
+    i = 0;
+    while ((i = buscar_balde_hash(hash, i)) != hash->tam) {
+        if (!hash->datos[i]) {
+            abb_iterar(hash->arboles[i], mover_a_lista_destino, &tabla);
+            abb_destruir(hash->arboles[i], NULL);
+            hash->arboles[i] = NULL;
+            continue;
+        }
+        while ((nodo = lista_ver_primero(hash->datos[i])))
+            lista_transferir_primero(hash->datos[i], tabla.datos[hash_funcion(nodo->clave) % tam_nuevo]);
+        lista_destruir(hash->datos[i], NULL);
+        hash->datos[i] = NULL;
+    }
+    liberar_arboles(hash);
+    alocador_liberar(&hash->contado, hash->datos, hash->tam * sizeof(lista_t *));
+    hash->datos = tabla.datos;
+    hash->tam = tam_nuevo;
+    for (i = 0; i < tam_nuevo; i++) {
+        if (hash->datos[i] && lista_largo(hash->datos[i]) > UMBRAL_ARBOL)
+            convertir_en_arbol(hash, i);
+    }
+    if (hash->filtro)
+        filtro_rearmar(hash);
+#ifdef HASH_ESTADISTICAS
+    hash->contadores.redimensiones++;
+    hash->contadores.ns_redimension += reloj_ns() - inicio;
+#endif
+    return true;
 }
 
-/**************************************
- **  Primitivas de la Tabla de hash  **
- **************************************/
+/* Saca el nodo de la tabla liberando su dato con destruir_dato */
+static void hash_reclamar_nodo(hash_t *hash, nodo_t *nodo) {
+    /* hash_borrar ya libera el dato de las claves vencidas */
+    bool vencido = nodo_vencido(hash, nodo);
+    void *dato = hash_borrar(hash, nodo->clave);
+    if (!vencido && hash->destruir_dato)
+        hash->destruir_dato(dato);
+}
 
-hash_t *hash_crear(hash_destruir_dato_t destruir_dato) {
-    return hash_crear_tam_variable(destruir_dato, TAM_INICIAL);
+/* Desaloja claves desde el final del orden de uso hasta volver a estar dentro
+ * del presupuesto. La clave recién guardada, nuevo, no se desaloja nunca. */
+static void hash_desalojar(hash_t *hash, nodo_t *nuevo) {
+    cache_t *cache = hash->cache;
+    nodo_t *victima;
+    size_t cantidad;
+
+    while (cache_excedido(cache, hash->cantidad) && (victima = cache->menos_reciente) != nuevo) {
+        /* CLOCK: una clave referenciada tiene otra oportunidad, la aguja sigue
+         * de largo. Pasa al frente pero detrás de nuevo, así si todas estaban
+         * referenciadas la aguja da la vuelta y no llega a nuevo */
+        if (victima->referenciado) {
+            victima->referenciado = false;
+            cache_desenlazar(cache, victima);
+            cache_enlazar_al_frente(cache, victima);
+            cache_desenlazar(cache, nuevo);
+            cache_enlazar_al_frente(cache, nuevo);
+            continue;
+        }
+        cantidad = hash->cantidad;
+        hash_reclamar_nodo(hash, victima);
+        if (hash->cantidad == cantidad)
+            break; // No se pudo sacar el nodo, se reintenta en el próximo guardar
+    }
 }
 
-bool hash_guardar(hash_t *hash, const char *clave, void *dato) {
+/* Guarda el par (clave, dato). Si expira es true, la clave vence en el tick vencimiento */
+static bool hash_guardar_con_vencimiento(hash_t *hash, const char *clave, void *dato,
+                                         bool expira, uint64_t vencimiento) {
     if (!clave) return false; // Debe recibir una clave válida
-    size_t indice = hash_conseguir_indice(hash, clave);
-    nodo_t *nuevo = nodo_crear(clave, dato);
+    size_t hash_clave = hash_funcion(clave), indice = hash_clave % hash->tam;
+    nodo_t *nuevo = nodo_crear(hash, clave, dato);
     lista_iter_t *iter;
+    abb_t *arbol;
+    void *anterior;
     if (!nuevo) return false;
 
-    /* Se crea la lista si no existe, si la lista o el iterador de esa lista no se pueden crear devuelve false */
-    if (!crear_lista_con_iter(hash, &iter, indice)) {
-        nodo_destruir(nuevo, hash->destruir_dato);
-        return false;
-    }
-    /* Busca la clave, si la encuentra tiene que borrar el elemento que va a ser reemplazado */
-    if (buscar_clave_lista(clave, iter)) {
-        nodo_destruir(lista_iter_borrar(iter), hash->destruir_dato); // El iter quedó en la posición del elemento repetido
-        --(hash->cantidad);
+    /* Se agenda el vencimiento antes de tocar la tabla, para no tener que deshacer nada */
+    if (expira) {
+        if (!hash->rueda)
+            hash->rueda = rueda_crear_con_alocador(hash->reloj(), &hash->contado);
+        if (!hash->rueda || !(nuevo->vencimiento = rueda_agregar(hash->rueda, vencimiento, nuevo))) {
+            nodo_destruir(hash, nuevo, hash->destruir_dato);
+            return false;
+        }
     }
-    /* Si no puede insertarlo tiene que destruir el nodo, el iter y la lista si está vacía */
-    if (!lista_iter_insertar(iter, nuevo)) {
-        nodo_destruir(nuevo, hash->destruir_dato);
-        destruir_lista_con_iter(hash, iter, indice);
-        return false;
+    if (!hash->datos[indice] && (arbol = arbol_del_balde(hash, indice))) {
+        /* En un árbol, guardar una clave que ya estaba reemplaza su nodo sin pedir memoria */
+        if (!abb_guardar(arbol, hash_clave, nuevo->clave, nuevo, &anterior)) {
+            nodo_destruir(hash, nuevo, hash->destruir_dato);
+            return false;
+        }
+        if (anterior) {
+            nodo_destruir(hash, anterior, hash->destruir_dato);
+            --(hash->cantidad);
+        }
+    } else {
+        /* Se crea la lista si no existe, si la lista o el iterador de esa lista no se pueden crear devuelve false */
+        if (!crear_lista_con_iter(hash, &iter, indice)) {
+            nodo_destruir(hash, nuevo, hash->destruir_dato);
+            return false;
+        }
+        /* Busca la clave, si la encuentra tiene que borrar el elemento que va a ser reemplazado */
+        if (buscar_clave_lista(hash, nuevo->clave, etiqueta_de(hash_clave), iter)) {
+            nodo_destruir(hash, lista_iter_borrar(iter), hash->destruir_dato); // El iter quedó en la posición del elemento repetido
+            --(hash->cantidad);
+        }
+        /* Si no puede insertarlo tiene que destruir el nodo, el iter y la lista si está vacía */
+        if (!lista_iter_insertar_con_etiqueta(iter, nuevo, etiqueta_de(hash_clave))) {
+            nodo_destruir(hash, nuevo, hash->destruir_dato);
+            destruir_lista_con_iter(hash, iter, indice);
+            return false;
+        }
+        lista_iter_destruir(iter);
+        if (lista_largo(hash->datos[indice]) > UMBRAL_ARBOL)
+            convertir_en_arbol(hash, indice);
     }
-    lista_iter_destruir(iter);
     ++(hash->cantidad);
+    if (hash->filtro)
+        filtro_agregar(hash->filtro, hash_clave);
+    if (hash->cache) {
+        hash->cache->bytes += cache_bytes_nodo(hash->cache, nuevo);
+        cache_enlazar_al_frente(hash->cache, nuevo);
+        hash_desalojar(hash, nuevo);
+    }
     if (debe_agrandar(hash))
         hash_redimensionar(hash, (hash->tam)*FACTOR_AGRANDAMIENTO);
     return true;
 }
 
+/* Saca de la tabla un nodo que la rueda dio por vencido y libera su dato */
+static void hash_vencer_nodo(void *dato, void *extra) {
+    hash_t *hash = extra;
+    nodo_t *nodo = dato;
+
+    /* La rueda ya liberó la entrada, el nodo pasa a ser uno sin TTL para poder borrarlo */
+    nodo->vencimiento = NULL;
+    hash_reclamar_nodo(hash, nodo);
+}
+
+/**************************************
+ **  Primitivas de la Tabla de hash  **
+ **************************************/
+
+hash_t *hash_crear(hash_destruir_dato_t destruir_dato) {
+    return hash_crear_tam_variable(destruir_dato, TAM_INICIAL, alocador_estandar());
+}
+
+hash_t *hash_crear_con_alocador(hash_destruir_dato_t destruir_dato, const alocador_t *alocador) {
+    return hash_crear_tam_variable(destruir_dato, TAM_INICIAL, alocador);
+}
+
+hash_t *hash_crear_con_internador(hash_destruir_dato_t destruir_dato, internador_t *internador) {
+    return hash_crear_con_internador_y_alocador(destruir_dato, internador, alocador_estandar());
+}
+
+hash_t *hash_crear_con_internador_y_alocador(hash_destruir_dato_t destruir_dato, internador_t *internador,
+                                             const alocador_t *alocador) {
+    hash_t *hash = hash_crear_tam_variable(destruir_dato, TAM_INICIAL, alocador);
+    if (hash)
+        hash->internador = internador;
+    return hash;
+}
+
+hash_t *hash_crear_con_claves_prestadas(hash_destruir_dato_t destruir_dato) {
+    return hash_crear_con_claves_prestadas_y_alocador(destruir_dato, alocador_estandar());
+}
+
+hash_t *hash_crear_con_claves_prestadas_y_alocador(hash_destruir_dato_t destruir_dato, const alocador_t *alocador) {
+    hash_t *hash = hash_crear_tam_variable(destruir_dato, TAM_INICIAL, alocador);
+    if (hash)
+        hash->claves_prestadas = true;
+    return hash;
+}
+
+hash_t *hash_crear_cache(hash_destruir_dato_t destruir_dato, hash_politica_t politica,
+                         size_t max_claves, size_t max_bytes, hash_tam_dato_t tam_dato) {
+    return hash_crear_cache_con_alocador(destruir_dato, politica, max_claves, max_bytes, tam_dato,
+                                         alocador_estandar());
+}
+
+hash_t *hash_crear_cache_con_alocador(hash_destruir_dato_t destruir_dato, hash_politica_t politica,
+                                      size_t max_claves, size_t max_bytes, hash_tam_dato_t tam_dato,
+                                      const alocador_t *alocador) {
+    hash_t *hash = hash_crear_tam_variable(destruir_dato, TAM_INICIAL, alocador);
+    cache_t *cache;
+    if (!hash)
+        return NULL;
+    cache = alocador_reservar_ceros(&hash->contado, sizeof(*cache));
+    if (!cache) {
+        hash_destruir(hash);
+        return NULL;
+    }
+    cache->politica = politica;
+    cache->max_claves = max_claves;
+    cache->max_bytes = max_bytes;
+    cache->tam_dato = tam_dato;
+    hash->cache = cache;
+    return hash;
+}
+
+bool hash_guardar(hash_t *hash, const char *clave, void *dato) {
+    return hash_guardar_con_vencimiento(hash, clave, dato, false, 0);
+}
+
+bool hash_guardar_con_ttl(hash_t *hash, const char *clave, void *dato, uint64_t ttl) {
+    return hash_guardar_con_vencimiento(hash, clave, dato, true, hash->reloj() + ttl);
+}
+
 void *hash_borrar(hash_t *hash, const char *clave) {
-	size_t indice = hash_conseguir_indice(hash,clave);
     lista_iter_t * iter;
     nodo_t * nodo_salida;
     void * dato_salida;
+    size_t hash_clave, indice;
+    abb_t * arbol;
 
-    /* Si la lista es NULL o no logra crear un iterador para recorrerla devuelve NULL */
-	if(!hash->datos[indice] || !(iter = lista_iter_crear(hash->datos[indice])) )
+    if (!(clave = clave_buscada(hash, clave))) {
+        CONTAR(hash, fallos, 1);
         return NULL;
-    /* Caso general */
-    if (buscar_clave_lista(clave, iter)) {
+    }
+    hash_clave = hash_funcion(clave);
+    if (!filtro_permite(hash, hash_clave))
+        return NULL;
+    indice = hash_clave % hash->tam;
+    if (!hash->datos[indice] && (arbol = arbol_del_balde(hash, indice))) {
+        if (!buscar_clave_arbol(hash, arbol, hash_clave, clave))
+            return NULL;
+        nodo_salida = abb_borrar(arbol, hash_clave, clave);
+        /* Un árbol que quedó corto vuelve a ser lista */
+        if (abb_cantidad(arbol) < UMBRAL_LISTA)
+            convertir_en_lista(hash, indice);
+    } else {
+        if (!hash->datos[indice])
+            CONTAR(hash, fallos, 1); // Búsqueda fallida sin sondeos
+        /* Si la lista es NULL o no logra crear un iterador para recorrerla devuelve NULL */
+        if (!hash->datos[indice] || !(iter = lista_iter_crear(hash->datos[indice])))
+            return NULL;
+        /* Caso no encontró la clave en la lista */
+        if (!buscar_clave_lista(hash, clave, etiqueta_de(hash_clave), iter)) {
+            lista_iter_destruir(iter);
+            return NULL;
+        }
         nodo_salida = lista_iter_borrar(iter); // El iter quedó en la posición que se debe borrar
-        dato_salida = nodo_ver_dato(nodo_salida);
-        nodo_destruir(nodo_salida, NULL);
-        --(hash->cantidad);
         destruir_lista_con_iter(hash, iter, indice);
-        if (debe_achicar(hash))
-            hash_redimensionar(hash, (hash->tam)/FACTOR_ACHIQUE);
-        return dato_salida;
-    /* Caso no encontró la clave en la lista */
+    }
+    /* Una clave vencida se reclama como si no estuviera: se libera su dato y se devuelve NULL */
+    if (nodo_vencido(hash, nodo_salida)) {
+        nodo_destruir(hash, nodo_salida, hash->destruir_dato);
+        dato_salida = NULL;
     } else {
-        lista_iter_destruir(iter);
-        return NULL;
+        dato_salida = nodo_ver_dato(nodo_salida);
+        nodo_destruir(hash, nodo_salida, NULL);
     }
+    --(hash->cantidad);
+    if (hash->filtro)
+        hash->borrados_filtro++;
+    if (debe_achicar(hash))
+        hash_redimensionar(hash, (hash->tam)/FACTOR_ACHIQUE);
+    /* El filtro no olvida las claves borradas, se rearma cuando son más que las que quedan */
+    if (hash->filtro && hash->borrados_filtro > hash->cantidad)
+        filtro_rearmar(hash);
+    return dato_salida;
 }
 
-void *hash_obtener(const hash_t *hash, const char *clave) {
-	size_t indice = hash_conseguir_indice(hash, clave);
+/* Busca el nodo de la clave en su balde, sea lista o árbol. Devuelve NULL si
+ * no está o si no se pudo crear el iterador para recorrer la lista */
+static nodo_t *buscar_nodo(const hash_t *hash, const char *clave) {
     lista_iter_t *iter;
-    void *dato_salida;
+    nodo_t *nodo = NULL;
+    size_t hash_clave, indice;
+    abb_t *arbol;
 
-    /* Si la lista es NULL o no logra crear un iterador para recorrerla devuelve NULL */
-	if (!hash->datos[indice] || !(iter = lista_iter_crear(hash->datos[indice])))
-	    return NULL;
-    /* Caso general */
-    if (buscar_clave_lista(clave, iter)) {
-        /* El iter quedó en la posición del elemento que debemos devolver */
-        dato_salida = nodo_ver_dato(lista_iter_ver_actual(iter));
-        lista_iter_destruir(iter);
-        return dato_salida;
-    } else {
-        lista_iter_destruir(iter);
+    if (!(clave = clave_buscada(hash, clave))) {
+        CONTAR(hash, fallos, 1);
+        return NULL;
+    }
+    hash_clave = hash_funcion(clave);
+    if (!filtro_permite(hash, hash_clave))
+        return NULL;
+    indice = hash_clave % hash->tam;
+    if (!hash->datos[indice]) {
+        if ((arbol = arbol_del_balde(hash, indice)))
+            return buscar_clave_arbol(hash, arbol, hash_clave, clave);
+        CONTAR(hash, fallos, 1); // Búsqueda fallida sin sondeos
         return NULL;
     }
+    if (!(iter = lista_iter_crear(hash->datos[indice])))
+        return NULL;
+    /* El iter quedó en la posición del nodo buscado, si lo encontró */
+    if (buscar_clave_lista(hash, clave, etiqueta_de(hash_clave), iter))
+        nodo = lista_iter_ver_actual(iter);
+    lista_iter_destruir(iter);
+    return nodo;
+}
+
+void *hash_obtener(const hash_t *hash, const char *clave) {
+    nodo_t *nodo = buscar_nodo(hash, clave);
+
+    /* Una clave vencida es como si no estuviera */
+    if (!nodo || nodo_vencido(hash, nodo))
+        return NULL;
+    if (hash->cache)
+        cache_usar(hash->cache, nodo);
+    return nodo_ver_dato(nodo);
 }
 
 bool hash_pertenece(const hash_t *hash, const char *clave) {
-	size_t indice = hash_conseguir_indice(hash,clave);
-    lista_iter_t *iter;
-    bool encontro_clave;
-    /* Si la lista es NULL o no logra crear un iterador para recorrerla devuelve false */
-	if (!hash->datos[indice] || !(iter = lista_iter_crear(hash->datos[indice])))
-	    return false;
-    encontro_clave = buscar_clave_lista(clave, iter);
-    lista_iter_destruir(iter);
-    return encontro_clave;
+    nodo_t *nodo = buscar_nodo(hash, clave);
+    return (nodo && !nodo_vencido(hash, nodo));
+}
+
+bool hash_activar_filtro(hash_t *hash) {
+    return (hash->filtro || filtro_rearmar(hash));
 }
 
 size_t hash_cantidad(const hash_t *hash) {
     return hash->cantidad;
 }
 
+size_t hash_expirar(hash_t *hash, uint64_t ahora, size_t max_trabajo) {
+    if (!hash->rueda)
+        return 0;
+    return rueda_avanzar(hash->rueda, ahora, max_trabajo, hash_vencer_nodo, hash);
+}
+
+void hash_establecer_reloj(hash_t *hash, hash_reloj_t reloj) {
+    hash->reloj = (reloj ? reloj : hash_reloj_monotono);
+    /* El tiempo de la rueda es del reloj anterior: sin claves con TTL se
+     * descarta, y la próxima se crea con el tiempo del reloj nuevo */
+    if (hash->rueda && !rueda_cantidad(hash->rueda)) {
+        rueda_destruir(hash->rueda);
+        hash->rueda = NULL;
+    }
+}
+
+/* Suma los bytes de la clave de cada nodo de una lista o un árbol */
+static bool sumar_bytes_clave(void *dato, void *extra) {
+    *(size_t *) extra += strlen(nodo_ver_clave(dato)) + 1;
+    return true;
+}
+
+bool hash_estadisticas(const hash_t *hash, hash_estadisticas_t *estadisticas) {
+    size_t *por_largo, largo, i, no_vacias = 0, acumuladas = 0;
+
+    memset(estadisticas, 0, sizeof(*estadisticas));
+    estadisticas->tam = hash->tam;
+    estadisticas->cantidad = hash->cantidad;
+    estadisticas->factor_carga = (double) hash->cantidad / (double) hash->tam;
+    estadisticas->arboles = hash->cantidad_arboles;
+    estadisticas->bytes_filtro = (hash->filtro ? filtro_memoria(hash->filtro) : 0);
+    estadisticas->bytes_tabla = hash->tam * (sizeof(lista_t *) + (hash->arboles ? sizeof(abb_t *) : 0));
+
+    /* Primera pasada: largo máximo y memoria de cada componente */
+    for (i = 0; (i = buscar_balde_hash(hash, i)) != hash->tam; i++) {
+        largo = largo_balde(hash, i);
+        if (largo > estadisticas->cadena_max)
+            estadisticas->cadena_max = largo;
+        if (hash->datos[i]) {
+            estadisticas->bytes_listas += lista_memoria(hash->datos[i]);
+            if (!hash->internador && !hash->claves_prestadas)
+                lista_iterar(hash->datos[i], sumar_bytes_clave, &estadisticas->bytes_claves);
+        } else {
+            estadisticas->bytes_listas += abb_memoria(hash->arboles[i]);
+            if (!hash->internador && !hash->claves_prestadas)
+                abb_iterar(hash->arboles[i], sumar_bytes_clave, &estadisticas->bytes_claves);
+        }
+        no_vacias++;
+    }
+    estadisticas->bytes_nodos = hash->cantidad * sizeof(nodo_t);
+
+    /* Segunda pasada: distribución exacta de los largos, para el histograma y el percentil */
+    por_largo = alocador_reservar_ceros(&hash->contado, (estadisticas->cadena_max + 1) * sizeof(size_t));
+    if (!por_largo)
+        return false;
+    for (i = 0; i < hash->tam; i++)
+        por_largo[largo_balde(hash, i)]++;
+    for (largo = 0; largo <= estadisticas->cadena_max; largo++) {
+        estadisticas->cadenas[largo < HASH_HISTOGRAMA_CADENAS ? largo : HASH_HISTOGRAMA_CADENAS - 1] += por_largo[largo];
+        if (largo > 0 && (double) acumuladas < PERCENTIL_CADENAS * (double) no_vacias) {
+            acumuladas += por_largo[largo];
+            estadisticas->cadena_p99 = largo;
+        }
+    }
+    alocador_liberar(&hash->contado, por_largo, (estadisticas->cadena_max + 1) * sizeof(size_t));
+    estadisticas->cadena_media = (no_vacias ? (double) hash->cantidad / (double) no_vacias : 0);
+
+#ifdef HASH_ESTADISTICAS
+    estadisticas->contadores = true;
+    estadisticas->redimensiones = hash->contadores.redimensiones;
+    estadisticas->segundos_redimension = (double) hash->contadores.ns_redimension / 1e9;
+    estadisticas->aciertos = hash->contadores.aciertos;
+    estadisticas->fallos = hash->contadores.fallos;
+    estadisticas->sondeos_aciertos = hash->contadores.sondeos_aciertos;
+    estadisticas->sondeos_fallos = hash->contadores.sondeos_fallos;
+    estadisticas->descartes_filtro = hash->contadores.descartes_filtro;
+#endif
+    return true;
+}
+
+size_t hash_memoria(const hash_t *hash) {
+    return hash->bytes;
+}
+
 void hash_destruir(hash_t *hash) {
+    alocador_t alocador = hash->alocador;
+
     hash_listas_destruir(hash);
-    free(hash->datos);
-    free(hash);
+    filtro_destruir(hash->filtro);
+    if (hash->rueda)
+        rueda_destruir(hash->rueda);
+    alocador_liberar(&hash->contado, hash->cache, sizeof(cache_t));
+    alocador_liberar(&hash->contado, hash->datos, hash->tam * sizeof(lista_t *));
+    alocador_liberar(&alocador, hash, sizeof(*hash));
 }
 
 /****************************************
@@ -362,27 +1053,44 @@ void hash_destruir(hash_t *hash) {
  ****************************************/
 
 hash_iter_t *hash_iter_crear(const hash_t *hash){
-	hash_iter_t* iter = malloc(sizeof(*iter));
+	hash_iter_t* iter = alocador_reservar(&hash->contado, sizeof(*iter));
 	if (!iter)
 	    return NULL;
 	iter->hash = hash;
-    /* Hay que buscar una lista distinta de NULL y crear un iter para ella */
-    iter->pos = buscar_lista_hash(hash, 0);
+    /* Hay que buscar un balde no vacío y crear un iter para él */
+    iter->pos = buscar_balde_hash(hash, 0);
     if (!actualizar_lista_iter(iter)) {
-        free(iter);
+        alocador_liberar(&hash->contado, iter, sizeof(*iter));
         return NULL;
     }
 	return iter;
 }
 
+/* Devuelve el nodo actual del iterador del balde, lista o árbol */
+static nodo_t *iter_nodo_actual(const hash_iter_t *iter) {
+    if (iter->lista_iter)
+        return lista_iter_ver_actual(iter->lista_iter);
+    return abb_iter_ver_actual(iter->arbol_iter);
+}
+
 bool hash_iter_avanzar(hash_iter_t *iter) {
+    bool fin_balde;
 	if (hash_iter_al_final(iter))
 	    return false;
-    lista_iter_avanzar(iter->lista_iter);
-	if (lista_iter_al_final(iter->lista_iter)) {
-        lista_iter_destruir(iter->lista_iter);
-        /* Se actualiza la posición con la siguiente lista válida */
-        iter->pos = buscar_lista_hash(iter->hash, iter->pos + 1);
+    if (iter->lista_iter) {
+        lista_iter_avanzar(iter->lista_iter);
+        fin_balde = lista_iter_al_final(iter->lista_iter);
+    } else {
+        abb_iter_avanzar(iter->arbol_iter);
+        fin_balde = abb_iter_al_final(iter->arbol_iter);
+    }
+	if (fin_balde) {
+        if (iter->lista_iter)
+            lista_iter_destruir(iter->lista_iter);
+        else
+            abb_iter_destruir(iter->arbol_iter);
+        /* Se actualiza la posición con el siguiente balde válido */
+        iter->pos = buscar_balde_hash(iter->hash, iter->pos + 1);
         if (!actualizar_lista_iter(iter))
             return false;
     }
@@ -392,9 +1100,15 @@ bool hash_iter_avanzar(hash_iter_t *iter) {
 const char *hash_iter_ver_actual(const hash_iter_t *iter) {
 	if (hash_iter_al_final(iter))
 		return NULL;
-    /* La clave está dentro del nodo dentro del nodo de la lista apuntado por lista_iter */
-    /* lista_iter va a apuntar a algo válido, por lo que ninguna función va a devolver NULL */
-    return nodo_ver_clave(lista_iter_ver_actual(iter->lista_iter));
+    /* La clave está dentro del nodo apuntado por el iterador del balde */
+    /* El iterador va a apuntar a algo válido, por lo que ninguna función va a devolver NULL */
+    return nodo_ver_clave(iter_nodo_actual(iter));
+}
+
+void *hash_iter_ver_dato(const hash_iter_t *iter) {
+    if (hash_iter_al_final(iter))
+        return NULL;
+    return nodo_ver_dato(iter_nodo_actual(iter));
 }
 
 bool hash_iter_al_final(const hash_iter_t *iter) {
@@ -404,5 +1118,7 @@ bool hash_iter_al_final(const hash_iter_t *iter) {
 void hash_iter_destruir(hash_iter_t *iter) {
 	if (iter->lista_iter)
 	    lista_iter_destruir(iter->lista_iter);
-	free(iter);
+	if (iter->arbol_iter)
+	    abb_iter_destruir(iter->arbol_iter);
+	alocador_liberar(&iter->hash->contado, iter, sizeof(*iter));
 }
@@ -1,8 +1,11 @@
 #ifndef HASH_H
 #define HASH_H
 
+#include "alocador.h"
+#include "internador.h"
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 
 // Los structs deben llamarse "hash" y "hash_iter".
 struct hash;
@@ -14,11 +17,111 @@ typedef struct hash_iter hash_iter_t;
 // tipo de función para destruir dato
 typedef void (*hash_destruir_dato_t)(void *);
 
+// tipo de función que devuelve el tiempo actual, para las claves con TTL
+typedef uint64_t (*hash_reloj_t)(void);
+
+// tipo de función que devuelve los bytes que ocupa un dato, para el cache
+typedef size_t (*hash_tam_dato_t)(const void *);
+
+// política de desalojo de un hash con capacidad acotada
+typedef enum {
+    HASH_CACHE_LRU,     // desaloja la clave usada hace más tiempo
+    HASH_CACHE_CLOCK    // aproxima LRU con un bit de referencia por clave
+} hash_politica_t;
+
+// cantidad de posiciones del histograma de largos de las listas
+#define HASH_HISTOGRAMA_CADENAS 16
+
+// estado de la tabla, ver hash_estadisticas
+typedef struct hash_estadisticas {
+    size_t tam;                 // cantidad de listas de la tabla
+    size_t cantidad;
+    double factor_carga;        // cantidad / tam
+    size_t cadenas[HASH_HISTOGRAMA_CADENAS]; // listas con i claves, la última posición acumula las más largas
+    size_t cadena_max;
+    double cadena_media;        // largo medio de las listas no vacías
+    size_t cadena_p99;          // el 99% de las listas no vacías tiene a lo sumo este largo
+    size_t arboles;             // listas convertidas en árbol por tener demasiadas colisiones
+    size_t bytes_tabla;         // arreglo de listas
+    size_t bytes_listas;        // estructuras de las listas y los árboles, y sus nodos
+    size_t bytes_nodos;         // nodos del hash
+    size_t bytes_claves;        // copias de las claves, 0 si son de un internador o prestadas
+    size_t bytes_filtro;        // filtro de búsquedas fallidas, 0 si no se activó
+    /* Contadores acumulados desde que se creó el hash. Solo se llevan si se
+     * compila con -DHASH_ESTADISTICAS (make estadisticas), si no valen 0 */
+    bool contadores;            // true si se compiló con HASH_ESTADISTICAS
+    size_t redimensiones;
+    double segundos_redimension;
+    size_t aciertos;            // búsquedas que encontraron la clave
+    size_t fallos;              // búsquedas que no la encontraron
+    size_t sondeos_aciertos;    // claves comparadas en las búsquedas exitosas
+    size_t sondeos_fallos;      // claves comparadas en las búsquedas fallidas
+    size_t descartes_filtro;    // búsquedas fallidas que respondió el filtro, sin recorrer la tabla
+} hash_estadisticas_t;
+
 /* Crea el hash
  * Pos: devuelve un puntero a una tabla de hash.
  */
 hash_t *hash_crear(hash_destruir_dato_t destruir_dato);
 
+/* Crea un hash que pide toda su memoria (la tabla, las listas, los nodos,
+ * las claves, los iteradores y los vencimientos) al alocador, que se copia.
+ * Su contexto debe vivir al menos tanto como el hash. Los datos no pasan
+ * por el alocador.
+ * Pos: devuelve un puntero a una tabla de hash, o NULL si falló.
+ */
+hash_t *hash_crear_con_alocador(hash_destruir_dato_t destruir_dato, const alocador_t *alocador);
+
+/* Crea un hash que, en lugar de copiar cada clave, guarda su copia canónica
+ * en el internador, que puede compartir con otros hashes: una clave presente
+ * en varios ocupa memoria una sola vez. Las búsquedas buscan primero la
+ * clave en el internador y después comparan las claves por puntero. El
+ * internador debe vivir al menos tanto como el hash.
+ * Pos: devuelve un puntero a una tabla de hash, o NULL si falló.
+ */
+hash_t *hash_crear_con_internador(hash_destruir_dato_t destruir_dato, internador_t *internador);
+
+/* Como hash_crear_con_internador, pero el hash pide su memoria al alocador
+ * (ver hash_crear_con_alocador). Las claves internadas son del internador.
+ * Pos: devuelve un puntero a una tabla de hash, o NULL si falló.
+ */
+hash_t *hash_crear_con_internador_y_alocador(hash_destruir_dato_t destruir_dato, internador_t *internador,
+                                             const alocador_t *alocador);
+
+/* Crea un hash que guarda el puntero a cada clave que recibe hash_guardar
+ * tal cual, sin copiarla ni liberarla nunca. Cada clave guardada tiene que
+ * seguir siendo válida y sin cambios mientras esté en el hash (por ejemplo,
+ * dentro de un archivo mapeado o de una arena que vive más que el hash); la
+ * clave que devuelve el iterador es ese mismo puntero.
+ * Pos: devuelve un puntero a una tabla de hash, o NULL si falló.
+ */
+hash_t *hash_crear_con_claves_prestadas(hash_destruir_dato_t destruir_dato);
+
+/* Como hash_crear_con_claves_prestadas, pero el hash pide su memoria al
+ * alocador (ver hash_crear_con_alocador).
+ * Pos: devuelve un puntero a una tabla de hash, o NULL si falló.
+ */
+hash_t *hash_crear_con_claves_prestadas_y_alocador(hash_destruir_dato_t destruir_dato, const alocador_t *alocador);
+
+/* Crea un hash con capacidad acotada, que funciona como cache. Si al guardar
+ * se supera max_claves o max_bytes (0 si no hay límite), se desalojan claves
+ * según la política y sus datos se liberan con destruir_dato. Los bytes de un
+ * par son los de la clave más los que devuelve tam_dato (o 0 si es NULL). Solo
+ * hash_guardar y hash_obtener cuentan como uso de una clave, y la clave recién
+ * guardada nunca se desaloja.
+ * Pos: devuelve un puntero a una tabla de hash, o NULL si falló.
+ */
+hash_t *hash_crear_cache(hash_destruir_dato_t destruir_dato, hash_politica_t politica,
+                         size_t max_claves, size_t max_bytes, hash_tam_dato_t tam_dato);
+
+/* Como hash_crear_cache, pero el hash, incluido su estado de cache, pide su
+ * memoria al alocador (ver hash_crear_con_alocador).
+ * Pos: devuelve un puntero a una tabla de hash, o NULL si falló.
+ */
+hash_t *hash_crear_cache_con_alocador(hash_destruir_dato_t destruir_dato, hash_politica_t politica,
+                                      size_t max_claves, size_t max_bytes, hash_tam_dato_t tam_dato,
+                                      const alocador_t *alocador);
+
 /* Guarda un elemento en el hash, si la clave ya se encuentra en la
  * estructura, la reemplaza. De no poder guardarlo devuelve false.
  * Pre: La estructura hash fue inicializada
@@ -26,6 +129,15 @@ hash_t *hash_crear(hash_destruir_dato_t destruir_dato);
  */
 bool hash_guardar(hash_t *hash, const char *clave, void *dato);
 
+/* Igual que hash_guardar, pero la clave expira ttl unidades de tiempo después
+ * de guardarla (por omisión, milisegundos de un reloj monótono). Una clave
+ * vencida no se encuentra con hash_obtener ni hash_pertenece; su dato se libera
+ * con destruir_dato al borrarla, reemplazarla o al reclamarla con hash_expirar.
+ * Pre: La estructura hash fue inicializada
+ * Post: Se almacenó el par (clave, dato) con su vencimiento
+ */
+bool hash_guardar_con_ttl(hash_t *hash, const char *clave, void *dato, uint64_t ttl);
+
 /* Borra un elemento del hash y devuelve el dato asociado.  Devuelve
  * NULL si el dato no estaba.
  * Pre: La estructura hash fue inicializada
@@ -45,11 +157,52 @@ void *hash_obtener(const hash_t *hash, const char *clave);
  */
 bool hash_pertenece(const hash_t *hash, const char *clave);
 
+/* Activa un filtro de Bloom delante de la tabla, que responde la mayoría de
+ * las búsquedas de claves que no están (hash_obtener, hash_pertenece y
+ * hash_borrar) sin recorrer las listas. Ocupa 12 bits por cada clave que
+ * admite la tabla antes de agrandarse; se rearma al redimensionar y cuando
+ * las claves borradas superan a las que quedan. Devuelve false si no pudo
+ * pedir memoria.
+ * Pre: La estructura hash fue inicializada
+ * Post: El hash tiene el filtro activado, si devolvió true
+ */
+bool hash_activar_filtro(hash_t *hash);
+
 /* Devuelve la cantidad de elementos del hash.
  * Pre: La estructura hash fue inicializada
  */
 size_t hash_cantidad(const hash_t *hash);
 
+/* Reclama las claves con TTL vencidas hasta el tiempo ahora, liberando sus
+ * datos con destruir_dato. Hace a lo sumo max_trabajo unidades de trabajo, las
+ * claves que queden vencidas se reclaman en la siguiente llamada. Devuelve la
+ * cantidad de claves reclamadas. Hasta ser reclamadas, las claves vencidas se
+ * siguen contando en hash_cantidad y recorriendo con el iterador.
+ * Pre: La estructura hash fue inicializada, ahora está en las unidades del reloj
+ */
+size_t hash_expirar(hash_t *hash, uint64_t ahora, size_t max_trabajo);
+
+/* Cambia el reloj con el que se calculan los vencimientos. Con NULL se vuelve
+ * al reloj monótono en milisegundos.
+ * Pre: La estructura hash fue inicializada y no tiene claves con TTL
+ */
+void hash_establecer_reloj(hash_t *hash, hash_reloj_t reloj);
+
+/* Completa estadisticas con el estado de la tabla: tamaño, carga, la
+ * distribución de largos de las listas y los bytes de cada componente, más
+ * los contadores si se compiló con HASH_ESTADISTICAS. Recorre toda la tabla,
+ * es O(tam + cantidad). Devuelve false si no pudo pedir memoria.
+ * Pre: La estructura hash fue inicializada
+ */
+bool hash_estadisticas(const hash_t *hash, hash_estadisticas_t *estadisticas);
+
+/* Devuelve los bytes exactos que el hash tiene pedidos a su alocador en
+ * este momento, incluyendo su propia estructura y sin contar los datos ni
+ * las claves de un internador o prestadas.
+ * Pre: La estructura hash fue inicializada
+ */
+size_t hash_memoria(const hash_t *hash);
+
 /* Destruye la estructura liberando la memoria pedida y llamando a la función
  * destruir para cada par (clave, dato).
  * Pre: La estructura hash fue inicializada
@@ -68,6 +221,9 @@ bool hash_iter_avanzar(hash_iter_t *iter);
 // Devuelve clave actual, esa clave no se puede modificar ni liberar.
 const char *hash_iter_ver_actual(const hash_iter_t *iter);
 
+// Devuelve el dato de la clave actual, o NULL si el iterador está al final.
+void *hash_iter_ver_dato(const hash_iter_t *iter);
+
 // Comprueba si terminó la iteración
 bool hash_iter_al_final(const hash_iter_t *iter);
 
@@ -0,0 +1,387 @@
+#define _POSIX_C_SOURCE 200809L
+#include "hash_archivo.h"
+#include "hash_funciones.h"
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+#define ARCHIVO_MAGIA "HASHSNAP"
+#define ARCHIVO_VERSION 1
+#define ARCHIVO_ORDEN_BYTES 0x01020304u
+#define ARCHIVO_SUFIJO_TEMPORAL ".tmp"
+
+/* Definiciones del formato del archivo */
+
+typedef struct cabecera {
+    char magia[8];
+    uint32_t version;
+    uint32_t orden_bytes;              // Distingue archivos escritos con otro orden de bytes
+    uint64_t cantidad;
+    uint64_t cantidad_baldes;          // Potencia de dos
+    uint64_t desplazamiento_indice;    // cantidad_baldes + 1 enteros: entradas del balde b en [i[b], i[b+1])
+    uint64_t desplazamiento_entradas;
+    uint64_t desplazamiento_bytes;
+    uint64_t tam_archivo;
+    uint32_t crc;                      // CRC-32 de los campos anteriores
+    uint32_t reservado;
+} cabecera_t;
+
+typedef struct entrada {
+    uint64_t hash;
+    uint64_t desplazamiento;   // Posición de la clave; el dato está a continuación de su '\0'
+    uint64_t largo_dato;
+    uint32_t largo_clave;      // Sin contar el '\0'
+    uint32_t crc;              // CRC-32 de la clave con su '\0' y del dato
+} entrada_t;
+
+struct hash_archivo {
+    const unsigned char *base;
+    size_t tam;
+    const cabecera_t *cabecera;
+    const uint64_t *indice;
+    const entrada_t *entradas;
+};
+
+/* Par del hash pendiente de escribir */
+typedef struct par {
+    uint64_t hash;
+    const char *clave;
+    void *dato;
+} par_t;
+
+/* Funciones auxiliares */
+
+static uint32_t cabecera_crc(const cabecera_t *cabecera) {
+    return hash_crc32(0, cabecera, offsetof(cabecera_t, crc));
+}
+
+static uint64_t cantidad_baldes_para(size_t cantidad) {
+    uint64_t baldes = 1;
+    while (baldes < cantidad)
+        baldes <<= 1;
+    return baldes;
+}
+
+/* Junta los pares vigentes del hash ordenados por balde y arma el índice.
+ * Devuelve NULL en caso de error. */
+static par_t *pares_por_balde(const hash_t *hash, uint64_t *indice, uint64_t cantidad_baldes, size_t *cantidad) {
+    size_t maximo = hash_cantidad(hash), n = 0, i;
+    par_t *pares = malloc((maximo ? maximo : 1) * sizeof(par_t));
+    par_t *ordenados = malloc((maximo ? maximo : 1) * sizeof(par_t));
+    hash_iter_t *iter = hash_iter_crear(hash);
+    const char *clave;
+    uint64_t balde;
+
+    if (!pares || !ordenados || !iter) {
+        free(pares);
+        free(ordenados);
+        if (iter)
+            hash_iter_destruir(iter);
+        return NULL;
+    }
+    /* Las claves vencidas que todavía no se reclamaron no se guardan */
+    for (; !hash_iter_al_final(iter); hash_iter_avanzar(iter)) {
+        clave = hash_iter_ver_actual(iter);
+        if (!hash_pertenece(hash, clave))
+            continue;
+        pares[n].clave = clave;
+        pares[n].dato = hash_iter_ver_dato(iter);
+        pares[n].hash = hash_fnv1a(clave, strlen(clave));
+        n++;
+    }
+    hash_iter_destruir(iter);
+
+    /* Ordenamiento por conteo: indice[b + 1] cuenta primero los pares del balde b */
+    memset(indice, 0, (cantidad_baldes + 1) * sizeof(uint64_t));
+    for (i = 0; i < n; i++)
+        indice[(pares[i].hash & (cantidad_baldes - 1)) + 1]++;
+    for (balde = 0; balde < cantidad_baldes; balde++)
+        indice[balde + 1] += indice[balde];
+    for (i = 0; i < n; i++) {
+        balde = pares[i].hash & (cantidad_baldes - 1);
+        ordenados[indice[balde]++] = pares[i];
+    }
+    /* Cada indice[b] quedó en el comienzo del balde b + 1, se corre un lugar */
+    memmove(indice + 1, indice, cantidad_baldes * sizeof(uint64_t));
+    indice[0] = 0;
+
+    free(pares);
+    *cantidad = n;
+    return ordenados;
+}
+
+/* Serializa el dato en *buffer, agrandándolo si hace falta. Devuelve false si falla */
+static bool serializar_en(hash_serializar_dato_t serializar_dato, const void *dato,
+                          unsigned char **buffer, size_t *capacidad, size_t *largo) {
+    unsigned char *nuevo;
+    if (!serializar_dato) {
+        *largo = 0;
+        return true;
+    }
+    *largo = serializar_dato(dato, *buffer, *capacidad);
+    if (*largo <= *capacidad)
+        return true;
+    nuevo = realloc(*buffer, *largo);
+    if (!nuevo)
+        return false;
+    *buffer = nuevo;
+    *capacidad = *largo;
+    return serializar_dato(dato, *buffer, *capacidad) == *largo;
+}
+
+/* Escribe el archivo completo. Devuelve false si falla alguna escritura */
+static bool escribir_archivo(FILE *archivo, const par_t *pares, size_t cantidad, const uint64_t *indice,
+                             uint64_t cantidad_baldes, hash_serializar_dato_t serializar_dato) {
+    cabecera_t cabecera;
+    entrada_t *entradas = malloc((cantidad ? cantidad : 1) * sizeof(entrada_t));
+    unsigned char *buffer = NULL;
+    size_t capacidad = 0, largo_dato, largo_clave, i;
+    uint64_t cursor;
+    bool ok = (entradas != NULL);
+
+    memset(&cabecera, 0, sizeof(cabecera));
+    memcpy(cabecera.magia, ARCHIVO_MAGIA, sizeof(cabecera.magia));
+    cabecera.version = ARCHIVO_VERSION;
+    cabecera.orden_bytes = ARCHIVO_ORDEN_BYTES;
+    cabecera.cantidad = cantidad;
+    cabecera.cantidad_baldes = cantidad_baldes;
+    cabecera.desplazamiento_indice = sizeof(cabecera_t);
+    cabecera.desplazamiento_entradas = cabecera.desplazamiento_indice + (cantidad_baldes + 1) * sizeof(uint64_t);
+    cabecera.desplazamiento_bytes = cabecera.desplazamiento_entradas + cantidad * sizeof(entrada_t);
+
+    /* Primero los bytes de claves y datos, que definen el contenido de las entradas */
+    cursor = cabecera.desplazamiento_bytes;
+    ok = ok && !fseeko(archivo, (off_t) cursor, SEEK_SET);
+    for (i = 0; ok && i < cantidad; i++) {
+        largo_clave = strlen(pares[i].clave);
+        ok = largo_clave <= UINT32_MAX && serializar_en(serializar_dato, pares[i].dato, &buffer, &capacidad, &largo_dato);
+        if (!ok)
+            break;
+        entradas[i].hash = pares[i].hash;
+        entradas[i].desplazamiento = cursor;
+        entradas[i].largo_dato = largo_dato;
+        entradas[i].largo_clave = (uint32_t) largo_clave;
+        entradas[i].crc = hash_crc32(hash_crc32(0, pares[i].clave, largo_clave + 1), buffer, largo_dato);
+        ok = fwrite(pares[i].clave, 1, largo_clave + 1, archivo) == largo_clave + 1 &&
+             (!largo_dato || fwrite(buffer, 1, largo_dato, archivo) == largo_dato);
+        cursor += largo_clave + 1 + largo_dato;
+    }
+    free(buffer);
+
+    /* Después el índice y las entradas, y por último la cabecera que los valida */
+    cabecera.tam_archivo = cursor;
+    cabecera.crc = cabecera_crc(&cabecera);
+    ok = ok && !fseeko(archivo, (off_t) cabecera.desplazamiento_indice, SEEK_SET) &&
+         fwrite(indice, sizeof(uint64_t), cantidad_baldes + 1, archivo) == cantidad_baldes + 1 &&
+         fwrite(entradas, sizeof(entrada_t), cantidad, archivo) == cantidad &&
+         !fseeko(archivo, 0, SEEK_SET) &&
+         fwrite(&cabecera, sizeof(cabecera), 1, archivo) == 1;
+    free(entradas);
+    return ok;
+}
+
+/* Devuelve true si los bytes de la entrada están dentro del archivo */
+static bool entrada_valida(const hash_archivo_t *archivo, const entrada_t *entrada) {
+    uint64_t desde = archivo->cabecera->desplazamiento_bytes;
+    uint64_t largo = (uint64_t) entrada->largo_clave + 1;
+    if (entrada->desplazamiento < desde || entrada->desplazamiento > archivo->tam ||
+        largo > archivo->tam - entrada->desplazamiento ||
+        entrada->largo_dato > archivo->tam - entrada->desplazamiento - largo)
+        return false;
+    return archivo->base[entrada->desplazamiento + entrada->largo_clave] == '\0';
+}
+
+static const entrada_t *archivo_buscar(const hash_archivo_t *archivo, const char *clave) {
+    size_t largo = strlen(clave);
+    uint64_t hash = hash_fnv1a(clave, largo);
+    uint64_t balde = hash & (archivo->cabecera->cantidad_baldes - 1);
+    uint64_t i, fin = archivo->indice[balde + 1];
+    const entrada_t *entrada;
+
+    if (fin > archivo->cabecera->cantidad)
+        return NULL;
+    for (i = archivo->indice[balde]; i < fin; i++) {
+        entrada = &archivo->entradas[i];
+        if (entrada->hash == hash && entrada->largo_clave == largo && entrada_valida(archivo, entrada) &&
+            !memcmp(archivo->base + entrada->desplazamiento, clave, largo))
+            return entrada;
+    }
+    return NULL;
+}
+
+/* Valida la cabecera contra el tamaño real del archivo */
+static bool cabecera_valida(const cabecera_t *cabecera, size_t tam) {
+    uint64_t baldes = cabecera->cantidad_baldes;
+    if (memcmp(cabecera->magia, ARCHIVO_MAGIA, sizeof(cabecera->magia)) ||
+        cabecera->version != ARCHIVO_VERSION || cabecera->orden_bytes != ARCHIVO_ORDEN_BYTES ||
+        cabecera->crc != cabecera_crc(cabecera) || cabecera->tam_archivo != tam)
+        return false;
+    /* Los baldes son potencia de dos y las secciones están en orden y dentro del archivo */
+    if (!baldes || (baldes & (baldes - 1)) || baldes > tam / sizeof(uint64_t) || cabecera->cantidad > tam / sizeof(entrada_t))
+        return false;
+    return (cabecera->desplazamiento_indice == sizeof(cabecera_t) &&
+            cabecera->desplazamiento_entradas == cabecera->desplazamiento_indice + (baldes + 1) * sizeof(uint64_t) &&
+            cabecera->desplazamiento_bytes == cabecera->desplazamiento_entradas + cabecera->cantidad * sizeof(entrada_t) &&
+            cabecera->desplazamiento_bytes <= tam);
+}
+
+/* Primitivas de la instantánea */
+
+bool hash_guardar_archivo(const hash_t *hash, const char *ruta, hash_serializar_dato_t serializar_dato) {
+    uint64_t cantidad_baldes = cantidad_baldes_para(hash_cantidad(hash));
+    uint64_t *indice = malloc((cantidad_baldes + 1) * sizeof(uint64_t));
+    char *temporal = malloc(strlen(ruta) + sizeof(ARCHIVO_SUFIJO_TEMPORAL));
+    par_t *pares = NULL;
+    size_t cantidad = 0;
+    FILE *archivo = NULL;
+    bool ok;
+
+    ok = indice && temporal && (pares = pares_por_balde(hash, indice, cantidad_baldes, &cantidad));
+    if (ok) {
+        /* Se escribe en un archivo temporal y se lo renombra, así nunca queda uno a medias */
+        strcpy(temporal, ruta);
+        strcat(temporal, ARCHIVO_SUFIJO_TEMPORAL);
+        ok = (archivo = fopen(temporal, "wb")) != NULL;
+    }
+    if (ok) {
+        ok = escribir_archivo(archivo, pares, cantidad, indice, cantidad_baldes, serializar_dato);
+        ok = !fflush(archivo) && !fsync(fileno(archivo)) && ok;
+        ok = !fclose(archivo) && ok;
+        ok = ok && !rename(temporal, ruta);
+        if (!ok)
+            remove(temporal);
+    }
+    free(pares);
+    free(indice);
+    free(temporal);
+    return ok;
+}
+
+/* Guarda en el hash todos los pares del archivo, con las claves dentro del
+ * archivo mapeado. Si falla, destruye el hash y devuelve NULL */
+static hash_t *archivo_llenar_hash(const hash_archivo_t *archivo, hash_t *hash,
+                                   hash_deserializar_dato_t deserializar_dato) {
+    const entrada_t *entrada;
+    const unsigned char *clave;
+    void *dato;
+    uint64_t i;
+
+    for (i = 0; i < archivo->cabecera->cantidad; i++) {
+        entrada = &archivo->entradas[i];
+        if (!entrada_valida(archivo, entrada))
+            break;
+        clave = archivo->base + entrada->desplazamiento;
+        dato = (deserializar_dato ? deserializar_dato(clave + entrada->largo_clave + 1, entrada->largo_dato) : NULL);
+        if (!hash_guardar(hash, (const char *) clave, dato))
+            break;
+    }
+    if (i < archivo->cabecera->cantidad) {
+        hash_destruir(hash);
+        return NULL;
+    }
+    return hash;
+}
+
+hash_t *hash_cargar_archivo(const char *ruta, hash_deserializar_dato_t deserializar_dato,
+                            hash_destruir_dato_t destruir_dato) {
+    hash_archivo_t *archivo = hash_archivo_abrir(ruta);
+    hash_t *hash = hash_crear(destruir_dato);
+
+    if (!archivo || !hash) {
+        if (archivo)
+            hash_archivo_cerrar(archivo);
+        if (hash)
+            hash_destruir(hash);
+        return NULL;
+    }
+    hash = archivo_llenar_hash(archivo, hash, deserializar_dato);
+    hash_archivo_cerrar(archivo);
+    return hash;
+}
+
+/* Primitivas del archivo abierto en memoria */
+
+hash_t *hash_archivo_indexar(const hash_archivo_t *archivo, hash_deserializar_dato_t deserializar_dato,
+                             hash_destruir_dato_t destruir_dato) {
+    hash_t *hash = hash_crear_con_claves_prestadas(destruir_dato);
+    if (!hash)
+        return NULL;
+    return archivo_llenar_hash(archivo, hash, deserializar_dato);
+}
+
+hash_archivo_t *hash_archivo_abrir(const char *ruta) {
+    hash_archivo_t *archivo = malloc(sizeof(*archivo));
+    struct stat estado;
+    void *base = MAP_FAILED;
+    int fd = open(ruta, O_RDONLY);
+
+    if (archivo && fd != -1 && !fstat(fd, &estado) && (size_t) estado.st_size >= sizeof(cabecera_t))
+        base = mmap(NULL, (size_t) estado.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    if (fd != -1)
+        close(fd);
+    if (base == MAP_FAILED) {
+        free(archivo);
+        return NULL;
+    }
+    archivo->base = base;
+    archivo->tam = (size_t) estado.st_size;
+    archivo->cabecera = base;
+    if (!cabecera_valida(archivo->cabecera, archivo->tam)) {
+        hash_archivo_cerrar(archivo);
+        return NULL;
+    }
+    archivo->indice = (const uint64_t *) (archivo->base + archivo->cabecera->desplazamiento_indice);
+    archivo->entradas = (const entrada_t *) (archivo->base + archivo->cabecera->desplazamiento_entradas);
+    return archivo;
+}
+
+const void *hash_archivo_obtener(const hash_archivo_t *archivo, const char *clave, size_t *largo) {
+    const entrada_t *entrada = archivo_buscar(archivo, clave);
+    if (!entrada)
+        return NULL;
+    if (largo)
+        *largo = entrada->largo_dato;
+    return archivo->base + entrada->desplazamiento + entrada->largo_clave + 1;
+}
+
+bool hash_archivo_pertenece(const hash_archivo_t *archivo, const char *clave) {
+    return archivo_buscar(archivo, clave) != NULL;
+}
+
+size_t hash_archivo_cantidad(const hash_archivo_t *archivo) {
+    return archivo->cabecera->cantidad;
+}
+
+bool hash_archivo_verificar(const hash_archivo_t *archivo) {
+    const entrada_t *entrada;
+    const unsigned char *bytes;
+    uint64_t i, balde;
+
+    /* El índice tiene que ser creciente y cubrir todas las entradas */
+    for (balde = 0; balde < archivo->cabecera->cantidad_baldes; balde++) {
+        if (archivo->indice[balde] > archivo->indice[balde + 1])
+            return false;
+    }
+    if (archivo->indice[0] || archivo->indice[archivo->cabecera->cantidad_baldes] != archivo->cabecera->cantidad)
+        return false;
+    for (i = 0; i < archivo->cabecera->cantidad; i++) {
+        entrada = &archivo->entradas[i];
+        if (!entrada_valida(archivo, entrada))
+            return false;
+        bytes = archivo->base + entrada->desplazamiento;
+        if (hash_fnv1a(bytes, entrada->largo_clave) != entrada->hash ||
+            hash_crc32(0, bytes, (size_t) entrada->largo_clave + 1 + entrada->largo_dato) != entrada->crc)
+            return false;
+    }
+    return true;
+}
+
+void hash_archivo_cerrar(hash_archivo_t *archivo) {
+    munmap((void *) archivo->base, archivo->tam);
+    free(archivo);
+}
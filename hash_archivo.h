@@ -0,0 +1,90 @@
+#ifndef HASH_ARCHIVO_H
+#define HASH_ARCHIVO_H
+
+#include "hash.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+/* Instantáneas de una tabla de hash en disco.
+ *
+ * El archivo está pensado para usarse con mmap sin deserializar nada: una
+ * cabecera, un índice de baldes con el desplazamiento de las entradas de cada
+ * balde, un arreglo de entradas de tamaño fijo y al final los bytes de las
+ * claves (terminadas en '\0') y de los datos, contiguos. Cada entrada lleva el
+ * CRC-32 de su clave y su dato. Los enteros se guardan en el orden de bytes de
+ * la máquina que escribió el archivo; en otra arquitectura no se puede abrir.
+ */
+
+typedef struct hash_archivo hash_archivo_t;
+
+/* Serializa dato en buffer, que tiene capacidad bytes. Devuelve la cantidad de
+ * bytes que ocupa el dato serializado; si es mayor a capacidad, no escribe nada
+ * y se la vuelve a llamar con un buffer suficiente.
+ */
+typedef size_t (*hash_serializar_dato_t)(const void *dato, void *buffer, size_t capacidad);
+
+/* Crea un dato a partir de los largo bytes que devolvió la serialización */
+typedef void *(*hash_deserializar_dato_t)(const void *bytes, size_t largo);
+
+/* Guarda todos los pares (clave, dato) del hash en el archivo de la ruta,
+ * reemplazándolo de forma atómica. Si serializar_dato es NULL, se guardan solo
+ * las claves. Devuelve false si no se pudo escribir el archivo.
+ * Pre: La estructura hash fue inicializada
+ */
+bool hash_guardar_archivo(const hash_t *hash, const char *ruta, hash_serializar_dato_t serializar_dato);
+
+/* Crea un hash con los pares del archivo de la ruta, creando cada dato con
+ * deserializar_dato (si es NULL, los datos quedan en NULL). Devuelve NULL si
+ * el archivo no existe, no es válido o no se pudo crear el hash.
+ * Pos: devuelve un hash que libera sus datos con destruir_dato.
+ */
+hash_t *hash_cargar_archivo(const char *ruta, hash_deserializar_dato_t deserializar_dato,
+                            hash_destruir_dato_t destruir_dato);
+
+/* Primitivas del archivo abierto en memoria, de solo lectura */
+
+/* Abre el archivo de la ruta con mmap y valida la cabecera y el índice.
+ * Devuelve NULL si no existe o no es válido.
+ */
+hash_archivo_t *hash_archivo_abrir(const char *ruta);
+
+/* Devuelve los bytes del dato serializado de la clave, que viven mientras el
+ * archivo esté abierto, y guarda su largo en largo (si no es NULL). Devuelve
+ * NULL si la clave no está.
+ * Pre: el archivo fue abierto
+ */
+const void *hash_archivo_obtener(const hash_archivo_t *archivo, const char *clave, size_t *largo);
+
+/* Crea un hash con los pares del archivo, como hash_cargar_archivo, pero sin
+ * copiar las claves: el hash usa las del archivo mapeado (ver
+ * hash_crear_con_claves_prestadas), así que hay que destruirlo antes de
+ * cerrar el archivo. Devuelve NULL si alguna entrada no es válida o no se
+ * pudo crear el hash.
+ * Pre: el archivo fue abierto
+ * Pos: devuelve un hash que libera sus datos con destruir_dato.
+ */
+hash_t *hash_archivo_indexar(const hash_archivo_t *archivo, hash_deserializar_dato_t deserializar_dato,
+                             hash_destruir_dato_t destruir_dato);
+
+/* Determina si la clave está en el archivo.
+ * Pre: el archivo fue abierto
+ */
+bool hash_archivo_pertenece(const hash_archivo_t *archivo, const char *clave);
+
+/* Devuelve la cantidad de claves del archivo.
+ * Pre: el archivo fue abierto
+ */
+size_t hash_archivo_cantidad(const hash_archivo_t *archivo);
+
+/* Recorre todas las entradas comprobando el CRC-32 de cada clave y su dato.
+ * Devuelve false si alguna está corrupta.
+ * Pre: el archivo fue abierto
+ */
+bool hash_archivo_verificar(const hash_archivo_t *archivo);
+
+/* Cierra el archivo, los datos que devolvió obtener dejan de ser válidos.
+ * Pre: el archivo fue abierto
+ */
+void hash_archivo_cerrar(hash_archivo_t *archivo);
+
+#endif // HASH_ARCHIVO_H
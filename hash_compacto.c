@@ -0,0 +1,346 @@
+#include "hash_compacto.h"
+#include "hash_funciones.h"
+#include <stdint.h>
+#include <string.h>
+#define TAM_INDICE_INICIAL 8    // Potencia de 2
+/* Las entradas, contando los huecos, llenan a lo sumo 2/3 del índice */
+#define USO_NUM 2
+#define USO_DEN 3
+/* Se achica cuando quedan menos de 1/8 de las entradas posibles */
+#define CARGA_MIN_DEN 8
+#define PERTURBACION 5          // Bits del hash que entran en cada sondeo, como en CPython
+
+/* Valores de las ranuras del índice que no apuntan a una entrada; la
+ * entrada i se guarda como i + PRIMERA_ENTRADA */
+#define RANURA_VACIA 0
+#define RANURA_BORRADA 1
+#define PRIMERA_ENTRADA 2
+
+/* Definiciones de estructuras de la tabla de hash */
+
+typedef struct entrada {
+    uint64_t valor;     // Hash de la clave
+    char *clave;        // NULL si la entrada es un hueco
+    void *dato;
+} entrada_t;
+
+struct hash_compacto {
+    entrada_t *entradas;    // En orden de inserción
+    size_t usadas;          // Entradas escritas, contando los huecos
+    size_t cantidad;
+    void *indice;           // tam_indice ranuras de ancho bytes
+    size_t tam_indice;      // Potencia de 2
+    size_t ancho;
+    hash_destruir_dato_t destruir_dato;
+    alocador_t alocador;
+    size_t bytes;           // Bytes pedidos al alocador que siguen en uso
+};
+
+struct hash_compacto_iter {
+    const hash_compacto_t *hash;
+    size_t pos;
+};
+
+/* Funciones auxiliares */
+
+static void *compacto_reservar(hash_compacto_t *hash, size_t tam) {
+    void *bloque = alocador_reservar(&hash->alocador, tam);
+    if (bloque)
+        hash->bytes += tam;
+    return bloque;
+}
+
+static void *compacto_reservar_ceros(hash_compacto_t *hash, size_t tam) {
+    void *bloque = alocador_reservar_ceros(&hash->alocador, tam);
+    if (bloque)
+        hash->bytes += tam;
+    return bloque;
+}
+
+static void compacto_liberar(hash_compacto_t *hash, void *bloque, size_t tam) {
+    alocador_liberar(&hash->alocador, bloque, tam);
+    hash->bytes -= tam;
+}
+
+static uint64_t compacto_hash(const char *clave) {
+    return hash_mezclar64(hash_fnv1a(clave, strlen(clave)));
+}
+
+/* Entradas que admite un índice de tam_indice ranuras */
+static size_t capacidad_entradas(size_t tam_indice) {
+    return tam_indice * USO_NUM / USO_DEN;
+}
+
+/* Ancho de ranura más chico en el que entra cualquier entrada del índice */
+static size_t ancho_para(size_t tam_indice) {
+    size_t maximo = capacidad_entradas(tam_indice) + PRIMERA_ENTRADA;
+    if (maximo <= UINT8_MAX)
+        return sizeof(uint8_t);
+    if (maximo <= UINT16_MAX)
+        return sizeof(uint16_t);
+    if (maximo <= UINT32_MAX)
+        return sizeof(uint32_t);
+    return sizeof(uint64_t);
+}
+
+/* Menor índice en el que entran cantidad entradas ocupando a lo sumo la
+ * mitad de la capacidad, así queda lugar para crecer */
+static size_t tam_indice_para(size_t cantidad) {
+    size_t tam = TAM_INDICE_INICIAL;
+    while (capacidad_entradas(tam) < 2 * cantidad)
+        tam *= 2;
+    return tam;
+}
+
+static size_t ranura_leer(const hash_compacto_t *hash, size_t i) {
+    switch (hash->ancho) {
+    case sizeof(uint8_t):
+        return ((const uint8_t *) hash->indice)[i];
+    case sizeof(uint16_t):
+        return ((const uint16_t *) hash->indice)[i];
+    case sizeof(uint32_t):
+        return ((const uint32_t *) hash->indice)[i];
+    default:
+        return (size_t) ((const uint64_t *) hash->indice)[i];
+    }
+}
+
+static void ranura_escribir(hash_compacto_t *hash, size_t i, size_t valor) {
+    switch (hash->ancho) {
+    case sizeof(uint8_t):
+        ((uint8_t *) hash->indice)[i] = (uint8_t) valor;
+        break;
+    case sizeof(uint16_t):
+        ((uint16_t *) hash->indice)[i] = (uint16_t) valor;
+        break;
+    case sizeof(uint32_t):
+        ((uint32_t *) hash->indice)[i] = (uint32_t) valor;
+        break;
+    default:
+        ((uint64_t *) hash->indice)[i] = (uint64_t) valor;
+    }
+}
+
+/* Recorre las ranuras en el orden de sondeo de CPython: los bits altos del
+ * hash entran de a poco, así claves que coinciden en los bajos se separan */
+static size_t siguiente_ranura(const hash_compacto_t *hash, size_t i, uint64_t *perturbacion) {
+    *perturbacion >>= PERTURBACION;
+    return (i * 5 + (size_t) *perturbacion + 1) & (hash->tam_indice - 1);
+}
+
+/* Devuelve la ranura que apunta a la entrada de la clave, o tam_indice si no está */
+static size_t buscar_ranura(const hash_compacto_t *hash, const char *clave, uint64_t valor) {
+    uint64_t perturbacion = valor;
+    size_t i = (size_t) valor & (hash->tam_indice - 1), ranura;
+    const entrada_t *entrada;
+
+    while ((ranura = ranura_leer(hash, i)) != RANURA_VACIA) {
+        if (ranura != RANURA_BORRADA) {
+            entrada = &hash->entradas[ranura - PRIMERA_ENTRADA];
+            if (entrada->valor == valor && !strcmp(entrada->clave, clave))
+                return i;
+        }
+        i = siguiente_ranura(hash, i, &perturbacion);
+    }
+    return hash->tam_indice;
+}
+
+/* Devuelve la primera ranura vacía o borrada del sondeo del hash valor */
+static size_t buscar_ranura_libre(const hash_compacto_t *hash, uint64_t valor) {
+    uint64_t perturbacion = valor;
+    size_t i = (size_t) valor & (hash->tam_indice - 1);
+    while (ranura_leer(hash, i) >= PRIMERA_ENTRADA)
+        i = siguiente_ranura(hash, i, &perturbacion);
+    return i;
+}
+
+/* Devuelve la primera entrada que no es un hueco desde pos, o usadas si no hay */
+static size_t buscar_entrada(const hash_compacto_t *hash, size_t pos) {
+    while (pos < hash->usadas && !hash->entradas[pos].clave)
+        pos++;
+    return pos;
+}
+
+/* Pasa las entradas a un arreglo y un índice de tam_indice ranuras, en el
+ * mismo orden y sin los huecos. Si no hay memoria la tabla queda como estaba */
+static bool compacto_redimensionar(hash_compacto_t *hash, size_t tam_indice) {
+    size_t ancho = ancho_para(tam_indice), capacidad = capacidad_entradas(tam_indice), usadas = 0;
+    entrada_t *entradas = compacto_reservar(hash, capacidad * sizeof(entrada_t));
+    void *indice = compacto_reservar_ceros(hash, tam_indice * ancho);
+
+    if (!entradas || !indice) {
+        if (entradas)
+            compacto_liberar(hash, entradas, capacidad * sizeof(entrada_t));
+        if (indice)
+            compacto_liberar(hash, indice, tam_indice * ancho);
+        return false;
+    }
+    for (size_t pos = buscar_entrada(hash, 0); pos < hash->usadas; pos = buscar_entrada(hash, pos + 1))
+        entradas[usadas++] = hash->entradas[pos];
+    compacto_liberar(hash, hash->entradas, capacidad_entradas(hash->tam_indice) * sizeof(entrada_t));
+    compacto_liberar(hash, hash->indice, hash->tam_indice * hash->ancho);
+    hash->entradas = entradas;
+    hash->usadas = usadas;
+    hash->indice = indice;
+    hash->tam_indice = tam_indice;
+    hash->ancho = ancho;
+    for (size_t pos = 0; pos < usadas; pos++)
+        ranura_escribir(hash, buscar_ranura_libre(hash, entradas[pos].valor), pos + PRIMERA_ENTRADA);
+    return true;
+}
+
+/**************************************
+ **  Primitivas de la Tabla de hash  **
+ **************************************/
+
+hash_compacto_t *hash_compacto_crear(hash_destruir_dato_t destruir_dato) {
+    return hash_compacto_crear_con_alocador(destruir_dato, alocador_estandar());
+}
+
+hash_compacto_t *hash_compacto_crear_con_alocador(hash_destruir_dato_t destruir_dato, const alocador_t *alocador) {
+    hash_compacto_t *nuevo = alocador_reservar(alocador, sizeof(*nuevo));
+    if (!nuevo)
+        return NULL;
+    nuevo->alocador = *alocador;
+    nuevo->bytes = sizeof(*nuevo);
+    nuevo->tam_indice = TAM_INDICE_INICIAL;
+    nuevo->ancho = ancho_para(TAM_INDICE_INICIAL);
+    nuevo->entradas = compacto_reservar(nuevo, capacidad_entradas(TAM_INDICE_INICIAL) * sizeof(entrada_t));
+    nuevo->indice = compacto_reservar_ceros(nuevo, TAM_INDICE_INICIAL * nuevo->ancho);
+    if (!nuevo->entradas || !nuevo->indice) {
+        if (nuevo->entradas)
+            alocador_liberar(alocador, nuevo->entradas, capacidad_entradas(TAM_INDICE_INICIAL) * sizeof(entrada_t));
+        if (nuevo->indice)
+            alocador_liberar(alocador, nuevo->indice, TAM_INDICE_INICIAL * nuevo->ancho);
+        alocador_liberar(alocador, nuevo, sizeof(*nuevo));
+        return NULL;
+    }
+    nuevo->usadas = 0;
+    nuevo->cantidad = 0;
+    nuevo->destruir_dato = destruir_dato;
+    return nuevo;
+}
+
+bool hash_compacto_guardar(hash_compacto_t *hash, const char *clave, void *dato) {
+    if (!clave) return false; // Debe recibir una clave válida
+    uint64_t valor = compacto_hash(clave);
+    size_t ranura = buscar_ranura(hash, clave, valor), largo;
+    entrada_t *entrada;
+
+    /* Si la clave ya está solo se reemplaza el dato, sin cambiar su lugar */
+    if (ranura < hash->tam_indice) {
+        entrada = &hash->entradas[ranura_leer(hash, ranura) - PRIMERA_ENTRADA];
+        if (hash->destruir_dato)
+            hash->destruir_dato(entrada->dato);
+        entrada->dato = dato;
+        return true;
+    }
+    /* Sin lugar al final de las entradas se compactan, y crecen si hace falta */
+    if (hash->usadas == capacidad_entradas(hash->tam_indice) &&
+        !compacto_redimensionar(hash, tam_indice_para(hash->cantidad + 1)))
+        return false;
+    largo = strlen(clave) + 1;
+    entrada = &hash->entradas[hash->usadas];
+    entrada->clave = compacto_reservar(hash, largo * sizeof(char));
+    if (!entrada->clave)
+        return false;
+    memcpy(entrada->clave, clave, largo);
+    entrada->valor = valor;
+    entrada->dato = dato;
+    ranura_escribir(hash, buscar_ranura_libre(hash, valor), hash->usadas + PRIMERA_ENTRADA);
+    hash->usadas++;
+    hash->cantidad++;
+    return true;
+}
+
+void *hash_compacto_borrar(hash_compacto_t *hash, const char *clave) {
+    entrada_t *entrada;
+    size_t ranura;
+    void *dato;
+
+    if (!clave || (ranura = buscar_ranura(hash, clave, compacto_hash(clave))) == hash->tam_indice)
+        return NULL;
+    /* La entrada queda como hueco hasta la próxima redimensión */
+    entrada = &hash->entradas[ranura_leer(hash, ranura) - PRIMERA_ENTRADA];
+    ranura_escribir(hash, ranura, RANURA_BORRADA);
+    dato = entrada->dato;
+    compacto_liberar(hash, entrada->clave, strlen(entrada->clave) + 1);
+    entrada->clave = NULL;
+    entrada->dato = NULL;
+    hash->cantidad--;
+    if (hash->tam_indice > TAM_INDICE_INICIAL && hash->cantidad * CARGA_MIN_DEN < capacidad_entradas(hash->tam_indice))
+        compacto_redimensionar(hash, tam_indice_para(hash->cantidad));
+    return dato;
+}
+
+void *hash_compacto_obtener(const hash_compacto_t *hash, const char *clave) {
+    size_t ranura;
+    if (!clave || (ranura = buscar_ranura(hash, clave, compacto_hash(clave))) == hash->tam_indice)
+        return NULL;
+    return hash->entradas[ranura_leer(hash, ranura) - PRIMERA_ENTRADA].dato;
+}
+
+bool hash_compacto_pertenece(const hash_compacto_t *hash, const char *clave) {
+    return (clave && buscar_ranura(hash, clave, compacto_hash(clave)) < hash->tam_indice);
+}
+
+size_t hash_compacto_cantidad(const hash_compacto_t *hash) {
+    return hash->cantidad;
+}
+
+size_t hash_compacto_ancho_indice(const hash_compacto_t *hash) {
+    return hash->ancho;
+}
+
+size_t hash_compacto_memoria(const hash_compacto_t *hash) {
+    return hash->bytes;
+}
+
+void hash_compacto_destruir(hash_compacto_t *hash) {
+    alocador_t alocador = hash->alocador;
+
+    for (size_t pos = buscar_entrada(hash, 0); pos < hash->usadas; pos = buscar_entrada(hash, pos + 1)) {
+        if (hash->destruir_dato)
+            hash->destruir_dato(hash->entradas[pos].dato);
+        alocador_liberar(&alocador, hash->entradas[pos].clave, strlen(hash->entradas[pos].clave) + 1);
+    }
+    alocador_liberar(&alocador, hash->entradas, capacidad_entradas(hash->tam_indice) * sizeof(entrada_t));
+    alocador_liberar(&alocador, hash->indice, hash->tam_indice * hash->ancho);
+    alocador_liberar(&alocador, hash, sizeof(*hash));
+}
+
+/****************************************
+ **  Primitivas del Iterador del hash  **
+ ****************************************/
+
+hash_compacto_iter_t *hash_compacto_iter_crear(const hash_compacto_t *hash) {
+    hash_compacto_iter_t *iter = alocador_reservar(&hash->alocador, sizeof(*iter));
+    if (!iter)
+        return NULL;
+    iter->hash = hash;
+    iter->pos = buscar_entrada(hash, 0);
+    return iter;
+}
+
+bool hash_compacto_iter_avanzar(hash_compacto_iter_t *iter) {
+    if (hash_compacto_iter_al_final(iter))
+        return false;
+    iter->pos = buscar_entrada(iter->hash, iter->pos + 1);
+    return true;
+}
+
+const char *hash_compacto_iter_ver_actual(const hash_compacto_iter_t *iter) {
+    return (hash_compacto_iter_al_final(iter) ? NULL : iter->hash->entradas[iter->pos].clave);
+}
+
+void *hash_compacto_iter_ver_dato(const hash_compacto_iter_t *iter) {
+    return (hash_compacto_iter_al_final(iter) ? NULL : iter->hash->entradas[iter->pos].dato);
+}
+
+bool hash_compacto_iter_al_final(const hash_compacto_iter_t *iter) {
+    return (iter->pos == iter->hash->usadas);
+}
+
+void hash_compacto_iter_destruir(hash_compacto_iter_t *iter) {
+    alocador_liberar(&iter->hash->alocador, iter, sizeof(*iter));
+}
@@ -0,0 +1,112 @@
+#ifndef HASH_COMPACTO_H
+#define HASH_COMPACTO_H
+
+#include "alocador.h"
+#include "hash.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+/* Tabla de hash compacta y ordenada, con la disposición de los diccionarios
+ * de CPython.
+ *
+ * Los pares se agregan al final de un arreglo denso de entradas, y un índice
+ * aparte, de direccionamiento abierto, guarda en cada ranura la posición de
+ * una entrada. Las ranuras ocupan 1, 2, 4 u 8 bytes según cuántas entradas
+ * entran en la tabla, así el índice de una tabla chica es muy chico y las
+ * entradas no dejan lugar libre entre ellas como las ranuras de un
+ * direccionamiento abierto. Iterar recorre las entradas en orden de
+ * inserción, en memoria contigua y sin pasar por el índice.
+ *
+ * Borrar deja un hueco en las entradas; los huecos se compactan al
+ * redimensionar, que ocurre cuando las entradas (contando los huecos) llenan
+ * 2/3 del índice. Reemplazar el dato de una clave no cambia su lugar.
+ *
+ * Las primitivas son las mismas que las de hash.h, sin TTL ni cache. Un
+ * iterador sobrevive a reemplazar datos, pero no a agregar ni borrar claves.
+ */
+
+typedef struct hash_compacto hash_compacto_t;
+typedef struct hash_compacto_iter hash_compacto_iter_t;
+
+/* Crea el hash
+ * Pos: devuelve un puntero a una tabla de hash, o NULL si falló.
+ */
+hash_compacto_t *hash_compacto_crear(hash_destruir_dato_t destruir_dato);
+
+/* Crea un hash que pide toda su memoria (las entradas, el índice, las claves y
+ * los iteradores) al alocador, que se copia. Su contexto debe vivir al menos
+ * tanto como el hash.
+ * Pos: devuelve un puntero a una tabla de hash, o NULL si falló.
+ */
+hash_compacto_t *hash_compacto_crear_con_alocador(hash_destruir_dato_t destruir_dato, const alocador_t *alocador);
+
+/* Guarda un elemento en el hash, si la clave ya se encuentra en la
+ * estructura, reemplaza su dato. De no poder guardarlo devuelve false.
+ * Pre: La estructura hash fue inicializada
+ * Post: Se almacenó el par (clave, dato)
+ */
+bool hash_compacto_guardar(hash_compacto_t *hash, const char *clave, void *dato);
+
+/* Borra un elemento del hash y devuelve el dato asociado. Devuelve
+ * NULL si el dato no estaba.
+ * Pre: La estructura hash fue inicializada
+ * Post: El elemento fue borrado de la estructura y se lo devolvió,
+ * en el caso de que estuviera guardado.
+ */
+void *hash_compacto_borrar(hash_compacto_t *hash, const char *clave);
+
+/* Obtiene el valor de un elemento del hash, si la clave no se encuentra
+ * devuelve NULL.
+ * Pre: La estructura hash fue inicializada
+ */
+void *hash_compacto_obtener(const hash_compacto_t *hash, const char *clave);
+
+/* Determina si clave pertenece o no al hash.
+ * Pre: La estructura hash fue inicializada
+ */
+bool hash_compacto_pertenece(const hash_compacto_t *hash, const char *clave);
+
+/* Devuelve la cantidad de elementos del hash.
+ * Pre: La estructura hash fue inicializada
+ */
+size_t hash_compacto_cantidad(const hash_compacto_t *hash);
+
+/* Devuelve los bytes que ocupa cada ranura del índice: 1, 2, 4 u 8.
+ * Pre: La estructura hash fue inicializada
+ */
+size_t hash_compacto_ancho_indice(const hash_compacto_t *hash);
+
+/* Devuelve los bytes que el hash tiene pedidos a su alocador, incluyendo su
+ * propia estructura y sin contar los datos ni los iteradores.
+ * Pre: La estructura hash fue inicializada
+ */
+size_t hash_compacto_memoria(const hash_compacto_t *hash);
+
+/* Destruye la estructura liberando la memoria pedida y llamando a la función
+ * destruir para cada par (clave, dato).
+ * Pre: La estructura hash fue inicializada
+ * Post: La estructura hash fue destruida
+ */
+void hash_compacto_destruir(hash_compacto_t *hash);
+
+/* Iterador del hash, en el orden en que se agregaron las claves */
+
+// Crea iterador
+hash_compacto_iter_t *hash_compacto_iter_crear(const hash_compacto_t *hash);
+
+// Avanza iterador
+bool hash_compacto_iter_avanzar(hash_compacto_iter_t *iter);
+
+// Devuelve clave actual, esa clave no se puede modificar ni liberar.
+const char *hash_compacto_iter_ver_actual(const hash_compacto_iter_t *iter);
+
+// Devuelve el dato de la clave actual, o NULL si el iterador está al final.
+void *hash_compacto_iter_ver_dato(const hash_compacto_iter_t *iter);
+
+// Comprueba si terminó la iteración
+bool hash_compacto_iter_al_final(const hash_compacto_iter_t *iter);
+
+// Destruye iterador
+void hash_compacto_iter_destruir(hash_compacto_iter_t *iter);
+
+#endif // HASH_COMPACTO_H
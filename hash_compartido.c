@@ -0,0 +1,368 @@
+#define _POSIX_C_SOURCE 200809L
+#include "hash_compartido.h"
+#include "hash_funciones.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+#define COMPARTIDO_MAGIA "HASHSHM"
+#define COMPARTIDO_VERSION 1
+#define ALINEACION 8
+
+/* Definiciones del formato de la región. Todos los enlaces son
+ * desplazamientos desde el comienzo de la región; 0 es el enlace vacío, que
+ * cae en la cabecera y nunca es un nodo. */
+
+typedef struct cabecera {
+    char magia[8];                     // Se escribe al final de crear: antes la región no es válida
+    uint32_t version;
+    uint32_t reservado;
+    uint64_t tam;
+    uint64_t cantidad_baldes;          // Potencia de dos
+    uint64_t desplazamiento_baldes;
+    uint64_t cantidad;
+    uint64_t fin_usado;                // Los nodos nuevos se toman desde acá
+    uint64_t libres;                   // Nodos borrados, enlazados por sig
+    pthread_mutex_t candado;           // Compartido entre procesos, robusto y recursivo
+} cabecera_t;
+
+typedef struct nodo {
+    uint64_t sig;
+    uint64_t hash;
+    uint64_t tam_bloque;               // Bytes del bloque, que puede ser mayor que el nodo si se reutilizó
+    uint32_t largo_clave;              // Sin contar el '\0'
+    uint32_t largo_dato;
+    char bytes[];                      // La clave con su '\0' y a continuación el dato
+} nodo_t;
+
+struct hash_compartido {
+    unsigned char *base;
+    size_t tam;
+    bool escribir;
+};
+
+/* Funciones auxiliares */
+
+static cabecera_t *cabecera_de(const hash_compartido_t *compartido) {
+    return (cabecera_t *) compartido->base;
+}
+
+/* Devuelve el nodo del desplazamiento, o NULL si es el enlace vacío o se sale
+ * de la región */
+static nodo_t *nodo_en(const hash_compartido_t *compartido, uint64_t desplazamiento) {
+    if (!desplazamiento || desplazamiento > compartido->tam - sizeof(nodo_t))
+        return NULL;
+    return (nodo_t *) (compartido->base + desplazamiento);
+}
+
+static uint64_t *balde_de(const hash_compartido_t *compartido, uint64_t hash) {
+    const cabecera_t *cabecera = cabecera_de(compartido);
+    uint64_t *baldes = (uint64_t *) (compartido->base + cabecera->desplazamiento_baldes);
+    return &baldes[hash & (cabecera->cantidad_baldes - 1)];
+}
+
+/* Devuelve el enlace que apunta al nodo de la clave, o el enlace vacío al
+ * final de su balde si no está */
+static uint64_t *buscar_enlace(const hash_compartido_t *compartido, const char *clave, size_t largo_clave,
+                               uint64_t hash) {
+    uint64_t *enlace = balde_de(compartido, hash);
+    nodo_t *nodo;
+
+    while ((nodo = nodo_en(compartido, *enlace))) {
+        if (nodo->hash == hash && nodo->largo_clave == largo_clave && !memcmp(nodo->bytes, clave, largo_clave))
+            return enlace;
+        enlace = &nodo->sig;
+    }
+    return enlace;
+}
+
+static const nodo_t *buscar_nodo(const hash_compartido_t *compartido, const char *clave) {
+    size_t largo_clave = strlen(clave);
+    return nodo_en(compartido, *buscar_enlace(compartido, clave, largo_clave, hash_fnv1a(clave, largo_clave)));
+}
+
+/* Vuelve a contar las claves después de que un proceso murió con el mutex
+ * tomado: los enlaces siempre quedan consistentes, pero la cantidad se
+ * actualiza después de enlazar */
+static void reparar(hash_compartido_t *compartido) {
+    cabecera_t *cabecera = cabecera_de(compartido);
+    uint64_t cantidad = 0;
+    const nodo_t *nodo;
+
+    for (uint64_t b = 0; b < cabecera->cantidad_baldes; b++) {
+        for (nodo = nodo_en(compartido, *balde_de(compartido, b)); nodo; nodo = nodo_en(compartido, nodo->sig))
+            cantidad++;
+    }
+    cabecera->cantidad = cantidad;
+}
+
+static bool tomar(hash_compartido_t *compartido) {
+    cabecera_t *cabecera = cabecera_de(compartido);
+    int resultado = pthread_mutex_lock(&cabecera->candado);
+
+    if (resultado == EOWNERDEAD) {
+        reparar(compartido);
+        pthread_mutex_consistent(&cabecera->candado);
+        return true;
+    }
+    return !resultado;
+}
+
+static void soltar(hash_compartido_t *compartido) {
+    pthread_mutex_unlock(&cabecera_de(compartido)->candado);
+}
+
+/* Devuelve el desplazamiento de un bloque de al menos tam bytes, reutilizando
+ * el primer nodo borrado que alcance, o 0 si no hay lugar */
+static uint64_t reservar_bloque(hash_compartido_t *compartido, uint64_t tam) {
+    cabecera_t *cabecera = cabecera_de(compartido);
+    uint64_t *enlace = &cabecera->libres, desplazamiento;
+    nodo_t *libre;
+
+    while ((libre = nodo_en(compartido, *enlace))) {
+        if (libre->tam_bloque >= tam) {
+            desplazamiento = *enlace;
+            *enlace = libre->sig;
+            return desplazamiento;
+        }
+        enlace = &libre->sig;
+    }
+    if (tam > cabecera->tam - cabecera->fin_usado)
+        return 0;
+    desplazamiento = cabecera->fin_usado;
+    cabecera->fin_usado += tam;
+    nodo_en(compartido, desplazamiento)->tam_bloque = tam;
+    return desplazamiento;
+}
+
+static void liberar_bloque(hash_compartido_t *compartido, uint64_t desplazamiento) {
+    cabecera_t *cabecera = cabecera_de(compartido);
+    nodo_en(compartido, desplazamiento)->sig = cabecera->libres;
+    cabecera->libres = desplazamiento;
+}
+
+static uint64_t alinear(uint64_t tam) {
+    return (tam + ALINEACION - 1) & ~(uint64_t) (ALINEACION - 1);
+}
+
+static hash_compartido_t *mapear(int fd, size_t tam, bool escribir) {
+    hash_compartido_t *compartido = malloc(sizeof(*compartido));
+    void *base;
+
+    if (!compartido)
+        return NULL;
+    base = mmap(NULL, tam, escribir ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0);
+    if (base == MAP_FAILED) {
+        free(compartido);
+        return NULL;
+    }
+    compartido->base = base;
+    compartido->tam = tam;
+    compartido->escribir = escribir;
+    return compartido;
+}
+
+static bool iniciar_candado(pthread_mutex_t *candado) {
+    pthread_mutexattr_t atributos;
+    bool ok;
+
+    if (pthread_mutexattr_init(&atributos))
+        return false;
+    ok = !pthread_mutexattr_setpshared(&atributos, PTHREAD_PROCESS_SHARED) &&
+         !pthread_mutexattr_setrobust(&atributos, PTHREAD_MUTEX_ROBUST) &&
+         !pthread_mutexattr_settype(&atributos, PTHREAD_MUTEX_RECURSIVE) &&
+         !pthread_mutex_init(candado, &atributos);
+    pthread_mutexattr_destroy(&atributos);
+    return ok;
+}
+
+static bool cabecera_valida(const cabecera_t *cabecera, size_t tam) {
+    return !memcmp(cabecera->magia, COMPARTIDO_MAGIA, sizeof(cabecera->magia)) &&
+           cabecera->version == COMPARTIDO_VERSION && cabecera->tam == tam &&
+           cabecera->cantidad_baldes && !(cabecera->cantidad_baldes & (cabecera->cantidad_baldes - 1)) &&
+           cabecera->desplazamiento_baldes == alinear(sizeof(cabecera_t)) &&
+           cabecera->cantidad_baldes <= (tam - cabecera->desplazamiento_baldes) / sizeof(uint64_t) &&
+           cabecera->fin_usado <= tam;
+}
+
+/**************************************
+ **  Primitivas del hash compartido  **
+ **************************************/
+
+hash_compartido_t *hash_compartido_crear(const char *nombre, size_t tam, size_t cantidad_baldes) {
+    uint64_t baldes = 1, desplazamiento_baldes = alinear(sizeof(cabecera_t));
+    hash_compartido_t *compartido;
+    cabecera_t *cabecera;
+    int fd;
+
+    while (baldes < cantidad_baldes)
+        baldes <<= 1;
+    if (tam < desplazamiento_baldes + baldes * sizeof(uint64_t))
+        return NULL;
+    fd = shm_open(nombre, O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd < 0)
+        return NULL;
+    /* ftruncate deja la región en ceros: la magia y los baldes quedan vacíos */
+    compartido = (ftruncate(fd, (off_t) tam) ? NULL : mapear(fd, tam, true));
+    close(fd);
+    if (!compartido) {
+        shm_unlink(nombre);
+        return NULL;
+    }
+    cabecera = cabecera_de(compartido);
+    if (!iniciar_candado(&cabecera->candado)) {
+        hash_compartido_cerrar(compartido);
+        shm_unlink(nombre);
+        return NULL;
+    }
+    cabecera->version = COMPARTIDO_VERSION;
+    cabecera->tam = tam;
+    cabecera->cantidad_baldes = baldes;
+    cabecera->desplazamiento_baldes = desplazamiento_baldes;
+    cabecera->fin_usado = alinear(desplazamiento_baldes + baldes * sizeof(uint64_t));
+    memcpy(cabecera->magia, COMPARTIDO_MAGIA, sizeof(cabecera->magia));
+    return compartido;
+}
+
+hash_compartido_t *hash_compartido_abrir(const char *nombre, bool escribir) {
+    hash_compartido_t *compartido;
+    struct stat estado;
+    int fd = shm_open(nombre, escribir ? O_RDWR : O_RDONLY, 0);
+
+    if (fd < 0)
+        return NULL;
+    if (fstat(fd, &estado) || (size_t) estado.st_size < sizeof(cabecera_t)) {
+        close(fd);
+        return NULL;
+    }
+    compartido = mapear(fd, (size_t) estado.st_size, escribir);
+    close(fd);
+    if (compartido && !cabecera_valida(cabecera_de(compartido), compartido->tam)) {
+        hash_compartido_cerrar(compartido);
+        return NULL;
+    }
+    return compartido;
+}
+
+bool hash_compartido_guardar(hash_compartido_t *compartido, const char *clave, const void *dato, size_t largo) {
+    if (!clave) return false; // Debe recibir una clave válida
+    size_t largo_clave = strlen(clave);
+    uint64_t hash = hash_fnv1a(clave, largo_clave), *enlace, desplazamiento, viejo;
+    cabecera_t *cabecera = cabecera_de(compartido);
+    nodo_t *nodo;
+
+    if (!compartido->escribir || largo_clave > UINT32_MAX || largo > UINT32_MAX || !tomar(compartido))
+        return false;
+    desplazamiento = reservar_bloque(compartido, alinear(sizeof(nodo_t) + largo_clave + 1 + largo));
+    if (!desplazamiento) {
+        soltar(compartido);
+        return false;
+    }
+    nodo = nodo_en(compartido, desplazamiento);
+    nodo->hash = hash;
+    nodo->largo_clave = (uint32_t) largo_clave;
+    nodo->largo_dato = (uint32_t) largo;
+    memcpy(nodo->bytes, clave, largo_clave + 1);
+    if (largo)
+        memcpy(nodo->bytes + largo_clave + 1, dato, largo);
+
+    /* El nodo queda completo antes de enlazarlo: enlazar es una sola escritura */
+    enlace = buscar_enlace(compartido, clave, largo_clave, hash);
+    viejo = *enlace;
+    if (viejo) {
+        /* El nodo viejo pasa a libres recién cuando ya nadie lo enlaza */
+        nodo->sig = nodo_en(compartido, viejo)->sig;
+        *enlace = desplazamiento;
+        liberar_bloque(compartido, viejo);
+    } else {
+        nodo->sig = 0;
+        *enlace = desplazamiento;
+        cabecera->cantidad++;
+    }
+    soltar(compartido);
+    return true;
+}
+
+bool hash_compartido_borrar(hash_compartido_t *compartido, const char *clave) {
+    if (!clave) return false; // Debe recibir una clave válida
+    size_t largo_clave = strlen(clave);
+    uint64_t *enlace, desplazamiento;
+
+    if (!compartido->escribir || !tomar(compartido))
+        return false;
+    enlace = buscar_enlace(compartido, clave, largo_clave, hash_fnv1a(clave, largo_clave));
+    desplazamiento = *enlace;
+    if (!desplazamiento) {
+        soltar(compartido);
+        return false;
+    }
+    *enlace = nodo_en(compartido, desplazamiento)->sig;
+    cabecera_de(compartido)->cantidad--;
+    liberar_bloque(compartido, desplazamiento);
+    soltar(compartido);
+    return true;
+}
+
+bool hash_compartido_obtener(const hash_compartido_t *compartido, const char *clave, void *buffer, size_t capacidad,
+                             size_t *largo) {
+    if (!clave) return false; // Debe recibir una clave válida
+    hash_compartido_t *propio = (hash_compartido_t *) compartido;
+    const nodo_t *nodo;
+
+    if (compartido->escribir && !tomar(propio))
+        return false;
+    nodo = buscar_nodo(compartido, clave);
+    if (nodo) {
+        *largo = nodo->largo_dato;
+        if (nodo->largo_dato <= capacidad && nodo->largo_dato)
+            memcpy(buffer, nodo->bytes + nodo->largo_clave + 1, nodo->largo_dato);
+    }
+    if (compartido->escribir)
+        soltar(propio);
+    return nodo;
+}
+
+bool hash_compartido_pertenece(const hash_compartido_t *compartido, const char *clave) {
+    if (!clave) return false; // Debe recibir una clave válida
+    hash_compartido_t *propio = (hash_compartido_t *) compartido;
+    bool pertenece;
+
+    if (compartido->escribir && !tomar(propio))
+        return false;
+    pertenece = buscar_nodo(compartido, clave);
+    if (compartido->escribir)
+        soltar(propio);
+    return pertenece;
+}
+
+size_t hash_compartido_cantidad(const hash_compartido_t *compartido) {
+    return cabecera_de(compartido)->cantidad;
+}
+
+size_t hash_compartido_libre(const hash_compartido_t *compartido) {
+    const cabecera_t *cabecera = cabecera_de(compartido);
+    return cabecera->tam - cabecera->fin_usado;
+}
+
+bool hash_compartido_bloquear(hash_compartido_t *compartido) {
+    return compartido->escribir && tomar(compartido);
+}
+
+void hash_compartido_desbloquear(hash_compartido_t *compartido) {
+    soltar(compartido);
+}
+
+void hash_compartido_cerrar(hash_compartido_t *compartido) {
+    munmap(compartido->base, compartido->tam);
+    free(compartido);
+}
+
+bool hash_compartido_eliminar(const char *nombre) {
+    return !shm_unlink(nombre);
+}
@@ -0,0 +1,105 @@
+#ifndef HASH_COMPARTIDO_H
+#define HASH_COMPARTIDO_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/* Tabla de hash en memoria compartida entre procesos.
+ *
+ * Los baldes, los nodos y sus claves y datos viven en una región de memoria
+ * compartida POSIX (shm_open y mmap) de tamaño fijo, así varios procesos de
+ * la misma máquina usan una sola copia de la tabla en lugar de armar cada uno
+ * la suya. Como cada proceso mapea la región en otra dirección, los nodos se
+ * enlazan con desplazamientos desde el comienzo de la región y no con
+ * punteros, y los datos son bytes que se copian a la región, no void *.
+ *
+ * Un proceso crea la tabla y los demás la abren por nombre. Abierta para
+ * escribir, cada operación toma un mutex compartido y robusto que está en la
+ * región: si un proceso muere con el mutex tomado, el siguiente que lo toma
+ * recupera la tabla. Los enlaces se actualizan con una sola escritura al
+ * final de cada operación, así una operación cortada deja a lo sumo un nodo
+ * sin usar. Abierta de solo lectura, la región se mapea sin permiso de
+ * escritura y no se toma el mutex: es para tablas que ya no se modifican.
+ *
+ * La cantidad de baldes se fija al crear la tabla y no cambia. La memoria de
+ * los nodos borrados o reemplazados se reutiliza para nodos del mismo tamaño
+ * o menores.
+ */
+
+typedef struct hash_compartido hash_compartido_t;
+
+/* Crea la región compartida de nombre (que empieza con '/', ver shm_open)
+ * con tam bytes y una tabla vacía de al menos cantidad_baldes baldes, y la
+ * abre para escribir. Falla si ya existe una región con ese nombre.
+ * Pos: devuelve la tabla, o NULL si falló.
+ */
+hash_compartido_t *hash_compartido_crear(const char *nombre, size_t tam, size_t cantidad_baldes);
+
+/* Abre la tabla de la región de nombre, creada por hash_compartido_crear en
+ * este u otro proceso. Si escribir es false la abre de solo lectura.
+ * Pos: devuelve la tabla, o NULL si no existe o no es válida.
+ */
+hash_compartido_t *hash_compartido_abrir(const char *nombre, bool escribir);
+
+/* Guarda una copia de los largo bytes de dato con la clave; si la clave ya
+ * está, reemplaza su dato. Reemplazar también necesita lugar para un nodo
+ * nuevo, porque el viejo se suelta recién después de enlazarlo. Devuelve
+ * false si la tabla es de solo lectura o no queda lugar en la región.
+ * Pre: la tabla fue creada o abierta
+ * Post: Se almacenó el par (clave, dato)
+ */
+bool hash_compartido_guardar(hash_compartido_t *compartido, const char *clave, const void *dato, size_t largo);
+
+/* Borra la clave y su dato. Devuelve false si no estaba o la tabla es de
+ * solo lectura.
+ * Pre: la tabla fue creada o abierta
+ */
+bool hash_compartido_borrar(hash_compartido_t *compartido, const char *clave);
+
+/* Devuelve false si la clave no está. Si está, guarda el largo de su dato en
+ * largo y, si entra en capacidad bytes, lo copia a buffer; si no entra no
+ * copia nada y se la vuelve a llamar con un buffer suficiente.
+ * Pre: la tabla fue creada o abierta
+ */
+bool hash_compartido_obtener(const hash_compartido_t *compartido, const char *clave, void *buffer, size_t capacidad,
+                             size_t *largo);
+
+/* Determina si la clave está en la tabla.
+ * Pre: la tabla fue creada o abierta
+ */
+bool hash_compartido_pertenece(const hash_compartido_t *compartido, const char *clave);
+
+/* Devuelve la cantidad de claves de la tabla.
+ * Pre: la tabla fue creada o abierta
+ */
+size_t hash_compartido_cantidad(const hash_compartido_t *compartido);
+
+/* Devuelve los bytes de la región que todavía no usó ningún nodo, sin contar
+ * los de nodos borrados que se pueden reutilizar.
+ * Pre: la tabla fue creada o abierta
+ */
+size_t hash_compartido_libre(const hash_compartido_t *compartido);
+
+/* Toma el mutex de la tabla para hacer varias operaciones seguidas sin que
+ * otro proceso la modifique en el medio; las primitivas se pueden llamar con
+ * el mutex tomado. Devuelve false si la tabla es de solo lectura.
+ * Pre: la tabla fue creada o abierta
+ */
+bool hash_compartido_bloquear(hash_compartido_t *compartido);
+
+/* Suelta el mutex tomado con hash_compartido_bloquear.
+ * Pre: el mutex fue tomado por este proceso con hash_compartido_bloquear
+ */
+void hash_compartido_desbloquear(hash_compartido_t *compartido);
+
+/* Desmapea la región. La tabla sigue existiendo para los demás procesos.
+ * Pre: la tabla fue creada o abierta
+ */
+void hash_compartido_cerrar(hash_compartido_t *compartido);
+
+/* Borra el nombre de la región; la memoria se libera cuando la cierra el
+ * último proceso que la tiene abierta. Devuelve false si no existía.
+ */
+bool hash_compartido_eliminar(const char *nombre);
+
+#endif // HASH_COMPARTIDO_H
@@ -0,0 +1,281 @@
+#include "hash_congelado.h"
+#include "hash_funciones.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#define CLAVES_POR_BALDE 4
+/* Las posiciones se buscan en un espacio 1/32 más grande que la cantidad de
+ * claves, así las últimas no necesitan millones de intentos. Las que caen
+ * fuera de [0, cantidad) se remapean a los huecos que quedaron adentro. */
+#define HOLGURA_BUSQUEDA 32
+#define MAX_PILOTOS (1u << 20)
+#define MAX_SEMILLAS 16
+
+/* Definiciones de estructuras de la tabla congelada */
+
+typedef struct ranura {
+    void *dato;
+    size_t clave;   // Posición de la clave dentro del bloque de claves
+} ranura_t;
+
+struct hash_congelado {
+    size_t cantidad;
+    size_t cantidad_baldes;
+    size_t tam_busqueda;  // Tamaño del espacio de posiciones de la función de hash
+    uint64_t semilla;
+    uint32_t *pilotos;    // Por balde, el valor que ubica a sus claves sin colisiones
+    size_t *remapeo;      // Posición final de las posiciones >= cantidad
+    ranura_t *ranuras;
+    char *claves;
+};
+
+/* Estado temporal de la construcción de la función de hash perfecta */
+typedef struct construccion {
+    size_t cantidad;
+    size_t tam_busqueda;
+    const char **claves;   // Claves dentro del bloque, en el orden del iterador
+    uint64_t *hashes;
+    size_t *orden;         // Índices de las claves agrupadas por balde
+    size_t *inicio_balde;  // Las claves del balde b son orden[inicio_balde[b] .. inicio_balde[b + 1])
+    size_t *baldes;        // Baldes de mayor a menor cantidad de claves
+    size_t *por_tam;       // Auxiliar para ordenar los baldes por tamaño
+    size_t *posiciones;    // Posiciones tentativas de las claves de un balde
+    bool *ocupada;
+} construccion_t;
+
+/* Funciones auxiliares */
+
+static uint64_t congelado_hash(uint64_t semilla, const char *clave) {
+    return hash_mezclar64(hash_fnv1a_semilla(clave, strlen(clave), semilla));
+}
+
+static size_t congelado_balde(uint64_t hash, size_t cantidad_baldes) {
+    return (size_t) ((hash >> 32) % cantidad_baldes);
+}
+
+static size_t congelado_posicion(uint64_t hash, uint32_t piloto, size_t cantidad) {
+    return (size_t) (hash_mezclar64(hash ^ hash_mezclar64(piloto)) % cantidad);
+}
+
+/* Agrupa las claves por balde y ordena los baldes de mayor a menor tamaño */
+static void agrupar_por_balde(construccion_t *c, size_t cantidad_baldes) {
+    size_t *por_tam = c->por_tam;
+    size_t i, balde, tam;
+
+    /* Ordenamiento por conteo de las claves según su balde */
+    memset(c->inicio_balde, 0, (cantidad_baldes + 1) * sizeof(size_t));
+    for (i = 0; i < c->cantidad; i++)
+        c->inicio_balde[congelado_balde(c->hashes[i], cantidad_baldes) + 1]++;
+    for (balde = 0; balde < cantidad_baldes; balde++)
+        c->inicio_balde[balde + 1] += c->inicio_balde[balde];
+    for (i = 0; i < c->cantidad; i++)
+        c->orden[c->inicio_balde[congelado_balde(c->hashes[i], cantidad_baldes)]++] = i;
+    memmove(c->inicio_balde + 1, c->inicio_balde, cantidad_baldes * sizeof(size_t));
+    c->inicio_balde[0] = 0;
+
+    /* Ordenamiento por conteo de los baldes según su tamaño, de mayor a menor.
+     * por_tam[t] termina siendo la cantidad de baldes de tamaño mayor a t */
+    memset(por_tam, 0, (c->cantidad + 2) * sizeof(size_t));
+    for (balde = 0; balde < cantidad_baldes; balde++)
+        por_tam[c->inicio_balde[balde + 1] - c->inicio_balde[balde]]++;
+    for (tam = c->cantidad + 1; tam > 0; tam--)
+        por_tam[tam - 1] += por_tam[tam];
+    for (balde = 0; balde < cantidad_baldes; balde++) {
+        tam = c->inicio_balde[balde + 1] - c->inicio_balde[balde];
+        c->baldes[por_tam[tam + 1]++] = balde;
+    }
+}
+
+/* Busca un piloto que ubique todas las claves del balde en posiciones libres y distintas */
+static bool buscar_piloto(construccion_t *c, size_t balde, uint32_t *piloto) {
+    size_t desde = c->inicio_balde[balde], tam = c->inicio_balde[balde + 1] - desde;
+    size_t j, k, posicion;
+    uint32_t p;
+
+    for (p = 0; p < MAX_PILOTOS; p++) {
+        for (j = 0; j < tam; j++) {
+            posicion = congelado_posicion(c->hashes[c->orden[desde + j]], p, c->tam_busqueda);
+            if (c->ocupada[posicion])
+                break;
+            c->ocupada[posicion] = true;
+            c->posiciones[j] = posicion;
+        }
+        if (j == tam) {
+            *piloto = p;
+            return true;
+        }
+        for (k = 0; k < j; k++)
+            c->ocupada[c->posiciones[k]] = false;
+    }
+    return false;
+}
+
+/* Intenta construir la función de hash perfecta con una semilla */
+static bool construir_con_semilla(hash_congelado_t *congelado, construccion_t *c, uint64_t semilla) {
+    size_t i, b;
+
+    congelado->semilla = semilla;
+    for (i = 0; i < c->cantidad; i++)
+        c->hashes[i] = congelado_hash(semilla, c->claves[i]);
+    agrupar_por_balde(c, congelado->cantidad_baldes);
+    memset(c->ocupada, 0, c->tam_busqueda * sizeof(bool));
+    for (b = 0; b < congelado->cantidad_baldes; b++) {
+        if (!buscar_piloto(c, c->baldes[b], &congelado->pilotos[c->baldes[b]]))
+            return false;
+    }
+    return true;
+}
+
+/* Copia las claves vigentes del hash en el bloque de claves y anota sus datos */
+static bool copiar_claves(const hash_t *hash, hash_congelado_t *congelado, construccion_t *c, void **datos) {
+    hash_iter_t *iter = hash_iter_crear(hash);
+    size_t bytes = 0, n = 0;
+    const char *clave;
+
+    if (!iter)
+        return false;
+    for (; !hash_iter_al_final(iter); hash_iter_avanzar(iter)) {
+        if (hash_pertenece(hash, hash_iter_ver_actual(iter)))
+            bytes += strlen(hash_iter_ver_actual(iter)) + 1;
+    }
+    hash_iter_destruir(iter);
+    if (!(congelado->claves = malloc(bytes ? bytes : 1)) || !(iter = hash_iter_crear(hash)))
+        return false;
+
+    bytes = 0;
+    for (; !hash_iter_al_final(iter); hash_iter_avanzar(iter)) {
+        clave = hash_iter_ver_actual(iter);
+        if (!hash_pertenece(hash, clave))
+            continue;
+        strcpy(congelado->claves + bytes, clave);
+        c->claves[n] = congelado->claves + bytes;
+        datos[n++] = hash_iter_ver_dato(iter);
+        bytes += strlen(clave) + 1;
+    }
+    hash_iter_destruir(iter);
+    c->cantidad = n;
+    return true;
+}
+
+static void construccion_destruir(construccion_t *c) {
+    free(c->claves);
+    free(c->hashes);
+    free(c->orden);
+    free(c->inicio_balde);
+    free(c->baldes);
+    free(c->posiciones);
+    free(c->por_tam);
+    free(c->ocupada);
+}
+
+/* Devuelve la ranura que le corresponde al hash */
+static ranura_t *congelado_ranura(const hash_congelado_t *congelado, uint64_t hash) {
+    size_t posicion = congelado_posicion(hash, congelado->pilotos[congelado_balde(hash, congelado->cantidad_baldes)],
+                                         congelado->tam_busqueda);
+    if (posicion >= congelado->cantidad)
+        posicion = congelado->remapeo[posicion - congelado->cantidad];
+    return &congelado->ranuras[posicion];
+}
+
+/* Asigna a cada posición ocupada fuera de [0, cantidad) un hueco libre adentro.
+ * Las libres van a la ranura 0: ahí cae una clave que no está, y la
+ * comparación de la clave la descarta */
+static void remapear(hash_congelado_t *congelado, const construccion_t *c) {
+    size_t hueco = 0, posicion;
+
+    for (posicion = congelado->cantidad; posicion < congelado->tam_busqueda; posicion++) {
+        if (!c->ocupada[posicion]) {
+            congelado->remapeo[posicion - congelado->cantidad] = 0;
+            continue;
+        }
+        while (c->ocupada[hueco])
+            hueco++;
+        congelado->remapeo[posicion - congelado->cantidad] = hueco++;
+    }
+}
+
+static const ranura_t *congelado_buscar(const hash_congelado_t *congelado, const char *clave) {
+    const ranura_t *ranura;
+
+    if (!congelado->cantidad)
+        return NULL;
+    ranura = congelado_ranura(congelado, congelado_hash(congelado->semilla, clave));
+    return (strcmp(congelado->claves + ranura->clave, clave) ? NULL : ranura);
+}
+
+/* Primitivas de la tabla congelada */
+
+hash_congelado_t *hash_congelar(const hash_t *hash) {
+    size_t maximo = hash_cantidad(hash) + 1, i;
+    hash_congelado_t *congelado = calloc(1, sizeof(*congelado));
+    construccion_t c;
+    void **datos = malloc(maximo * sizeof(void *));
+    uint64_t semilla = 0;
+    bool ok;
+
+    memset(&c, 0, sizeof(c));
+    c.claves = malloc(maximo * sizeof(char *));
+    c.hashes = malloc(maximo * sizeof(uint64_t));
+    c.orden = malloc(maximo * sizeof(size_t));
+    c.posiciones = malloc(maximo * sizeof(size_t));
+    c.por_tam = malloc((maximo + 1) * sizeof(size_t));
+    c.ocupada = malloc((maximo + maximo / HOLGURA_BUSQUEDA) * sizeof(bool));
+    ok = congelado && datos && c.claves && c.hashes && c.orden && c.posiciones && c.por_tam && c.ocupada &&
+         copiar_claves(hash, congelado, &c, datos);
+    if (ok) {
+        congelado->cantidad = c.cantidad;
+        congelado->cantidad_baldes = c.cantidad / CLAVES_POR_BALDE + 1;
+        congelado->tam_busqueda = c.tam_busqueda = c.cantidad + c.cantidad / HOLGURA_BUSQUEDA + 1;
+        congelado->remapeo = malloc((c.tam_busqueda - c.cantidad) * sizeof(size_t));
+        c.inicio_balde = malloc((congelado->cantidad_baldes + 1) * sizeof(size_t));
+        c.baldes = malloc(congelado->cantidad_baldes * sizeof(size_t));
+        congelado->pilotos = malloc(congelado->cantidad_baldes * sizeof(uint32_t));
+        congelado->ranuras = malloc((c.cantidad ? c.cantidad : 1) * sizeof(ranura_t));
+        ok = c.inicio_balde && c.baldes && congelado->pilotos && congelado->remapeo && congelado->ranuras;
+    }
+    /* Si una semilla no alcanza (por ejemplo, dos claves con el mismo hash) se
+     * prueba otra: la semilla entra en el estado de FNV, así que cambia qué
+     * claves chocan */
+    for (i = 0; ok && i < MAX_SEMILLAS; i++) {
+        semilla = hash_mezclar64(semilla + i + 1);
+        if (construir_con_semilla(congelado, &c, semilla))
+            break;
+    }
+    ok = ok && i < MAX_SEMILLAS;
+    if (ok) {
+        remapear(congelado, &c);
+        for (i = 0; i < c.cantidad; i++) {
+            ranura_t *ranura = congelado_ranura(congelado, c.hashes[i]);
+            ranura->dato = datos[i];
+            ranura->clave = (size_t) (c.claves[i] - congelado->claves);
+        }
+    }
+    construccion_destruir(&c);
+    free(datos);
+    if (!ok && congelado) {
+        hash_congelado_destruir(congelado);
+        return NULL;
+    }
+    return congelado;
+}
+
+void *hash_congelado_obtener(const hash_congelado_t *congelado, const char *clave) {
+    const ranura_t *ranura = congelado_buscar(congelado, clave);
+    return (ranura ? ranura->dato : NULL);
+}
+
+bool hash_congelado_pertenece(const hash_congelado_t *congelado, const char *clave) {
+    return congelado_buscar(congelado, clave) != NULL;
+}
+
+size_t hash_congelado_cantidad(const hash_congelado_t *congelado) {
+    return congelado->cantidad;
+}
+
+void hash_congelado_destruir(hash_congelado_t *congelado) {
+    free(congelado->pilotos);
+    free(congelado->remapeo);
+    free(congelado->ranuras);
+    free(congelado->claves);
+    free(congelado);
+}
@@ -0,0 +1,47 @@
+#ifndef HASH_CONGELADO_H
+#define HASH_CONGELADO_H
+
+#include "hash.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+/* Tabla de hash inmutable para cargas de solo lectura.
+ *
+ * Se construye a partir de un hash con una función de hash perfecta mínima
+ * (esquema CHD/PTHash: cada balde de claves busca un piloto que las ubique en
+ * posiciones libres), así cada clave tiene una posición propia en un arreglo
+ * de exactamente hash_cantidad(hash) lugares. Las claves se copian contiguas
+ * en un único bloque y obtener hace un hash, lee el piloto del balde y la
+ * ranura, y compara una sola clave.
+ */
+
+typedef struct hash_congelado hash_congelado_t;
+
+/* Crea una tabla inmutable con los pares vigentes del hash. Los datos se
+ * comparten con el hash original, que sigue siendo su dueño.
+ * Pre: La estructura hash fue inicializada
+ * Pos: devuelve la tabla congelada, o NULL si falló.
+ */
+hash_congelado_t *hash_congelar(const hash_t *hash);
+
+/* Obtiene el valor de la clave, o NULL si no está.
+ * Pre: la tabla fue congelada
+ */
+void *hash_congelado_obtener(const hash_congelado_t *congelado, const char *clave);
+
+/* Determina si la clave pertenece a la tabla.
+ * Pre: la tabla fue congelada
+ */
+bool hash_congelado_pertenece(const hash_congelado_t *congelado, const char *clave);
+
+/* Devuelve la cantidad de claves.
+ * Pre: la tabla fue congelada
+ */
+size_t hash_congelado_cantidad(const hash_congelado_t *congelado);
+
+/* Destruye la tabla, sin destruir los datos.
+ * Pre: la tabla fue congelada
+ */
+void hash_congelado_destruir(hash_congelado_t *congelado);
+
+#endif // HASH_CONGELADO_H
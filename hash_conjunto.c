@@ -0,0 +1,174 @@
+#include "hash_conjunto.h"
+#include "hash_tipado.h"
+#include <string.h>
+
+HASH_DEFINIR_CONJUNTO(tabla_claves, hash_tipado_cadena_t, hash_tipado_hash_guardado, hash_tipado_igual_guardado)
+
+/* Definiciones de estructuras del conjunto */
+
+struct hash_conjunto {
+    tabla_claves_t *claves;
+};
+
+/* Funciones auxiliares */
+
+/* Agrega la clave, que ya trae su hash, copiando la cadena si no estaba */
+static bool agregar_clave(hash_conjunto_t *conjunto, hash_tipado_cadena_t clave) {
+    tabla_claves_t *tabla = conjunto->claves;
+    bool nueva;
+    size_t pos = tabla_claves_ubicar_(tabla, clave, &nueva), tam;
+    char *copia;
+
+    if (pos == tabla->capacidad)
+        return false;
+    if (!nueva)
+        return true;
+    tam = strlen(clave.cadena) + 1;
+    copia = alocador_reservar(&tabla->alocador, tam);
+    if (!copia) {
+        tabla_claves_quitar_(tabla, pos);
+        return false;
+    }
+    memcpy(copia, clave.cadena, tam);
+    tabla->pares[pos].clave.cadena = copia;
+    return true;
+}
+
+static void liberar_clave(const tabla_claves_t *tabla, hash_tipado_cadena_t clave) {
+    alocador_liberar(&tabla->alocador, (char *) clave.cadena, strlen(clave.cadena) + 1);
+}
+
+/* Crea un conjunto con el alocador de a y lugar para cantidad claves */
+static hash_conjunto_t *conjunto_para(const hash_conjunto_t *a, size_t cantidad) {
+    hash_conjunto_t *resultado = hash_conjunto_crear_con_alocador(&a->claves->alocador);
+    if (resultado && !tabla_claves_asegurar(resultado->claves, cantidad)) {
+        hash_conjunto_destruir(resultado);
+        return NULL;
+    }
+    return resultado;
+}
+
+/* Agrega al resultado las claves de origen que están (o no están, según
+ * esta) en otro. Con otro NULL agrega todas. */
+static bool agregar_filtradas(hash_conjunto_t *resultado, const tabla_claves_t *origen,
+                              const tabla_claves_t *otro, bool esta) {
+    for (size_t i = 0; i < origen->capacidad; i++) {
+        if (!origen->ocupados[i])
+            continue;
+        if (otro && tabla_claves_pertenece(otro, origen->pares[i].clave) != esta)
+            continue;
+        if (!agregar_clave(resultado, origen->pares[i].clave))
+            return false;
+    }
+    return true;
+}
+
+/**************************************
+ **     Primitivas del conjunto      **
+ **************************************/
+
+hash_conjunto_t *hash_conjunto_crear(void) {
+    return hash_conjunto_crear_con_alocador(alocador_estandar());
+}
+
+hash_conjunto_t *hash_conjunto_crear_con_alocador(const alocador_t *alocador) {
+    hash_conjunto_t *conjunto = alocador_reservar(alocador, sizeof(*conjunto));
+    if (!conjunto)
+        return NULL;
+    conjunto->claves = tabla_claves_crear_con_alocador(alocador);
+    if (!conjunto->claves) {
+        alocador_liberar(alocador, conjunto, sizeof(*conjunto));
+        return NULL;
+    }
+    return conjunto;
+}
+
+bool hash_conjunto_guardar(hash_conjunto_t *conjunto, const char *clave) {
+    if (!clave) return false; // Debe recibir una clave válida
+    return agregar_clave(conjunto, hash_tipado_cadena_crear(clave));
+}
+
+bool hash_conjunto_borrar(hash_conjunto_t *conjunto, const char *clave) {
+    tabla_claves_t *tabla = conjunto->claves;
+    size_t pos;
+
+    if (!clave)
+        return false;
+    pos = tabla_claves_buscar_(tabla, hash_tipado_cadena_crear(clave));
+    if (!tabla->ocupados[pos])
+        return false;
+    liberar_clave(tabla, tabla->pares[pos].clave);
+    tabla_claves_quitar_(tabla, pos);
+    return true;
+}
+
+bool hash_conjunto_pertenece(const hash_conjunto_t *conjunto, const char *clave) {
+    return (clave && tabla_claves_pertenece(conjunto->claves, hash_tipado_cadena_crear(clave)));
+}
+
+size_t hash_conjunto_cantidad(const hash_conjunto_t *conjunto) {
+    return tabla_claves_cantidad(conjunto->claves);
+}
+
+void hash_conjunto_iterar(const hash_conjunto_t *conjunto, bool (*visitar)(const char *clave, void *extra),
+                          void *extra) {
+    const tabla_claves_t *tabla = conjunto->claves;
+    for (size_t i = 0; i < tabla->capacidad; i++) {
+        if (tabla->ocupados[i] && !visitar(tabla->pares[i].clave.cadena, extra))
+            return;
+    }
+}
+
+hash_conjunto_t *hash_conjunto_union(const hash_conjunto_t *a, const hash_conjunto_t *b) {
+    hash_conjunto_t *resultado = conjunto_para(a, a->claves->cantidad + b->claves->cantidad);
+    if (!resultado)
+        return NULL;
+    if (!agregar_filtradas(resultado, a->claves, NULL, true) ||
+        !agregar_filtradas(resultado, b->claves, NULL, true)) {
+        hash_conjunto_destruir(resultado);
+        return NULL;
+    }
+    return resultado;
+}
+
+hash_conjunto_t *hash_conjunto_interseccion(const hash_conjunto_t *a, const hash_conjunto_t *b) {
+    /* Se recorre el más chico y se busca en el otro */
+    const tabla_claves_t *menor = a->claves, *mayor = b->claves;
+    hash_conjunto_t *resultado;
+
+    if (menor->cantidad > mayor->cantidad) {
+        menor = b->claves;
+        mayor = a->claves;
+    }
+    resultado = conjunto_para(a, menor->cantidad);
+    if (!resultado)
+        return NULL;
+    if (!agregar_filtradas(resultado, menor, mayor, true)) {
+        hash_conjunto_destruir(resultado);
+        return NULL;
+    }
+    return resultado;
+}
+
+hash_conjunto_t *hash_conjunto_diferencia(const hash_conjunto_t *a, const hash_conjunto_t *b) {
+    hash_conjunto_t *resultado = conjunto_para(a, a->claves->cantidad);
+    if (!resultado)
+        return NULL;
+    if (!agregar_filtradas(resultado, a->claves, b->claves, false)) {
+        hash_conjunto_destruir(resultado);
+        return NULL;
+    }
+    return resultado;
+}
+
+void hash_conjunto_destruir(hash_conjunto_t *conjunto) {
+    tabla_claves_t *tabla = conjunto->claves;
+    alocador_t alocador = tabla->alocador;
+
+    for (size_t i = 0; i < tabla->capacidad; i++) {
+        if (tabla->ocupados[i])
+            liberar_clave(tabla, tabla->pares[i].clave);
+    }
+    tabla_claves_destruir(tabla);
+    alocador_liberar(&alocador, conjunto, sizeof(*conjunto));
+}
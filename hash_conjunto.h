@@ -0,0 +1,92 @@
+#ifndef HASH_CONJUNTO_H
+#define HASH_CONJUNTO_H
+
+#include "alocador.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+/* Conjunto de cadenas.
+ *
+ * Es una instancia de HASH_DEFINIR_CONJUNTO (hash_tipado.h): cada ranura
+ * guarda solo la clave, sin lugar para un dato, así que pesa lo mismo que un
+ * puntero y su hash. La clave se copia al guardarla y su hash queda guardado
+ * con ella, así agrandar la tabla no vuelve a recorrer las cadenas.
+ *
+ * La unión, la intersección y la diferencia crean un conjunto nuevo. El
+ * resultado se pide de una vez con el tamaño máximo que puede tener y cada
+ * clave pasa al resultado con el hash que ya tenía, así cada elemento se
+ * busca una sola vez en cada conjunto y ninguna cadena se vuelve a hashear.
+ */
+
+typedef struct hash_conjunto hash_conjunto_t;
+
+/* Crea el conjunto
+ * Pos: devuelve un conjunto vacío, o NULL si falló.
+ */
+hash_conjunto_t *hash_conjunto_crear(void);
+
+/* Crea un conjunto que pide toda su memoria (la tabla y las claves) al
+ * alocador, que se copia. Su contexto debe vivir al menos tanto como el
+ * conjunto.
+ * Pos: devuelve un conjunto vacío, o NULL si falló.
+ */
+hash_conjunto_t *hash_conjunto_crear_con_alocador(const alocador_t *alocador);
+
+/* Agrega la clave al conjunto; si ya estaba no hace nada. De no poder
+ * guardarla devuelve false.
+ * Pre: el conjunto fue creado
+ * Post: la clave pertenece al conjunto
+ */
+bool hash_conjunto_guardar(hash_conjunto_t *conjunto, const char *clave);
+
+/* Saca la clave del conjunto. Devuelve false si no estaba.
+ * Pre: el conjunto fue creado
+ * Post: la clave no pertenece al conjunto
+ */
+bool hash_conjunto_borrar(hash_conjunto_t *conjunto, const char *clave);
+
+/* Determina si la clave pertenece o no al conjunto.
+ * Pre: el conjunto fue creado
+ */
+bool hash_conjunto_pertenece(const hash_conjunto_t *conjunto, const char *clave);
+
+/* Devuelve la cantidad de claves del conjunto.
+ * Pre: el conjunto fue creado
+ */
+size_t hash_conjunto_cantidad(const hash_conjunto_t *conjunto);
+
+/* Llama a visitar con cada clave del conjunto, en ningún orden en particular,
+ * hasta que devuelva false. No se debe modificar el conjunto mientras tanto.
+ * Pre: el conjunto fue creado
+ */
+void hash_conjunto_iterar(const hash_conjunto_t *conjunto, bool (*visitar)(const char *clave, void *extra),
+                          void *extra);
+
+/* Devuelve un conjunto nuevo con las claves que están en a o en b, que pide
+ * su memoria al alocador de a.
+ * Pre: a y b fueron creados
+ * Pos: devuelve la unión, o NULL si falló.
+ */
+hash_conjunto_t *hash_conjunto_union(const hash_conjunto_t *a, const hash_conjunto_t *b);
+
+/* Devuelve un conjunto nuevo con las claves que están en a y en b, que pide
+ * su memoria al alocador de a.
+ * Pre: a y b fueron creados
+ * Pos: devuelve la intersección, o NULL si falló.
+ */
+hash_conjunto_t *hash_conjunto_interseccion(const hash_conjunto_t *a, const hash_conjunto_t *b);
+
+/* Devuelve un conjunto nuevo con las claves de a que no están en b, que pide
+ * su memoria al alocador de a.
+ * Pre: a y b fueron creados
+ * Pos: devuelve la diferencia, o NULL si falló.
+ */
+hash_conjunto_t *hash_conjunto_diferencia(const hash_conjunto_t *a, const hash_conjunto_t *b);
+
+/* Destruye el conjunto liberando sus claves.
+ * Pre: el conjunto fue creado
+ * Post: el conjunto fue destruido
+ */
+void hash_conjunto_destruir(hash_conjunto_t *conjunto);
+
+#endif // HASH_CONJUNTO_H
@@ -0,0 +1,466 @@
+#include "hash_cuckoo.h"
+#include "hash_funciones.h"
+#include <stdint.h>
+#include <string.h>
+#define CELDAS 4                // Celdas por balde, un balde ocupa una línea de cache
+#define TAM_LINEA 64
+#define BALDES_INICIALES 4
+#define DESBORDE 8              // Claves que pueden quedar fuera de sus dos baldes
+#define MAX_DESALOJOS 500
+/* Ocupación máxima de las celdas: 9/10 */
+#define CARGA_MAX_NUM 9
+#define CARGA_MAX_DEN 10
+/* Se achica cuando queda menos de 1/8 ocupado */
+#define CARGA_MIN_DEN 8
+/* Multiplicador impar que lleva la etiqueta a un desplazamiento entre baldes */
+#define MEZCLA_ETIQUETA 0x5bd1e995u
+
+/* Definiciones de estructuras de la tabla de hash */
+
+typedef struct celda {
+    char *clave;
+    void *dato;
+} celda_t;
+
+typedef struct balde {
+    celda_t celdas[CELDAS];
+} balde_t;
+
+/* Un par con lo necesario para ubicarlo sin volver a hashear su clave */
+typedef struct entrada {
+    char *clave;
+    void *dato;
+    uint8_t etiqueta;
+    size_t balde;       // Uno de sus dos baldes
+} entrada_t;
+
+/* Los arreglos de la tabla, aparte del hash para poder armar una nueva al redimensionar */
+typedef struct tabla {
+    uint8_t *etiquetas;     // Una por celda, 0 si la celda está libre
+    balde_t *baldes;        // Alineados a TAM_LINEA dentro de memoria
+    void *memoria;
+    size_t cant_baldes;     // Potencia de 2
+    entrada_t desborde[DESBORDE];
+    size_t cant_desborde;
+} tabla_t;
+
+struct hash_cuckoo {
+    tabla_t tabla;
+    size_t cantidad;        // Incluye las claves del desborde
+    uint32_t azar;          // Estado del generador que elige qué celda desalojar
+    hash_destruir_dato_t destruir_dato;
+    alocador_t alocador;
+    size_t bytes;           // Bytes pedidos al alocador que siguen en uso
+};
+
+/* La posición recorre las celdas de todos los baldes y después el desborde */
+struct hash_cuckoo_iter {
+    const hash_cuckoo_t *hash;
+    size_t pos;
+};
+
+/* Funciones auxiliares */
+
+static void *cuckoo_reservar(hash_cuckoo_t *hash, size_t tam) {
+    void *bloque = alocador_reservar(&hash->alocador, tam);
+    if (bloque)
+        hash->bytes += tam;
+    return bloque;
+}
+
+static void cuckoo_liberar(hash_cuckoo_t *hash, void *bloque, size_t tam) {
+    alocador_liberar(&hash->alocador, bloque, tam);
+    hash->bytes -= tam;
+}
+
+static uint64_t cuckoo_hash(const char *clave) {
+    return hash_mezclar64(hash_fnv1a(clave, strlen(clave)));
+}
+
+/* Los 8 bits altos del hash son la etiqueta, que nunca es 0 */
+static uint8_t cuckoo_etiqueta(uint64_t valor) {
+    uint8_t etiqueta = (uint8_t) (valor >> 56);
+    return (etiqueta ? etiqueta : 1);
+}
+
+static size_t primer_balde(const tabla_t *tabla, uint64_t valor) {
+    return (size_t) valor & (tabla->cant_baldes - 1);
+}
+
+/* El otro balde de una clave; aplicarlo dos veces devuelve el balde original */
+static size_t balde_alternativo(const tabla_t *tabla, size_t balde, uint8_t etiqueta) {
+    return (balde ^ (etiqueta * (size_t) MEZCLA_ETIQUETA)) & (tabla->cant_baldes - 1);
+}
+
+static size_t celdas_tabla(const tabla_t *tabla) {
+    return tabla->cant_baldes * CELDAS;
+}
+
+/* Devuelve una celda libre del balde, o CELDAS si está lleno */
+static size_t celda_libre(const tabla_t *tabla, size_t balde) {
+    const uint8_t *etiquetas = tabla->etiquetas + balde * CELDAS;
+    size_t i = 0;
+    while (i < CELDAS && etiquetas[i])
+        i++;
+    return i;
+}
+
+static void tabla_ocupar(tabla_t *tabla, size_t balde, size_t i, const entrada_t *entrada) {
+    tabla->etiquetas[balde * CELDAS + i] = entrada->etiqueta;
+    tabla->baldes[balde].celdas[i].clave = entrada->clave;
+    tabla->baldes[balde].celdas[i].dato = entrada->dato;
+}
+
+/* Generador xorshift, alcanza para que los desalojos no entren en ciclos */
+static uint32_t siguiente_azar(uint32_t *azar) {
+    *azar ^= *azar << 13;
+    *azar ^= *azar >> 17;
+    *azar ^= *azar << 5;
+    return *azar;
+}
+
+/* Pone la entrada en una celda libre de alguno de sus dos baldes. Si los dos
+ * están llenos desaloja a una clave al azar y sigue con ella en su otro
+ * balde; si después de MAX_DESALOJOS queda una clave sin lugar (puede no ser
+ * la original), va al desborde. Devuelve false si el desborde estaba lleno, y
+ * en ese caso la clave sin lugar queda en entrada */
+static bool tabla_colocar(tabla_t *tabla, entrada_t *entrada, uint32_t *azar) {
+    size_t balde = entrada->balde, i, desalojos;
+    size_t otro = balde_alternativo(tabla, balde, entrada->etiqueta);
+    entrada_t desalojada;
+
+    if ((i = celda_libre(tabla, balde)) < CELDAS || (i = celda_libre(tabla, balde = otro)) < CELDAS) {
+        tabla_ocupar(tabla, balde, i, entrada);
+        return true;
+    }
+    for (desalojos = 0; desalojos < MAX_DESALOJOS; desalojos++) {
+        i = siguiente_azar(azar) % CELDAS;
+        desalojada.clave = tabla->baldes[balde].celdas[i].clave;
+        desalojada.dato = tabla->baldes[balde].celdas[i].dato;
+        desalojada.etiqueta = tabla->etiquetas[balde * CELDAS + i];
+        tabla_ocupar(tabla, balde, i, entrada);
+        /* La desalojada sigue en su otro balde */
+        *entrada = desalojada;
+        balde = balde_alternativo(tabla, balde, entrada->etiqueta);
+        entrada->balde = balde;
+        if ((i = celda_libre(tabla, balde)) < CELDAS) {
+            tabla_ocupar(tabla, balde, i, entrada);
+            return true;
+        }
+    }
+    if (tabla->cant_desborde == DESBORDE)
+        return false;
+    tabla->desborde[tabla->cant_desborde++] = *entrada;
+    return true;
+}
+
+/* Busca la clave, cuyo hash es valor. Devuelve true si la encuentra y deja en
+ * pos su posición, con la numeración del iterador */
+static bool tabla_buscar(const tabla_t *tabla, const char *clave, uint64_t valor, size_t *pos) {
+    uint8_t etiqueta = cuckoo_etiqueta(valor);
+    size_t baldes[2], i, b;
+
+    baldes[0] = primer_balde(tabla, valor);
+    baldes[1] = balde_alternativo(tabla, baldes[0], etiqueta);
+    for (b = 0; b < 2; b++) {
+        for (i = 0; i < CELDAS; i++) {
+            if (tabla->etiquetas[baldes[b] * CELDAS + i] == etiqueta &&
+                !strcmp(tabla->baldes[baldes[b]].celdas[i].clave, clave)) {
+                *pos = baldes[b] * CELDAS + i;
+                return true;
+            }
+        }
+    }
+    for (i = 0; i < tabla->cant_desborde; i++) {
+        if (tabla->desborde[i].etiqueta == etiqueta && !strcmp(tabla->desborde[i].clave, clave)) {
+            *pos = celdas_tabla(tabla) + i;
+            return true;
+        }
+    }
+    return false;
+}
+
+/* Devuelve la celda de la posición, que está ocupada, o la del desborde */
+static celda_t *tabla_celda(const tabla_t *tabla, size_t pos, celda_t *copia) {
+    const entrada_t *entrada;
+    if (pos < celdas_tabla(tabla))
+        return &tabla->baldes[pos / CELDAS].celdas[pos % CELDAS];
+    entrada = &tabla->desborde[pos - celdas_tabla(tabla)];
+    copia->clave = entrada->clave;
+    copia->dato = entrada->dato;
+    return copia;
+}
+
+static bool posicion_ocupada(const tabla_t *tabla, size_t pos) {
+    if (pos < celdas_tabla(tabla))
+        return tabla->etiquetas[pos] != 0;
+    return pos - celdas_tabla(tabla) < tabla->cant_desborde;
+}
+
+/* Devuelve la primera posición ocupada desde pos, o el total si no hay */
+static size_t buscar_ocupada(const tabla_t *tabla, size_t pos) {
+    size_t total = celdas_tabla(tabla) + tabla->cant_desborde;
+    while (pos < total && !posicion_ocupada(tabla, pos))
+        pos++;
+    return pos;
+}
+
+/* Devuelve a sus baldes las claves del desborde que tienen lugar, sin desalojar a otras */
+static void vaciar_desborde(tabla_t *tabla) {
+    size_t i = 0, celda, balde;
+    entrada_t *entrada;
+
+    while (i < tabla->cant_desborde) {
+        entrada = &tabla->desborde[i];
+        balde = entrada->balde;
+        if ((celda = celda_libre(tabla, balde)) == CELDAS) {
+            balde = balde_alternativo(tabla, balde, entrada->etiqueta);
+            celda = celda_libre(tabla, balde);
+        }
+        if (celda == CELDAS) {
+            i++;
+            continue;
+        }
+        tabla_ocupar(tabla, balde, celda, entrada);
+        tabla->desborde[i] = tabla->desborde[--(tabla->cant_desborde)];
+    }
+}
+
+/* Pide los arreglos de una tabla vacía de cant_baldes baldes */
+static bool tabla_crear(hash_cuckoo_t *hash, tabla_t *tabla, size_t cant_baldes) {
+    tabla->cant_baldes = cant_baldes;
+    tabla->cant_desborde = 0;
+    tabla->etiquetas = cuckoo_reservar(hash, cant_baldes * CELDAS * sizeof(uint8_t));
+    if (!tabla->etiquetas)
+        return false;
+    tabla->memoria = cuckoo_reservar(hash, cant_baldes * sizeof(balde_t) + TAM_LINEA - 1);
+    if (!tabla->memoria) {
+        cuckoo_liberar(hash, tabla->etiquetas, cant_baldes * CELDAS * sizeof(uint8_t));
+        return false;
+    }
+    memset(tabla->etiquetas, 0, cant_baldes * CELDAS * sizeof(uint8_t));
+    tabla->baldes = (balde_t *) (((uintptr_t) tabla->memoria + TAM_LINEA - 1) & ~(uintptr_t) (TAM_LINEA - 1));
+    return true;
+}
+
+static void tabla_liberar(hash_cuckoo_t *hash, tabla_t *tabla) {
+    cuckoo_liberar(hash, tabla->etiquetas, tabla->cant_baldes * CELDAS * sizeof(uint8_t));
+    cuckoo_liberar(hash, tabla->memoria, tabla->cant_baldes * sizeof(balde_t) + TAM_LINEA - 1);
+}
+
+/* Menor cantidad de baldes en la que entran cantidad claves ocupando a lo
+ * sumo la mitad de la carga máxima, así la tabla nueva tiene margen para crecer */
+static size_t baldes_para(size_t cantidad) {
+    size_t cant_baldes = BALDES_INICIALES;
+    while (cantidad * 2 * CARGA_MAX_DEN > cant_baldes * CELDAS * CARGA_MAX_NUM)
+        cant_baldes *= 2;
+    return cant_baldes;
+}
+
+/* Reubica todas las claves en una tabla de al menos cant_baldes baldes. Si
+ * el desborde de la nueva se llena, aunque entren todas, se vuelve a probar
+ * con el doble: la próxima clave que se guarde tiene que tener lugar. Las
+ * claves no se copian. Si no hay memoria la tabla queda como estaba */
+static bool cuckoo_redimensionar(hash_cuckoo_t *hash, size_t cant_baldes) {
+    tabla_t *vieja = &hash->tabla, nueva;
+    entrada_t entrada;
+    celda_t copia, *celda;
+    uint64_t valor;
+    size_t pos;
+    bool ok = false;
+
+    while (!ok) {
+        if (!tabla_crear(hash, &nueva, cant_baldes))
+            return false;
+        ok = true;
+        for (pos = buscar_ocupada(vieja, 0); ok && pos < celdas_tabla(vieja) + vieja->cant_desborde;
+             pos = buscar_ocupada(vieja, pos + 1)) {
+            celda = tabla_celda(vieja, pos, &copia);
+            entrada.clave = celda->clave;
+            entrada.dato = celda->dato;
+            valor = cuckoo_hash(celda->clave);
+            entrada.etiqueta = cuckoo_etiqueta(valor);
+            entrada.balde = primer_balde(&nueva, valor);
+            ok = tabla_colocar(&nueva, &entrada, &hash->azar);
+        }
+        ok = ok && nueva.cant_desborde < DESBORDE;
+        if (!ok) {
+            tabla_liberar(hash, &nueva);
+            cant_baldes *= 2;
+        }
+    }
+    tabla_liberar(hash, vieja);
+    hash->tabla = nueva;
+    return true;
+}
+
+static bool debe_agrandar(const hash_cuckoo_t *hash) {
+    return ((hash->cantidad + 1) * CARGA_MAX_DEN > celdas_tabla(&hash->tabla) * CARGA_MAX_NUM ||
+            hash->tabla.cant_desborde == DESBORDE);
+}
+
+static bool debe_achicar(const hash_cuckoo_t *hash) {
+    return (hash->tabla.cant_baldes > BALDES_INICIALES && hash->cantidad * CARGA_MIN_DEN < celdas_tabla(&hash->tabla));
+}
+
+/**************************************
+ **  Primitivas de la Tabla de hash  **
+ **************************************/
+
+hash_cuckoo_t *hash_cuckoo_crear(hash_destruir_dato_t destruir_dato) {
+    return hash_cuckoo_crear_con_alocador(destruir_dato, alocador_estandar());
+}
+
+hash_cuckoo_t *hash_cuckoo_crear_con_alocador(hash_destruir_dato_t destruir_dato, const alocador_t *alocador) {
+    hash_cuckoo_t *nuevo = alocador_reservar(alocador, sizeof(*nuevo));
+    if (!nuevo)
+        return NULL;
+    nuevo->alocador = *alocador;
+    nuevo->bytes = sizeof(*nuevo);
+    if (!tabla_crear(nuevo, &nuevo->tabla, BALDES_INICIALES)) {
+        alocador_liberar(alocador, nuevo, sizeof(*nuevo));
+        return NULL;
+    }
+    nuevo->cantidad = 0;
+    nuevo->azar = 2463534242u;
+    nuevo->destruir_dato = destruir_dato;
+    return nuevo;
+}
+
+bool hash_cuckoo_guardar(hash_cuckoo_t *hash, const char *clave, void *dato) {
+    if (!clave) return false; // Debe recibir una clave válida
+    uint64_t valor = cuckoo_hash(clave);
+    celda_t copia, *celda;
+    entrada_t entrada;
+    size_t pos, largo;
+
+    /* Si la clave ya está solo se reemplaza el dato */
+    if (tabla_buscar(&hash->tabla, clave, valor, &pos)) {
+        celda = tabla_celda(&hash->tabla, pos, &copia);
+        if (hash->destruir_dato)
+            hash->destruir_dato(celda->dato);
+        if (pos < celdas_tabla(&hash->tabla))
+            celda->dato = dato;
+        else
+            hash->tabla.desborde[pos - celdas_tabla(&hash->tabla)].dato = dato;
+        return true;
+    }
+    /* Con el desborde con lugar, colocar una clave no puede fallar */
+    if (debe_agrandar(hash) && !cuckoo_redimensionar(hash, hash->tabla.cant_baldes * 2))
+        return false;
+    largo = strlen(clave) + 1;
+    entrada.clave = cuckoo_reservar(hash, largo * sizeof(char));
+    if (!entrada.clave)
+        return false;
+    memcpy(entrada.clave, clave, largo);
+    entrada.dato = dato;
+    entrada.etiqueta = cuckoo_etiqueta(valor);
+    entrada.balde = primer_balde(&hash->tabla, valor);
+    tabla_colocar(&hash->tabla, &entrada, &hash->azar);
+    hash->cantidad++;
+    return true;
+}
+
+void *hash_cuckoo_borrar(hash_cuckoo_t *hash, const char *clave) {
+    tabla_t *tabla = &hash->tabla;
+    celda_t copia, *celda;
+    size_t pos;
+    void *dato;
+
+    if (!clave || !tabla_buscar(tabla, clave, cuckoo_hash(clave), &pos))
+        return NULL;
+    celda = tabla_celda(tabla, pos, &copia);
+    dato = celda->dato;
+    cuckoo_liberar(hash, celda->clave, strlen(celda->clave) + 1);
+    if (pos < celdas_tabla(tabla))
+        tabla->etiquetas[pos] = 0;
+    else
+        tabla->desborde[pos - celdas_tabla(tabla)] = tabla->desborde[--(tabla->cant_desborde)];
+    hash->cantidad--;
+    /* La celda liberada puede recibir una clave del desborde */
+    if (tabla->cant_desborde)
+        vaciar_desborde(tabla);
+    if (debe_achicar(hash))
+        cuckoo_redimensionar(hash, baldes_para(hash->cantidad));
+    return dato;
+}
+
+void *hash_cuckoo_obtener(const hash_cuckoo_t *hash, const char *clave) {
+    celda_t copia;
+    size_t pos;
+    if (!clave || !tabla_buscar(&hash->tabla, clave, cuckoo_hash(clave), &pos))
+        return NULL;
+    return tabla_celda(&hash->tabla, pos, &copia)->dato;
+}
+
+bool hash_cuckoo_pertenece(const hash_cuckoo_t *hash, const char *clave) {
+    size_t pos;
+    return (clave && tabla_buscar(&hash->tabla, clave, cuckoo_hash(clave), &pos));
+}
+
+size_t hash_cuckoo_cantidad(const hash_cuckoo_t *hash) {
+    return hash->cantidad;
+}
+
+double hash_cuckoo_carga(const hash_cuckoo_t *hash) {
+    return (double) (hash->cantidad - hash->tabla.cant_desborde) / (double) celdas_tabla(&hash->tabla);
+}
+
+size_t hash_cuckoo_memoria(const hash_cuckoo_t *hash) {
+    return hash->bytes;
+}
+
+void hash_cuckoo_destruir(hash_cuckoo_t *hash) {
+    alocador_t alocador = hash->alocador;
+    tabla_t *tabla = &hash->tabla;
+    celda_t copia, *celda;
+    size_t pos;
+
+    for (pos = buscar_ocupada(tabla, 0); pos < celdas_tabla(tabla) + tabla->cant_desborde;
+         pos = buscar_ocupada(tabla, pos + 1)) {
+        celda = tabla_celda(tabla, pos, &copia);
+        if (hash->destruir_dato)
+            hash->destruir_dato(celda->dato);
+        alocador_liberar(&alocador, celda->clave, strlen(celda->clave) + 1);
+    }
+    tabla_liberar(hash, tabla);
+    alocador_liberar(&alocador, hash, sizeof(*hash));
+}
+
+/****************************************
+ **  Primitivas del Iterador del hash  **
+ ****************************************/
+
+hash_cuckoo_iter_t *hash_cuckoo_iter_crear(const hash_cuckoo_t *hash) {
+    hash_cuckoo_iter_t *iter = alocador_reservar(&hash->alocador, sizeof(*iter));
+    if (!iter)
+        return NULL;
+    iter->hash = hash;
+    iter->pos = buscar_ocupada(&hash->tabla, 0);
+    return iter;
+}
+
+bool hash_cuckoo_iter_avanzar(hash_cuckoo_iter_t *iter) {
+    if (hash_cuckoo_iter_al_final(iter))
+        return false;
+    iter->pos = buscar_ocupada(&iter->hash->tabla, iter->pos + 1);
+    return true;
+}
+
+const char *hash_cuckoo_iter_ver_actual(const hash_cuckoo_iter_t *iter) {
+    celda_t copia;
+    return (hash_cuckoo_iter_al_final(iter) ? NULL : tabla_celda(&iter->hash->tabla, iter->pos, &copia)->clave);
+}
+
+void *hash_cuckoo_iter_ver_dato(const hash_cuckoo_iter_t *iter) {
+    celda_t copia;
+    return (hash_cuckoo_iter_al_final(iter) ? NULL : tabla_celda(&iter->hash->tabla, iter->pos, &copia)->dato);
+}
+
+bool hash_cuckoo_iter_al_final(const hash_cuckoo_iter_t *iter) {
+    return (iter->pos == celdas_tabla(&iter->hash->tabla) + iter->hash->tabla.cant_desborde);
+}
+
+void hash_cuckoo_iter_destruir(hash_cuckoo_iter_t *iter) {
+    alocador_liberar(&iter->hash->alocador, iter, sizeof(*iter));
+}
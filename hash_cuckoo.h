@@ -0,0 +1,112 @@
+#ifndef HASH_CUCKOO_H
+#define HASH_CUCKOO_H
+
+#include "alocador.h"
+#include "hash.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+/* Tabla de hash cuckoo por baldes.
+ *
+ * Cada clave puede estar en solo dos baldes de 4 celdas (cada balde ocupa una
+ * línea de cache), o en un desborde chico para las que no entraron. Buscar
+ * mira a lo sumo esos dos baldes y el desborde, así el peor caso es O(1) sin
+ * importar la carga. Por cada celda se guarda además una etiqueta de 8 bits
+ * del hash en un arreglo aparte y denso: solo se compara la clave de las
+ * celdas cuya etiqueta coincide, y el segundo balde se calcula a partir del
+ * primero y la etiqueta, así mover una clave no necesita volver a hashearla.
+ *
+ * Guardar una clave cuyos dos baldes están llenos desaloja a otra hacia su
+ * balde alternativo, y así sucesivamente hasta un límite de desalojos. La
+ * tabla se agranda al superar 9/10 de ocupación o al llenarse el desborde.
+ *
+ * Las primitivas son las mismas que las de hash.h, sin TTL ni cache. Las
+ * claves se mueven entre celdas al guardar y borrar, así que un iterador no
+ * sobrevive a guardar ni a borrar.
+ */
+
+typedef struct hash_cuckoo hash_cuckoo_t;
+typedef struct hash_cuckoo_iter hash_cuckoo_iter_t;
+
+/* Crea el hash
+ * Pos: devuelve un puntero a una tabla de hash, o NULL si falló.
+ */
+hash_cuckoo_t *hash_cuckoo_crear(hash_destruir_dato_t destruir_dato);
+
+/* Crea un hash que pide toda su memoria (la tabla, las claves y los
+ * iteradores) al alocador, que se copia. Su contexto debe vivir al menos
+ * tanto como el hash.
+ * Pos: devuelve un puntero a una tabla de hash, o NULL si falló.
+ */
+hash_cuckoo_t *hash_cuckoo_crear_con_alocador(hash_destruir_dato_t destruir_dato, const alocador_t *alocador);
+
+/* Guarda un elemento en el hash, si la clave ya se encuentra en la
+ * estructura, reemplaza su dato. De no poder guardarlo devuelve false.
+ * Pre: La estructura hash fue inicializada
+ * Post: Se almacenó el par (clave, dato)
+ */
+bool hash_cuckoo_guardar(hash_cuckoo_t *hash, const char *clave, void *dato);
+
+/* Borra un elemento del hash y devuelve el dato asociado. Devuelve
+ * NULL si el dato no estaba.
+ * Pre: La estructura hash fue inicializada
+ * Post: El elemento fue borrado de la estructura y se lo devolvió,
+ * en el caso de que estuviera guardado.
+ */
+void *hash_cuckoo_borrar(hash_cuckoo_t *hash, const char *clave);
+
+/* Obtiene el valor de un elemento del hash, si la clave no se encuentra
+ * devuelve NULL.
+ * Pre: La estructura hash fue inicializada
+ */
+void *hash_cuckoo_obtener(const hash_cuckoo_t *hash, const char *clave);
+
+/* Determina si clave pertenece o no al hash.
+ * Pre: La estructura hash fue inicializada
+ */
+bool hash_cuckoo_pertenece(const hash_cuckoo_t *hash, const char *clave);
+
+/* Devuelve la cantidad de elementos del hash.
+ * Pre: La estructura hash fue inicializada
+ */
+size_t hash_cuckoo_cantidad(const hash_cuckoo_t *hash);
+
+/* Devuelve la fracción de celdas ocupadas, sin contar el desborde.
+ * Pre: La estructura hash fue inicializada
+ */
+double hash_cuckoo_carga(const hash_cuckoo_t *hash);
+
+/* Devuelve los bytes que el hash tiene pedidos a su alocador, incluyendo su
+ * propia estructura y sin contar los datos ni los iteradores.
+ * Pre: La estructura hash fue inicializada
+ */
+size_t hash_cuckoo_memoria(const hash_cuckoo_t *hash);
+
+/* Destruye la estructura liberando la memoria pedida y llamando a la función
+ * destruir para cada par (clave, dato).
+ * Pre: La estructura hash fue inicializada
+ * Post: La estructura hash fue destruida
+ */
+void hash_cuckoo_destruir(hash_cuckoo_t *hash);
+
+/* Iterador del hash, en el orden de las celdas y después el desborde */
+
+// Crea iterador
+hash_cuckoo_iter_t *hash_cuckoo_iter_crear(const hash_cuckoo_t *hash);
+
+// Avanza iterador
+bool hash_cuckoo_iter_avanzar(hash_cuckoo_iter_t *iter);
+
+// Devuelve clave actual, esa clave no se puede modificar ni liberar.
+const char *hash_cuckoo_iter_ver_actual(const hash_cuckoo_iter_t *iter);
+
+// Devuelve el dato de la clave actual, o NULL si el iterador está al final.
+void *hash_cuckoo_iter_ver_dato(const hash_cuckoo_iter_t *iter);
+
+// Comprueba si terminó la iteración
+bool hash_cuckoo_iter_al_final(const hash_cuckoo_iter_t *iter);
+
+// Destruye iterador
+void hash_cuckoo_iter_destruir(hash_cuckoo_iter_t *iter);
+
+#endif // HASH_CUCKOO_H
@@ -0,0 +1,404 @@
+#define _POSIX_C_SOURCE 200809L
+#include "hash_diario.h"
+#include "hash_funciones.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+#define DIARIO_SUFIJO_INSTANTANEA ".snap"
+#define LOTE_INICIAL 4096
+#define LOTE_MAXIMO (64 * 1024)    // Al pasar de acá el lote se escribe aunque no se haya confirmado
+
+/* Definiciones del formato del diario: una sucesión de registros, cada uno
+ * con esta cabecera seguida de la clave (sin '\0') y el dato serializado. Los
+ * enteros están en el orden de bytes de la máquina. */
+
+typedef enum {
+    REGISTRO_GUARDAR = 1,
+    REGISTRO_BORRAR = 2
+} tipo_registro_t;
+
+typedef struct registro {
+    uint32_t crc;              // CRC-32 del resto de la cabecera, la clave y el dato
+    uint32_t tipo;
+    uint32_t largo_clave;
+    uint32_t largo_dato;
+} registro_t;
+
+struct hash_diario {
+    hash_t *hash;
+    hash_serializar_dato_t serializar_dato;
+    hash_destruir_dato_t destruir_dato;
+    hash_diario_sincronizar_t sincronizar;
+    int fd;
+    char *ruta_instantanea;
+    unsigned char *lote;       // Registros todavía sin escribir
+    size_t largo_lote;
+    size_t capacidad_lote;
+    size_t tam_archivo;        // Bytes ya escritos en el diario
+    size_t compactar_desde;
+    bool fallo;                // Falló escribir un lote que despachó una operación
+};
+
+/* Funciones auxiliares */
+
+static bool asegurar_lote(hash_diario_t *diario, size_t largo) {
+    size_t capacidad = diario->capacidad_lote;
+    unsigned char *lote;
+
+    if (largo <= capacidad)
+        return true;
+    while (capacidad < largo)
+        capacidad *= 2;
+    lote = realloc(diario->lote, capacidad);
+    if (!lote)
+        return false;
+    diario->lote = lote;
+    diario->capacidad_lote = capacidad;
+    return true;
+}
+
+/* Agrega un registro al final del lote. Devuelve false si no pudo
+ * serializar el dato o pedir memoria, y entonces el lote no cambia */
+static bool agregar_registro(hash_diario_t *diario, tipo_registro_t tipo, const char *clave, const void *dato) {
+    size_t inicio = diario->largo_lote, largo_clave = strlen(clave), largo_dato = 0, disponible;
+    size_t comienzo_dato = inicio + sizeof(registro_t) + largo_clave;
+    registro_t registro;
+
+    if (largo_clave > UINT32_MAX || !asegurar_lote(diario, comienzo_dato))
+        return false;
+    if (tipo == REGISTRO_GUARDAR && diario->serializar_dato) {
+        disponible = diario->capacidad_lote - comienzo_dato;
+        largo_dato = diario->serializar_dato(dato, diario->lote + comienzo_dato, disponible);
+        if (largo_dato > disponible &&
+            (!asegurar_lote(diario, comienzo_dato + largo_dato) ||
+             diario->serializar_dato(dato, diario->lote + comienzo_dato, largo_dato) != largo_dato))
+            return false;
+        if (largo_dato > UINT32_MAX)
+            return false;
+    }
+    memcpy(diario->lote + inicio + sizeof(registro_t), clave, largo_clave);
+    registro.crc = 0;
+    registro.tipo = tipo;
+    registro.largo_clave = (uint32_t) largo_clave;
+    registro.largo_dato = (uint32_t) largo_dato;
+    memcpy(diario->lote + inicio, &registro, sizeof(registro));
+    registro.crc = hash_crc32(0, diario->lote + inicio + sizeof(uint32_t),
+                              sizeof(registro_t) - sizeof(uint32_t) + largo_clave + largo_dato);
+    memcpy(diario->lote + inicio, &registro.crc, sizeof(uint32_t));
+    diario->largo_lote = comienzo_dato + largo_dato;
+    return true;
+}
+
+/* Escribe el lote completo con un solo write (o varios si el sistema escribe
+ * menos). Si falla a la mitad corta el diario donde estaba, así no queda un
+ * registro a medias antes de los que se escriban después */
+static bool escribir_lote(hash_diario_t *diario) {
+    size_t escrito = 0;
+    ssize_t resultado;
+
+    while (escrito < diario->largo_lote) {
+        resultado = write(diario->fd, diario->lote + escrito, diario->largo_lote - escrito);
+        if (resultado < 0 && errno == EINTR)
+            continue;
+        if (resultado <= 0) {
+            /* Si tampoco se puede cortar, al recuperarlo se descarta desde el
+             * registro a medias en adelante */
+            ftruncate(diario->fd, (off_t) diario->tam_archivo);
+            return false;
+        }
+        escrito += (size_t) resultado;
+    }
+    diario->tam_archivo += diario->largo_lote;
+    diario->largo_lote = 0;
+    return true;
+}
+
+/* Escribe el lote y, salvo con HASH_DIARIO_SINCRONIZAR_NUNCA, lo sincroniza.
+ * Si falla al escribirlo, el lote queda pendiente para el próximo intento */
+static bool escribir_y_sincronizar(hash_diario_t *diario) {
+    if (!diario->largo_lote)
+        return true;
+    if (!escribir_lote(diario))
+        return false;
+    if (diario->sincronizar != HASH_DIARIO_SINCRONIZAR_NUNCA && fsync(diario->fd))
+        return false;
+    if (diario->compactar_desde && diario->tam_archivo > diario->compactar_desde)
+        hash_diario_compactar(diario);
+    return true;
+}
+
+/* Escribe el lote si corresponde según la política y su tamaño. La operación
+ * ya está aplicada, así que un error no la deshace: queda anotado para el
+ * próximo hash_diario_confirmar */
+static void despachar(hash_diario_t *diario) {
+    if (diario->sincronizar != HASH_DIARIO_SINCRONIZAR_SIEMPRE && diario->largo_lote < LOTE_MAXIMO)
+        return;
+    if (!escribir_y_sincronizar(diario))
+        diario->fallo = true;
+}
+
+/* Aplica un registro válido al hash. Devuelve false si no pudo guardar */
+static bool aplicar_registro(hash_diario_t *diario, const registro_t *registro, const char *clave,
+                             const unsigned char *bytes_dato, hash_deserializar_dato_t deserializar_dato) {
+    void *dato;
+
+    if (registro->tipo == REGISTRO_BORRAR) {
+        dato = hash_borrar(diario->hash, clave);
+        if (dato && diario->destruir_dato)
+            diario->destruir_dato(dato);
+        return true;
+    }
+    dato = (deserializar_dato ? deserializar_dato(bytes_dato, registro->largo_dato) : NULL);
+    if (!hash_guardar(diario->hash, clave, dato)) {
+        if (dato && diario->destruir_dato)
+            diario->destruir_dato(dato);
+        return false;
+    }
+    return true;
+}
+
+/* Repite sobre el hash los registros válidos de los tam bytes del diario y
+ * guarda en *valido hasta dónde llegan. Devuelve false si falló al aplicar
+ * un registro válido */
+static bool repetir(hash_diario_t *diario, const unsigned char *bytes, size_t tam, size_t *valido,
+                    hash_deserializar_dato_t deserializar_dato) {
+    size_t pos = 0, largo, capacidad = 0;
+    char *clave = NULL, *nueva;
+    registro_t registro;
+    bool ok = true;
+
+    while (ok && tam - pos >= sizeof(registro_t)) {
+        memcpy(&registro, bytes + pos, sizeof(registro));
+        largo = (size_t) registro.largo_clave + registro.largo_dato;
+        /* Un registro incompleto o que no coincide con su CRC es el final */
+        if ((registro.tipo != REGISTRO_GUARDAR && registro.tipo != REGISTRO_BORRAR) ||
+            largo > tam - pos - sizeof(registro_t) ||
+            registro.crc != hash_crc32(0, bytes + pos + sizeof(uint32_t), sizeof(registro_t) - sizeof(uint32_t) + largo))
+            break;
+        if (registro.largo_clave >= capacidad) {
+            nueva = realloc(clave, (size_t) registro.largo_clave + 1);
+            if (!nueva) {
+                ok = false;
+                break;
+            }
+            clave = nueva;
+            capacidad = (size_t) registro.largo_clave + 1;
+        }
+        memcpy(clave, bytes + pos + sizeof(registro_t), registro.largo_clave);
+        clave[registro.largo_clave] = '\0';
+        ok = aplicar_registro(diario, &registro, clave, bytes + pos + sizeof(registro_t) + registro.largo_clave,
+                              deserializar_dato);
+        if (ok)
+            pos += sizeof(registro_t) + largo;
+    }
+    free(clave);
+    *valido = pos;
+    return ok;
+}
+
+/* Lee el diario de la ruta y lo repite sobre el hash. Lo mapea con mmap y,
+ * si no puede, lo lee entero a memoria */
+static bool recuperar(hash_diario_t *diario, const char *ruta, size_t *valido,
+                      hash_deserializar_dato_t deserializar_dato) {
+    int fd = open(ruta, O_RDONLY);
+    struct stat estado;
+    unsigned char *bytes;
+    size_t tam, leido = 0;
+    ssize_t resultado;
+    bool ok;
+
+    *valido = 0;
+    if (fd < 0)
+        return errno == ENOENT;
+    if (fstat(fd, &estado)) {
+        close(fd);
+        return false;
+    }
+    tam = (size_t) estado.st_size;
+    if (!tam) {
+        close(fd);
+        return true;
+    }
+    bytes = mmap(NULL, tam, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (bytes != MAP_FAILED) {
+        close(fd);
+        ok = repetir(diario, bytes, tam, valido, deserializar_dato);
+        munmap(bytes, tam);
+        return ok;
+    }
+    bytes = malloc(tam);
+    ok = (bytes != NULL);
+    while (ok && leido < tam) {
+        resultado = read(fd, bytes + leido, tam - leido);
+        if (resultado < 0 && errno == EINTR)
+            continue;
+        ok = resultado > 0;
+        if (ok)
+            leido += (size_t) resultado;
+    }
+    close(fd);
+    ok = ok && repetir(diario, bytes, tam, valido, deserializar_dato);
+    free(bytes);
+    return ok;
+}
+
+/* Carga la instantánea si existe; si no, crea un hash vacío. Una instantánea
+ * que existe pero no se puede cargar es un error, no un hash vacío */
+static hash_t *cargar_instantanea(const char *ruta, hash_deserializar_dato_t deserializar_dato,
+                                  hash_destruir_dato_t destruir_dato) {
+    struct stat estado;
+    if (stat(ruta, &estado))
+        return (errno == ENOENT ? hash_crear(destruir_dato) : NULL);
+    return hash_cargar_archivo(ruta, deserializar_dato, destruir_dato);
+}
+
+/* Sincroniza el directorio que contiene la ruta, para que sean durables la
+ * creación o el renombre de un archivo en él y no solo su contenido */
+static bool sincronizar_directorio(const char *ruta) {
+    const char *barra = strrchr(ruta, '/');
+    size_t largo = (barra ? (size_t) (barra - ruta) : 0);
+    char *directorio = malloc(largo + 2);
+    int fd;
+    bool ok;
+
+    if (!directorio)
+        return false;
+    if (!barra)
+        strcpy(directorio, ".");
+    else if (!largo)
+        strcpy(directorio, "/");
+    else {
+        memcpy(directorio, ruta, largo);
+        directorio[largo] = '\0';
+    }
+    fd = open(directorio, O_RDONLY);
+    free(directorio);
+    if (fd < 0)
+        return false;
+    ok = !fsync(fd);
+    close(fd);
+    return ok;
+}
+
+/* Primitivas del diario */
+
+hash_diario_t *hash_diario_abrir(const char *ruta, hash_serializar_dato_t serializar_dato,
+                                 hash_deserializar_dato_t deserializar_dato, hash_destruir_dato_t destruir_dato,
+                                 hash_diario_sincronizar_t sincronizar) {
+    hash_diario_t *diario = calloc(1, sizeof(*diario));
+    size_t valido = 0;
+    struct stat estado;
+    bool ok, nuevo;
+
+    if (!diario)
+        return NULL;
+    diario->serializar_dato = serializar_dato;
+    diario->destruir_dato = destruir_dato;
+    diario->sincronizar = sincronizar;
+    diario->ruta_instantanea = malloc(strlen(ruta) + sizeof(DIARIO_SUFIJO_INSTANTANEA));
+    diario->lote = malloc(LOTE_INICIAL);
+    diario->capacidad_lote = LOTE_INICIAL;
+    ok = diario->ruta_instantanea && diario->lote;
+    if (ok) {
+        strcpy(diario->ruta_instantanea, ruta);
+        strcat(diario->ruta_instantanea, DIARIO_SUFIJO_INSTANTANEA);
+        diario->hash = cargar_instantanea(diario->ruta_instantanea, deserializar_dato, destruir_dato);
+        ok = diario->hash && recuperar(diario, ruta, &valido, deserializar_dato);
+    }
+    /* Se descarta lo que haya después del último registro válido, así lo que
+     * se agregue ahora queda a continuación de él. Si el diario se crea recién
+     * ahora, también se sincroniza su directorio: si no, tras un corte de luz
+     * el archivo podría no existir aunque se hayan sincronizado registros */
+    nuevo = ok && stat(ruta, &estado) && errno == ENOENT;
+    diario->fd = (ok ? open(ruta, O_WRONLY | O_CREAT | O_APPEND, 0644) : -1);
+    if (diario->fd < 0 || ftruncate(diario->fd, (off_t) valido) || (nuevo && !sincronizar_directorio(ruta))) {
+        if (diario->fd >= 0)
+            close(diario->fd);
+        if (diario->hash)
+            hash_destruir(diario->hash);
+        free(diario->ruta_instantanea);
+        free(diario->lote);
+        free(diario);
+        return NULL;
+    }
+    diario->tam_archivo = valido;
+    return diario;
+}
+
+hash_t *hash_diario_hash(const hash_diario_t *diario) {
+    return diario->hash;
+}
+
+bool hash_diario_guardar(hash_diario_t *diario, const char *clave, void *dato) {
+    size_t largo_anterior = diario->largo_lote;
+
+    if (!clave || !agregar_registro(diario, REGISTRO_GUARDAR, clave, dato))
+        return false;
+    if (!hash_guardar(diario->hash, clave, dato)) {
+        diario->largo_lote = largo_anterior;
+        return false;
+    }
+    despachar(diario);
+    return true;
+}
+
+void *hash_diario_borrar(hash_diario_t *diario, const char *clave) {
+    void *dato;
+
+    /* Borrar una clave que no está no cambia nada y no se registra */
+    if (!clave || !hash_pertenece(diario->hash, clave) || !agregar_registro(diario, REGISTRO_BORRAR, clave, NULL))
+        return NULL;
+    dato = hash_borrar(diario->hash, clave);
+    despachar(diario);
+    return dato;
+}
+
+bool hash_diario_confirmar(hash_diario_t *diario) {
+    bool ok = escribir_y_sincronizar(diario) && !diario->fallo;
+    diario->fallo = false;
+    return ok;
+}
+
+bool hash_diario_compactar(hash_diario_t *diario) {
+    if (diario->largo_lote && !escribir_lote(diario))
+        return false;
+    /* Si se corta entre la instantánea y vaciar el diario, al recuperar se
+     * repiten registros que la instantánea ya tiene: el resultado es el mismo,
+     * porque cada registro deja su clave en un estado que no depende del
+     * anterior */
+    if (!hash_guardar_archivo(diario->hash, diario->ruta_instantanea, diario->serializar_dato))
+        return false;
+    /* El diario se vacía recién cuando el renombre de la instantánea es
+     * durable; si no, tras un corte de luz podría quedar la instantánea
+     * anterior con el diario vacío */
+    if (!sincronizar_directorio(diario->ruta_instantanea))
+        return false;
+    if (ftruncate(diario->fd, 0) || fsync(diario->fd))
+        return false;
+    diario->tam_archivo = 0;
+    return true;
+}
+
+void hash_diario_compactar_desde(hash_diario_t *diario, size_t bytes) {
+    diario->compactar_desde = bytes;
+}
+
+size_t hash_diario_bytes(const hash_diario_t *diario) {
+    return diario->tam_archivo + diario->largo_lote;
+}
+
+void hash_diario_cerrar(hash_diario_t *diario) {
+    if (diario->largo_lote && escribir_lote(diario))
+        fsync(diario->fd);
+    close(diario->fd);
+    hash_destruir(diario->hash);
+    free(diario->ruta_instantanea);
+    free(diario->lote);
+    free(diario);
+}
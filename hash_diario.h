@@ -0,0 +1,96 @@
+#ifndef HASH_DIARIO_H
+#define HASH_DIARIO_H
+
+#include "hash.h"
+#include "hash_archivo.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+/* Envoltorio de un hash que lo hace durable con un diario de escritura.
+ *
+ * Cada guardar y borrar agrega al final del archivo del diario un registro
+ * con la operación, la clave y el dato serializado, protegido con un CRC-32.
+ * Al abrir, el hash se recupera cargando la última instantánea (en el formato
+ * de hash_archivo.h) y repitiendo encima los registros del diario, que se lee
+ * con mmap. Si el proceso murió a mitad de una escritura, el diario termina
+ * en un registro incompleto o con un CRC que no coincide: se repite hasta el
+ * último registro válido y se corta ahí.
+ *
+ * Los registros se juntan en un lote en memoria y se escriben con un solo
+ * write (y un solo fsync, según la política), así muchas operaciones pagan
+ * una escritura al disco. Compactar escribe una instantánea nueva y vacía el
+ * diario, para que no crezca sin límite ni haya que repetirlo entero.
+ *
+ * La instantánea está en la ruta del diario con el sufijo ".snap".
+ */
+
+typedef struct hash_diario hash_diario_t;
+
+typedef enum {
+    HASH_DIARIO_SINCRONIZAR_SIEMPRE,   // Cada operación se escribe y se sincroniza antes de volver
+    HASH_DIARIO_SINCRONIZAR_POR_LOTE,  // Cada lote se escribe y se sincroniza junto, al llenarse o al confirmar
+    HASH_DIARIO_SINCRONIZAR_NUNCA      // Cada lote se escribe, y el sistema decide cuándo llega al disco
+} hash_diario_sincronizar_t;
+
+/* Abre el diario de la ruta, creándolo si no existe, y recupera el hash a
+ * partir de la instantánea y el diario. Los datos se escriben con
+ * serializar_dato y se recuperan con deserializar_dato (ver hash_archivo.h);
+ * si alguno es NULL, se guardan o se recuperan solo las claves.
+ * Pos: devuelve el diario, con un hash que libera sus datos con
+ * destruir_dato, o NULL si falló.
+ */
+hash_diario_t *hash_diario_abrir(const char *ruta, hash_serializar_dato_t serializar_dato,
+                                 hash_deserializar_dato_t deserializar_dato, hash_destruir_dato_t destruir_dato,
+                                 hash_diario_sincronizar_t sincronizar);
+
+/* Devuelve el hash del diario, para consultarlo. Modificarlo directamente
+ * no queda en el diario.
+ * Pre: el diario fue abierto
+ */
+hash_t *hash_diario_hash(const hash_diario_t *diario);
+
+/* Primitivas equivalentes a hash_guardar y hash_borrar que además agregan la
+ * operación al diario. Como en hash.h, guardar devuelve false si la clave es
+ * NULL, o si no pudo serializar el dato o modificar el hash; entonces ni el
+ * hash ni el diario cambian y el dato sigue siendo del llamador. Si después
+ * falla escribir o sincronizar el lote, la operación igual queda aplicada y
+ * en el lote: el error lo informa el próximo hash_diario_confirmar.
+ * Pre: el diario fue abierto
+ */
+bool hash_diario_guardar(hash_diario_t *diario, const char *clave, void *dato);
+void *hash_diario_borrar(hash_diario_t *diario, const char *clave);
+
+/* Escribe el lote pendiente y, salvo con HASH_DIARIO_SINCRONIZAR_NUNCA, lo
+ * sincroniza. Devuelve false si falló, o si falló escribir o sincronizar un
+ * lote que despachó una operación desde el confirmar anterior.
+ * Pre: el diario fue abierto
+ * Post: las operaciones anteriores son durables
+ */
+bool hash_diario_confirmar(hash_diario_t *diario);
+
+/* Escribe una instantánea del hash de forma atómica y vacía el diario.
+ * Devuelve false si falló; el diario sigue siendo válido igual.
+ * Pre: el diario fue abierto
+ */
+bool hash_diario_compactar(hash_diario_t *diario);
+
+/* Hace que el diario se compacte solo cada vez que, al escribir un lote,
+ * supera bytes bytes. Con 0 (el valor inicial) solo se compacta llamando a
+ * hash_diario_compactar.
+ * Pre: el diario fue abierto
+ */
+void hash_diario_compactar_desde(hash_diario_t *diario, size_t bytes);
+
+/* Devuelve los bytes del diario, incluyendo los del lote sin escribir.
+ * Pre: el diario fue abierto
+ */
+size_t hash_diario_bytes(const hash_diario_t *diario);
+
+/* Confirma el lote pendiente, cierra el diario y destruye el hash llamando a
+ * destruir_dato para cada dato.
+ * Pre: el diario fue abierto
+ * Post: el diario fue cerrado
+ */
+void hash_diario_cerrar(hash_diario_t *diario);
+
+#endif // HASH_DIARIO_H
@@ -0,0 +1,43 @@
+#include "hash_funciones.h"
+#define FNV_BASE 14695981039346656037u
+#define FNV_PRIMO 1099511628211u
+#define CRC32_POLINOMIO 0xEDB88320u
+
+uint64_t hash_fnv1a(const void *bytes, size_t largo) {
+    return hash_fnv1a_semilla(bytes, largo, 0);
+}
+
+uint64_t hash_fnv1a_semilla(const void *bytes, size_t largo, uint64_t semilla) {
+    const unsigned char *actual = bytes;
+    uint64_t hashval = FNV_BASE ^ semilla;
+    size_t i;
+
+    for (i = 0; i < largo; i++) {
+        hashval ^= actual[i];
+        hashval *= FNV_PRIMO;
+    }
+    return hashval;
+}
+
+uint64_t hash_mezclar64(uint64_t x) {
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdu;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53u;
+    x ^= x >> 33;
+    return x;
+}
+
+uint32_t hash_crc32(uint32_t crc, const void *bytes, size_t largo) {
+    const unsigned char *actual = bytes;
+    size_t i;
+    int bit;
+
+    crc = ~crc;
+    for (i = 0; i < largo; i++) {
+        crc ^= actual[i];
+        for (bit = 0; bit < 8; bit++)
+            crc = (crc >> 1) ^ (CRC32_POLINOMIO & (0u - (crc & 1u)));
+    }
+    return ~crc;
+}
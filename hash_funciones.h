@@ -0,0 +1,28 @@
+#ifndef HASH_FUNCIONES_H
+#define HASH_FUNCIONES_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Funciones de hash y de verificación compartidas por las distintas tablas */
+
+/* Devuelve el hash FNV-1a de 64 bits de los largo bytes apuntados por bytes */
+uint64_t hash_fnv1a(const void *bytes, size_t largo);
+
+/* Como hash_fnv1a, pero con la semilla mezclada en el estado inicial: claves
+ * que chocan con una semilla en general no chocan con otra. Con semilla 0 es
+ * igual a hash_fnv1a.
+ */
+uint64_t hash_fnv1a_semilla(const void *bytes, size_t largo, uint64_t semilla);
+
+/* Mezcla los bits de x para que cada bit de entrada afecte a todos los de
+ * salida (finalizador de MurmurHash3). Es una biyección.
+ */
+uint64_t hash_mezclar64(uint64_t x);
+
+/* Devuelve el CRC-32 (polinomio de IEEE 802.3) de los largo bytes apuntados
+ * por bytes. crc es el valor parcial de un cálculo anterior, o 0 al empezar.
+ */
+uint32_t hash_crc32(uint32_t crc, const void *bytes, size_t largo);
+
+#endif // HASH_FUNCIONES_H
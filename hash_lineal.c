@@ -0,0 +1,506 @@
+#include "hash_lineal.h"
+#include "hash_funciones.h"
+#include <stdint.h>
+#include <string.h>
+#define SEGMENTO 512            // Baldes por segmento, potencia de 2
+#define BALDES_INICIALES 8      // Potencia de 2, no más que SEGMENTO
+#define DIRECTORIO_INICIAL 8
+/* Se parte un balde al pasar de 2 claves por balde */
+#define CARGA_MAX 2
+/* Se juntan baldes al bajar de 1 clave cada 2 baldes, de a lo sumo
+ * JUNTAR_POR_BORRADO por vez para que la tabla alcance a la cantidad */
+#define CARGA_MIN_DEN 2
+#define JUNTAR_POR_BORRADO 2
+
+/* Definiciones de estructuras de la tabla de hash */
+
+/* Los nodos y los segmentos se comparten entre un hash y sus clones. ref
+ * cuenta los punteros que llegan a cada uno (de los baldes, de otros nodos,
+ * de los directorios y de las copias que usan su dato); con más de uno no se
+ * modifican, y el que quiere cambiarlos trabaja sobre una copia. */
+
+/* La clave va en el mismo bloque que el nodo */
+typedef struct nodo nodo_t;
+struct nodo {
+    nodo_t *sig;
+    nodo_t *dueno;      // Nodo del que se copió el dato, que lo destruye; NULL si es este
+    size_t ref;
+    uint64_t valor;     // Hash de la clave
+    void *dato;
+    bool entregado;     // Borrar entregó el dato, ya no lo destruye el hash
+    char clave[];
+};
+
+typedef struct segmento {
+    size_t ref;
+    nodo_t *baldes[SEGMENTO];
+} segmento_t;
+
+/* Lo compartido por un hash y sus clones */
+typedef struct familia {
+    size_t hashes;
+    size_t bytes;           // Bytes pedidos al alocador que siguen en uso
+} familia_t;
+
+struct hash_lineal {
+    segmento_t **segmentos; // Directorio de segmentos de baldes
+    size_t cap_segmentos;   // Entradas del directorio
+    size_t cant_segmentos;  // Segmentos en uso, los primeros del directorio
+    size_t tam_nivel;       // Baldes al empezar la vuelta, potencia de 2
+    size_t siguiente;       // Próximo balde a partir, menor que tam_nivel
+    size_t cantidad;
+    hash_destruir_dato_t destruir_dato;
+    alocador_t alocador;
+    familia_t *familia;
+};
+
+struct hash_lineal_iter {
+    const hash_lineal_t *hash;
+    size_t balde;
+    nodo_t *actual;         // NULL al final
+};
+
+/* Funciones auxiliares */
+
+static void *lineal_reservar(hash_lineal_t *hash, size_t tam) {
+    void *bloque = alocador_reservar(&hash->alocador, tam);
+    if (bloque)
+        hash->familia->bytes += tam;
+    return bloque;
+}
+
+static void *lineal_reservar_ceros(hash_lineal_t *hash, size_t tam) {
+    void *bloque = alocador_reservar_ceros(&hash->alocador, tam);
+    if (bloque)
+        hash->familia->bytes += tam;
+    return bloque;
+}
+
+static void lineal_liberar(hash_lineal_t *hash, void *bloque, size_t tam) {
+    alocador_liberar(&hash->alocador, bloque, tam);
+    hash->familia->bytes -= tam;
+}
+
+static uint64_t lineal_hash(const char *clave) {
+    return hash_mezclar64(hash_fnv1a(clave, strlen(clave)));
+}
+
+static size_t bytes_nodo(const nodo_t *nodo) {
+    return sizeof(*nodo) + strlen(nodo->clave) + 1;
+}
+
+static size_t cant_baldes(const hash_lineal_t *hash) {
+    return hash->tam_nivel + hash->siguiente;
+}
+
+/* Balde para leer, puede estar compartido */
+static nodo_t **balde(const hash_lineal_t *hash, size_t indice) {
+    return &hash->segmentos[indice / SEGMENTO]->baldes[indice % SEGMENTO];
+}
+
+/* Los baldes anteriores a siguiente ya se partieron en esta vuelta, y
+ * para ellos cuenta un bit más del hash */
+static size_t indice_de(const hash_lineal_t *hash, uint64_t valor) {
+    size_t indice = (size_t) valor & (hash->tam_nivel - 1);
+    if (indice < hash->siguiente)
+        indice = (size_t) valor & (2 * hash->tam_nivel - 1);
+    return indice;
+}
+
+/* Devuelve el enlace que apunta al nodo de la clave, o el enlace vacío del
+ * final de su balde si no está */
+static nodo_t **buscar_enlace(const hash_lineal_t *hash, const char *clave, uint64_t valor) {
+    nodo_t **enlace = balde(hash, indice_de(hash, valor));
+    while (*enlace && ((*enlace)->valor != valor || strcmp((*enlace)->clave, clave)))
+        enlace = &(*enlace)->sig;
+    return enlace;
+}
+
+/* Suelta una referencia al nodo. Los que quedan sin referencias se liberan,
+ * junto con su dato o la referencia a su dueño, y sueltan al siguiente */
+static void soltar_nodos(hash_lineal_t *hash, nodo_t *nodo) {
+    nodo_t *sig;
+    while (nodo && !--(nodo->ref)) {
+        sig = nodo->sig;
+        if (nodo->dueno)
+            soltar_nodos(hash, nodo->dueno);
+        else if (hash->destruir_dato && !nodo->entregado)
+            hash->destruir_dato(nodo->dato);
+        lineal_liberar(hash, nodo, bytes_nodo(nodo));
+        nodo = sig;
+    }
+}
+
+static void soltar_segmento(hash_lineal_t *hash, segmento_t *segmento) {
+    if (--(segmento->ref))
+        return;
+    for (size_t i = 0; i < SEGMENTO; i++)
+        soltar_nodos(hash, segmento->baldes[i]);
+    lineal_liberar(hash, segmento, sizeof(*segmento));
+}
+
+/* Copia un nodo compartido. La copia usa el dato del dueño original, que
+ * sigue vivo mientras alguna copia lo use */
+static nodo_t *copiar_nodo(hash_lineal_t *hash, nodo_t *nodo) {
+    size_t tam = bytes_nodo(nodo);
+    nodo_t *copia = lineal_reservar(hash, tam);
+    if (!copia)
+        return NULL;
+    memcpy(copia, nodo, tam);
+    copia->ref = 1;
+    copia->entregado = false;
+    if (copia->sig)
+        copia->sig->ref++;
+    if (!copia->dueno)
+        copia->dueno = nodo;
+    copia->dueno->ref++;
+    return copia;
+}
+
+/* Devuelve el balde para modificarlo, copiando antes su segmento si está
+ * compartido. Devuelve NULL si no hay memoria para la copia */
+static nodo_t **balde_propio(hash_lineal_t *hash, size_t indice) {
+    segmento_t **segmento = &hash->segmentos[indice / SEGMENTO], *copia;
+    if ((*segmento)->ref > 1) {
+        copia = lineal_reservar(hash, sizeof(*copia));
+        if (!copia)
+            return NULL;
+        memcpy(copia, *segmento, sizeof(*copia));
+        copia->ref = 1;
+        for (size_t i = 0; i < SEGMENTO; i++) {
+            if (copia->baldes[i])
+                copia->baldes[i]->ref++;
+        }
+        (*segmento)->ref--;
+        *segmento = copia;
+    }
+    return &(*segmento)->baldes[indice % SEGMENTO];
+}
+
+/* Copia los nodos compartidos de la lista que empieza en enlace, que ya es
+ * propio, para poder modificar cualquiera. Si no hay memoria la lista queda
+ * copiada en parte y devuelve false */
+static bool lista_propia(hash_lineal_t *hash, nodo_t **enlace) {
+    nodo_t *copia;
+    for (; *enlace; enlace = &(*enlace)->sig) {
+        if ((*enlace)->ref == 1)
+            continue;
+        if (!(copia = copiar_nodo(hash, *enlace)))
+            return false;
+        (*enlace)->ref--;
+        *enlace = copia;
+    }
+    return true;
+}
+
+/* Devuelve el balde con toda su lista lista para modificar, o NULL */
+static nodo_t **balde_y_lista_propios(hash_lineal_t *hash, size_t indice) {
+    nodo_t **enlace = balde_propio(hash, indice);
+    return (enlace && lista_propia(hash, enlace) ? enlace : NULL);
+}
+
+/* Se asegura de que exista el segmento del balde indice, que es el
+ * primero después de los que están en uso o uno de ellos */
+static bool asegurar_segmento(hash_lineal_t *hash, size_t indice) {
+    size_t segmento = indice / SEGMENTO, cap;
+    segmento_t **directorio;
+
+    if (segmento < hash->cant_segmentos)
+        return true;
+    if (hash->cant_segmentos == hash->cap_segmentos) {
+        cap = 2 * hash->cap_segmentos;
+        directorio = alocador_redimensionar(&hash->alocador, hash->segmentos,
+                                            hash->cap_segmentos * sizeof(segmento_t *), cap * sizeof(segmento_t *));
+        if (!directorio)
+            return false;
+        hash->familia->bytes += (cap - hash->cap_segmentos) * sizeof(segmento_t *);
+        hash->segmentos = directorio;
+        hash->cap_segmentos = cap;
+    }
+    hash->segmentos[segmento] = lineal_reservar_ceros(hash, sizeof(segmento_t));
+    if (!hash->segmentos[segmento])
+        return false;
+    hash->segmentos[segmento]->ref = 1;
+    hash->cant_segmentos++;
+    return true;
+}
+
+/* Parte el balde siguiente: las claves con el bit nuevo del hash en 1 pasan
+ * a un balde al final. Si no hay memoria no hace nada, y la tabla sigue
+ * funcionando con más carga */
+static void partir_balde(hash_lineal_t *hash) {
+    size_t nuevo = cant_baldes(hash), mascara = 2 * hash->tam_nivel - 1;
+    nodo_t **enlace, **destino, *nodo;
+
+    if (!asegurar_segmento(hash, nuevo))
+        return;
+    destino = balde_propio(hash, nuevo);
+    enlace = balde_y_lista_propios(hash, hash->siguiente);
+    if (!destino || !enlace)
+        return;
+    while ((nodo = *enlace)) {
+        if (((size_t) nodo->valor & mascara) == hash->siguiente) {
+            enlace = &nodo->sig;
+            continue;
+        }
+        *enlace = nodo->sig;
+        nodo->sig = *destino;
+        *destino = nodo;
+    }
+    if (++(hash->siguiente) == hash->tam_nivel) {
+        hash->tam_nivel *= 2;
+        hash->siguiente = 0;
+    }
+}
+
+/* Deshace la última partición: pasa las claves del último balde al balde
+ * del que salieron, y suelta su segmento si quedó vacío. Si no hay memoria
+ * para copiar lo compartido no hace nada */
+static void juntar_baldes(hash_lineal_t *hash) {
+    size_t tam_nivel = hash->tam_nivel, siguiente = hash->siguiente, ultimo;
+    nodo_t **enlace, **destino;
+
+    if (!siguiente) {
+        if (tam_nivel == BALDES_INICIALES)
+            return;
+        tam_nivel /= 2;
+        siguiente = tam_nivel;
+    }
+    siguiente--;
+    ultimo = tam_nivel + siguiente;
+    if (*balde(hash, ultimo)) {
+        destino = balde_propio(hash, siguiente);
+        enlace = balde_y_lista_propios(hash, ultimo);
+        if (!destino || !enlace)
+            return;
+        while (*enlace)
+            enlace = &(*enlace)->sig;
+        *enlace = *destino;
+        *destino = *balde(hash, ultimo);
+        *balde(hash, ultimo) = NULL;
+    }
+    hash->tam_nivel = tam_nivel;
+    hash->siguiente = siguiente;
+    if (ultimo % SEGMENTO == 0) {
+        soltar_segmento(hash, hash->segmentos[ultimo / SEGMENTO]);
+        hash->cant_segmentos--;
+    }
+}
+
+/* Devuelve el primer balde no vacío desde indice, o la cantidad de baldes si no hay */
+static size_t buscar_balde_ocupado(const hash_lineal_t *hash, size_t indice) {
+    while (indice < cant_baldes(hash) && !*balde(hash, indice))
+        indice++;
+    return indice;
+}
+
+/* Reserva un hash sin segmentos en uso, de la familia recibida */
+static hash_lineal_t *hash_lineal_armar(hash_destruir_dato_t destruir_dato, const alocador_t *alocador,
+                                        familia_t *familia, size_t cap_segmentos) {
+    hash_lineal_t *nuevo = alocador_reservar(alocador, sizeof(*nuevo));
+    if (!nuevo)
+        return NULL;
+    nuevo->alocador = *alocador;
+    nuevo->familia = familia;
+    nuevo->segmentos = lineal_reservar(nuevo, cap_segmentos * sizeof(segmento_t *));
+    if (!nuevo->segmentos) {
+        alocador_liberar(alocador, nuevo, sizeof(*nuevo));
+        return NULL;
+    }
+    familia->bytes += sizeof(*nuevo);
+    familia->hashes++;
+    nuevo->cap_segmentos = cap_segmentos;
+    nuevo->cant_segmentos = 0;
+    nuevo->destruir_dato = destruir_dato;
+    return nuevo;
+}
+
+/**************************************
+ **  Primitivas de la Tabla de hash  **
+ **************************************/
+
+hash_lineal_t *hash_lineal_crear(hash_destruir_dato_t destruir_dato) {
+    return hash_lineal_crear_con_alocador(destruir_dato, alocador_estandar());
+}
+
+hash_lineal_t *hash_lineal_crear_con_alocador(hash_destruir_dato_t destruir_dato, const alocador_t *alocador) {
+    familia_t *familia = alocador_reservar(alocador, sizeof(*familia));
+    hash_lineal_t *nuevo;
+    if (!familia)
+        return NULL;
+    familia->hashes = 0;
+    familia->bytes = sizeof(*familia);
+    nuevo = hash_lineal_armar(destruir_dato, alocador, familia, DIRECTORIO_INICIAL);
+    if (!nuevo) {
+        alocador_liberar(alocador, familia, sizeof(*familia));
+        return NULL;
+    }
+    nuevo->tam_nivel = BALDES_INICIALES;
+    nuevo->siguiente = 0;
+    nuevo->cantidad = 0;
+    if (!asegurar_segmento(nuevo, 0)) {
+        hash_lineal_destruir(nuevo);
+        return NULL;
+    }
+    return nuevo;
+}
+
+hash_lineal_t *hash_lineal_clonar(hash_lineal_t *hash) {
+    hash_lineal_t *clon = hash_lineal_armar(hash->destruir_dato, &hash->alocador, hash->familia, hash->cap_segmentos);
+    if (!clon)
+        return NULL;
+    for (size_t i = 0; i < hash->cant_segmentos; i++) {
+        clon->segmentos[i] = hash->segmentos[i];
+        clon->segmentos[i]->ref++;
+    }
+    clon->cant_segmentos = hash->cant_segmentos;
+    clon->tam_nivel = hash->tam_nivel;
+    clon->siguiente = hash->siguiente;
+    clon->cantidad = hash->cantidad;
+    return clon;
+}
+
+bool hash_lineal_guardar(hash_lineal_t *hash, const char *clave, void *dato) {
+    if (!clave) return false; // Debe recibir una clave válida
+    uint64_t valor = lineal_hash(clave);
+    size_t indice = indice_de(hash, valor), largo;
+    nodo_t **enlace, *nodo;
+
+    /* Si la clave ya está solo se reemplaza el dato. Si el dato era de otro
+     * nodo, lo destruye ese cuando nadie más lo use */
+    if (*buscar_enlace(hash, clave, valor)) {
+        if (!balde_y_lista_propios(hash, indice))
+            return false;
+        nodo = *buscar_enlace(hash, clave, valor);
+        if (nodo->dueno)
+            soltar_nodos(hash, nodo->dueno);
+        else if (hash->destruir_dato && !nodo->entregado)
+            hash->destruir_dato(nodo->dato);
+        nodo->dueno = NULL;
+        nodo->entregado = false;
+        nodo->dato = dato;
+        return true;
+    }
+    /* Las claves nuevas van al principio, así no se copia la lista */
+    if (!(enlace = balde_propio(hash, indice)))
+        return false;
+    largo = strlen(clave) + 1;
+    nodo = lineal_reservar(hash, sizeof(*nodo) + largo);
+    if (!nodo)
+        return false;
+    nodo->sig = *enlace;
+    nodo->dueno = NULL;
+    nodo->ref = 1;
+    nodo->valor = valor;
+    nodo->dato = dato;
+    nodo->entregado = false;
+    memcpy(nodo->clave, clave, largo);
+    *enlace = nodo;
+    hash->cantidad++;
+    if (hash->cantidad > CARGA_MAX * cant_baldes(hash))
+        partir_balde(hash);
+    return true;
+}
+
+void *hash_lineal_borrar(hash_lineal_t *hash, const char *clave) {
+    nodo_t **enlace, *nodo;
+    uint64_t valor;
+    void *dato;
+
+    if (!clave)
+        return NULL;
+    valor = lineal_hash(clave);
+    if (!*buscar_enlace(hash, clave, valor) || !balde_y_lista_propios(hash, indice_de(hash, valor)))
+        return NULL;
+    enlace = buscar_enlace(hash, clave, valor);
+    nodo = *enlace;
+    *enlace = nodo->sig;
+    nodo->sig = NULL;
+    dato = nodo->dato;
+    /* El dato se entrega aunque algún clon lo siga viendo */
+    (nodo->dueno ? nodo->dueno : nodo)->entregado = true;
+    soltar_nodos(hash, nodo);
+    hash->cantidad--;
+    for (int i = 0; i < JUNTAR_POR_BORRADO && hash->cantidad * CARGA_MIN_DEN < cant_baldes(hash); i++)
+        juntar_baldes(hash);
+    return dato;
+}
+
+void *hash_lineal_obtener(const hash_lineal_t *hash, const char *clave) {
+    nodo_t *nodo;
+    if (!clave)
+        return NULL;
+    nodo = *buscar_enlace(hash, clave, lineal_hash(clave));
+    return (nodo ? nodo->dato : NULL);
+}
+
+bool hash_lineal_pertenece(const hash_lineal_t *hash, const char *clave) {
+    return (clave && *buscar_enlace(hash, clave, lineal_hash(clave)));
+}
+
+size_t hash_lineal_cantidad(const hash_lineal_t *hash) {
+    return hash->cantidad;
+}
+
+size_t hash_lineal_baldes(const hash_lineal_t *hash) {
+    return cant_baldes(hash);
+}
+
+size_t hash_lineal_memoria(const hash_lineal_t *hash) {
+    return hash->familia->bytes;
+}
+
+void hash_lineal_destruir(hash_lineal_t *hash) {
+    alocador_t alocador = hash->alocador;
+    familia_t *familia = hash->familia;
+
+    for (size_t i = 0; i < hash->cant_segmentos; i++)
+        soltar_segmento(hash, hash->segmentos[i]);
+    lineal_liberar(hash, hash->segmentos, hash->cap_segmentos * sizeof(segmento_t *));
+    familia->bytes -= sizeof(*hash);
+    alocador_liberar(&alocador, hash, sizeof(*hash));
+    if (!--(familia->hashes))
+        alocador_liberar(&alocador, familia, sizeof(*familia));
+}
+
+/****************************************
+ **  Primitivas del Iterador del hash  **
+ ****************************************/
+
+hash_lineal_iter_t *hash_lineal_iter_crear(const hash_lineal_t *hash) {
+    hash_lineal_iter_t *iter = alocador_reservar(&hash->alocador, sizeof(*iter));
+    if (!iter)
+        return NULL;
+    iter->hash = hash;
+    iter->balde = buscar_balde_ocupado(hash, 0);
+    iter->actual = (iter->balde < cant_baldes(hash) ? *balde(hash, iter->balde) : NULL);
+    return iter;
+}
+
+bool hash_lineal_iter_avanzar(hash_lineal_iter_t *iter) {
+    if (hash_lineal_iter_al_final(iter))
+        return false;
+    iter->actual = iter->actual->sig;
+    if (!iter->actual) {
+        iter->balde = buscar_balde_ocupado(iter->hash, iter->balde + 1);
+        if (iter->balde < cant_baldes(iter->hash))
+            iter->actual = *balde(iter->hash, iter->balde);
+    }
+    return true;
+}
+
+const char *hash_lineal_iter_ver_actual(const hash_lineal_iter_t *iter) {
+    return (hash_lineal_iter_al_final(iter) ? NULL : iter->actual->clave);
+}
+
+void *hash_lineal_iter_ver_dato(const hash_lineal_iter_t *iter) {
+    return (hash_lineal_iter_al_final(iter) ? NULL : iter->actual->dato);
+}
+
+bool hash_lineal_iter_al_final(const hash_lineal_iter_t *iter) {
+    return (!iter->actual);
+}
+
+void hash_lineal_iter_destruir(hash_lineal_iter_t *iter) {
+    alocador_liberar(&iter->hash->alocador, iter, sizeof(*iter));
+}
@@ -0,0 +1,134 @@
+#ifndef HASH_LINEAL_H
+#define HASH_LINEAL_H
+
+#include "alocador.h"
+#include "hash.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+/* Tabla de hash con hashing lineal (Litwin, Larson).
+ *
+ * Es una tabla de baldes con listas, como la de hash.h, pero en lugar de
+ * triplicar la tabla y rehashear todas las claves de una vez crece de a un
+ * balde: cada vez que la carga pasa de 2 claves por balde se parte el balde
+ * que sigue en orden, y sus claves se reparten entre él y uno nuevo al final.
+ * Al terminar una vuelta se duplicó la cantidad de baldes sin que ninguna
+ * operación haya movido más que las claves de un balde. Al borrar se juntan
+ * los baldes de la misma forma.
+ *
+ * Los baldes están en segmentos de tamaño fijo que se piden a medida que
+ * hacen falta, así nunca se copia el arreglo de baldes ni se tiene el viejo
+ * y el nuevo a la vez: crecer solo pide un segmento y, cada tanto, agranda el
+ * directorio de segmentos, que es chico. Cada nodo guarda el hash de su
+ * clave, así partir un balde no vuelve a hashear cadenas.
+ *
+ * hash_lineal_clonar hace una copia que comparte los segmentos y los nodos
+ * con el original: cada lado copia un segmento o un nodo recién cuando va a
+ * modificarlo, así clonar cuesta un puntero por segmento y la memoria crece
+ * solo con lo que cambia después.
+ *
+ * Las primitivas son las mismas que las de hash.h, sin TTL ni cache. Los
+ * nodos se mueven entre baldes al guardar y borrar, así que un iterador no
+ * sobrevive a guardar ni a borrar.
+ */
+
+typedef struct hash_lineal hash_lineal_t;
+typedef struct hash_lineal_iter hash_lineal_iter_t;
+
+/* Crea el hash
+ * Pos: devuelve un puntero a una tabla de hash, o NULL si falló.
+ */
+hash_lineal_t *hash_lineal_crear(hash_destruir_dato_t destruir_dato);
+
+/* Crea un hash que pide toda su memoria (los segmentos, los nodos y los
+ * iteradores) al alocador, que se copia. Su contexto debe vivir al menos
+ * tanto como el hash.
+ * Pos: devuelve un puntero a una tabla de hash, o NULL si falló.
+ */
+hash_lineal_t *hash_lineal_crear_con_alocador(hash_destruir_dato_t destruir_dato, const alocador_t *alocador);
+
+/* Crea una copia del hash que comparte con él sus baldes y sus pares hasta
+ * que alguno de los dos los modifica; el costo es proporcional a la cantidad
+ * de segmentos de baldes. Los dos usan el mismo alocador y destruir_dato, y
+ * los datos también se comparten: un dato reemplazado se destruye cuando
+ * ningún hash lo ve. El dato que devuelve borrar pasa al llamador aunque un
+ * clon lo siga viendo, así que no se lo debe destruir antes que a ese clon.
+ * Mientras no se modifique ni destruya el clon, se lo puede leer e iterar
+ * desde otro hilo aunque se modifique el original; todo lo demás, incluso
+ * destruir cualquiera de los dos, es del mismo hilo.
+ * Pre: La estructura hash fue inicializada
+ * Pos: devuelve la copia, o NULL si falló.
+ */
+hash_lineal_t *hash_lineal_clonar(hash_lineal_t *hash);
+
+/* Guarda un elemento en el hash, si la clave ya se encuentra en la
+ * estructura, reemplaza su dato. De no poder guardarlo devuelve false.
+ * Pre: La estructura hash fue inicializada
+ * Post: Se almacenó el par (clave, dato)
+ */
+bool hash_lineal_guardar(hash_lineal_t *hash, const char *clave, void *dato);
+
+/* Borra un elemento del hash y devuelve el dato asociado. Devuelve
+ * NULL si el dato no estaba.
+ * Pre: La estructura hash fue inicializada
+ * Post: El elemento fue borrado de la estructura y se lo devolvió,
+ * en el caso de que estuviera guardado.
+ */
+void *hash_lineal_borrar(hash_lineal_t *hash, const char *clave);
+
+/* Obtiene el valor de un elemento del hash, si la clave no se encuentra
+ * devuelve NULL.
+ * Pre: La estructura hash fue inicializada
+ */
+void *hash_lineal_obtener(const hash_lineal_t *hash, const char *clave);
+
+/* Determina si clave pertenece o no al hash.
+ * Pre: La estructura hash fue inicializada
+ */
+bool hash_lineal_pertenece(const hash_lineal_t *hash, const char *clave);
+
+/* Devuelve la cantidad de elementos del hash.
+ * Pre: La estructura hash fue inicializada
+ */
+size_t hash_lineal_cantidad(const hash_lineal_t *hash);
+
+/* Devuelve la cantidad de baldes de la tabla, que crece de a uno.
+ * Pre: La estructura hash fue inicializada
+ */
+size_t hash_lineal_baldes(const hash_lineal_t *hash);
+
+/* Devuelve los bytes que el hash tiene pedidos a su alocador, incluyendo su
+ * propia estructura y sin contar los datos ni los iteradores. Con clones es
+ * la memoria de todos juntos, contando una vez lo compartido.
+ * Pre: La estructura hash fue inicializada
+ */
+size_t hash_lineal_memoria(const hash_lineal_t *hash);
+
+/* Destruye la estructura liberando la memoria pedida y llamando a la función
+ * destruir para cada par (clave, dato).
+ * Pre: La estructura hash fue inicializada
+ * Post: La estructura hash fue destruida
+ */
+void hash_lineal_destruir(hash_lineal_t *hash);
+
+/* Iterador del hash, en el orden de los baldes */
+
+// Crea iterador
+hash_lineal_iter_t *hash_lineal_iter_crear(const hash_lineal_t *hash);
+
+// Avanza iterador
+bool hash_lineal_iter_avanzar(hash_lineal_iter_t *iter);
+
+// Devuelve clave actual, esa clave no se puede modificar ni liberar.
+const char *hash_lineal_iter_ver_actual(const hash_lineal_iter_t *iter);
+
+// Devuelve el dato de la clave actual, o NULL si el iterador está al final.
+void *hash_lineal_iter_ver_dato(const hash_lineal_iter_t *iter);
+
+// Comprueba si terminó la iteración
+bool hash_lineal_iter_al_final(const hash_lineal_iter_t *iter);
+
+// Destruye iterador
+void hash_lineal_iter_destruir(hash_lineal_iter_t *iter);
+
+#endif // HASH_LINEAL_H
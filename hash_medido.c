@@ -0,0 +1,105 @@
+#include "hash_medido.h"
+#include "reloj.h"
+#include <stdlib.h>
+/* Latencia máxima con contador propio, 10 segundos */
+#define LATENCIA_MAXIMA 10000000000u
+#define DIGITOS_LATENCIA 3
+
+static const char *NOMBRES_OPERACION[] = { "guardar", "borrar", "obtener", "pertenece" };
+
+/* Definición de la estructura del envoltorio */
+struct hash_medido {
+    hash_t *hash;
+    histograma_t *histogramas[HASH_MEDIDO_OPERACIONES];
+    uint64_t costo_reloj;   // Lo que tarda leer el reloj dos veces seguidas
+};
+
+/* Funciones auxiliares */
+
+static void registrar(hash_medido_t *medido, hash_operacion_t operacion, uint64_t inicio) {
+    reloj_registrar(medido->histogramas[operacion], inicio, medido->costo_reloj);
+}
+
+/* Primitivas del envoltorio */
+
+hash_medido_t *hash_medido_crear(hash_t *hash) {
+    hash_medido_t *medido = calloc(1, sizeof(*medido));
+    if (!medido)
+        return NULL;
+    medido->hash = hash;
+    for (int i = 0; i < HASH_MEDIDO_OPERACIONES; i++) {
+        medido->histogramas[i] = histograma_crear(LATENCIA_MAXIMA, DIGITOS_LATENCIA);
+        if (!medido->histogramas[i]) {
+            hash_medido_destruir(medido);
+            return NULL;
+        }
+    }
+    medido->costo_reloj = reloj_calibrar();
+    return medido;
+}
+
+hash_t *hash_medido_hash(const hash_medido_t *medido) {
+    return medido->hash;
+}
+
+bool hash_medido_guardar(hash_medido_t *medido, const char *clave, void *dato) {
+    uint64_t inicio = reloj_ns();
+    bool resultado = hash_guardar(medido->hash, clave, dato);
+    registrar(medido, HASH_MEDIDO_GUARDAR, inicio);
+    return resultado;
+}
+
+void *hash_medido_borrar(hash_medido_t *medido, const char *clave) {
+    uint64_t inicio = reloj_ns();
+    void *resultado = hash_borrar(medido->hash, clave);
+    registrar(medido, HASH_MEDIDO_BORRAR, inicio);
+    return resultado;
+}
+
+void *hash_medido_obtener(hash_medido_t *medido, const char *clave) {
+    uint64_t inicio = reloj_ns();
+    void *resultado = hash_obtener(medido->hash, clave);
+    registrar(medido, HASH_MEDIDO_OBTENER, inicio);
+    return resultado;
+}
+
+bool hash_medido_pertenece(hash_medido_t *medido, const char *clave) {
+    uint64_t inicio = reloj_ns();
+    bool resultado = hash_pertenece(medido->hash, clave);
+    registrar(medido, HASH_MEDIDO_PERTENECE, inicio);
+    return resultado;
+}
+
+const histograma_t *hash_medido_histograma(const hash_medido_t *medido, hash_operacion_t operacion) {
+    return medido->histogramas[operacion];
+}
+
+void hash_medido_reiniciar(hash_medido_t *medido) {
+    for (int i = 0; i < HASH_MEDIDO_OPERACIONES; i++)
+        histograma_reiniciar(medido->histogramas[i]);
+}
+
+void hash_medido_imprimir(const hash_medido_t *medido, FILE *archivo) {
+    const histograma_t *histograma;
+
+    fprintf(archivo, "operacion,cantidad,media_ns,p50_ns,p99_ns,p999_ns,max_ns\n");
+    for (int i = 0; i < HASH_MEDIDO_OPERACIONES; i++) {
+        histograma = medido->histogramas[i];
+        if (!histograma_cantidad(histograma))
+            continue;
+        fprintf(archivo, "%s,%llu,%.1f,%llu,%llu,%llu,%llu\n", NOMBRES_OPERACION[i],
+                (unsigned long long) histograma_cantidad(histograma), histograma_media(histograma),
+                (unsigned long long) histograma_percentil(histograma, 50),
+                (unsigned long long) histograma_percentil(histograma, 99),
+                (unsigned long long) histograma_percentil(histograma, 99.9),
+                (unsigned long long) histograma_maximo(histograma));
+    }
+}
+
+void hash_medido_destruir(hash_medido_t *medido) {
+    for (int i = 0; i < HASH_MEDIDO_OPERACIONES; i++) {
+        if (medido->histogramas[i])
+            histograma_destruir(medido->histogramas[i]);
+    }
+    free(medido);
+}
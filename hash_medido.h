@@ -0,0 +1,69 @@
+#ifndef HASH_MEDIDO_H
+#define HASH_MEDIDO_H
+
+#include "hash.h"
+#include "histograma.h"
+#include <stdbool.h>
+#include <stdio.h>
+
+/* Envoltorio de un hash que mide la latencia de cada operación.
+ *
+ * Las primitivas llaman a las de hash.h midiendo el tiempo con el reloj
+ * monotónico (descontando el costo de leer el reloj) y registran cada
+ * latencia, en nanosegundos, en un histograma por tipo de operación. Así se
+ * ven las colas que el promedio esconde, como el hash_guardar que dispara
+ * una redimensión.
+ */
+
+typedef struct hash_medido hash_medido_t;
+
+typedef enum {
+    HASH_MEDIDO_GUARDAR,
+    HASH_MEDIDO_BORRAR,
+    HASH_MEDIDO_OBTENER,
+    HASH_MEDIDO_PERTENECE,
+    HASH_MEDIDO_OPERACIONES
+} hash_operacion_t;
+
+/* Crea un envoltorio que mide las operaciones sobre el hash. El hash sigue
+ * siendo del llamador, y puede usarse directamente sin que se mida.
+ * Pre: La estructura hash fue inicializada
+ * Post: devuelve el envoltorio con los histogramas vacíos, o NULL si falló.
+ */
+hash_medido_t *hash_medido_crear(hash_t *hash);
+
+/* Devuelve el hash envuelto.
+ * Pre: el envoltorio fue creado
+ */
+hash_t *hash_medido_hash(const hash_medido_t *medido);
+
+/* Primitivas equivalentes a las de hash.h que además registran su latencia.
+ * Pre: el envoltorio fue creado
+ */
+bool hash_medido_guardar(hash_medido_t *medido, const char *clave, void *dato);
+void *hash_medido_borrar(hash_medido_t *medido, const char *clave);
+void *hash_medido_obtener(hash_medido_t *medido, const char *clave);
+bool hash_medido_pertenece(hash_medido_t *medido, const char *clave);
+
+/* Devuelve el histograma de latencias en nanosegundos de la operación.
+ * Pre: el envoltorio fue creado
+ */
+const histograma_t *hash_medido_histograma(const hash_medido_t *medido, hash_operacion_t operacion);
+
+/* Vacía los histogramas de todas las operaciones.
+ * Pre: el envoltorio fue creado
+ */
+void hash_medido_reiniciar(hash_medido_t *medido);
+
+/* Escribe en CSV, por cada operación con mediciones, la cantidad, el
+ * promedio, p50, p99, p999 y el máximo en nanosegundos, con una cabecera.
+ * Pre: el envoltorio fue creado
+ */
+void hash_medido_imprimir(const hash_medido_t *medido, FILE *archivo);
+
+/* Destruye el envoltorio, sin destruir el hash.
+ * Pre: el envoltorio fue creado
+ */
+void hash_medido_destruir(hash_medido_t *medido);
+
+#endif // HASH_MEDIDO_H
@@ -0,0 +1,231 @@
+#include "hash_multimapa.h"
+#include "hash_tipado.h"
+#include <string.h>
+
+#define DATOS_INICIALES 4
+
+/* Con capacidad 0 la clave tiene un solo dato, en uno; si no, los datos están
+ * en el arreglo varios */
+typedef struct valores {
+    void **varios;
+    size_t cantidad;
+    size_t capacidad;
+    void *uno;
+} valores_t;
+
+HASH_DEFINIR(tabla_valores, hash_tipado_cadena_t, valores_t, hash_tipado_hash_guardado, hash_tipado_igual_guardado)
+
+/* Definiciones de estructuras del multimapa */
+
+struct hash_multimapa {
+    tabla_valores_t *tabla;
+    size_t cantidad_datos;
+    hash_destruir_dato_t destruir_dato;
+};
+
+/* Funciones auxiliares */
+
+static void **datos_de(valores_t *valores) {
+    return (valores->capacidad ? valores->varios : &valores->uno);
+}
+
+/* Hace lugar para un dato más en los valores de una clave */
+static bool hacer_lugar(const alocador_t *alocador, valores_t *valores) {
+    void **varios;
+    size_t capacidad;
+
+    if (valores->cantidad < valores->capacidad)
+        return true;
+    if (!valores->capacidad) {
+        /* Segundo dato: el primero pasa de la ranura al arreglo */
+        varios = alocador_reservar(alocador, DATOS_INICIALES * sizeof(void *));
+        if (!varios)
+            return false;
+        varios[0] = valores->uno;
+        valores->capacidad = DATOS_INICIALES;
+    } else {
+        capacidad = valores->capacidad * 2;
+        varios = alocador_redimensionar(alocador, valores->varios, valores->capacidad * sizeof(void *),
+                                        capacidad * sizeof(void *));
+        if (!varios)
+            return false;
+        valores->capacidad = capacidad;
+    }
+    valores->varios = varios;
+    return true;
+}
+
+/* Libera la clave y el arreglo de datos de la posición pos y la saca */
+static void quitar_clave(tabla_valores_t *tabla, size_t pos) {
+    tabla_valores_par_t *par = &tabla->pares[pos];
+    if (par->valor.capacidad)
+        alocador_liberar(&tabla->alocador, par->valor.varios, par->valor.capacidad * sizeof(void *));
+    alocador_liberar(&tabla->alocador, (char *) par->clave.cadena, strlen(par->clave.cadena) + 1);
+    tabla_valores_quitar_(tabla, pos);
+}
+
+static void destruir_datos(const hash_multimapa_t *multimapa, valores_t *valores) {
+    void **datos = datos_de(valores);
+    if (!multimapa->destruir_dato)
+        return;
+    for (size_t i = 0; i < valores->cantidad; i++)
+        multimapa->destruir_dato(datos[i]);
+}
+
+/**************************************
+ **     Primitivas del multimapa     **
+ **************************************/
+
+hash_multimapa_t *hash_multimapa_crear(hash_destruir_dato_t destruir_dato) {
+    return hash_multimapa_crear_con_alocador(destruir_dato, alocador_estandar());
+}
+
+hash_multimapa_t *hash_multimapa_crear_con_alocador(hash_destruir_dato_t destruir_dato, const alocador_t *alocador) {
+    hash_multimapa_t *multimapa = alocador_reservar(alocador, sizeof(*multimapa));
+    if (!multimapa)
+        return NULL;
+    multimapa->tabla = tabla_valores_crear_con_alocador(alocador);
+    if (!multimapa->tabla) {
+        alocador_liberar(alocador, multimapa, sizeof(*multimapa));
+        return NULL;
+    }
+    multimapa->cantidad_datos = 0;
+    multimapa->destruir_dato = destruir_dato;
+    return multimapa;
+}
+
+bool hash_multimapa_agregar(hash_multimapa_t *multimapa, const char *clave, void *dato) {
+    if (!clave) return false; // Debe recibir una clave válida
+    tabla_valores_t *tabla = multimapa->tabla;
+    bool nueva;
+    size_t pos = tabla_valores_ubicar_(tabla, hash_tipado_cadena_crear(clave), &nueva), tam;
+    valores_t *valores;
+    char *copia;
+
+    if (pos == tabla->capacidad)
+        return false;
+    valores = &tabla->pares[pos].valor;
+    if (nueva) {
+        tam = strlen(clave) + 1;
+        copia = alocador_reservar(&tabla->alocador, tam);
+        if (!copia) {
+            tabla_valores_quitar_(tabla, pos);
+            return false;
+        }
+        memcpy(copia, clave, tam);
+        tabla->pares[pos].clave.cadena = copia;
+        valores->varios = NULL;
+        valores->cantidad = 0;
+        valores->capacidad = 0;
+    } else if (!hacer_lugar(&tabla->alocador, valores)) {
+        return false;
+    }
+    datos_de(valores)[valores->cantidad++] = dato;
+    multimapa->cantidad_datos++;
+    return true;
+}
+
+void *const *hash_multimapa_obtener(const hash_multimapa_t *multimapa, const char *clave, size_t *cantidad) {
+    const tabla_valores_t *tabla = multimapa->tabla;
+    size_t pos;
+
+    if (!clave) {
+        *cantidad = 0;
+        return NULL;
+    }
+    pos = tabla_valores_buscar_(tabla, hash_tipado_cadena_crear(clave));
+    if (!tabla->ocupados[pos]) {
+        *cantidad = 0;
+        return NULL;
+    }
+    *cantidad = tabla->pares[pos].valor.cantidad;
+    return datos_de(&tabla->pares[pos].valor);
+}
+
+bool hash_multimapa_pertenece(const hash_multimapa_t *multimapa, const char *clave) {
+    return (clave && tabla_valores_pertenece(multimapa->tabla, hash_tipado_cadena_crear(clave)));
+}
+
+bool hash_multimapa_borrar(hash_multimapa_t *multimapa, const char *clave) {
+    tabla_valores_t *tabla = multimapa->tabla;
+    size_t pos;
+
+    if (!clave)
+        return false;
+    pos = tabla_valores_buscar_(tabla, hash_tipado_cadena_crear(clave));
+    if (!tabla->ocupados[pos])
+        return false;
+    multimapa->cantidad_datos -= tabla->pares[pos].valor.cantidad;
+    destruir_datos(multimapa, &tabla->pares[pos].valor);
+    quitar_clave(tabla, pos);
+    return true;
+}
+
+bool hash_multimapa_borrar_dato(hash_multimapa_t *multimapa, const char *clave, const void *dato) {
+    tabla_valores_t *tabla = multimapa->tabla;
+    size_t pos, i;
+    valores_t *valores;
+    void **datos;
+
+    if (!clave)
+        return false;
+    pos = tabla_valores_buscar_(tabla, hash_tipado_cadena_crear(clave));
+    if (!tabla->ocupados[pos])
+        return false;
+    valores = &tabla->pares[pos].valor;
+    datos = datos_de(valores);
+    for (i = 0; i < valores->cantidad && datos[i] != dato; i++)
+        ;
+    if (i == valores->cantidad)
+        return false;
+    multimapa->cantidad_datos--;
+    if (valores->cantidad == 1) {
+        quitar_clave(tabla, pos);
+        return true;
+    }
+    /* Se corren los siguientes para conservar el orden */
+    memmove(&datos[i], &datos[i + 1], (valores->cantidad - i - 1) * sizeof(void *));
+    valores->cantidad--;
+    return true;
+}
+
+size_t hash_multimapa_cantidad(const hash_multimapa_t *multimapa) {
+    return tabla_valores_cantidad(multimapa->tabla);
+}
+
+size_t hash_multimapa_cantidad_datos(const hash_multimapa_t *multimapa) {
+    return multimapa->cantidad_datos;
+}
+
+void hash_multimapa_iterar(const hash_multimapa_t *multimapa,
+                           bool (*visitar)(const char *clave, void *const *datos, size_t cantidad, void *extra),
+                           void *extra) {
+    const tabla_valores_t *tabla = multimapa->tabla;
+    tabla_valores_par_t *par;
+
+    for (size_t i = 0; i < tabla->capacidad; i++) {
+        if (!tabla->ocupados[i])
+            continue;
+        par = &tabla->pares[i];
+        if (!visitar(par->clave.cadena, datos_de(&par->valor), par->valor.cantidad, extra))
+            return;
+    }
+}
+
+void hash_multimapa_destruir(hash_multimapa_t *multimapa) {
+    tabla_valores_t *tabla = multimapa->tabla;
+    alocador_t alocador = tabla->alocador;
+    tabla_valores_par_t *par;
+
+    for (size_t i = 0; i < tabla->capacidad; i++) {
+        if (!tabla->ocupados[i])
+            continue;
+        par = &tabla->pares[i];
+        destruir_datos(multimapa, &par->valor);
+        if (par->valor.capacidad)
+            alocador_liberar(&alocador, par->valor.varios, par->valor.capacidad * sizeof(void *));
+        alocador_liberar(&alocador, (char *) par->clave.cadena, strlen(par->clave.cadena) + 1);
+    }
+    tabla_valores_destruir(tabla);
+    alocador_liberar(&alocador, multimapa, sizeof(*multimapa));
+}
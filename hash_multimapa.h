@@ -0,0 +1,94 @@
+#ifndef HASH_MULTIMAPA_H
+#define HASH_MULTIMAPA_H
+
+#include "alocador.h"
+#include "hash.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+/* Tabla de hash con varios datos por clave.
+ *
+ * Es una instancia de HASH_DEFINIR (hash_tipado.h) cuyo valor es la lista de
+ * datos de la clave. El primer dato se guarda en la misma ranura que la
+ * clave, así una clave con un solo dato no pide más memoria que en hash.h;
+ * a partir del segundo los datos pasan a un arreglo contiguo que se duplica
+ * al llenarse. Obtener devuelve ese arreglo, así recorrer los datos de una
+ * clave no sigue punteros de nodo en nodo.
+ *
+ * Los datos de una clave se mantienen en el orden en que se agregaron.
+ */
+
+typedef struct hash_multimapa hash_multimapa_t;
+
+/* Crea el multimapa
+ * Pos: devuelve un multimapa vacío, o NULL si falló.
+ */
+hash_multimapa_t *hash_multimapa_crear(hash_destruir_dato_t destruir_dato);
+
+/* Crea un multimapa que pide toda su memoria (la tabla, las claves y los
+ * arreglos de datos) al alocador, que se copia. Su contexto debe vivir al
+ * menos tanto como el multimapa.
+ * Pos: devuelve un multimapa vacío, o NULL si falló.
+ */
+hash_multimapa_t *hash_multimapa_crear_con_alocador(hash_destruir_dato_t destruir_dato, const alocador_t *alocador);
+
+/* Agrega el dato al final de los datos de la clave, sin reemplazar los que
+ * ya tenía. De no poder guardarlo devuelve false.
+ * Pre: el multimapa fue creado
+ * Post: el dato es el último de la clave
+ */
+bool hash_multimapa_agregar(hash_multimapa_t *multimapa, const char *clave, void *dato);
+
+/* Devuelve los datos de la clave como un arreglo y deja en *cantidad su
+ * largo; si la clave no está devuelve NULL y deja 0. El arreglo es del
+ * multimapa y deja de ser válido al agregar o borrar.
+ * Pre: el multimapa fue creado
+ */
+void *const *hash_multimapa_obtener(const hash_multimapa_t *multimapa, const char *clave, size_t *cantidad);
+
+/* Determina si la clave tiene al menos un dato.
+ * Pre: el multimapa fue creado
+ */
+bool hash_multimapa_pertenece(const hash_multimapa_t *multimapa, const char *clave);
+
+/* Borra la clave y destruye todos sus datos con destruir_dato. Devuelve
+ * false si la clave no estaba.
+ * Pre: el multimapa fue creado
+ * Post: la clave no pertenece al multimapa
+ */
+bool hash_multimapa_borrar(hash_multimapa_t *multimapa, const char *clave);
+
+/* Saca de la clave la primera aparición del dato, sin destruirlo, y borra la
+ * clave si era su último dato. Devuelve false si la clave no tenía ese dato.
+ * Pre: el multimapa fue creado
+ */
+bool hash_multimapa_borrar_dato(hash_multimapa_t *multimapa, const char *clave, const void *dato);
+
+/* Devuelve la cantidad de claves distintas del multimapa.
+ * Pre: el multimapa fue creado
+ */
+size_t hash_multimapa_cantidad(const hash_multimapa_t *multimapa);
+
+/* Devuelve la cantidad de datos del multimapa, sumando los de todas las
+ * claves.
+ * Pre: el multimapa fue creado
+ */
+size_t hash_multimapa_cantidad_datos(const hash_multimapa_t *multimapa);
+
+/* Llama a visitar con cada clave y sus datos, en ningún orden en particular
+ * entre claves, hasta que devuelva false. No se debe modificar el multimapa
+ * mientras tanto.
+ * Pre: el multimapa fue creado
+ */
+void hash_multimapa_iterar(const hash_multimapa_t *multimapa,
+                           bool (*visitar)(const char *clave, void *const *datos, size_t cantidad, void *extra),
+                           void *extra);
+
+/* Destruye el multimapa liberando la memoria pedida y llamando a
+ * destruir_dato para cada dato.
+ * Pre: el multimapa fue creado
+ * Post: el multimapa fue destruido
+ */
+void hash_multimapa_destruir(hash_multimapa_t *multimapa);
+
+#endif // HASH_MULTIMAPA_H
@@ -0,0 +1,372 @@
+#include "hash_swiss.h"
+#include "hash_funciones.h"
+#include <stdint.h>
+#include <string.h>
+#if defined(__SSE2__) && !defined(HASH_SWISS_ESCALAR)
+#include <emmintrin.h>
+#define HASH_SWISS_SSE2
+#endif
+#define GRUPO 16
+#define CAPACIDAD_INICIAL GRUPO
+/* Ocupación máxima, contando las ranuras borradas: 7/8 */
+#define CARGA_MAX_NUM 7
+#define CARGA_MAX_DEN 8
+/* Se achica cuando queda menos de 1/8 ocupado */
+#define CARGA_MIN_DEN 8
+
+/* Valores de los bytes de control. Las ranuras ocupadas guardan los 7 bits
+ * bajos del hash de su clave, así que tienen el bit alto en 0; las vacías y
+ * las borradas lo tienen en 1. */
+#define CONTROL_VACIO ((int8_t) -128)
+#define CONTROL_BORRADO ((int8_t) -2)
+
+/* Definiciones de estructuras de la tabla de hash */
+
+typedef struct ranura {
+    char *clave;
+    void *dato;
+} ranura_t;
+
+struct hash_swiss {
+    int8_t *control;      // Un byte por ranura, de a grupos de GRUPO
+    ranura_t *ranuras;
+    size_t capacidad;     // Potencia de 2, múltiplo de GRUPO
+    size_t cantidad;
+    size_t borrados;      // Ranuras borradas, siguen cortando el paso a las nuevas
+    hash_destruir_dato_t destruir_dato;
+    alocador_t alocador;
+    size_t bytes;         // Bytes pedidos al alocador que siguen en uso
+};
+
+struct hash_swiss_iter {
+    const hash_swiss_t *hash;
+    size_t pos;
+};
+
+/* Bits de un grupo, el bit i corresponde a la ranura i del grupo */
+typedef uint32_t mascara_t;
+
+/* Funciones de los grupos de control */
+
+#ifdef HASH_SWISS_SSE2
+
+/* Ranuras del grupo cuyo byte de control es valor */
+static mascara_t grupo_coincidencias(const int8_t *grupo, int8_t valor) {
+    __m128i bytes = _mm_loadu_si128((const __m128i *) grupo);
+    return (mascara_t) _mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(valor)));
+}
+
+/* Ranuras del grupo vacías o borradas, las que tienen el bit alto en 1 */
+static mascara_t grupo_libres(const int8_t *grupo) {
+    return (mascara_t) _mm_movemask_epi8(_mm_loadu_si128((const __m128i *) grupo));
+}
+
+#else
+
+static mascara_t grupo_coincidencias(const int8_t *grupo, int8_t valor) {
+    mascara_t mascara = 0;
+    for (int i = 0; i < GRUPO; i++)
+        mascara |= (mascara_t) (grupo[i] == valor) << i;
+    return mascara;
+}
+
+static mascara_t grupo_libres(const int8_t *grupo) {
+    mascara_t mascara = 0;
+    for (int i = 0; i < GRUPO; i++)
+        mascara |= (mascara_t) (grupo[i] < 0) << i;
+    return mascara;
+}
+
+#endif
+
+/* Devuelve la posición del bit en 1 más bajo de una máscara no nula */
+static size_t primer_bit(mascara_t mascara) {
+#ifdef __GNUC__
+    return (size_t) __builtin_ctz(mascara);
+#else
+    size_t i = 0;
+    while (!(mascara & 1)) {
+        mascara >>= 1;
+        i++;
+    }
+    return i;
+#endif
+}
+
+/* Funciones auxiliares */
+
+static void *swiss_reservar(hash_swiss_t *hash, size_t tam) {
+    void *bloque = alocador_reservar(&hash->alocador, tam);
+    if (bloque)
+        hash->bytes += tam;
+    return bloque;
+}
+
+static void swiss_liberar(hash_swiss_t *hash, void *bloque, size_t tam) {
+    alocador_liberar(&hash->alocador, bloque, tam);
+    hash->bytes -= tam;
+}
+
+static uint64_t swiss_hash(const char *clave) {
+    return hash_mezclar64(hash_fnv1a(clave, strlen(clave)));
+}
+
+/* Los 7 bits bajos del hash van al control, el resto elige el grupo */
+static int8_t swiss_etiqueta(uint64_t hash) {
+    return (int8_t) (hash & 0x7f);
+}
+
+static size_t swiss_primer_grupo(const hash_swiss_t *hash, uint64_t valor) {
+    return (size_t) (valor >> 7) & (hash->capacidad / GRUPO - 1);
+}
+
+/* Sondeo triangular: con una cantidad de grupos potencia de 2, los recorre todos */
+static size_t swiss_siguiente_grupo(const hash_swiss_t *hash, size_t grupo, size_t salto) {
+    return (grupo + salto) & (hash->capacidad / GRUPO - 1);
+}
+
+/* Busca la clave, cuyo hash es valor. Devuelve true si la encuentra y deja
+ * su ranura en pos. Solo compara las claves cuyo control coincide. */
+static bool swiss_buscar(const hash_swiss_t *hash, const char *clave, uint64_t valor, size_t *pos) {
+    int8_t etiqueta = swiss_etiqueta(valor);
+    size_t grupo = swiss_primer_grupo(hash, valor), salto = 0, i;
+    const int8_t *control;
+    mascara_t coincidencias;
+
+    for (;;) {
+        control = hash->control + grupo * GRUPO;
+        for (coincidencias = grupo_coincidencias(control, etiqueta); coincidencias; coincidencias &= coincidencias - 1) {
+            i = grupo * GRUPO + primer_bit(coincidencias);
+            if (!strcmp(hash->ranuras[i].clave, clave)) {
+                *pos = i;
+                return true;
+            }
+        }
+        /* Una ranura vacía en el grupo corta la búsqueda: la clave se habría guardado ahí */
+        if (grupo_coincidencias(control, CONTROL_VACIO))
+            return false;
+        grupo = swiss_siguiente_grupo(hash, grupo, ++salto);
+    }
+}
+
+/* Devuelve la primera ranura libre (vacía o borrada) de la secuencia de sondeo de valor */
+static size_t swiss_buscar_libre(const hash_swiss_t *hash, uint64_t valor) {
+    size_t grupo = swiss_primer_grupo(hash, valor), salto = 0;
+    mascara_t libres;
+
+    while (!(libres = grupo_libres(hash->control + grupo * GRUPO)))
+        grupo = swiss_siguiente_grupo(hash, grupo, ++salto);
+    return grupo * GRUPO + primer_bit(libres);
+}
+
+static void swiss_ocupar(hash_swiss_t *hash, size_t pos, uint64_t valor, char *clave, void *dato) {
+    if (hash->control[pos] == CONTROL_BORRADO)
+        hash->borrados--;
+    hash->control[pos] = swiss_etiqueta(valor);
+    hash->ranuras[pos].clave = clave;
+    hash->ranuras[pos].dato = dato;
+    hash->cantidad++;
+}
+
+/* Menor capacidad en la que entran cantidad claves ocupando a lo sumo la
+ * mitad de la carga máxima, así la tabla nueva tiene margen para crecer */
+static size_t capacidad_para(size_t cantidad) {
+    size_t capacidad = CAPACIDAD_INICIAL;
+    while (cantidad * 2 * CARGA_MAX_DEN > capacidad * CARGA_MAX_NUM)
+        capacidad *= 2;
+    return capacidad;
+}
+
+/* Crea arreglos de capacidad_nueva ranuras y reubica en ellos las claves,
+ * descartando las ranuras borradas. Las claves no se copian. */
+static bool swiss_redimensionar(hash_swiss_t *hash, size_t capacidad_nueva) {
+    int8_t *control_viejo = hash->control;
+    ranura_t *ranuras_viejas = hash->ranuras;
+    size_t capacidad_vieja = hash->capacidad, i;
+    uint64_t valor;
+    int8_t *control = swiss_reservar(hash, capacidad_nueva * sizeof(int8_t));
+    ranura_t *ranuras = swiss_reservar(hash, capacidad_nueva * sizeof(ranura_t));
+
+    if (!control || !ranuras) {
+        swiss_liberar(hash, control, control ? capacidad_nueva * sizeof(int8_t) : 0);
+        swiss_liberar(hash, ranuras, ranuras ? capacidad_nueva * sizeof(ranura_t) : 0);
+        return false;
+    }
+    memset(control, CONTROL_VACIO, capacidad_nueva * sizeof(int8_t));
+    hash->control = control;
+    hash->ranuras = ranuras;
+    hash->capacidad = capacidad_nueva;
+    hash->cantidad = 0;
+    hash->borrados = 0;
+    for (i = 0; i < capacidad_vieja; i++) {
+        if (control_viejo[i] < 0)
+            continue;
+        valor = swiss_hash(ranuras_viejas[i].clave);
+        swiss_ocupar(hash, swiss_buscar_libre(hash, valor), valor, ranuras_viejas[i].clave, ranuras_viejas[i].dato);
+    }
+    swiss_liberar(hash, control_viejo, capacidad_vieja * sizeof(int8_t));
+    swiss_liberar(hash, ranuras_viejas, capacidad_vieja * sizeof(ranura_t));
+    return true;
+}
+
+static bool debe_agrandar(const hash_swiss_t *hash) {
+    return ((hash->cantidad + hash->borrados + 1) * CARGA_MAX_DEN > hash->capacidad * CARGA_MAX_NUM);
+}
+
+static bool debe_achicar(const hash_swiss_t *hash) {
+    return (hash->capacidad > CAPACIDAD_INICIAL && hash->cantidad * CARGA_MIN_DEN < hash->capacidad);
+}
+
+/* Devuelve la primera ranura ocupada desde pos, o la capacidad si no hay */
+static size_t buscar_ocupada(const hash_swiss_t *hash, size_t pos) {
+    while (pos < hash->capacidad && hash->control[pos] < 0)
+        pos++;
+    return pos;
+}
+
+/**************************************
+ **  Primitivas de la Tabla de hash  **
+ **************************************/
+
+hash_swiss_t *hash_swiss_crear(hash_destruir_dato_t destruir_dato) {
+    return hash_swiss_crear_con_alocador(destruir_dato, alocador_estandar());
+}
+
+hash_swiss_t *hash_swiss_crear_con_alocador(hash_destruir_dato_t destruir_dato, const alocador_t *alocador) {
+    hash_swiss_t *nuevo = alocador_reservar(alocador, sizeof(*nuevo));
+    if (!nuevo)
+        return NULL;
+    nuevo->alocador = *alocador;
+    nuevo->bytes = sizeof(*nuevo);
+    nuevo->control = swiss_reservar(nuevo, CAPACIDAD_INICIAL * sizeof(int8_t));
+    nuevo->ranuras = swiss_reservar(nuevo, CAPACIDAD_INICIAL * sizeof(ranura_t));
+    if (!nuevo->control || !nuevo->ranuras) {
+        alocador_liberar(alocador, nuevo->control, CAPACIDAD_INICIAL * sizeof(int8_t));
+        alocador_liberar(alocador, nuevo->ranuras, CAPACIDAD_INICIAL * sizeof(ranura_t));
+        alocador_liberar(alocador, nuevo, sizeof(*nuevo));
+        return NULL;
+    }
+    memset(nuevo->control, CONTROL_VACIO, CAPACIDAD_INICIAL * sizeof(int8_t));
+    nuevo->capacidad = CAPACIDAD_INICIAL;
+    nuevo->cantidad = 0;
+    nuevo->borrados = 0;
+    nuevo->destruir_dato = destruir_dato;
+    return nuevo;
+}
+
+bool hash_swiss_guardar(hash_swiss_t *hash, const char *clave, void *dato) {
+    if (!clave) return false; // Debe recibir una clave válida
+    uint64_t valor = swiss_hash(clave);
+    size_t pos, largo;
+    char *copia;
+
+    /* Si la clave ya está solo se reemplaza el dato */
+    if (swiss_buscar(hash, clave, valor, &pos)) {
+        if (hash->destruir_dato)
+            hash->destruir_dato(hash->ranuras[pos].dato);
+        hash->ranuras[pos].dato = dato;
+        return true;
+    }
+    /* Si sobran ranuras borradas, capacidad_para devuelve la misma capacidad y solo se limpian */
+    if (debe_agrandar(hash) && !swiss_redimensionar(hash, capacidad_para(hash->cantidad + 1)))
+        return false;
+    largo = strlen(clave) + 1;
+    copia = swiss_reservar(hash, largo * sizeof(char));
+    if (!copia)
+        return false;
+    memcpy(copia, clave, largo);
+    swiss_ocupar(hash, swiss_buscar_libre(hash, valor), valor, copia, dato);
+    return true;
+}
+
+void *hash_swiss_borrar(hash_swiss_t *hash, const char *clave) {
+    size_t pos;
+    void *dato;
+
+    if (!clave || !swiss_buscar(hash, clave, swiss_hash(clave), &pos))
+        return NULL;
+    dato = hash->ranuras[pos].dato;
+    swiss_liberar(hash, hash->ranuras[pos].clave, strlen(hash->ranuras[pos].clave) + 1);
+    /* Si el grupo tiene una ranura vacía ninguna búsqueda pasa de largo por él,
+     * y la ranura puede quedar vacía. Si no, queda borrada para no cortar el sondeo */
+    if (grupo_coincidencias(hash->control + pos / GRUPO * GRUPO, CONTROL_VACIO)) {
+        hash->control[pos] = CONTROL_VACIO;
+    } else {
+        hash->control[pos] = CONTROL_BORRADO;
+        hash->borrados++;
+    }
+    hash->cantidad--;
+    if (debe_achicar(hash))
+        swiss_redimensionar(hash, capacidad_para(hash->cantidad));
+    return dato;
+}
+
+void *hash_swiss_obtener(const hash_swiss_t *hash, const char *clave) {
+    size_t pos;
+    if (!clave || !swiss_buscar(hash, clave, swiss_hash(clave), &pos))
+        return NULL;
+    return hash->ranuras[pos].dato;
+}
+
+bool hash_swiss_pertenece(const hash_swiss_t *hash, const char *clave) {
+    size_t pos;
+    return (clave && swiss_buscar(hash, clave, swiss_hash(clave), &pos));
+}
+
+size_t hash_swiss_cantidad(const hash_swiss_t *hash) {
+    return hash->cantidad;
+}
+
+size_t hash_swiss_memoria(const hash_swiss_t *hash) {
+    return hash->bytes;
+}
+
+void hash_swiss_destruir(hash_swiss_t *hash) {
+    alocador_t alocador = hash->alocador;
+    size_t pos;
+
+    for (pos = buscar_ocupada(hash, 0); pos < hash->capacidad; pos = buscar_ocupada(hash, pos + 1)) {
+        if (hash->destruir_dato)
+            hash->destruir_dato(hash->ranuras[pos].dato);
+        alocador_liberar(&alocador, hash->ranuras[pos].clave, strlen(hash->ranuras[pos].clave) + 1);
+    }
+    alocador_liberar(&alocador, hash->control, hash->capacidad * sizeof(int8_t));
+    alocador_liberar(&alocador, hash->ranuras, hash->capacidad * sizeof(ranura_t));
+    alocador_liberar(&alocador, hash, sizeof(*hash));
+}
+
+/****************************************
+ **  Primitivas del Iterador del hash  **
+ ****************************************/
+
+hash_swiss_iter_t *hash_swiss_iter_crear(const hash_swiss_t *hash) {
+    hash_swiss_iter_t *iter = alocador_reservar(&hash->alocador, sizeof(*iter));
+    if (!iter)
+        return NULL;
+    iter->hash = hash;
+    iter->pos = buscar_ocupada(hash, 0);
+    return iter;
+}
+
+bool hash_swiss_iter_avanzar(hash_swiss_iter_t *iter) {
+    if (hash_swiss_iter_al_final(iter))
+        return false;
+    iter->pos = buscar_ocupada(iter->hash, iter->pos + 1);
+    return true;
+}
+
+const char *hash_swiss_iter_ver_actual(const hash_swiss_iter_t *iter) {
+    return (hash_swiss_iter_al_final(iter) ? NULL : iter->hash->ranuras[iter->pos].clave);
+}
+
+void *hash_swiss_iter_ver_dato(const hash_swiss_iter_t *iter) {
+    return (hash_swiss_iter_al_final(iter) ? NULL : iter->hash->ranuras[iter->pos].dato);
+}
+
+bool hash_swiss_iter_al_final(const hash_swiss_iter_t *iter) {
+    return (iter->pos == iter->hash->capacidad);
+}
+
+void hash_swiss_iter_destruir(hash_swiss_iter_t *iter) {
+    alocador_liberar(&iter->hash->alocador, iter, sizeof(*iter));
+}
@@ -0,0 +1,104 @@
+#ifndef HASH_SWISS_H
+#define HASH_SWISS_H
+
+#include "alocador.h"
+#include "hash.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+/* Tabla de hash con direccionamiento abierto por grupos, al estilo de
+ * SwissTable/F14.
+ *
+ * Las ranuras (clave, dato) están en un arreglo plano, y por cada ranura hay
+ * un byte de control: vacía, borrada, o los 7 bits bajos del hash de su clave.
+ * Se sondea de a grupos de 16 bytes de control: con SSE2 se compara el grupo
+ * entero contra los 7 bits de la clave buscada en una sola instrucción, y
+ * solo se comparan las claves de las ranuras que coinciden. Sin SSE2 (o
+ * compilando con -DHASH_SWISS_ESCALAR) se usa una versión escalar equivalente.
+ * La tabla se agranda al superar 7/8 de ocupación.
+ *
+ * Las primitivas son las mismas que las de hash.h, sin TTL ni cache. Las
+ * ranuras se mueven al redimensionar, así que un iterador no sobrevive a
+ * guardar ni a borrar.
+ */
+
+typedef struct hash_swiss hash_swiss_t;
+typedef struct hash_swiss_iter hash_swiss_iter_t;
+
+/* Crea el hash
+ * Pos: devuelve un puntero a una tabla de hash, o NULL si falló.
+ */
+hash_swiss_t *hash_swiss_crear(hash_destruir_dato_t destruir_dato);
+
+/* Crea un hash que pide toda su memoria (la tabla, las claves y los
+ * iteradores) al alocador, que se copia. Su contexto debe vivir al menos
+ * tanto como el hash.
+ * Pos: devuelve un puntero a una tabla de hash, o NULL si falló.
+ */
+hash_swiss_t *hash_swiss_crear_con_alocador(hash_destruir_dato_t destruir_dato, const alocador_t *alocador);
+
+/* Guarda un elemento en el hash, si la clave ya se encuentra en la
+ * estructura, reemplaza su dato. De no poder guardarlo devuelve false.
+ * Pre: La estructura hash fue inicializada
+ * Post: Se almacenó el par (clave, dato)
+ */
+bool hash_swiss_guardar(hash_swiss_t *hash, const char *clave, void *dato);
+
+/* Borra un elemento del hash y devuelve el dato asociado. Devuelve
+ * NULL si el dato no estaba.
+ * Pre: La estructura hash fue inicializada
+ * Post: El elemento fue borrado de la estructura y se lo devolvió,
+ * en el caso de que estuviera guardado.
+ */
+void *hash_swiss_borrar(hash_swiss_t *hash, const char *clave);
+
+/* Obtiene el valor de un elemento del hash, si la clave no se encuentra
+ * devuelve NULL.
+ * Pre: La estructura hash fue inicializada
+ */
+void *hash_swiss_obtener(const hash_swiss_t *hash, const char *clave);
+
+/* Determina si clave pertenece o no al hash.
+ * Pre: La estructura hash fue inicializada
+ */
+bool hash_swiss_pertenece(const hash_swiss_t *hash, const char *clave);
+
+/* Devuelve la cantidad de elementos del hash.
+ * Pre: La estructura hash fue inicializada
+ */
+size_t hash_swiss_cantidad(const hash_swiss_t *hash);
+
+/* Devuelve los bytes que el hash tiene pedidos a su alocador, incluyendo su
+ * propia estructura y sin contar los datos ni los iteradores.
+ * Pre: La estructura hash fue inicializada
+ */
+size_t hash_swiss_memoria(const hash_swiss_t *hash);
+
+/* Destruye la estructura liberando la memoria pedida y llamando a la función
+ * destruir para cada par (clave, dato).
+ * Pre: La estructura hash fue inicializada
+ * Post: La estructura hash fue destruida
+ */
+void hash_swiss_destruir(hash_swiss_t *hash);
+
+/* Iterador del hash, en el orden de las ranuras */
+
+// Crea iterador
+hash_swiss_iter_t *hash_swiss_iter_crear(const hash_swiss_t *hash);
+
+// Avanza iterador
+bool hash_swiss_iter_avanzar(hash_swiss_iter_t *iter);
+
+// Devuelve clave actual, esa clave no se puede modificar ni liberar.
+const char *hash_swiss_iter_ver_actual(const hash_swiss_iter_t *iter);
+
+// Devuelve el dato de la clave actual, o NULL si el iterador está al final.
+void *hash_swiss_iter_ver_dato(const hash_swiss_iter_t *iter);
+
+// Comprueba si terminó la iteración
+bool hash_swiss_iter_al_final(const hash_swiss_iter_t *iter);
+
+// Destruye iterador
+void hash_swiss_iter_destruir(hash_swiss_iter_t *iter);
+
+#endif // HASH_SWISS_H
@@ -0,0 +1,325 @@
+#ifndef HASH_TIPADO_H
+#define HASH_TIPADO_H
+
+#include "alocador.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/* Tablas de hash especializadas en tiempo de compilación.
+ *
+ * HASH_DEFINIR(nombre, tipo_clave, tipo_valor, fn_hash, fn_igual) define el
+ * tipo nombre_t y sus primitivas como funciones static inline, para una clave
+ * y un valor de tipos concretos que se guardan por valor dentro de la tabla:
+ * no hay un nodo ni un void * por par, y el compilador puede expandir en línea
+ * fn_hash y fn_igual. Va en un .c (o en un .h propio) por cada combinación:
+ *
+ *     HASH_DEFINIR(hash_u64, uint64_t, double, hash_tipado_hash_u64, hash_tipado_igual_u64)
+ *
+ *     hash_u64_t *tabla = hash_u64_crear();
+ *     hash_u64_guardar(tabla, 42, 3.5);
+ *     double *valor = hash_u64_obtener(tabla, 42);
+ *
+ * fn_hash recibe una clave y devuelve un uint64_t, con todos sus bits bien
+ * mezclados; fn_igual recibe dos claves y devuelve un bool. Con claves de tipo
+ * puntero (por ejemplo cadenas) la tabla guarda el puntero, no una copia: lo
+ * apuntado tiene que vivir al menos tanto como el par.
+ *
+ * Es direccionamiento abierto con sondeo lineal sobre un arreglo de pares,
+ * con borrado por corrimiento hacia atrás (sin marcas de borrado). La tabla
+ * se agranda al superar 3/4 de ocupación y se achica por debajo de 1/8.
+ *
+ * Primitivas definidas, con la semántica de las de hash.h:
+ *     nombre_t *nombre_crear(void);
+ *     nombre_t *nombre_crear_con_alocador(const alocador_t *alocador);
+ *     bool nombre_guardar(nombre_t *tabla, tipo_clave clave, tipo_valor valor);
+ *     tipo_valor *nombre_obtener(const nombre_t *tabla, tipo_clave clave);
+ *     bool nombre_pertenece(const nombre_t *tabla, tipo_clave clave);
+ *     bool nombre_borrar(nombre_t *tabla, tipo_clave clave, tipo_valor *valor);
+ *     size_t nombre_cantidad(const nombre_t *tabla);
+ *     bool nombre_asegurar(nombre_t *tabla, size_t cantidad);
+ *     void nombre_iterar(const nombre_t *tabla, bool (*visitar)(tipo_clave, tipo_valor *, void *), void *extra);
+ *     void nombre_destruir(nombre_t *tabla);
+ * obtener devuelve un puntero al valor dentro de la tabla, o NULL si la clave
+ * no está; deja de ser válido al guardar o borrar. borrar copia el valor en
+ * *valor si valor no es NULL, y devuelve false si la clave no estaba. asegurar
+ * agranda la tabla de una vez para que entren cantidad claves sin volver a
+ * redimensionar, y devuelve false si no hay memoria. La tabla no libera lo
+ * que apunten los valores: para eso se los recorre con iterar antes de
+ * destruirla.
+ *
+ * HASH_DEFINIR_CONJUNTO(nombre, tipo_clave, fn_hash, fn_igual) define un
+ * conjunto sobre la misma tabla, sin lugar para el valor en el par. Cambia
+ * guardar, obtener y borrar por:
+ *     bool nombre_agregar(nombre_t *tabla, tipo_clave clave);
+ *     bool nombre_sacar(nombre_t *tabla, tipo_clave clave);
+ *     void nombre_iterar(const nombre_t *tabla, bool (*visitar)(tipo_clave, void *), void *extra);
+ * agregar devuelve false solo si no hay memoria; sacar devuelve false si la
+ * clave no estaba.
+ *
+ * hash_tipado_cadena_t es una clave de cadena que lleva su hash calculado:
+ * rehashear la tabla o pasar la clave de una tabla a otra no vuelve a recorrer
+ * la cadena, y la comparación descarta casi todas las distintas sin strcmp.
+ */
+
+#define HASH_TIPADO_CAPACIDAD_INICIAL 16
+
+/* Funciones de hash e igualdad para los tipos de clave más comunes */
+
+/* Finalizador de MurmurHash3, el mismo que hash_mezclar64, acá en línea */
+static inline uint64_t hash_tipado_mezclar(uint64_t x) {
+    x ^= x >> 33;
+    x *= UINT64_C(0xff51afd7ed558ccd);
+    x ^= x >> 33;
+    x *= UINT64_C(0xc4ceb9fe1a85ec53);
+    x ^= x >> 33;
+    return x;
+}
+
+/* FNV-1a de 64 bits de largo bytes, mezclado */
+static inline uint64_t hash_tipado_hash_bytes(const void *bytes, size_t largo) {
+    const unsigned char *actual = bytes;
+    uint64_t valor = UINT64_C(0xcbf29ce484222325);
+    for (size_t i = 0; i < largo; i++)
+        valor = (valor ^ actual[i]) * UINT64_C(0x100000001b3);
+    return hash_tipado_mezclar(valor);
+}
+
+static inline uint64_t hash_tipado_hash_u64(uint64_t clave) {
+    return hash_tipado_mezclar(clave);
+}
+
+static inline bool hash_tipado_igual_u64(uint64_t a, uint64_t b) {
+    return a == b;
+}
+
+static inline uint64_t hash_tipado_hash_cadena(const char *clave) {
+    return hash_tipado_hash_bytes(clave, strlen(clave));
+}
+
+static inline bool hash_tipado_igual_cadena(const char *a, const char *b) {
+    return !strcmp(a, b);
+}
+
+typedef struct hash_tipado_cadena {
+    const char *cadena;
+    uint64_t hash;
+} hash_tipado_cadena_t;
+
+static inline hash_tipado_cadena_t hash_tipado_cadena_crear(const char *cadena) {
+    hash_tipado_cadena_t clave = {cadena, hash_tipado_hash_cadena(cadena)};
+    return clave;
+}
+
+static inline uint64_t hash_tipado_hash_guardado(hash_tipado_cadena_t clave) {
+    return clave.hash;
+}
+
+static inline bool hash_tipado_igual_guardado(hash_tipado_cadena_t a, hash_tipado_cadena_t b) {
+    return a.hash == b.hash && !strcmp(a.cadena, b.cadena);
+}
+
+/* Núcleo compartido por HASH_DEFINIR y HASH_DEFINIR_CONJUNTO. campo_valor son
+ * los campos del par además de la clave: "tipo_valor valor;" para una tabla y
+ * nada para un conjunto. Las primitivas terminadas en _ son internas. */
+#define HASH_TIPADO_NUCLEO_(nombre, tipo_clave, campo_valor, fn_hash, fn_igual)                              \
+                                                                                                             \
+typedef struct nombre##_par {                                                                                \
+    tipo_clave clave;                                                                                        \
+    campo_valor                                                                                              \
+} nombre##_par_t;                                                                                            \
+                                                                                                             \
+typedef struct nombre {                                                                                      \
+    nombre##_par_t *pares;                                                                                   \
+    bool *ocupados;                                                                                          \
+    size_t capacidad;   /* Potencia de 2 */                                                                  \
+    size_t cantidad;                                                                                         \
+    alocador_t alocador;                                                                                     \
+} nombre##_t;                                                                                                \
+                                                                                                             \
+static inline size_t nombre##_inicio_(const nombre##_t *tabla, tipo_clave clave) {                           \
+    return (size_t) fn_hash(clave) & (tabla->capacidad - 1);                                                 \
+}                                                                                                            \
+                                                                                                             \
+/* Devuelve la posición de la clave, o la de la ranura libre donde iría */                                   \
+static inline size_t nombre##_buscar_(const nombre##_t *tabla, tipo_clave clave) {                           \
+    size_t pos = nombre##_inicio_(tabla, clave);                                                             \
+    while (tabla->ocupados[pos] && !fn_igual(tabla->pares[pos].clave, clave))                                \
+        pos = (pos + 1) & (tabla->capacidad - 1);                                                            \
+    return pos;                                                                                              \
+}                                                                                                            \
+                                                                                                             \
+static inline bool nombre##_reservar_(nombre##_t *tabla, size_t capacidad) {                                 \
+    tabla->pares = alocador_reservar(&tabla->alocador, capacidad * sizeof(nombre##_par_t));                  \
+    tabla->ocupados = alocador_reservar_ceros(&tabla->alocador, capacidad * sizeof(bool));                   \
+    if (!tabla->pares || !tabla->ocupados) {                                                                 \
+        alocador_liberar(&tabla->alocador, tabla->pares, capacidad * sizeof(nombre##_par_t));                \
+        alocador_liberar(&tabla->alocador, tabla->ocupados, capacidad * sizeof(bool));                       \
+        return false;                                                                                        \
+    }                                                                                                        \
+    tabla->capacidad = capacidad;                                                                            \
+    return true;                                                                                             \
+}                                                                                                            \
+                                                                                                             \
+static inline bool nombre##_redimensionar_(nombre##_t *tabla, size_t capacidad) {                            \
+    nombre##_t vieja = *tabla;                                                                               \
+    size_t pos;                                                                                              \
+    if (!nombre##_reservar_(tabla, capacidad)) {                                                             \
+        *tabla = vieja;                                                                                      \
+        return false;                                                                                        \
+    }                                                                                                        \
+    for (size_t i = 0; i < vieja.capacidad; i++) {                                                           \
+        if (!vieja.ocupados[i])                                                                              \
+            continue;                                                                                        \
+        pos = nombre##_inicio_(tabla, vieja.pares[i].clave);                                                 \
+        while (tabla->ocupados[pos])                                                                         \
+            pos = (pos + 1) & (tabla->capacidad - 1);                                                        \
+        tabla->pares[pos] = vieja.pares[i];                                                                  \
+        tabla->ocupados[pos] = true;                                                                         \
+    }                                                                                                        \
+    alocador_liberar(&tabla->alocador, vieja.pares, vieja.capacidad * sizeof(nombre##_par_t));               \
+    alocador_liberar(&tabla->alocador, vieja.ocupados, vieja.capacidad * sizeof(bool));                      \
+    return true;                                                                                             \
+}                                                                                                            \
+                                                                                                             \
+/* Devuelve la posición de la clave. Si no estaba la agrega, sin nada más que                                \
+ * la clave en el par, y deja nueva en true; devuelve la capacidad si no hay                                 \
+ * memoria para agrandar la tabla */                                                                         \
+static inline size_t nombre##_ubicar_(nombre##_t *tabla, tipo_clave clave, bool *nueva) {                    \
+    size_t pos = nombre##_buscar_(tabla, clave);                                                             \
+    *nueva = !tabla->ocupados[pos];                                                                          \
+    if (!*nueva)                                                                                             \
+        return pos;                                                                                          \
+    /* Clave nueva: se agranda antes de pasar de 3/4 y se vuelve a buscar su lugar */                        \
+    if ((tabla->cantidad + 1) * 4 > tabla->capacidad * 3) {                                                  \
+        if (!nombre##_redimensionar_(tabla, tabla->capacidad * 2))                                           \
+            return tabla->capacidad;                                                                         \
+        pos = nombre##_buscar_(tabla, clave);                                                                \
+    }                                                                                                        \
+    tabla->ocupados[pos] = true;                                                                             \
+    tabla->pares[pos].clave = clave;                                                                         \
+    tabla->cantidad++;                                                                                       \
+    return pos;                                                                                              \
+}                                                                                                            \
+                                                                                                             \
+/* Saca el par de la posición hueco, que está ocupada */                                                     \
+static inline void nombre##_quitar_(nombre##_t *tabla, size_t hueco) {                                       \
+    size_t mascara = tabla->capacidad - 1, pos, inicio;                                                      \
+    /* Corrimiento hacia atrás: los pares siguientes del grupo que pueden                                    \
+     * ocupar el hueco se mueven a él, así ninguna búsqueda se corta antes */                                \
+    for (pos = (hueco + 1) & mascara; tabla->ocupados[pos]; pos = (pos + 1) & mascara) {                     \
+        inicio = nombre##_inicio_(tabla, tabla->pares[pos].clave);                                           \
+        if (((pos - inicio) & mascara) >= ((pos - hueco) & mascara)) {                                       \
+            tabla->pares[hueco] = tabla->pares[pos];                                                         \
+            hueco = pos;                                                                                     \
+        }                                                                                                    \
+    }                                                                                                        \
+    tabla->ocupados[hueco] = false;                                                                          \
+    tabla->cantidad--;                                                                                       \
+    if (tabla->capacidad > HASH_TIPADO_CAPACIDAD_INICIAL && tabla->cantidad * 8 < tabla->capacidad)          \
+        nombre##_redimensionar_(tabla, tabla->capacidad / 2);                                                \
+}                                                                                                            \
+                                                                                                             \
+static inline nombre##_t *nombre##_crear_con_alocador(const alocador_t *alocador) {                          \
+    nombre##_t *tabla = alocador_reservar(alocador, sizeof(*tabla));                                         \
+    if (!tabla)                                                                                              \
+        return NULL;                                                                                         \
+    tabla->alocador = *alocador;                                                                             \
+    tabla->cantidad = 0;                                                                                     \
+    if (!nombre##_reservar_(tabla, HASH_TIPADO_CAPACIDAD_INICIAL)) {                                         \
+        alocador_liberar(alocador, tabla, sizeof(*tabla));                                                   \
+        return NULL;                                                                                         \
+    }                                                                                                        \
+    return tabla;                                                                                            \
+}                                                                                                            \
+                                                                                                             \
+static inline nombre##_t *nombre##_crear(void) {                                                             \
+    return nombre##_crear_con_alocador(alocador_estandar());                                                 \
+}                                                                                                            \
+                                                                                                             \
+static inline bool nombre##_asegurar(nombre##_t *tabla, size_t cantidad) {                                   \
+    size_t capacidad = tabla->capacidad;                                                                     \
+    while (cantidad * 4 > capacidad * 3)                                                                     \
+        capacidad *= 2;                                                                                      \
+    return (capacidad == tabla->capacidad || nombre##_redimensionar_(tabla, capacidad));                     \
+}                                                                                                            \
+                                                                                                             \
+static inline bool nombre##_pertenece(const nombre##_t *tabla, tipo_clave clave) {                           \
+    return tabla->ocupados[nombre##_buscar_(tabla, clave)];                                                  \
+}                                                                                                            \
+                                                                                                             \
+static inline size_t nombre##_cantidad(const nombre##_t *tabla) {                                            \
+    return tabla->cantidad;                                                                                  \
+}                                                                                                            \
+                                                                                                             \
+static inline void nombre##_destruir(nombre##_t *tabla) {                                                    \
+    alocador_t alocador = tabla->alocador;                                                                   \
+    alocador_liberar(&alocador, tabla->pares, tabla->capacidad * sizeof(nombre##_par_t));                    \
+    alocador_liberar(&alocador, tabla->ocupados, tabla->capacidad * sizeof(bool));                           \
+    alocador_liberar(&alocador, tabla, sizeof(*tabla));                                                      \
+}
+
+#define HASH_DEFINIR(nombre, tipo_clave, tipo_valor, fn_hash, fn_igual)                                      \
+                                                                                                             \
+HASH_TIPADO_NUCLEO_(nombre, tipo_clave, tipo_valor valor;, fn_hash, fn_igual)                                \
+                                                                                                             \
+static inline bool nombre##_guardar(nombre##_t *tabla, tipo_clave clave, tipo_valor valor) {                 \
+    bool nueva;                                                                                              \
+    size_t pos = nombre##_ubicar_(tabla, clave, &nueva);                                                     \
+    if (pos == tabla->capacidad)                                                                             \
+        return false;                                                                                        \
+    tabla->pares[pos].valor = valor;                                                                         \
+    return true;                                                                                             \
+}                                                                                                            \
+                                                                                                             \
+static inline tipo_valor *nombre##_obtener(const nombre##_t *tabla, tipo_clave clave) {                      \
+    size_t pos = nombre##_buscar_(tabla, clave);                                                             \
+    return (tabla->ocupados[pos] ? &tabla->pares[pos].valor : NULL);                                         \
+}                                                                                                            \
+                                                                                                             \
+static inline bool nombre##_borrar(nombre##_t *tabla, tipo_clave clave, tipo_valor *valor) {                \
+    size_t pos = nombre##_buscar_(tabla, clave);                                                             \
+    if (!tabla->ocupados[pos])                                                                               \
+        return false;                                                                                        \
+    if (valor)                                                                                               \
+        *valor = tabla->pares[pos].valor;                                                                    \
+    nombre##_quitar_(tabla, pos);                                                                            \
+    return true;                                                                                             \
+}                                                                                                            \
+                                                                                                             \
+static inline void nombre##_iterar(const nombre##_t *tabla,                                                  \
+                                   bool (*visitar)(tipo_clave clave, tipo_valor *valor, void *extra),        \
+                                   void *extra) {                                                            \
+    for (size_t i = 0; i < tabla->capacidad; i++) {                                                          \
+        if (tabla->ocupados[i] && !visitar(tabla->pares[i].clave, &tabla->pares[i].valor, extra))            \
+            return;                                                                                          \
+    }                                                                                                        \
+}
+
+#define HASH_DEFINIR_CONJUNTO(nombre, tipo_clave, fn_hash, fn_igual)                                         \
+                                                                                                             \
+HASH_TIPADO_NUCLEO_(nombre, tipo_clave, , fn_hash, fn_igual)                                                 \
+                                                                                                             \
+static inline bool nombre##_agregar(nombre##_t *tabla, tipo_clave clave) {                                   \
+    bool nueva;                                                                                              \
+    return nombre##_ubicar_(tabla, clave, &nueva) < tabla->capacidad;                                        \
+}                                                                                                            \
+                                                                                                             \
+static inline bool nombre##_sacar(nombre##_t *tabla, tipo_clave clave) {                                     \
+    size_t pos = nombre##_buscar_(tabla, clave);                                                             \
+    if (!tabla->ocupados[pos])                                                                               \
+        return false;                                                                                        \
+    nombre##_quitar_(tabla, pos);                                                                            \
+    return true;                                                                                             \
+}                                                                                                            \
+                                                                                                             \
+static inline void nombre##_iterar(const nombre##_t *tabla, bool (*visitar)(tipo_clave clave, void *extra),  \
+                                   void *extra) {                                                            \
+    for (size_t i = 0; i < tabla->capacidad; i++) {                                                          \
+        if (tabla->ocupados[i] && !visitar(tabla->pares[i].clave, extra))                                    \
+            return;                                                                                          \
+    }                                                                                                        \
+}
+
+#endif // HASH_TIPADO_H
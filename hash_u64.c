@@ -0,0 +1,122 @@
+#include "hash_u64.h"
+#include "hash_tipado.h"
+
+HASH_DEFINIR(tabla_u64, uint64_t, void *, hash_tipado_hash_u64, hash_tipado_igual_u64)
+
+/* Definiciones de estructuras de la tabla de hash */
+
+struct hash_u64 {
+    tabla_u64_t *tabla;
+    hash_destruir_dato_t destruir_dato;
+};
+
+struct hash_u64_iter {
+    const tabla_u64_t *tabla;
+    size_t pos;
+};
+
+/* Devuelve la primera posición ocupada desde pos, o la capacidad si no hay */
+static size_t buscar_ocupada(const tabla_u64_t *tabla, size_t pos) {
+    while (pos < tabla->capacidad && !tabla->ocupados[pos])
+        pos++;
+    return pos;
+}
+
+/**************************************
+ **  Primitivas de la Tabla de hash  **
+ **************************************/
+
+hash_u64_t *hash_u64_crear(hash_destruir_dato_t destruir_dato) {
+    return hash_u64_crear_con_alocador(destruir_dato, alocador_estandar());
+}
+
+hash_u64_t *hash_u64_crear_con_alocador(hash_destruir_dato_t destruir_dato, const alocador_t *alocador) {
+    hash_u64_t *hash = alocador_reservar(alocador, sizeof(*hash));
+    if (!hash)
+        return NULL;
+    hash->tabla = tabla_u64_crear_con_alocador(alocador);
+    if (!hash->tabla) {
+        alocador_liberar(alocador, hash, sizeof(*hash));
+        return NULL;
+    }
+    hash->destruir_dato = destruir_dato;
+    return hash;
+}
+
+bool hash_u64_guardar(hash_u64_t *hash, uint64_t clave, void *dato) {
+    void **anterior = tabla_u64_obtener(hash->tabla, clave);
+    /* Si la clave ya está solo se reemplaza el dato */
+    if (anterior) {
+        if (hash->destruir_dato)
+            hash->destruir_dato(*anterior);
+        *anterior = dato;
+        return true;
+    }
+    return tabla_u64_guardar(hash->tabla, clave, dato);
+}
+
+void *hash_u64_borrar(hash_u64_t *hash, uint64_t clave) {
+    void *dato;
+    return (tabla_u64_borrar(hash->tabla, clave, &dato) ? dato : NULL);
+}
+
+void *hash_u64_obtener(const hash_u64_t *hash, uint64_t clave) {
+    void **dato = tabla_u64_obtener(hash->tabla, clave);
+    return (dato ? *dato : NULL);
+}
+
+bool hash_u64_pertenece(const hash_u64_t *hash, uint64_t clave) {
+    return tabla_u64_pertenece(hash->tabla, clave);
+}
+
+size_t hash_u64_cantidad(const hash_u64_t *hash) {
+    return tabla_u64_cantidad(hash->tabla);
+}
+
+void hash_u64_destruir(hash_u64_t *hash) {
+    alocador_t alocador = hash->tabla->alocador;
+    size_t pos;
+
+    if (hash->destruir_dato) {
+        for (pos = buscar_ocupada(hash->tabla, 0); pos < hash->tabla->capacidad; pos = buscar_ocupada(hash->tabla, pos + 1))
+            hash->destruir_dato(hash->tabla->pares[pos].valor);
+    }
+    tabla_u64_destruir(hash->tabla);
+    alocador_liberar(&alocador, hash, sizeof(*hash));
+}
+
+/****************************************
+ **  Primitivas del Iterador del hash  **
+ ****************************************/
+
+hash_u64_iter_t *hash_u64_iter_crear(const hash_u64_t *hash) {
+    hash_u64_iter_t *iter = alocador_reservar(&hash->tabla->alocador, sizeof(*iter));
+    if (!iter)
+        return NULL;
+    iter->tabla = hash->tabla;
+    iter->pos = buscar_ocupada(hash->tabla, 0);
+    return iter;
+}
+
+bool hash_u64_iter_avanzar(hash_u64_iter_t *iter) {
+    if (hash_u64_iter_al_final(iter))
+        return false;
+    iter->pos = buscar_ocupada(iter->tabla, iter->pos + 1);
+    return true;
+}
+
+uint64_t hash_u64_iter_ver_actual(const hash_u64_iter_t *iter) {
+    return (hash_u64_iter_al_final(iter) ? 0 : iter->tabla->pares[iter->pos].clave);
+}
+
+void *hash_u64_iter_ver_dato(const hash_u64_iter_t *iter) {
+    return (hash_u64_iter_al_final(iter) ? NULL : iter->tabla->pares[iter->pos].valor);
+}
+
+bool hash_u64_iter_al_final(const hash_u64_iter_t *iter) {
+    return (iter->pos == iter->tabla->capacidad);
+}
+
+void hash_u64_iter_destruir(hash_u64_iter_t *iter) {
+    alocador_liberar(&iter->tabla->alocador, iter, sizeof(*iter));
+}
@@ -0,0 +1,139 @@
+#include "histograma.h"
+#include <stdlib.h>
+#include <string.h>
+#define DIGITOS_MAX 5
+
+/* Definición de la estructura del histograma.
+ *
+ * Los valores menores a sub_baldes se cuentan de a uno. Después, el balde e
+ * (e >= 1) agrupa los valores con sub_baldes / 2 <= (valor >> e) < sub_baldes
+ * en sub-baldes de ancho 2^e, así todos los valores del histograma se
+ * representan con bits_sub bits significativos.
+ */
+struct histograma {
+    uint64_t *contadores;
+    size_t cantidad_contadores;
+    unsigned bits_sub;   // log2 de la cantidad de sub-baldes
+    uint64_t limite;     // Mayor valor con contador propio
+    uint64_t cantidad;
+    uint64_t suma;
+    uint64_t minimo;
+    uint64_t maximo;
+};
+
+/* Funciones auxiliares */
+
+static unsigned log2_piso(uint64_t valor) {
+#ifdef __GNUC__
+    return 63u - (unsigned) __builtin_clzll(valor);
+#else
+    unsigned log = 0;
+    while (valor >>= 1)
+        log++;
+    return log;
+#endif
+}
+
+static size_t histograma_indice(const histograma_t *histograma, uint64_t valor) {
+    unsigned corrimiento;
+
+    if (valor >> histograma->bits_sub == 0)
+        return (size_t) valor;
+    corrimiento = log2_piso(valor) - (histograma->bits_sub - 1);
+    return ((size_t) corrimiento << (histograma->bits_sub - 1)) + (size_t) (valor >> corrimiento);
+}
+
+/* Devuelve el mayor valor que cae en el mismo sub-balde del índice */
+static uint64_t histograma_valor_alto(const histograma_t *histograma, size_t indice) {
+    size_t mitad = (size_t) 1 << (histograma->bits_sub - 1);
+    unsigned corrimiento;
+
+    if (indice < 2 * mitad)
+        return indice;
+    corrimiento = (unsigned) (indice / mitad - 1);
+    return (((uint64_t) (indice - corrimiento * mitad)) << corrimiento) + (((uint64_t) 1 << corrimiento) - 1);
+}
+
+/* Primitivas del histograma */
+
+histograma_t *histograma_crear(uint64_t maximo, unsigned digitos) {
+    histograma_t *histograma;
+    uint64_t sub_baldes = 2;
+
+    if (digitos < 1 || digitos > DIGITOS_MAX)
+        return NULL;
+    histograma = calloc(1, sizeof(*histograma));
+    if (!histograma)
+        return NULL;
+    /* Con 2 * 10^digitos sub-baldes, el ancho de cada uno es a lo sumo una parte en 10^digitos */
+    while (digitos--)
+        sub_baldes *= 10;
+    histograma->bits_sub = log2_piso(sub_baldes - 1) + 1;
+    histograma->limite = (maximo < 1 ? 1 : maximo);
+    histograma->cantidad_contadores = histograma_indice(histograma, histograma->limite) + 1;
+    histograma->contadores = calloc(histograma->cantidad_contadores, sizeof(uint64_t));
+    if (!histograma->contadores) {
+        free(histograma);
+        return NULL;
+    }
+    return histograma;
+}
+
+void histograma_registrar(histograma_t *histograma, uint64_t valor) {
+    histograma->contadores[histograma_indice(histograma, valor < histograma->limite ? valor : histograma->limite)]++;
+    if (!histograma->cantidad || valor < histograma->minimo)
+        histograma->minimo = valor;
+    if (valor > histograma->maximo)
+        histograma->maximo = valor;
+    histograma->cantidad++;
+    histograma->suma += valor;
+}
+
+uint64_t histograma_cantidad(const histograma_t *histograma) {
+    return histograma->cantidad;
+}
+
+double histograma_media(const histograma_t *histograma) {
+    return (histograma->cantidad ? (double) histograma->suma / (double) histograma->cantidad : 0);
+}
+
+uint64_t histograma_minimo(const histograma_t *histograma) {
+    return histograma->minimo;
+}
+
+uint64_t histograma_maximo(const histograma_t *histograma) {
+    return histograma->maximo;
+}
+
+uint64_t histograma_percentil(const histograma_t *histograma, double percentil) {
+    uint64_t objetivo, acumulado = 0, valor;
+    size_t i;
+
+    if (!histograma->cantidad)
+        return 0;
+    if (percentil > 100)
+        percentil = 100;
+    objetivo = (uint64_t) (percentil / 100 * (double) histograma->cantidad + 0.5);
+    if (objetivo < 1)
+        objetivo = 1;
+    for (i = 0; i < histograma->cantidad_contadores; i++) {
+        acumulado += histograma->contadores[i];
+        if (acumulado >= objetivo)
+            break;
+    }
+    valor = histograma_valor_alto(histograma, i);
+    return (valor < histograma->maximo ? valor : histograma->maximo);
+}
+
+void histograma_reiniciar(histograma_t *histograma) {
+    memset(histograma->contadores, 0, histograma->cantidad_contadores * sizeof(uint64_t));
+    histograma->cantidad = 0;
+    histograma->suma = 0;
+    histograma->minimo = 0;
+    histograma->maximo = 0;
+}
+
+void histograma_destruir(histograma_t *histograma) {
+    free(histograma->contadores);
+    free(histograma);
+}
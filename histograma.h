@@ -0,0 +1,66 @@
+#ifndef HISTOGRAMA_H
+#define HISTOGRAMA_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Histograma de valores enteros con precisión relativa acotada, al estilo
+ * HdrHistogram. Los valores se agrupan en baldes de ancho creciente en
+ * potencias de dos, y cada balde se divide en sub-baldes, así el error de
+ * cualquier valor registrado es menor a una parte en 10^digitos. Registrar
+ * es O(1) y no reserva memoria, la memoria depende solo del rango y la
+ * precisión, no de la cantidad de valores.
+ */
+
+typedef struct histograma histograma_t;
+
+/* Crea un histograma para valores entre 0 y maximo con la cantidad de
+ * dígitos significativos pedida (entre 1 y 5).
+ * Post: devuelve un histograma vacío, o NULL si falló.
+ */
+histograma_t *histograma_crear(uint64_t maximo, unsigned digitos);
+
+/* Registra un valor. Los valores mayores al máximo del histograma se cuentan
+ * en el último balde, pero histograma_maximo devuelve el valor exacto.
+ * Pre: el histograma fue creado
+ */
+void histograma_registrar(histograma_t *histograma, uint64_t valor);
+
+/* Devuelve la cantidad de valores registrados.
+ * Pre: el histograma fue creado
+ */
+uint64_t histograma_cantidad(const histograma_t *histograma);
+
+/* Devuelve el promedio de los valores registrados, o 0 si está vacío.
+ * Pre: el histograma fue creado
+ */
+double histograma_media(const histograma_t *histograma);
+
+/* Devuelve el menor valor registrado, o 0 si está vacío.
+ * Pre: el histograma fue creado
+ */
+uint64_t histograma_minimo(const histograma_t *histograma);
+
+/* Devuelve el mayor valor registrado, o 0 si está vacío.
+ * Pre: el histograma fue creado
+ */
+uint64_t histograma_maximo(const histograma_t *histograma);
+
+/* Devuelve el valor por debajo del cual (inclusive) está el percentil
+ * pedido de los valores registrados, con percentil entre 0 y 100. El valor
+ * devuelto es el mayor equivalente de su sub-balde, acotado por el máximo.
+ * Pre: el histograma fue creado
+ */
+uint64_t histograma_percentil(const histograma_t *histograma, double percentil);
+
+/* Vacía el histograma, manteniendo su rango y precisión.
+ * Pre: el histograma fue creado
+ */
+void histograma_reiniciar(histograma_t *histograma);
+
+/* Destruye el histograma.
+ * Pre: el histograma fue creado
+ */
+void histograma_destruir(histograma_t *histograma);
+
+#endif // HISTOGRAMA_H
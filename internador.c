@@ -0,0 +1,108 @@
+#include "internador.h"
+#include "alocador.h"
+#include "hash_tipado.h"
+#include <string.h>
+
+/* Cada copia canónica va precedida por su cuenta de referencias, en el mismo
+ * bloque. La tabla guarda la copia como clave y como valor, así buscar una
+ * cadena devuelve directamente su copia. */
+typedef struct copia {
+    size_t referencias;
+    char cadena[];
+} copia_t;
+
+HASH_DEFINIR(tabla_copias, const char *, char *, hash_tipado_hash_cadena, hash_tipado_igual_cadena)
+
+struct internador {
+    tabla_copias_t *copias;
+    size_t bytes_copias;
+};
+
+/* Funciones auxiliares */
+
+static copia_t *copia_de(const char *interna) {
+    return (copia_t *) (interna - offsetof(copia_t, cadena));
+}
+
+static size_t copia_tam(const char *cadena) {
+    return sizeof(copia_t) + strlen(cadena) + 1;
+}
+
+static bool liberar_copia(const char *clave, char **interna, void *extra) {
+    alocador_liberar(alocador_estandar(), copia_de(*interna), copia_tam(*interna));
+    return true;
+}
+
+/* Primitivas del internador */
+
+internador_t *internador_crear(void) {
+    internador_t *internador = alocador_reservar(alocador_estandar(), sizeof(*internador));
+    if (!internador)
+        return NULL;
+    internador->copias = tabla_copias_crear();
+    if (!internador->copias) {
+        alocador_liberar(alocador_estandar(), internador, sizeof(*internador));
+        return NULL;
+    }
+    internador->bytes_copias = 0;
+    return internador;
+}
+
+const char *internador_internar(internador_t *internador, const char *cadena) {
+    char **interna = tabla_copias_obtener(internador->copias, cadena);
+    size_t tam;
+    copia_t *copia;
+
+    if (interna) {
+        copia_de(*interna)->referencias++;
+        return *interna;
+    }
+    tam = copia_tam(cadena);
+    copia = alocador_reservar(alocador_estandar(), tam);
+    if (!copia)
+        return NULL;
+    copia->referencias = 1;
+    memcpy(copia->cadena, cadena, tam - sizeof(copia_t));
+    if (!tabla_copias_guardar(internador->copias, copia->cadena, copia->cadena)) {
+        alocador_liberar(alocador_estandar(), copia, tam);
+        return NULL;
+    }
+    internador->bytes_copias += tam;
+    return copia->cadena;
+}
+
+const char *internador_buscar(const internador_t *internador, const char *cadena) {
+    char **interna = tabla_copias_obtener(internador->copias, cadena);
+    return (interna ? *interna : NULL);
+}
+
+void internador_soltar(internador_t *internador, const char *interna) {
+    copia_t *copia = copia_de(interna);
+    size_t tam;
+
+    if (--copia->referencias > 0)
+        return;
+    tam = copia_tam(interna);
+    tabla_copias_borrar(internador->copias, interna, NULL);
+    internador->bytes_copias -= tam;
+    alocador_liberar(alocador_estandar(), copia, tam);
+}
+
+size_t internador_referencias(const internador_t *internador, const char *interna) {
+    return copia_de(interna)->referencias;
+}
+
+size_t internador_cantidad(const internador_t *internador) {
+    return tabla_copias_cantidad(internador->copias);
+}
+
+size_t internador_memoria(const internador_t *internador) {
+    return sizeof(*internador) + sizeof(tabla_copias_t) +
+           internador->copias->capacidad * (sizeof(tabla_copias_par_t) + sizeof(bool)) + internador->bytes_copias;
+}
+
+void internador_destruir(internador_t *internador) {
+    tabla_copias_iterar(internador->copias, liberar_copia, NULL);
+    tabla_copias_destruir(internador->copias);
+    alocador_liberar(alocador_estandar(), internador, sizeof(*internador));
+}
@@ -0,0 +1,63 @@
+#ifndef INTERNADOR_H
+#define INTERNADOR_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/* Conjunto de cadenas internadas, compartido entre tablas.
+ *
+ * Internar una cadena devuelve su copia canónica: dos cadenas iguales
+ * internadas en el mismo internador dan el mismo puntero, así que se pueden
+ * comparar por puntero. Cada copia lleva la cuenta de sus referencias y se
+ * libera cuando se suelta la última. Los hashes creados con
+ * hash_crear_con_internador guardan las claves así, y una misma clave en
+ * varios de ellos ocupa memoria una sola vez.
+ */
+
+typedef struct internador internador_t;
+
+/* Crea un internador vacío.
+ * Post: devuelve el internador, o NULL si falló.
+ */
+internador_t *internador_crear(void);
+
+/* Devuelve la copia canónica de la cadena, creándola si no estaba, y le suma
+ * una referencia. Devuelve NULL si no pudo pedir memoria.
+ * Pre: el internador fue creado
+ */
+const char *internador_internar(internador_t *internador, const char *cadena);
+
+/* Devuelve la copia canónica de la cadena sin sumarle una referencia, o NULL
+ * si la cadena no está internada.
+ * Pre: el internador fue creado
+ */
+const char *internador_buscar(const internador_t *internador, const char *cadena);
+
+/* Resta una referencia a la copia canónica y la libera si era la última.
+ * Pre: el internador fue creado, interna fue devuelta por internador_internar
+ * y tiene referencias
+ */
+void internador_soltar(internador_t *internador, const char *interna);
+
+/* Devuelve la cantidad de referencias de la copia canónica.
+ * Pre: el internador fue creado, interna fue devuelta por internador_internar
+ * y tiene referencias
+ */
+size_t internador_referencias(const internador_t *internador, const char *interna);
+
+/* Devuelve la cantidad de cadenas distintas internadas.
+ * Pre: el internador fue creado
+ */
+size_t internador_cantidad(const internador_t *internador);
+
+/* Devuelve los bytes que ocupan el internador y sus copias.
+ * Pre: el internador fue creado
+ */
+size_t internador_memoria(const internador_t *internador);
+
+/* Destruye el internador y todas sus copias.
+ * Pre: el internador fue creado, y ya no lo usa ningún hash
+ */
+void internador_destruir(internador_t *internador);
+
+#endif // INTERNADOR_H
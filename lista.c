@@ -1,53 +1,151 @@
 #include "lista.h"
-#include <stdlib.h>
+#include <string.h>
+/* Datos por nodo, así un nodo con sus etiquetas ocupa una línea de cache de 64 bytes */
+#define DATOS_POR_NODO 5
 
-/* Definicion de la estructura lista */
+/* Definicion de la estructura lista.
+ * Es una lista desenrollada: cada nodo guarda varios datos contiguos, así
+ * recorrer una lista corta toca un solo nodo. Junto a cada dato va su
+ * etiqueta, para que lista_iter_buscar descarte datos sin leerlos. Ningún
+ * nodo de la lista queda vacío. */
 typedef struct nodo nodo_t;
 struct nodo {
-    void * dato;   // Puntero al dato guardado
     nodo_t * sig;   // Puntero al siguiente nodo
+    nodo_t * ant;   // Puntero al nodo anterior
+    void * datos[DATOS_POR_NODO];
+    uint8_t etiquetas[DATOS_POR_NODO];
+    uint8_t cantidad;   // Datos ocupados, desde datos[0]
 };
 
 struct lista {
     nodo_t * primer;   // Puntero al primer nodo
     nodo_t * ultimo;   // Puntero al ultimo nodo
     size_t largo;
+    size_t nodos;      // Nodos pedidos, incluyendo los de la reserva
+    nodo_t * reserva;  // Nodos libres para las inserciones reservadas, enlazados por sig
+    size_t reservados; // Inserciones al principio reservadas y todavía no hechas
+    const alocador_t * alocador;   // De donde salen la lista, sus nodos y sus iteradores
 };
 
+/* El iterador está en el dato pos del nodo actual, o al final si actual es NULL */
 struct lista_iter {
     nodo_t * actual;
-    nodo_t * anterior;
+    size_t pos;
     lista_t * lista;
+    const alocador_t * alocador;
 };
 
 /* Funciones auxiliares */
-static nodo_t * crear_nodo(void * dato) {
-    nodo_t * nuevo = malloc(sizeof(*nuevo));
-    if (!nuevo)
-        return NULL;
-    nuevo->dato = dato;
+
+/* Devuelve un nodo vacío, de la reserva si hay o pidiéndolo al alocador */
+static nodo_t * crear_nodo(lista_t * lista) {
+    nodo_t * nuevo = lista->reserva;
+    if (nuevo) {
+        lista->reserva = nuevo->sig;
+    } else {
+        nuevo = alocador_reservar(lista->alocador, sizeof(*nuevo));
+        if (!nuevo)
+            return NULL;
+        lista->nodos++;
+    }
     nuevo->sig = NULL;
+    nuevo->ant = NULL;
+    nuevo->cantidad = 0;
     return nuevo;
 }
 
-static void lista_destruir_nodos(nodo_t * nodo, void destruir_dato(void*)) {
-    if (!nodo)
-        return;
-    if (destruir_dato)
-        destruir_dato(nodo->dato);
-    lista_destruir_nodos(nodo->sig, destruir_dato);
-    free(nodo);
-    return;
+static void destruir_nodo(lista_t * lista, nodo_t * nodo) {
+    alocador_liberar(lista->alocador, nodo, sizeof(*nodo));
+    lista->nodos--;
+}
+
+/* Engancha nuevo después de nodo, o al principio si nodo es NULL */
+static void enlazar_despues(lista_t * lista, nodo_t * nodo, nodo_t * nuevo) {
+    nuevo->ant = nodo;
+    nuevo->sig = (nodo ? nodo->sig : lista->primer);
+    if (nuevo->sig)
+        nuevo->sig->ant = nuevo;
+    else
+        lista->ultimo = nuevo;
+    if (nodo)
+        nodo->sig = nuevo;
+    else
+        lista->primer = nuevo;
+}
+
+/* Desengancha el nodo, que quedó vacío, y lo libera */
+static void quitar_nodo(lista_t * lista, nodo_t * nodo) {
+    if (nodo->ant)
+        nodo->ant->sig = nodo->sig;
+    else
+        lista->primer = nodo->sig;
+    if (nodo->sig)
+        nodo->sig->ant = nodo->ant;
+    else
+        lista->ultimo = nodo->ant;
+    destruir_nodo(lista, nodo);
+}
+
+/* Pone el dato con su etiqueta en la posición pos del nodo, que tiene lugar */
+static void nodo_insertar(nodo_t * nodo, size_t pos, void * dato, uint8_t etiqueta) {
+    memmove(&nodo->datos[pos + 1], &nodo->datos[pos], (nodo->cantidad - pos) * sizeof(void *));
+    memmove(&nodo->etiquetas[pos + 1], &nodo->etiquetas[pos], nodo->cantidad - pos);
+    nodo->datos[pos] = dato;
+    nodo->etiquetas[pos] = etiqueta;
+    nodo->cantidad++;
+}
+
+/* Saca el dato de la posición pos del nodo y lo devuelve */
+static void * nodo_sacar(nodo_t * nodo, size_t pos) {
+    void * dato = nodo->datos[pos];
+    nodo->cantidad--;
+    memmove(&nodo->datos[pos], &nodo->datos[pos + 1], (nodo->cantidad - pos) * sizeof(void *));
+    memmove(&nodo->etiquetas[pos], &nodo->etiquetas[pos + 1], nodo->cantidad - pos);
+    return dato;
+}
+
+/* Lugares libres para insertar al principio sin crear un nodo */
+static size_t huecos_al_principio(const lista_t * lista) {
+    return (lista->primer ? DATOS_POR_NODO - lista->primer->cantidad : 0);
+}
+
+static size_t largo_reserva(const lista_t * lista) {
+    size_t largo = 0;
+    for (nodo_t * nodo = lista->reserva; nodo; nodo = nodo->sig)
+        largo++;
+    return largo;
+}
+
+/* Libera los nodos de la cadena y, si se recibe destruir_dato, sus datos.
+ * Es iterativa, así una lista larga no agota la pila */
+static void lista_destruir_nodos(const alocador_t * alocador, nodo_t * nodo, void destruir_dato(void*)) {
+    nodo_t * sig;
+    for (; nodo; nodo = sig) {
+        sig = nodo->sig;
+        if (destruir_dato) {
+            for (size_t i = 0; i < nodo->cantidad; i++)
+                destruir_dato(nodo->datos[i]);
+        }
+        alocador_liberar(alocador, nodo, sizeof(*nodo));
+    }
 }
 
 /* Primitivas de la lista */
 lista_t *lista_crear(void) {
-    lista_t * nueva = malloc(sizeof(*nueva));
+    return lista_crear_con_alocador(alocador_estandar());
+}
+
+lista_t *lista_crear_con_alocador(const alocador_t *alocador) {
+    lista_t * nueva = alocador_reservar(alocador, sizeof(*nueva));
     if (!nueva)
         return NULL;
     nueva->primer = NULL;
     nueva->ultimo = NULL;
     nueva->largo = 0;
+    nueva->nodos = 0;
+    nueva->reserva = NULL;
+    nueva->reservados = 0;
+    nueva->alocador = alocador;
     return nueva;
 }
 
@@ -56,59 +154,109 @@ bool lista_esta_vacia(const lista_t *lista) {
 }
 
 bool lista_insertar_primero(lista_t *lista, void *dato) {
-    nodo_t * nuevo = crear_nodo(dato);
-    if (!nuevo)
-        return false;
-    if (lista_esta_vacia(lista))
-        lista->ultimo = nuevo;
-    nuevo->sig = lista->primer;
-    lista->primer = nuevo;
+    return lista_insertar_primero_con_etiqueta(lista, dato, 0);
+}
+
+bool lista_insertar_primero_con_etiqueta(lista_t *lista, void *dato, uint8_t etiqueta) {
+    nodo_t * nuevo;
+    if (!huecos_al_principio(lista)) {
+        nuevo = crear_nodo(lista);
+        if (!nuevo)
+            return false;
+        enlazar_despues(lista, NULL, nuevo);
+    }
+    nodo_insertar(lista->primer, 0, dato, etiqueta);
+    if (lista->reservados)
+        --(lista->reservados);
     ++(lista->largo);
     return true;
 }
 
 bool lista_insertar_ultimo(lista_t *lista, void *dato) {
-    nodo_t * nuevo = crear_nodo(dato);
-    if (!nuevo)
-        return false;
-    if (lista_esta_vacia(lista)) {
-        lista->primer = nuevo;
-    } else {
-        lista->ultimo->sig = nuevo;
+    return lista_insertar_ultimo_con_etiqueta(lista, dato, 0);
+}
+
+bool lista_insertar_ultimo_con_etiqueta(lista_t *lista, void *dato, uint8_t etiqueta) {
+    nodo_t * nuevo;
+    if (lista_esta_vacia(lista) || lista->ultimo->cantidad == DATOS_POR_NODO) {
+        nuevo = crear_nodo(lista);
+        if (!nuevo)
+            return false;
+        enlazar_despues(lista, lista->ultimo, nuevo);
     }
-    lista->ultimo = nuevo;
+    nodo_insertar(lista->ultimo, lista->ultimo->cantidad, dato, etiqueta);
     ++(lista->largo);
     return true;
 }
 
 void *lista_borrar_primero(lista_t *lista) {
     void * primer_dato;
-    nodo_t * primer_nodo = lista->primer;
     if (lista_esta_vacia(lista))
         return NULL;
-    /* Si primer era el único nodo, entonces último es NULL */
-    if (!lista->primer->sig)
-        lista->ultimo = NULL;
-    primer_dato = lista->primer->dato;
-    lista->primer = lista->primer->sig;
+    primer_dato = nodo_sacar(lista->primer, 0);
+    if (!lista->primer->cantidad)
+        quitar_nodo(lista, lista->primer);
     --(lista->largo);
-    free(primer_nodo);
     return primer_dato;
 }
 
+bool lista_reservar(lista_t *lista, size_t cantidad) {
+    size_t huecos = huecos_al_principio(lista), nodos_reserva = largo_reserva(lista), necesarios;
+    nodo_t * nuevo;
+
+    lista->reservados += cantidad;
+    necesarios = (lista->reservados > huecos ? (lista->reservados - huecos + DATOS_POR_NODO - 1) / DATOS_POR_NODO : 0);
+    for (; nodos_reserva < necesarios; nodos_reserva++) {
+        nuevo = alocador_reservar(lista->alocador, sizeof(*nuevo));
+        if (!nuevo) {
+            lista->reservados -= cantidad;
+            return false;
+        }
+        lista->nodos++;
+        nuevo->sig = lista->reserva;
+        lista->reserva = nuevo;
+    }
+    return true;
+}
+
+bool lista_transferir_primero(lista_t *origen, lista_t *destino) {
+    nodo_t * nuevo = NULL;
+    uint8_t etiqueta;
+    if (lista_esta_vacia(origen))
+        return false;
+    /* Si destino no tiene lugar se crea el nodo antes de tocar origen */
+    if (!huecos_al_principio(destino)) {
+        nuevo = crear_nodo(destino);
+        if (!nuevo)
+            return false;
+        enlazar_despues(destino, NULL, nuevo);
+    }
+    etiqueta = origen->primer->etiquetas[0];
+    nodo_insertar(destino->primer, 0, lista_borrar_primero(origen), etiqueta);
+    if (destino->reservados)
+        --(destino->reservados);
+    ++(destino->largo);
+    return true;
+}
+
 void *lista_ver_primero(const lista_t *lista) {
-    return (lista_esta_vacia(lista) ? NULL : lista->primer->dato);
+    return (lista_esta_vacia(lista) ? NULL : lista->primer->datos[0]);
 }
 
 size_t lista_largo(const lista_t *lista) {
     return lista->largo;
 }
 
+size_t lista_memoria(const lista_t *lista) {
+    return sizeof(*lista) + lista->nodos * sizeof(nodo_t);
+}
+
 void lista_destruir(lista_t *lista, void destruir_dato(void *)) {
     if (!lista)
         return;
-    lista_destruir_nodos(lista->primer, destruir_dato);
-    free(lista);
+    lista_destruir_nodos(lista->alocador, lista->primer, destruir_dato);
+    lista_destruir_nodos(lista->alocador, lista->reserva, NULL);
+    alocador_liberar(lista->alocador, lista, sizeof(*lista));
     return;
 }
 
@@ -118,29 +266,34 @@ lista_iter_t *lista_iter_crear(lista_t *lista) {
     /* La lista debe estar creada */
     if (!lista) return NULL;
 
-    nuevo = malloc(sizeof(*nuevo));
+    nuevo = alocador_reservar(lista->alocador, sizeof(*nuevo));
     if (!nuevo)
         return NULL;
     nuevo->actual = lista->primer;
-    nuevo->anterior = NULL;
+    nuevo->pos = 0;
     nuevo->lista = lista;
+    nuevo->alocador = lista->alocador;
     return nuevo;
 }
 
 bool lista_iter_avanzar(lista_iter_t *iter) {
     if (lista_iter_al_final(iter))
         return false;
-    iter->anterior = iter->actual;
-    iter->actual = iter->actual->sig;
+    if (++(iter->pos) == iter->actual->cantidad) {
+        iter->actual = iter->actual->sig;
+        iter->pos = 0;
+    }
     return true;
 }
 
 void *lista_iter_ver_actual(const lista_iter_t *iter) {
-    return (lista_iter_al_final(iter) ? NULL : iter->actual->dato);
+    return (lista_iter_al_final(iter) ? NULL : iter->actual->datos[iter->pos]);
 }
 
 bool lista_iter_al_principio(const lista_iter_t *iter) {
-    return (!iter->anterior);
+    if (lista_iter_al_final(iter))
+        return lista_esta_vacia(iter->lista);
+    return (!iter->actual->ant && !iter->pos);
 }
 
 bool lista_iter_al_final(const lista_iter_t *iter) {
@@ -148,50 +301,82 @@ bool lista_iter_al_final(const lista_iter_t *iter) {
 }
 
 void lista_iter_destruir(lista_iter_t *iter) {
-    free(iter);
+    alocador_liberar(iter->alocador, iter, sizeof(*iter));
 }
 
 bool lista_iter_insertar(lista_iter_t *iter, void *dato) {
-    nodo_t * nuevo = crear_nodo(dato);
-    if (!nuevo)
-        return false;
+    return lista_iter_insertar_con_etiqueta(iter, dato, 0);
+}
 
-    /* Si está al final de la lista el último va a ser el nodo insertado */
-    if (lista_iter_al_final(iter))
-        iter->lista->ultimo = nuevo;
-    /* Si está al principio de la lista el primer va a ser el nodo insertado */
-    if (lista_iter_al_principio(iter)) {
-        iter->lista->primer = nuevo;
-    } else {
-        iter->anterior->sig = nuevo;
+bool lista_iter_insertar_con_etiqueta(lista_iter_t *iter, void *dato, uint8_t etiqueta) {
+    lista_t * lista = iter->lista;
+    nodo_t * nodo = iter->actual, * nuevo;
+    size_t pos = iter->pos, mitad;
+
+    /* Al final se agrega en el último nodo, que es el anterior a la posición */
+    if (lista_iter_al_final(iter)) {
+        nodo = lista->ultimo;
+        pos = (nodo ? nodo->cantidad : 0);
+    }
+    if (!nodo || nodo->cantidad == DATOS_POR_NODO) {
+        nuevo = crear_nodo(lista);
+        if (!nuevo)
+            return false;
+        enlazar_despues(lista, nodo, nuevo);
+        /* Si el dato va dentro de un nodo lleno, se parte el nodo a la mitad */
+        if (nodo && pos < nodo->cantidad) {
+            mitad = nodo->cantidad / 2;
+            memcpy(nuevo->datos, &nodo->datos[mitad], (nodo->cantidad - mitad) * sizeof(void *));
+            memcpy(nuevo->etiquetas, &nodo->etiquetas[mitad], nodo->cantidad - mitad);
+            nuevo->cantidad = (uint8_t) (nodo->cantidad - mitad);
+            nodo->cantidad = (uint8_t) mitad;
+        }
+        if (!nodo || pos >= nodo->cantidad) {
+            pos -= (nodo ? nodo->cantidad : 0);
+            nodo = nuevo;
+        }
     }
-    nuevo->sig = iter->actual;
-    iter->actual = nuevo;
-    ++(iter->lista->largo);
+    nodo_insertar(nodo, pos, dato, etiqueta);
+    iter->actual = nodo;
+    iter->pos = pos;
+    ++(lista->largo);
     return true;
 }
 
+bool lista_iter_buscar(lista_iter_t *iter, uint8_t etiqueta, bool (*coincide)(void *dato, void *extra),
+                       void *extra) {
+    nodo_t * nodo;
+    size_t i;
+
+    for (nodo = iter->actual, i = iter->pos; nodo; nodo = nodo->sig, i = 0) {
+        for (; i < nodo->cantidad; i++) {
+            if (nodo->etiquetas[i] == etiqueta && coincide(nodo->datos[i], extra)) {
+                iter->actual = nodo;
+                iter->pos = i;
+                return true;
+            }
+        }
+    }
+    iter->actual = NULL;
+    iter->pos = 0;
+    return false;
+}
+
 void *lista_iter_borrar(lista_iter_t *iter) {
     void * dato;
-    nodo_t * aux;
+    nodo_t * nodo = iter->actual;
     /* Nada para borrar */
     if (lista_iter_al_final(iter))
         return NULL;
 
-    aux = iter->actual->sig;
-    /* Si está al principio el primer va a ser el siguiente al actual */
-    if (lista_iter_al_principio(iter)) {
-        iter->lista->primer = aux;
-    } else {
-        iter->anterior->sig = aux; /* Caso general */
-    }
-    /* Si el actual era el último, el último va a ser el anterior */
-    if (!aux) {
-        iter->lista->ultimo = iter->anterior;
+    dato = nodo_sacar(nodo, iter->pos);
+    /* El siguiente dato está en la misma posición, o al principio del nodo siguiente */
+    if (iter->pos == nodo->cantidad) {
+        iter->actual = nodo->sig;
+        iter->pos = 0;
     }
-    dato = iter->actual->dato;
-    free(iter->actual);
-    iter->actual = aux;
+    if (!nodo->cantidad)
+        quitar_nodo(iter->lista, nodo);
     --(iter->lista->largo);
     return dato;
 }
@@ -201,8 +386,10 @@ void lista_iterar(lista_t *lista, bool (*visitar)(void *dato, void *extra), void
     nodo_t * actual;
 
     for (actual = lista->primer; actual != NULL; actual = actual->sig) {
-        if (!visitar(actual->dato, extra)) {
-            return;
+        for (size_t i = 0; i < actual->cantidad; i++) {
+            if (!visitar(actual->datos[i], extra)) {
+                return;
+            }
         }
     }
 }
@@ -1,8 +1,10 @@
 #ifndef LISTA_H
 #define LISTA_H
 
+#include "alocador.h"
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 
 /* Declaraciones de estructuras */
 typedef struct lista lista_t;
@@ -15,6 +17,13 @@ typedef struct lista_iter lista_iter_t;
  */
 lista_t *lista_crear(void);
 
+/* Crea una lista que pide su memoria, la de sus nodos y la de sus iteradores
+ * al alocador, que debe vivir al menos tanto como la lista y sus iteradores.
+ * Devuelve NULL en caso de error.
+ * Post: devuelve una nueva lista vacía.
+ */
+lista_t *lista_crear_con_alocador(const alocador_t *alocador);
+
 /* Devuelve verdadero o falso, según si la lista tiene o no elementos insertados.
  * Pre: la lista fue creada.
  */
@@ -32,6 +41,14 @@ bool lista_insertar_primero(lista_t *lista, void *dato);
  */
 bool lista_insertar_ultimo(lista_t *lista, void *dato);
 
+/* Cada elemento lleva una etiqueta de un byte, guardada junto al dato, que
+ * lista_iter_buscar compara antes de mirar el dato. Las primitivas sin
+ * _con_etiqueta insertan con etiqueta 0; transferir conserva la etiqueta.
+ * Pre: la lista fue creada.
+ */
+bool lista_insertar_primero_con_etiqueta(lista_t *lista, void *dato, uint8_t etiqueta);
+bool lista_insertar_ultimo_con_etiqueta(lista_t *lista, void *dato, uint8_t etiqueta);
+
 /* Saca el primer elemento de la lista. Si la lista tiene elementos, se quita el
  * primero de la lista, y se devuelve su valor, si está vacía, devuelve NULL.
  * Pre: la lista fue creada.
@@ -40,6 +57,23 @@ bool lista_insertar_ultimo(lista_t *lista, void *dato);
  */
 void *lista_borrar_primero(lista_t *lista);
 
+/* Reserva lugar para cantidad inserciones más al principio de la lista,
+ * además de las ya reservadas: mientras no se inserte en otro lugar, las
+ * próximas inserciones al principio (lista_insertar_primero, o como destino
+ * de lista_transferir_primero) no piden memoria. Devuelve false si no pudo
+ * pedirla, y en ese caso no cambia lo reservado.
+ * Pre: la lista fue creada.
+ */
+bool lista_reservar(lista_t *lista, size_t cantidad);
+
+/* Mueve el primer elemento de origen al principio de destino. Solo pide
+ * memoria si destino no tiene lugar reservado (ver lista_reservar).
+ * Devuelve false si origen estaba vacía o no se pudo pedir memoria.
+ * Pre: ambas listas fueron creadas.
+ * Post: origen tiene un elemento menos y destino uno más, si origen no estaba vacía.
+ */
+bool lista_transferir_primero(lista_t *origen, lista_t *destino);
+
 /* Obtiene el valor del primer elemento de la lista. Si la lista tiene
  * elementos, se devuelve el valor del primero, si está vacía devuelve NULL.
  * Pre: la lista fue creada.
@@ -52,6 +86,12 @@ void *lista_ver_primero(const lista_t *lista);
  */
 size_t lista_largo(const lista_t *lista);
 
+/* Devuelve los bytes que ocupan la lista y sus nodos, incluyendo los
+ * reservados, sin contar los datos.
+ * Pre: la lista fue creada.
+ */
+size_t lista_memoria(const lista_t *lista);
+
 /* Destruye la lista. Si se recibe la función destruir_dato por parámetro,
  * para cada uno de los elementos de la lista llama a destruir_dato.
  * Pre: destruir_dato es una función capaz de destruir
@@ -100,6 +140,19 @@ void lista_iter_destruir(lista_iter_t *iter);
  */
 bool lista_iter_insertar(lista_iter_t *iter, void *dato);
 
+/* Como lista_iter_insertar, con la etiqueta del elemento insertado.
+ * Pre: el iterador fue creado, la lista fue creada.
+ */
+bool lista_iter_insertar_con_etiqueta(lista_iter_t *iter, void *dato, uint8_t etiqueta);
+
+/* Avanza el iterador, desde la posición actual, hasta el primer elemento con
+ * la etiqueta para el que coincide(dato, extra) devuelve true. Los elementos
+ * con otra etiqueta se saltean sin pasarle su dato a coincide. Devuelve false
+ * y deja el iterador al final si no hay ninguno.
+ * Pre: el iterador fue creado, la lista fue creada.
+ */
+bool lista_iter_buscar(lista_iter_t *iter, uint8_t etiqueta, bool (*coincide)(void *dato, void *extra), void *extra);
+
 /* Borra el elemento en la posición actual del iterador. Devuelve NULL si falló.
  * Deja el iterador en la posición del elemento siguiente al borrado.
  * Pre: el iterador fue creado, la lista fue creada.
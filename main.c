@@ -7,6 +7,25 @@
  * *****************************************************************/
 
 void pruebas_hash_catedra(void);
+void pruebas_hash_alumno(void);
+void pruebas_hash_archivo_alumno(void);
+void pruebas_hash_congelado_alumno(void);
+void pruebas_histograma_alumno(void);
+void pruebas_hash_medido_alumno(void);
+void pruebas_traza_alumno(void);
+void pruebas_alocador_paginas_alumno(void);
+void pruebas_hash_swiss_alumno(void);
+void pruebas_hash_tipado_alumno(void);
+void pruebas_hash_u64_alumno(void);
+void pruebas_internador_alumno(void);
+void pruebas_lista_alumno(void);
+void pruebas_hash_cuckoo_alumno(void);
+void pruebas_hash_lineal_alumno(void);
+void pruebas_hash_compacto_alumno(void);
+void pruebas_hash_conjunto_alumno(void);
+void pruebas_hash_multimapa_alumno(void);
+void pruebas_hash_compartido_alumno(void);
+void pruebas_hash_diario_alumno(void);
 void pruebas_volumen_catedra(size_t);
 
 int main(int argc, char *argv[])
@@ -21,5 +40,26 @@ int main(int argc, char *argv[])
     printf("~~~ PRUEBAS CÁTEDRA ~~~\n");
     pruebas_hash_catedra();
 
+    printf("~~~ PRUEBAS ALUMNO ~~~\n");
+    pruebas_hash_alumno();
+    pruebas_hash_archivo_alumno();
+    pruebas_hash_congelado_alumno();
+    pruebas_histograma_alumno();
+    pruebas_hash_medido_alumno();
+    pruebas_traza_alumno();
+    pruebas_alocador_paginas_alumno();
+    pruebas_hash_swiss_alumno();
+    pruebas_hash_tipado_alumno();
+    pruebas_hash_u64_alumno();
+    pruebas_internador_alumno();
+    pruebas_lista_alumno();
+    pruebas_hash_cuckoo_alumno();
+    pruebas_hash_lineal_alumno();
+    pruebas_hash_compacto_alumno();
+    pruebas_hash_conjunto_alumno();
+    pruebas_hash_multimapa_alumno();
+    pruebas_hash_compartido_alumno();
+    pruebas_hash_diario_alumno();
+
     return failure_count() > 0;
 }
@@ -0,0 +1,99 @@
+#include "alocador_paginas.h"
+#include "hash.h"
+#include "testing.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TAM_GRANDE ((size_t) 5 << 20)
+
+/* ******************************************************************
+ *                        PRUEBAS UNITARIAS
+ * *****************************************************************/
+
+static bool todo_en(const unsigned char *bloque, size_t tam, unsigned char valor)
+{
+    for (size_t i = 0; i < tam; i++) {
+        if (bloque[i] != valor)
+            return false;
+    }
+    return true;
+}
+
+static void prueba_alocador_paginas_bloques(alocador_numa_t numa)
+{
+    alocador_t alocador;
+    unsigned char *chico, *grande;
+
+    alocador_paginas_grandes(&alocador, numa);
+    chico = alocador_reservar_ceros(&alocador, 100);
+    grande = alocador_reservar_ceros(&alocador, TAM_GRANDE);
+    print_test("Prueba alocador paginas reservar bloque chico en cero", chico && todo_en(chico, 100, 0));
+    print_test("Prueba alocador paginas reservar bloque grande en cero", grande && todo_en(grande, TAM_GRANDE, 0));
+    print_test("Prueba alocador paginas el bloque grande esta alineado a 2MB",
+               grande && ((uintptr_t) grande & ((2u << 20) - 1)) == 0);
+
+    /* Redimensionar conserva el contenido al pasar de chico a grande y de vuelta */
+    memset(chico, 7, 100);
+    chico = alocador_redimensionar(&alocador, chico, 100, TAM_GRANDE);
+    print_test("Prueba alocador paginas redimensionar de chico a grande", chico && todo_en(chico, 100, 7));
+    memset(chico, 9, TAM_GRANDE);
+    chico = alocador_redimensionar(&alocador, chico, TAM_GRANDE, 50);
+    print_test("Prueba alocador paginas redimensionar de grande a chico", chico && todo_en(chico, 50, 9));
+
+    memset(grande, 1, TAM_GRANDE);
+    grande = alocador_redimensionar(&alocador, grande, TAM_GRANDE, TAM_GRANDE + 100);
+    print_test("Prueba alocador paginas agrandar bloque grande dentro de sus paginas",
+               grande && todo_en(grande, TAM_GRANDE, 1));
+    grande = alocador_redimensionar(&alocador, grande, TAM_GRANDE + 100, 3 * TAM_GRANDE);
+    print_test("Prueba alocador paginas agrandar bloque grande a otras paginas",
+               grande && todo_en(grande, TAM_GRANDE, 1));
+
+    alocador_liberar(&alocador, chico, 50);
+    alocador_liberar(&alocador, grande, 3 * TAM_GRANDE);
+}
+
+static void prueba_alocador_paginas_hash(size_t largo)
+{
+    alocador_t alocador;
+    hash_t* hash;
+    char clave[16];
+    bool ok = true;
+
+    alocador_paginas_grandes(&alocador, ALOCADOR_NUMA_INTERCALADO);
+    hash = hash_crear_con_alocador(NULL, &alocador);
+    print_test("Prueba alocador paginas crear hash", hash);
+
+    /* Con estas claves el arreglo de baldes supera una página grande */
+    for (unsigned i = 0; ok && i < largo; i++) {
+        sprintf(clave, "%08u", i);
+        ok = hash_guardar(hash, clave, NULL);
+    }
+    print_test("Prueba alocador paginas guardar muchos elementos", ok);
+    for (unsigned i = 0; ok && i < largo; i++) {
+        sprintf(clave, "%08u", i);
+        ok = hash_pertenece(hash, clave);
+    }
+    print_test("Prueba alocador paginas pertenecen todos", ok && hash_cantidad(hash) == largo);
+    for (unsigned i = 0; ok && i < largo; i++) {
+        sprintf(clave, "%08u", i);
+        hash_borrar(hash, clave);
+    }
+    print_test("Prueba alocador paginas borrar todos, la tabla se achica", hash_cantidad(hash) == 0);
+
+    hash_destruir(hash);
+}
+
+/* ******************************************************************
+ *                        FUNCIÓN PRINCIPAL
+ * *****************************************************************/
+
+void pruebas_alocador_paginas_alumno()
+{
+    /* Ejecuta todas las pruebas unitarias. */
+    prueba_alocador_paginas_bloques(ALOCADOR_NUMA_PRIMER_TOQUE);
+    prueba_alocador_paginas_bloques(ALOCADOR_NUMA_INTERCALADO);
+    prueba_alocador_paginas_hash(300000);
+}
@@ -0,0 +1,684 @@
+#include "hash.h"
+#include "testing.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/* ******************************************************************
+ *                        FUNCIONES AUXILIARES
+ * *****************************************************************/
+
+/* Reloj manual para controlar los vencimientos desde las pruebas */
+static uint64_t reloj_prueba_ahora;
+
+static uint64_t reloj_prueba(void)
+{
+    return reloj_prueba_ahora;
+}
+
+/* Cuenta los datos destruidos y verifica que ninguno se destruya antes de vencer */
+static size_t destruidos;
+static bool destruido_antes_de_tiempo;
+
+static void destruir_contando(void *dato)
+{
+    if (dato && *(uint64_t *) dato > reloj_prueba_ahora)
+        destruido_antes_de_tiempo = true;
+    destruidos++;
+}
+
+static size_t tam_dato_fijo(const void *dato)
+{
+    return 10;
+}
+
+/* Generador pseudoaleatorio reproducible */
+static uint64_t aleatorio_estado = 88172645463325252u;
+
+static uint64_t aleatorio(void)
+{
+    aleatorio_estado ^= aleatorio_estado << 13;
+    aleatorio_estado ^= aleatorio_estado >> 7;
+    aleatorio_estado ^= aleatorio_estado << 17;
+    return aleatorio_estado;
+}
+
+/* Alocador que lleva la cuenta de los bytes, puede fallar después de una
+ * cantidad de reservas y verifica que se libere con el tamaño reservado */
+#define CABECERA_ALOCADOR 16
+
+typedef struct alocador_prueba {
+    size_t bytes;
+    size_t restantes;   // Reservas que puede hacer antes de empezar a fallar
+    bool tam_incorrecto;
+} alocador_prueba_t;
+
+static void *prueba_reservar(void *contexto, size_t tam)
+{
+    alocador_prueba_t *prueba = contexto;
+    char *bloque;
+    if (!prueba->restantes || !(bloque = malloc(tam + CABECERA_ALOCADOR)))
+        return NULL;
+    prueba->restantes--;
+    prueba->bytes += tam;
+    *(size_t *) bloque = tam;
+    return bloque + CABECERA_ALOCADOR;
+}
+
+static void *prueba_redimensionar(void *contexto, void *bloque, size_t tam_anterior, size_t tam)
+{
+    alocador_prueba_t *prueba = contexto;
+    char *nuevo;
+    if (bloque && *(size_t *) ((char *) bloque - CABECERA_ALOCADOR) != tam_anterior)
+        prueba->tam_incorrecto = true;
+    if (!prueba->restantes ||
+        !(nuevo = realloc(bloque ? (char *) bloque - CABECERA_ALOCADOR : NULL, tam + CABECERA_ALOCADOR)))
+        return NULL;
+    prueba->restantes--;
+    prueba->bytes = prueba->bytes - tam_anterior + tam;
+    *(size_t *) nuevo = tam;
+    return nuevo + CABECERA_ALOCADOR;
+}
+
+static void prueba_liberar(void *contexto, void *bloque, size_t tam)
+{
+    alocador_prueba_t *prueba = contexto;
+    char *inicio = (char *) bloque - CABECERA_ALOCADOR;
+    if (*(size_t *) inicio != tam)
+        prueba->tam_incorrecto = true;
+    prueba->bytes -= tam;
+    free(inicio);
+}
+
+/* ******************************************************************
+ *                        PRUEBAS UNITARIAS
+ * *****************************************************************/
+
+static void prueba_hash_ttl()
+{
+    hash_t* hash = hash_crear(destruir_contando);
+    uint64_t vence_a = 10, vence_b = 20;
+
+    hash_establecer_reloj(hash, reloj_prueba);
+    reloj_prueba_ahora = 0;
+    destruidos = 0;
+
+    print_test("Prueba hash TTL guardar clave A", hash_guardar_con_ttl(hash, "A", &vence_a, 10));
+    print_test("Prueba hash TTL guardar clave B", hash_guardar_con_ttl(hash, "B", &vence_b, 20));
+    print_test("Prueba hash TTL guardar clave C sin TTL", hash_guardar(hash, "C", NULL));
+    reloj_prueba_ahora = 9;
+    print_test("Prueba hash TTL obtener A antes de vencer", hash_obtener(hash, "A") == &vence_a);
+    print_test("Prueba hash TTL expirar antes de tiempo no reclama nada", hash_expirar(hash, 9, 100) == 0);
+
+    reloj_prueba_ahora = 10;
+    print_test("Prueba hash TTL obtener A vencida es NULL", !hash_obtener(hash, "A"));
+    print_test("Prueba hash TTL pertenece A vencida es false", !hash_pertenece(hash, "A"));
+    print_test("Prueba hash TTL la vencida se cuenta hasta reclamarla", hash_cantidad(hash) == 3);
+    print_test("Prueba hash TTL expirar reclama A", hash_expirar(hash, 10, 100) == 1);
+    print_test("Prueba hash TTL se destruyó el dato de A", destruidos == 1);
+    print_test("Prueba hash TTL la cantidad de elementos es 2", hash_cantidad(hash) == 2);
+
+    /* Reemplazar con hash_guardar quita el vencimiento */
+    print_test("Prueba hash TTL reemplazar B sin TTL", hash_guardar(hash, "B", NULL));
+    print_test("Prueba hash TTL se destruyó el dato reemplazado", destruidos == 2);
+    reloj_prueba_ahora = 100;
+    print_test("Prueba hash TTL expirar no reclama B reemplazada", hash_expirar(hash, 100, 100) == 0);
+    print_test("Prueba hash TTL pertenece B", hash_pertenece(hash, "B"));
+
+    /* Borrar una clave vencida la reclama y devuelve NULL */
+    print_test("Prueba hash TTL guardar clave D", hash_guardar_con_ttl(hash, "D", &vence_a, 0));
+    print_test("Prueba hash TTL borrar D vencida es NULL", !hash_borrar(hash, "D"));
+    print_test("Prueba hash TTL se destruyó el dato de D", destruidos == 3);
+    print_test("Prueba hash TTL la cantidad de elementos es 2", hash_cantidad(hash) == 2);
+
+    hash_destruir(hash);
+}
+
+static void prueba_hash_ttl_cambiar_reloj()
+{
+    hash_t* hash = hash_crear(NULL);
+
+    /* La rueda se crea con el reloj monótono, que ya va muy por delante del de prueba */
+    print_test("Prueba hash TTL guardar clave A con el reloj monotono", hash_guardar_con_ttl(hash, "A", NULL, 1000));
+    hash_borrar(hash, "A");
+    hash_establecer_reloj(hash, reloj_prueba);
+    reloj_prueba_ahora = 0;
+    print_test("Prueba hash TTL guardar clave B con el reloj nuevo", hash_guardar_con_ttl(hash, "B", NULL, 1000));
+    print_test("Prueba hash TTL expirar antes de tiempo no reclama B", hash_expirar(hash, 0, 100) == 0);
+    print_test("Prueba hash TTL pertenece B", hash_pertenece(hash, "B"));
+    print_test("Prueba hash TTL expirar reclama B al vencer", hash_expirar(hash, 1000, (size_t) -1) == 1);
+
+    hash_destruir(hash);
+}
+
+static void prueba_hash_ttl_trabajo_acotado()
+{
+    hash_t* hash = hash_crear(destruir_contando);
+    uint64_t vencimiento = 5;
+    char clave[10];
+    size_t reclamadas, pasadas = 0;
+    bool ok = true;
+
+    hash_establecer_reloj(hash, reloj_prueba);
+    reloj_prueba_ahora = 0;
+    destruidos = 0;
+    for (unsigned i = 0; i < 100; i++) {
+        sprintf(clave, "%08u", i);
+        ok &= hash_guardar_con_ttl(hash, clave, &vencimiento, 5);
+    }
+    print_test("Prueba hash TTL guardar 100 claves", ok);
+
+    reloj_prueba_ahora = 1000;
+    do {
+        reclamadas = hash_expirar(hash, 1000, 10);
+        ok &= reclamadas <= 10;
+        pasadas++;
+    } while (hash_cantidad(hash) > 0 && pasadas < 100);
+    print_test("Prueba hash TTL cada pasada respeta max_trabajo", ok);
+    print_test("Prueba hash TTL se reclamaron todas en varias pasadas", hash_cantidad(hash) == 0 && pasadas > 1);
+    print_test("Prueba hash TTL se destruyeron todos los datos", destruidos == 100);
+
+    hash_destruir(hash);
+}
+
+static void prueba_hash_ttl_volumen(size_t largo)
+{
+    hash_t* hash = hash_crear(destruir_contando);
+    uint64_t *vencimientos = malloc(largo * sizeof(uint64_t));
+    char clave[10];
+    bool ok = true;
+    size_t vencidas;
+
+    hash_establecer_reloj(hash, reloj_prueba);
+    reloj_prueba_ahora = 0;
+    destruidos = 0;
+    destruido_antes_de_tiempo = false;
+
+    /* Vencimientos repartidos en todos los niveles de la rueda y más allá de su alcance */
+    for (unsigned i = 0; i < largo; i++) {
+        uint64_t ttl = aleatorio() % ((uint64_t) 1 << (4 + 6 * (i % 6)));
+        sprintf(clave, "%08u", i);
+        vencimientos[i] = ttl;
+        ok &= hash_guardar_con_ttl(hash, clave, &vencimientos[i], ttl);
+    }
+    print_test("Prueba hash TTL guardar muchas claves", ok);
+
+    /* Avanza el tiempo a saltos y verifica que se reclame exactamente lo vencido */
+    while (ok && hash_cantidad(hash) > 0) {
+        reloj_prueba_ahora += aleatorio() % ((uint64_t) 1 << (aleatorio() % 36));
+        hash_expirar(hash, reloj_prueba_ahora, (size_t) -1);
+        vencidas = 0;
+        for (size_t i = 0; i < largo; i++)
+            vencidas += vencimientos[i] <= reloj_prueba_ahora;
+        ok = (destruidos == vencidas && hash_cantidad(hash) == largo - vencidas);
+    }
+    print_test("Prueba hash TTL se reclamó exactamente lo vencido", ok);
+    print_test("Prueba hash TTL ningún dato se destruyó antes de vencer", !destruido_antes_de_tiempo);
+
+    free(vencimientos);
+    hash_destruir(hash);
+}
+
+static void prueba_hash_cache_lru()
+{
+    hash_t* hash = hash_crear_cache(destruir_contando, HASH_CACHE_LRU, 3, 0, NULL);
+    uint64_t valor = 0;
+
+    reloj_prueba_ahora = 0;
+    destruidos = 0;
+    print_test("Prueba hash cache LRU crear", hash);
+    print_test("Prueba hash cache LRU guardar A", hash_guardar(hash, "A", &valor));
+    print_test("Prueba hash cache LRU guardar B", hash_guardar(hash, "B", &valor));
+    print_test("Prueba hash cache LRU guardar C", hash_guardar(hash, "C", &valor));
+    print_test("Prueba hash cache LRU obtener A la usa", hash_obtener(hash, "A") == &valor);
+    print_test("Prueba hash cache LRU guardar D", hash_guardar(hash, "D", &valor));
+    print_test("Prueba hash cache LRU la cantidad de elementos es 3", hash_cantidad(hash) == 3);
+    print_test("Prueba hash cache LRU se desalojó B", !hash_pertenece(hash, "B"));
+    print_test("Prueba hash cache LRU A sigue", hash_pertenece(hash, "A"));
+    print_test("Prueba hash cache LRU se destruyó el dato desalojado", destruidos == 1);
+
+    /* Reemplazar una clave no desaloja otra */
+    print_test("Prueba hash cache LRU reemplazar C", hash_guardar(hash, "C", &valor));
+    print_test("Prueba hash cache LRU la cantidad de elementos es 3", hash_cantidad(hash) == 3);
+    print_test("Prueba hash cache LRU guardar E desaloja A", hash_guardar(hash, "E", &valor) && !hash_pertenece(hash, "A"));
+    print_test("Prueba hash cache LRU borrar D", hash_borrar(hash, "D") == &valor);
+    print_test("Prueba hash cache LRU guardar F no desaloja", hash_guardar(hash, "F", &valor) && hash_cantidad(hash) == 3);
+
+    hash_destruir(hash);
+    print_test("Prueba hash cache LRU destruir libera el resto", destruidos == 6);
+}
+
+static void prueba_hash_cache_clock()
+{
+    hash_t* hash = hash_crear_cache(destruir_contando, HASH_CACHE_CLOCK, 3, 0, NULL);
+    uint64_t valor = 0;
+
+    reloj_prueba_ahora = 0;
+    destruidos = 0;
+    print_test("Prueba hash cache CLOCK guardar A, B y C", hash_guardar(hash, "A", &valor) &&
+               hash_guardar(hash, "B", &valor) && hash_guardar(hash, "C", &valor));
+    print_test("Prueba hash cache CLOCK obtener A la referencia", hash_obtener(hash, "A") == &valor);
+    print_test("Prueba hash cache CLOCK guardar D", hash_guardar(hash, "D", &valor));
+    print_test("Prueba hash cache CLOCK A tuvo otra oportunidad", hash_pertenece(hash, "A"));
+    print_test("Prueba hash cache CLOCK se desalojó B", !hash_pertenece(hash, "B"));
+    print_test("Prueba hash cache CLOCK guardar E desaloja C", hash_guardar(hash, "E", &valor) && !hash_pertenece(hash, "C"));
+    /* A ya usó su otra oportunidad y quedó detrás de D, como en la vuelta de la aguja */
+    print_test("Prueba hash cache CLOCK guardar G desaloja A", hash_guardar(hash, "G", &valor) && !hash_pertenece(hash, "A"));
+    print_test("Prueba hash cache CLOCK guardar H desaloja D", hash_guardar(hash, "H", &valor) && !hash_pertenece(hash, "D"));
+    print_test("Prueba hash cache CLOCK se destruyeron los desalojados", destruidos == 4);
+
+    hash_destruir(hash);
+}
+
+static void prueba_hash_cache_clock_todas_referenciadas()
+{
+    hash_t* hash = hash_crear_cache(destruir_contando, HASH_CACHE_CLOCK, 2, 0, NULL);
+    uint64_t valor = 0;
+
+    destruidos = 0;
+    print_test("Prueba hash cache CLOCK guardar A y B", hash_guardar(hash, "A", &valor) && hash_guardar(hash, "B", &valor));
+    print_test("Prueba hash cache CLOCK obtener A y B las referencia",
+               hash_obtener(hash, "A") == &valor && hash_obtener(hash, "B") == &valor);
+    print_test("Prueba hash cache CLOCK guardar C con todas referenciadas", hash_guardar(hash, "C", &valor));
+    print_test("Prueba hash cache CLOCK la clave recien guardada no se desaloja", hash_obtener(hash, "C") == &valor);
+    print_test("Prueba hash cache CLOCK se desalojo una sola clave vieja",
+               hash_cantidad(hash) == 2 && destruidos == 1 && hash_pertenece(hash, "A") != hash_pertenece(hash, "B"));
+
+    hash_destruir(hash);
+}
+
+static void prueba_hash_cache_bytes()
+{
+    /* Cada par ocupa 3 bytes de clave más 10 de dato, entran 3 en 40 bytes */
+    hash_t* hash = hash_crear_cache(destruir_contando, HASH_CACHE_LRU, 0, 40, tam_dato_fijo);
+    uint64_t valor = 0;
+    char clave[10];
+    bool ok = true;
+
+    reloj_prueba_ahora = 0;
+    destruidos = 0;
+    for (unsigned i = 0; i < 10; i++) {
+        sprintf(clave, "k%u", i);
+        ok &= hash_guardar(hash, clave, &valor) && hash_cantidad(hash) <= 3;
+    }
+    print_test("Prueba hash cache por bytes respeta el presupuesto", ok);
+    print_test("Prueba hash cache por bytes la cantidad de elementos es 3", hash_cantidad(hash) == 3);
+    print_test("Prueba hash cache por bytes quedan las más recientes", hash_pertenece(hash, "k7") &&
+               hash_pertenece(hash, "k8") && hash_pertenece(hash, "k9"));
+    print_test("Prueba hash cache por bytes se destruyeron los desalojados", destruidos == 7);
+
+    hash_destruir(hash);
+}
+
+static void prueba_hash_cache_volumen(size_t largo, hash_politica_t politica)
+{
+    const size_t capacidad = 100;
+    hash_t* hash = hash_crear_cache(destruir_contando, politica, capacidad, 0, NULL);
+    uint64_t valor = 0;
+    char clave[10];
+    bool ok = true;
+
+    reloj_prueba_ahora = 0;
+    destruidos = 0;
+    for (unsigned i = 0; i < largo; i++) {
+        sprintf(clave, "%08u", i);
+        ok &= hash_guardar(hash, clave, &valor) && hash_cantidad(hash) <= capacidad;
+        /* Una clave vieja muy usada tiene que sobrevivir con ambas políticas */
+        ok &= hash_obtener(hash, "00000000") == &valor;
+    }
+    print_test("Prueba hash cache volumen nunca supera la capacidad", ok);
+    print_test("Prueba hash cache volumen la clave más usada sigue", hash_pertenece(hash, "00000000"));
+    sprintf(clave, "%08u", (unsigned) largo - 1);
+    print_test("Prueba hash cache volumen la última clave sigue", hash_pertenece(hash, clave));
+    print_test("Prueba hash cache volumen se destruyeron los desalojados", destruidos == largo - capacidad);
+
+    hash_destruir(hash);
+}
+
+static void prueba_hash_estadisticas(size_t largo)
+{
+    hash_t* hash = hash_crear(NULL);
+    hash_estadisticas_t estadisticas;
+    size_t listas = 0;
+    char clave[10];
+    bool ok = true;
+
+    print_test("Prueba hash estadisticas de hash vacio", hash_estadisticas(hash, &estadisticas));
+    print_test("Prueba hash estadisticas hash vacio no tiene cadenas", estadisticas.cadena_max == 0 &&
+               estadisticas.cadenas[0] == estadisticas.tam && estadisticas.bytes_nodos == 0);
+
+    for (unsigned i = 0; i < largo; i++) {
+        sprintf(clave, "%08u", i);
+        ok &= hash_guardar(hash, clave, NULL);
+    }
+    for (unsigned i = 0; i < 2 * largo; i++) {
+        sprintf(clave, "%08u", i);
+        hash_obtener(hash, clave);
+    }
+    print_test("Prueba hash estadisticas guardar y buscar muchos elementos", ok);
+    print_test("Prueba hash estadisticas", hash_estadisticas(hash, &estadisticas));
+    print_test("Prueba hash estadisticas la cantidad es correcta", estadisticas.cantidad == largo);
+    print_test("Prueba hash estadisticas el factor de carga es correcto",
+               estadisticas.factor_carga == (double) largo / (double) estadisticas.tam);
+    for (size_t i = 0; i < HASH_HISTOGRAMA_CADENAS; i++)
+        listas += estadisticas.cadenas[i];
+    print_test("Prueba hash estadisticas el histograma cubre todas las listas", listas == estadisticas.tam);
+    print_test("Prueba hash estadisticas media <= p99 <= max", estadisticas.cadena_media <= (double) estadisticas.cadena_p99 &&
+               estadisticas.cadena_p99 <= estadisticas.cadena_max && estadisticas.cadena_max > 0);
+    print_test("Prueba hash estadisticas bytes de claves", estadisticas.bytes_claves == largo * 9);
+    print_test("Prueba hash estadisticas bytes de la tabla y nodos", estadisticas.bytes_tabla > 0 &&
+               estadisticas.bytes_nodos > 0 && estadisticas.bytes_listas > 0);
+#ifdef HASH_ESTADISTICAS
+    print_test("Prueba hash estadisticas hay contadores", estadisticas.contadores);
+    print_test("Prueba hash estadisticas hubo redimensiones", estadisticas.redimensiones > 0);
+    print_test("Prueba hash estadisticas aciertos y fallos", estadisticas.aciertos == largo &&
+               estadisticas.fallos == 2 * largo);
+    print_test("Prueba hash estadisticas sondeos", estadisticas.sondeos_aciertos >= estadisticas.aciertos);
+#else
+    print_test("Prueba hash estadisticas sin contadores valen 0", !estadisticas.contadores &&
+               estadisticas.redimensiones == 0 && estadisticas.aciertos == 0);
+#endif
+
+    hash_destruir(hash);
+}
+
+static void prueba_hash_alocador(size_t largo)
+{
+    alocador_prueba_t prueba = { 0, SIZE_MAX, false };
+    alocador_t alocador = { prueba_reservar, prueba_redimensionar, prueba_liberar, &prueba };
+    hash_t* hash = hash_crear_con_alocador(NULL, &alocador);
+    hash_iter_t* iter;
+    char clave[16];
+    size_t recorridas = 0;
+    bool ok = true;
+
+    print_test("Prueba hash alocador crear hash", hash);
+    print_test("Prueba hash alocador la memoria del hash vacio es exacta", hash_memoria(hash) == prueba.bytes);
+
+    reloj_prueba_ahora = 0;
+    hash_establecer_reloj(hash, reloj_prueba);
+    for (unsigned i = 0; ok && i < largo; i++) {
+        sprintf(clave, "%08u", i);
+        ok = (i % 2 ? hash_guardar(hash, clave, NULL) : hash_guardar_con_ttl(hash, clave, NULL, 100));
+        ok = ok && hash_memoria(hash) == prueba.bytes;
+    }
+    print_test("Prueba hash alocador guardar muchos con y sin TTL, memoria exacta", ok);
+
+    iter = hash_iter_crear(hash);
+    print_test("Prueba hash alocador el iterador usa el alocador", hash_memoria(hash) == prueba.bytes);
+    for (; !hash_iter_al_final(iter); hash_iter_avanzar(iter))
+        recorridas++;
+    hash_iter_destruir(iter);
+    print_test("Prueba hash alocador iterar todo", recorridas == largo && hash_memoria(hash) == prueba.bytes);
+
+    /* Vencen las claves con TTL y se borran las demás, la tabla se achica */
+    reloj_prueba_ahora = 100;
+    print_test("Prueba hash alocador vencer la mitad", hash_expirar(hash, 100, SIZE_MAX) == (largo + 1) / 2);
+    for (unsigned i = 1; i < largo; i += 2) {
+        sprintf(clave, "%08u", i);
+        hash_borrar(hash, clave);
+    }
+    print_test("Prueba hash alocador vaciar, memoria exacta", hash_cantidad(hash) == 0 &&
+               hash_memoria(hash) == prueba.bytes);
+
+    hash_destruir(hash);
+    print_test("Prueba hash alocador destruir libera todo", prueba.bytes == 0);
+    print_test("Prueba hash alocador se libera con el tamaño reservado", !prueba.tam_incorrecto);
+}
+
+/* Las variantes con internador, claves prestadas y cache también piden
+ * toda la memoria del hash al alocador */
+static void prueba_hash_alocador_variantes(size_t largo)
+{
+    alocador_prueba_t prueba = { 0, SIZE_MAX, false };
+    alocador_t alocador = { prueba_reservar, prueba_redimensionar, prueba_liberar, &prueba };
+    internador_t *internador = internador_crear();
+    char *arena = malloc(largo * 16);
+    hash_t *hashes[3];
+    const char *nombres[3] = { "internador", "claves prestadas", "cache" };
+    char mensaje[96];
+    bool ok;
+
+    hashes[0] = hash_crear_con_internador_y_alocador(NULL, internador, &alocador);
+    hashes[1] = hash_crear_con_claves_prestadas_y_alocador(NULL, &alocador);
+    hashes[2] = hash_crear_cache_con_alocador(NULL, HASH_CACHE_LRU, largo / 2, 0, NULL, &alocador);
+    for (unsigned i = 0; i < largo; i++)
+        sprintf(arena + i * 16, "%08u", i);
+
+    for (size_t h = 0; h < 3; h++) {
+        ok = hashes[h] && prueba.bytes > 0;
+        for (unsigned i = 0; ok && i < largo; i++)
+            ok = hash_guardar(hashes[h], arena + i * 16, NULL);
+        sprintf(mensaje, "Prueba hash alocador con %s, guardar muchos", nombres[h]);
+        print_test(mensaje, ok);
+    }
+    print_test("Prueba hash alocador la memoria de los tres es la del alocador",
+               hash_memoria(hashes[0]) + hash_memoria(hashes[1]) + hash_memoria(hashes[2]) == prueba.bytes);
+
+    for (size_t h = 0; h < 3; h++)
+        hash_destruir(hashes[h]);
+    print_test("Prueba hash alocador variantes destruir libera todo", prueba.bytes == 0 && !prueba.tam_incorrecto);
+    internador_destruir(internador);
+    free(arena);
+}
+
+static void prueba_hash_alocador_sin_memoria(size_t largo)
+{
+    alocador_prueba_t prueba = { 0, SIZE_MAX, false };
+    alocador_t alocador = { prueba_reservar, prueba_redimensionar, prueba_liberar, &prueba };
+    hash_t* hash = hash_crear_con_alocador(NULL, &alocador);
+    char clave[16];
+    bool *guardada = calloc(largo, sizeof(bool));
+    bool ok = true;
+
+    prueba.restantes = 0;
+    print_test("Prueba hash alocador sin memoria guardar falla", !hash_guardar(hash, "A", NULL));
+    print_test("Prueba hash alocador sin memoria el hash sigue vacio", hash_cantidad(hash) == 0 &&
+               hash_memoria(hash) == prueba.bytes);
+
+    /* Las reservas fallan en distintos puntos de guardar y de las redimensiones */
+    for (unsigned i = 0; i < largo; i++) {
+        sprintf(clave, "%08u", i);
+        prueba.restantes = (aleatorio() % 8 ? SIZE_MAX : aleatorio() % 4);
+        guardada[i] = hash_guardar(hash, clave, NULL);
+    }
+    prueba.restantes = SIZE_MAX;
+    for (unsigned i = 0; ok && i < largo; i++) {
+        sprintf(clave, "%08u", i);
+        ok = hash_pertenece(hash, clave) == guardada[i];
+    }
+    print_test("Prueba hash alocador con fallas quedan exactamente las guardadas", ok);
+    print_test("Prueba hash alocador con fallas la memoria es exacta", hash_memoria(hash) == prueba.bytes);
+
+    hash_destruir(hash);
+    free(guardada);
+    print_test("Prueba hash alocador con fallas destruir libera todo", prueba.bytes == 0 && !prueba.tam_incorrecto);
+}
+
+static void prueba_hash_claves_prestadas(size_t largo)
+{
+    hash_t* hash = hash_crear_con_claves_prestadas(NULL);
+    hash_t* copiadas = hash_crear(NULL);
+    hash_iter_t* iter;
+    char *arena = malloc(largo * 16), clave[16];
+    bool ok = true;
+
+    /* Las claves viven en una arena que el hash no libera */
+    for (unsigned i = 0; ok && i < largo; i++) {
+        sprintf(arena + i * 16, "%08u", i);
+        ok = hash_guardar(hash, arena + i * 16, arena + i * 16) && hash_guardar(copiadas, arena + i * 16, NULL);
+    }
+    print_test("Prueba hash claves prestadas guardar muchos elementos", ok && hash_cantidad(hash) == largo);
+    for (unsigned i = 0; ok && i < largo; i++) {
+        sprintf(clave, "%08u", i);
+        ok = hash_obtener(hash, clave) == arena + i * 16;
+    }
+    print_test("Prueba hash claves prestadas obtener con otra copia de la clave", ok);
+
+    iter = hash_iter_crear(hash);
+    for (; ok && !hash_iter_al_final(iter); hash_iter_avanzar(iter))
+        ok = hash_iter_ver_actual(iter) == hash_iter_ver_dato(iter);
+    hash_iter_destruir(iter);
+    print_test("Prueba hash claves prestadas el iterador devuelve el puntero guardado", ok);
+    print_test("Prueba hash claves prestadas no se copian las claves", hash_memoria(hash) < hash_memoria(copiadas));
+
+    for (unsigned i = 0; ok && i < largo; i += 2)
+        ok = hash_borrar(hash, arena + i * 16) == arena + i * 16;
+    print_test("Prueba hash claves prestadas borrar la mitad", ok && hash_cantidad(hash) == largo / 2);
+
+    /* Destruir el hash no libera las claves, que siguen siendo de la arena */
+    hash_destruir(hash);
+    hash_destruir(copiadas);
+    free(arena);
+}
+
+/* Escribe en clave la combinación i de bloques de dos letras con el mismo
+ * hash de K&R ("Aa", "BB" y "C#"), así todas las claves colisionan */
+static void clave_que_colisiona(char *clave, size_t i, size_t bloques, const char *primero)
+{
+    for (size_t b = 0; b < bloques; b++, i /= 2) {
+        clave[2 * b] = (i % 2) ? 'B' : primero[0];
+        clave[2 * b + 1] = (i % 2) ? 'B' : primero[1];
+    }
+    clave[2 * bloques] = '\0';
+}
+
+static void prueba_hash_colisiones(size_t bloques)
+{
+    hash_t* hash = hash_crear(free);
+    hash_estadisticas_t estadisticas;
+    hash_iter_t* iter;
+    size_t largo = (size_t) 1 << bloques, recorridos = 0, *valor;
+    char clave[64];
+    bool ok = true;
+
+    for (size_t i = 0; ok && i < largo; i++) {
+        clave_que_colisiona(clave, i, bloques, "Aa");
+        valor = malloc(sizeof(size_t));
+        *valor = i;
+        ok = hash_guardar(hash, clave, valor);
+    }
+    print_test("Prueba hash colisiones guardar claves con el mismo hash", ok && hash_cantidad(hash) == largo);
+    hash_estadisticas(hash, &estadisticas);
+    print_test("Prueba hash colisiones la lista larga se convierte en arbol",
+               estadisticas.arboles == 1 && estadisticas.cadena_max == largo);
+    if (estadisticas.contadores)
+        print_test("Prueba hash colisiones guardar no recorre toda la lista",
+                   estadisticas.sondeos_fallos < largo * 2 * (bloques + 1));
+
+    for (size_t i = 0; ok && i < largo; i++) {
+        clave_que_colisiona(clave, i, bloques, "Aa");
+        valor = hash_obtener(hash, clave);
+        ok = valor && *valor == i;
+        /* Con "C#" en lugar de "Aa" el hash es el mismo pero la clave no está */
+        clave_que_colisiona(clave, i & ~(size_t) 1, bloques, "C#");
+        ok = ok && !hash_pertenece(hash, clave);
+    }
+    print_test("Prueba hash colisiones obtener en el arbol", ok);
+
+    /* Reemplazar una clave del árbol libera el dato anterior */
+    clave_que_colisiona(clave, 0, bloques, "Aa");
+    valor = malloc(sizeof(size_t));
+    *valor = largo;
+    print_test("Prueba hash colisiones reemplazar en el arbol", hash_guardar(hash, clave, valor) &&
+               hash_obtener(hash, clave) == valor && hash_cantidad(hash) == largo);
+
+    iter = hash_iter_crear(hash);
+    for (; ok && !hash_iter_al_final(iter); hash_iter_avanzar(iter), recorridos++)
+        ok = hash_obtener(hash, hash_iter_ver_actual(iter)) == hash_iter_ver_dato(iter);
+    hash_iter_destruir(iter);
+    print_test("Prueba hash colisiones el iterador recorre el arbol", ok && recorridos == largo);
+
+    /* Al quedar pocas claves el árbol vuelve a ser lista */
+    for (size_t i = 0; ok && i < largo - 3; i++) {
+        clave_que_colisiona(clave, i, bloques, "Aa");
+        valor = hash_borrar(hash, clave);
+        ok = valor && *valor == (i ? i : largo);
+        free(valor);
+    }
+    hash_estadisticas(hash, &estadisticas);
+    print_test("Prueba hash colisiones borrar casi todas las claves", ok && hash_cantidad(hash) == 3);
+    print_test("Prueba hash colisiones el arbol vuelve a ser lista", estadisticas.arboles == 0 && estadisticas.cadena_max == 3);
+    for (size_t i = largo - 3; ok && i < largo; i++) {
+        clave_que_colisiona(clave, i, bloques, "Aa");
+        valor = hash_obtener(hash, clave);
+        ok = valor && *valor == i;
+    }
+    print_test("Prueba hash colisiones quedan las ultimas claves", ok);
+
+    hash_destruir(hash);
+}
+
+static void prueba_hash_filtro(size_t largo)
+{
+    hash_t* hash = hash_crear(NULL);
+    hash_estadisticas_t estadisticas;
+    char clave[16];
+    size_t memoria;
+    bool ok = true;
+
+    /* El filtro se puede activar con claves ya guardadas */
+    for (unsigned i = 0; ok && i < largo / 2; i++) {
+        sprintf(clave, "%08u", i);
+        ok = hash_guardar(hash, clave, hash);
+    }
+    memoria = hash_memoria(hash);
+    print_test("Prueba hash filtro activar", ok && hash_activar_filtro(hash) && hash_memoria(hash) > memoria);
+    for (unsigned i = (unsigned) largo / 2; ok && i < largo; i++) {
+        sprintf(clave, "%08u", i);
+        ok = hash_guardar(hash, clave, hash);
+    }
+    print_test("Prueba hash filtro guardar muchos elementos", ok && hash_cantidad(hash) == largo);
+
+    for (unsigned i = 0; ok && i < largo; i++) {
+        sprintf(clave, "%08u", i);
+        ok = hash_obtener(hash, clave) == hash && hash_pertenece(hash, clave);
+        sprintf(clave, "%08u", i + (unsigned) largo);
+        ok = ok && !hash_obtener(hash, clave) && !hash_pertenece(hash, clave) && !hash_borrar(hash, clave);
+    }
+    print_test("Prueba hash filtro no descarta claves que estan", ok);
+    hash_estadisticas(hash, &estadisticas);
+    print_test("Prueba hash filtro estadisticas bytes del filtro", estadisticas.bytes_filtro > 0);
+    if (estadisticas.contadores)
+        print_test("Prueba hash filtro descarta casi todas las busquedas fallidas",
+                   estadisticas.descartes_filtro > 3 * largo * 95 / 100);
+
+    /* Después de borrar, el filtro se rearma y las claves borradas no están */
+    for (unsigned i = 0; ok && i < largo; i++) {
+        sprintf(clave, "%08u", i);
+        ok = (i % 10 == 0) || hash_borrar(hash, clave) == hash;
+    }
+    for (unsigned i = 0; ok && i < largo; i++) {
+        sprintf(clave, "%08u", i);
+        ok = hash_pertenece(hash, clave) == (i % 10 == 0);
+    }
+    print_test("Prueba hash filtro borrar la mayoria de las claves", ok && hash_cantidad(hash) == (largo + 9) / 10);
+
+    hash_destruir(hash);
+}
+
+/* ******************************************************************
+ *                        FUNCIÓN PRINCIPAL
+ * *****************************************************************/
+
+void pruebas_hash_alumno()
+{
+    /* Ejecuta todas las pruebas unitarias. */
+    prueba_hash_ttl();
+    prueba_hash_ttl_cambiar_reloj();
+    prueba_hash_ttl_trabajo_acotado();
+    prueba_hash_ttl_volumen(5000);
+    prueba_hash_cache_lru();
+    prueba_hash_cache_clock();
+    prueba_hash_cache_clock_todas_referenciadas();
+    prueba_hash_cache_bytes();
+    prueba_hash_cache_volumen(5000, HASH_CACHE_LRU);
+    prueba_hash_cache_volumen(5000, HASH_CACHE_CLOCK);
+    prueba_hash_estadisticas(5000);
+    prueba_hash_alocador(5000);
+    prueba_hash_alocador_variantes(1000);
+    prueba_hash_alocador_sin_memoria(5000);
+    prueba_hash_claves_prestadas(5000);
+    prueba_hash_colisiones(12);
+    prueba_hash_filtro(5000);
+}
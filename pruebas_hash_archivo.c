@@ -0,0 +1,146 @@
+#include "hash.h"
+#include "hash_archivo.h"
+#include "testing.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define RUTA_PRUEBA "prueba_hash_archivo.snap"
+
+/* ******************************************************************
+ *                        FUNCIONES AUXILIARES
+ * *****************************************************************/
+
+/* Los datos de las pruebas son cadenas, se serializan con su '\0' */
+static size_t serializar_cadena(const void *dato, void *buffer, size_t capacidad)
+{
+    size_t largo = strlen(dato) + 1;
+    if (largo <= capacidad)
+        memcpy(buffer, dato, largo);
+    return largo;
+}
+
+static void *deserializar_cadena(const void *bytes, size_t largo)
+{
+    char *cadena = malloc(largo);
+    if (cadena)
+        memcpy(cadena, bytes, largo);
+    return cadena;
+}
+
+/* Cambia un byte del archivo para simular corrupción */
+static void corromper_byte(const char *ruta, long posicion, int origen)
+{
+    FILE *archivo = fopen(ruta, "r+b");
+    int byte;
+    fseek(archivo, posicion, origen);
+    byte = fgetc(archivo);
+    fseek(archivo, -1, SEEK_CUR);
+    fputc(byte ^ 0x55, archivo);
+    fclose(archivo);
+}
+
+/* ******************************************************************
+ *                        PRUEBAS UNITARIAS
+ * *****************************************************************/
+
+static void prueba_hash_archivo_vacio()
+{
+    hash_t* hash = hash_crear(NULL);
+    hash_archivo_t* archivo;
+
+    print_test("Prueba hash archivo guardar hash vacio", hash_guardar_archivo(hash, RUTA_PRUEBA, NULL));
+    archivo = hash_archivo_abrir(RUTA_PRUEBA);
+    print_test("Prueba hash archivo abrir archivo vacio", archivo);
+    print_test("Prueba hash archivo la cantidad es 0", hash_archivo_cantidad(archivo) == 0);
+    print_test("Prueba hash archivo obtener A es NULL", !hash_archivo_obtener(archivo, "A", NULL));
+    print_test("Prueba hash archivo verificar archivo vacio", hash_archivo_verificar(archivo));
+
+    hash_archivo_cerrar(archivo);
+    hash_destruir(hash);
+    remove(RUTA_PRUEBA);
+}
+
+static void prueba_hash_archivo_volumen(size_t largo)
+{
+    hash_t* hash = hash_crear(free);
+    hash_t* cargado;
+    hash_archivo_t* archivo;
+    char clave[16], valor[32];
+    const char *leido;
+    size_t largo_leido;
+    bool ok = true;
+
+    for (unsigned i = 0; i < largo; i++) {
+        sprintf(clave, "%08u", i);
+        sprintf(valor, "valor %u", i * 7);
+        ok &= hash_guardar(hash, clave, deserializar_cadena(valor, strlen(valor) + 1));
+    }
+    print_test("Prueba hash archivo guardar muchos elementos en el hash", ok);
+    print_test("Prueba hash archivo guardar el archivo", hash_guardar_archivo(hash, RUTA_PRUEBA, serializar_cadena));
+
+    archivo = hash_archivo_abrir(RUTA_PRUEBA);
+    print_test("Prueba hash archivo abrir", archivo);
+    print_test("Prueba hash archivo la cantidad es correcta", hash_archivo_cantidad(archivo) == largo);
+    print_test("Prueba hash archivo verificar", hash_archivo_verificar(archivo));
+    for (unsigned i = 0; ok && i < largo; i++) {
+        sprintf(clave, "%08u", i);
+        sprintf(valor, "valor %u", i * 7);
+        leido = hash_archivo_obtener(archivo, clave, &largo_leido);
+        ok = leido && largo_leido == strlen(valor) + 1 && !strcmp(leido, valor);
+    }
+    print_test("Prueba hash archivo obtener devuelve los datos sin deserializar", ok);
+    print_test("Prueba hash archivo pertenece clave inexistente es false", !hash_archivo_pertenece(archivo, "no esta"));
+    hash_archivo_cerrar(archivo);
+
+    cargado = hash_cargar_archivo(RUTA_PRUEBA, deserializar_cadena, free);
+    print_test("Prueba hash archivo cargar", cargado);
+    print_test("Prueba hash archivo cargar la cantidad es correcta", hash_cantidad(cargado) == largo);
+    for (unsigned i = 0; ok && i < largo; i++) {
+        sprintf(clave, "%08u", i);
+        ok = !strcmp(hash_obtener(cargado, clave), hash_obtener(hash, clave));
+    }
+    print_test("Prueba hash archivo cargar tiene los mismos pares", ok);
+    hash_destruir(cargado);
+
+    /* Indexar usa las claves del archivo mapeado sin copiarlas */
+    archivo = hash_archivo_abrir(RUTA_PRUEBA);
+    cargado = hash_archivo_indexar(archivo, deserializar_cadena, free);
+    print_test("Prueba hash archivo indexar", cargado && hash_cantidad(cargado) == largo);
+    for (unsigned i = 0; ok && i < largo; i++) {
+        sprintf(clave, "%08u", i);
+        ok = !strcmp(hash_obtener(cargado, clave), hash_obtener(hash, clave));
+    }
+    print_test("Prueba hash archivo indexar tiene los mismos pares", ok);
+    print_test("Prueba hash archivo indexar no copia las claves", hash_memoria(cargado) < hash_memoria(hash));
+    hash_destruir(cargado);
+    hash_archivo_cerrar(archivo);
+
+    /* Un byte cambiado en el último dato se detecta al verificar */
+    corromper_byte(RUTA_PRUEBA, -3, SEEK_END);
+    archivo = hash_archivo_abrir(RUTA_PRUEBA);
+    print_test("Prueba hash archivo abrir archivo con datos corruptos", archivo);
+    print_test("Prueba hash archivo verificar detecta la corrupcion", !hash_archivo_verificar(archivo));
+    hash_archivo_cerrar(archivo);
+
+    /* Una cabecera corrupta no se abre */
+    corromper_byte(RUTA_PRUEBA, 20, SEEK_SET);
+    print_test("Prueba hash archivo abrir con cabecera corrupta es NULL", !hash_archivo_abrir(RUTA_PRUEBA));
+    print_test("Prueba hash archivo cargar con cabecera corrupta es NULL", !hash_cargar_archivo(RUTA_PRUEBA, NULL, NULL));
+    print_test("Prueba hash archivo abrir archivo inexistente es NULL", !hash_archivo_abrir("no_existe.snap"));
+
+    hash_destruir(hash);
+    remove(RUTA_PRUEBA);
+}
+
+/* ******************************************************************
+ *                        FUNCIÓN PRINCIPAL
+ * *****************************************************************/
+
+void pruebas_hash_archivo_alumno()
+{
+    /* Ejecuta todas las pruebas unitarias. */
+    prueba_hash_archivo_vacio();
+    prueba_hash_archivo_volumen(5000);
+}
@@ -0,0 +1,249 @@
+#include "hash_compacto.h"
+#include "testing.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* ******************************************************************
+ *                        PRUEBAS UNITARIAS
+ * *****************************************************************/
+
+static void prueba_hash_compacto_vacio()
+{
+    hash_compacto_t* hash = hash_compacto_crear(NULL);
+
+    print_test("Prueba hash compacto crear hash vacio", hash);
+    print_test("Prueba hash compacto la cantidad de elementos es 0", hash_compacto_cantidad(hash) == 0);
+    print_test("Prueba hash compacto obtener clave A, es NULL", !hash_compacto_obtener(hash, "A"));
+    print_test("Prueba hash compacto pertenece clave A, es false", !hash_compacto_pertenece(hash, "A"));
+    print_test("Prueba hash compacto borrar clave A, es NULL", !hash_compacto_borrar(hash, "A"));
+    print_test("Prueba hash compacto guardar clave NULL, es false", !hash_compacto_guardar(hash, NULL, NULL));
+
+    hash_compacto_destruir(hash);
+}
+
+static void prueba_hash_compacto_reemplazar_con_destruir()
+{
+    hash_compacto_t* hash = hash_compacto_crear(free);
+    char *clave1 = "perro", *valor1a = malloc(10), *valor1b = malloc(10);
+    char *clave2 = "", *valor2 = malloc(10);
+
+    print_test("Prueba hash compacto insertar clave1", hash_compacto_guardar(hash, clave1, valor1a));
+    print_test("Prueba hash compacto insertar clave vacia", hash_compacto_guardar(hash, clave2, valor2));
+    print_test("Prueba hash compacto obtener clave1 es valor1a", hash_compacto_obtener(hash, clave1) == valor1a);
+    print_test("Prueba hash compacto reemplazar clave1 libera valor1a", hash_compacto_guardar(hash, clave1, valor1b));
+    print_test("Prueba hash compacto obtener clave1 es valor1b", hash_compacto_obtener(hash, clave1) == valor1b);
+    print_test("Prueba hash compacto la cantidad de elementos es 2", hash_compacto_cantidad(hash) == 2);
+    print_test("Prueba hash compacto pertenece clave vacia", hash_compacto_pertenece(hash, clave2));
+
+    /* Se destruye el hash con elementos, libera valor1b y valor2 */
+    hash_compacto_destruir(hash);
+}
+
+static void prueba_hash_compacto_volumen(size_t largo)
+{
+    hash_compacto_t* hash = hash_compacto_crear(free);
+    char clave[16];
+    unsigned *valor;
+    bool ok = true;
+
+    for (unsigned i = 0; ok && i < largo; i++) {
+        sprintf(clave, "%08u", i);
+        valor = malloc(sizeof(unsigned));
+        *valor = i;
+        ok = hash_compacto_guardar(hash, clave, valor);
+    }
+    print_test("Prueba hash compacto almacenar muchos elementos", ok);
+    print_test("Prueba hash compacto la cantidad de elementos es correcta", hash_compacto_cantidad(hash) == largo);
+
+    for (unsigned i = 0; ok && i < largo; i++) {
+        sprintf(clave, "%08u", i);
+        valor = hash_compacto_obtener(hash, clave);
+        ok = valor && *valor == i;
+    }
+    print_test("Prueba hash compacto obtener muchos elementos", ok);
+
+    for (unsigned i = (unsigned) largo; ok && i < 2 * largo; i++) {
+        sprintf(clave, "%08u", i);
+        ok = !hash_compacto_pertenece(hash, clave);
+    }
+    print_test("Prueba hash compacto las claves que no estan no pertenecen", ok);
+
+    /* Borrar las claves pares deja huecos en las entradas y ranuras borradas en el índice */
+    for (unsigned i = 0; ok && i < largo; i += 2) {
+        sprintf(clave, "%08u", i);
+        valor = hash_compacto_borrar(hash, clave);
+        ok = valor && *valor == i;
+        free(valor);
+    }
+    print_test("Prueba hash compacto borrar la mitad de los elementos", ok);
+    for (unsigned i = 0; ok && i < largo; i++) {
+        sprintf(clave, "%08u", i);
+        ok = (hash_compacto_pertenece(hash, clave) == (i % 2 == 1));
+    }
+    print_test("Prueba hash compacto siguen las claves impares y no las pares", ok);
+
+    /* Volver a guardar las pares las agrega al final */
+    for (unsigned i = 0; ok && i < largo; i += 2) {
+        sprintf(clave, "%08u", i);
+        valor = malloc(sizeof(unsigned));
+        *valor = i;
+        ok = hash_compacto_guardar(hash, clave, valor);
+    }
+    for (unsigned i = 0; ok && i < largo; i++) {
+        sprintf(clave, "%08u", i);
+        valor = hash_compacto_obtener(hash, clave);
+        ok = valor && *valor == i;
+    }
+    print_test("Prueba hash compacto volver a guardar las claves borradas", ok && hash_compacto_cantidad(hash) == largo);
+
+    /* Borrar todo achica la tabla */
+    for (unsigned i = 0; ok && i < largo; i++) {
+        sprintf(clave, "%08u", i);
+        free(hash_compacto_borrar(hash, clave));
+    }
+    print_test("Prueba hash compacto borrar todos los elementos", hash_compacto_cantidad(hash) == 0);
+    print_test("Prueba hash compacto la tabla vacia ocupa poca memoria", hash_compacto_memoria(hash) < 1024);
+
+    hash_compacto_destruir(hash);
+}
+
+/* Guarda y borra muchas veces pocas claves distintas, sin que la tabla crezca */
+static void prueba_hash_compacto_rotacion(size_t vueltas)
+{
+    hash_compacto_t* hash = hash_compacto_crear(NULL);
+    char clave[16];
+    size_t memoria;
+    bool ok = true;
+
+    for (unsigned i = 0; i < 10; i++) {
+        sprintf(clave, "fija%u", i);
+        hash_compacto_guardar(hash, clave, NULL);
+    }
+    memoria = hash_compacto_memoria(hash);
+    for (unsigned i = 0; ok && i < vueltas; i++) {
+        sprintf(clave, "%08u", i);
+        ok = hash_compacto_guardar(hash, clave, NULL) && hash_compacto_pertenece(hash, "fija3");
+        hash_compacto_borrar(hash, clave);
+    }
+    print_test("Prueba hash compacto guardar y borrar muchas claves distintas", ok && hash_compacto_cantidad(hash) == 10);
+    print_test("Prueba hash compacto los huecos no agrandan la tabla", hash_compacto_memoria(hash) < 2 * memoria);
+
+    hash_compacto_destruir(hash);
+}
+
+/* Iterar sigue el orden de inserción, aunque se borren y reemplacen claves */
+static void prueba_hash_compacto_orden(size_t largo)
+{
+    hash_compacto_t* hash = hash_compacto_crear(NULL);
+    hash_compacto_iter_t* iter;
+    char clave[16];
+    unsigned esperada = 1;
+    bool ok = true;
+
+    for (unsigned i = 0; i < largo; i++) {
+        sprintf(clave, "%08u", i);
+        hash_compacto_guardar(hash, clave, NULL);
+    }
+    /* Se borran las pares y se reemplaza el dato de las impares */
+    for (unsigned i = 0; i < largo; i++) {
+        sprintf(clave, "%08u", i);
+        if (i % 2 == 0)
+            hash_compacto_borrar(hash, clave);
+        else
+            hash_compacto_guardar(hash, clave, hash);
+    }
+    sprintf(clave, "%08u", 0);
+    hash_compacto_guardar(hash, clave, NULL);
+
+    iter = hash_compacto_iter_crear(hash);
+    for (; ok && esperada < largo; esperada += 2) {
+        sprintf(clave, "%08u", esperada);
+        ok = !strcmp(hash_compacto_iter_ver_actual(iter), clave) && hash_compacto_iter_ver_dato(iter) == hash;
+        hash_compacto_iter_avanzar(iter);
+    }
+    print_test("Prueba hash compacto iterar sigue el orden de insercion", ok);
+    print_test("Prueba hash compacto la clave borrada y vuelta a guardar queda al final",
+               !strcmp(hash_compacto_iter_ver_actual(iter), "00000000"));
+    hash_compacto_iter_avanzar(iter);
+    print_test("Prueba hash compacto iterador al final despues de la ultima", hash_compacto_iter_al_final(iter));
+
+    hash_compacto_iter_destruir(iter);
+    hash_compacto_destruir(hash);
+}
+
+/* El índice usa las ranuras más chicas en las que entran las posiciones */
+static void prueba_hash_compacto_ancho(void)
+{
+    hash_compacto_t* hash = hash_compacto_crear(NULL);
+    char clave[16];
+    bool ok = true;
+
+    print_test("Prueba hash compacto vacio usa ranuras de 1 byte", hash_compacto_ancho_indice(hash) == 1);
+    for (unsigned i = 0; ok && i < 80; i++) {
+        sprintf(clave, "%08u", i);
+        ok = hash_compacto_guardar(hash, clave, NULL);
+    }
+    print_test("Prueba hash compacto con 80 claves usa ranuras de 1 byte", ok && hash_compacto_ancho_indice(hash) == 1);
+    for (unsigned i = 80; ok && i < 1000; i++) {
+        sprintf(clave, "%08u", i);
+        ok = hash_compacto_guardar(hash, clave, NULL);
+    }
+    print_test("Prueba hash compacto con 1000 claves usa ranuras de 2 bytes", ok && hash_compacto_ancho_indice(hash) == 2);
+    for (unsigned i = 1000; ok && i < 100000; i++) {
+        sprintf(clave, "%08u", i);
+        ok = hash_compacto_guardar(hash, clave, NULL);
+    }
+    print_test("Prueba hash compacto con 100000 claves usa ranuras de 4 bytes", ok && hash_compacto_ancho_indice(hash) == 4);
+    for (unsigned i = 0; i < 100000; i++) {
+        sprintf(clave, "%08u", i);
+        hash_compacto_borrar(hash, clave);
+    }
+    print_test("Prueba hash compacto vaciado vuelve a ranuras de 1 byte", hash_compacto_ancho_indice(hash) == 1);
+
+    hash_compacto_destruir(hash);
+}
+
+static void prueba_hash_compacto_iterar(size_t largo)
+{
+    hash_compacto_t* hash = hash_compacto_crear(NULL);
+    hash_compacto_iter_t* iter;
+    char clave[16];
+    size_t recorridos = 0;
+    bool ok = true;
+
+    for (unsigned i = 0; i < largo; i++) {
+        sprintf(clave, "%08u", i);
+        hash_compacto_guardar(hash, clave, hash);
+    }
+    iter = hash_compacto_iter_crear(hash);
+    print_test("Prueba hash compacto crear iterador", iter);
+    while (!hash_compacto_iter_al_final(iter)) {
+        ok = ok && hash_compacto_pertenece(hash, hash_compacto_iter_ver_actual(iter)) && hash_compacto_iter_ver_dato(iter) == hash;
+        recorridos++;
+        hash_compacto_iter_avanzar(iter);
+    }
+    print_test("Prueba hash compacto iterador recorre todas las claves", ok && recorridos == largo);
+    print_test("Prueba hash compacto iterador al final, ver actual es NULL", !hash_compacto_iter_ver_actual(iter));
+    print_test("Prueba hash compacto iterador al final, avanzar es false", !hash_compacto_iter_avanzar(iter));
+
+    hash_compacto_iter_destruir(iter);
+    hash_compacto_destruir(hash);
+}
+
+/* ******************************************************************
+ *                        FUNCIÓN PRINCIPAL
+ * *****************************************************************/
+
+void pruebas_hash_compacto_alumno()
+{
+    /* Ejecuta todas las pruebas unitarias. */
+    prueba_hash_compacto_vacio();
+    prueba_hash_compacto_reemplazar_con_destruir();
+    prueba_hash_compacto_volumen(5000);
+    prueba_hash_compacto_rotacion(5000);
+    prueba_hash_compacto_orden(1000);
+    prueba_hash_compacto_ancho();
+    prueba_hash_compacto_iterar(1000);
+}
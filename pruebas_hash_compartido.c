@@ -0,0 +1,216 @@
+#define _POSIX_C_SOURCE 200809L
+#include "hash_compartido.h"
+#include "testing.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#define NOMBRE_PRUEBA "/prueba_hash_compartido"
+
+/* ******************************************************************
+ *                        FUNCIONES AUXILIARES
+ * *****************************************************************/
+
+/* Corre hijo en otro proceso y devuelve si terminó con éxito */
+static bool en_otro_proceso(bool (*hijo)(void))
+{
+    int estado;
+    pid_t pid = fork();
+
+    if (pid < 0)
+        return false;
+    if (pid == 0)
+        _exit(hijo() ? 0 : 1);
+    return waitpid(pid, &estado, 0) == pid && WIFEXITED(estado) && WEXITSTATUS(estado) == 0;
+}
+
+static bool obtener_cadena(const hash_compartido_t *compartido, const char *clave, const char *esperado)
+{
+    char buffer[64];
+    size_t largo;
+    return hash_compartido_obtener(compartido, clave, buffer, sizeof(buffer), &largo) &&
+           largo == strlen(esperado) + 1 && !strcmp(buffer, esperado);
+}
+
+static bool hijo_escribe(void)
+{
+    hash_compartido_t *compartido = hash_compartido_abrir(NOMBRE_PRUEBA, true);
+    bool ok = compartido && obtener_cadena(compartido, "perro", "guau") &&
+              hash_compartido_guardar(compartido, "hijo", "hola", 5) && hash_compartido_borrar(compartido, "gato");
+    if (compartido)
+        hash_compartido_cerrar(compartido);
+    return ok;
+}
+
+static bool hijo_lee(void)
+{
+    hash_compartido_t *compartido = hash_compartido_abrir(NOMBRE_PRUEBA, false);
+    bool ok = compartido && obtener_cadena(compartido, "hijo", "hola") && !hash_compartido_pertenece(compartido, "gato") &&
+              !hash_compartido_guardar(compartido, "otro", "x", 2) && !hash_compartido_bloquear(compartido);
+    if (compartido)
+        hash_compartido_cerrar(compartido);
+    return ok;
+}
+
+/* Muere con el mutex tomado y sin cerrar la tabla */
+static bool hijo_muere_bloqueado(void)
+{
+    hash_compartido_t *compartido = hash_compartido_abrir(NOMBRE_PRUEBA, true);
+    return compartido && hash_compartido_bloquear(compartido);
+}
+
+/* ******************************************************************
+ *                        PRUEBAS UNITARIAS
+ * *****************************************************************/
+
+static void prueba_hash_compartido_vacio()
+{
+    hash_compartido_t* compartido;
+    size_t largo;
+
+    hash_compartido_eliminar(NOMBRE_PRUEBA);
+    print_test("Prueba hash compartido abrir una tabla que no existe es NULL", !hash_compartido_abrir(NOMBRE_PRUEBA, false));
+    compartido = hash_compartido_crear(NOMBRE_PRUEBA, 1 << 16, 64);
+    print_test("Prueba hash compartido crear tabla vacia", compartido);
+    print_test("Prueba hash compartido crear una tabla que ya existe es NULL", !hash_compartido_crear(NOMBRE_PRUEBA, 1 << 16, 64));
+    print_test("Prueba hash compartido la cantidad de elementos es 0", hash_compartido_cantidad(compartido) == 0);
+    print_test("Prueba hash compartido obtener clave A, es false", !hash_compartido_obtener(compartido, "A", NULL, 0, &largo));
+    print_test("Prueba hash compartido pertenece clave A, es false", !hash_compartido_pertenece(compartido, "A"));
+    print_test("Prueba hash compartido borrar clave A, es false", !hash_compartido_borrar(compartido, "A"));
+    print_test("Prueba hash compartido guardar clave NULL, es false", !hash_compartido_guardar(compartido, NULL, "x", 1));
+    print_test("Prueba hash compartido obtener clave NULL, es false",
+               !hash_compartido_obtener(compartido, NULL, NULL, 0, &largo));
+    print_test("Prueba hash compartido pertenece clave NULL, es false", !hash_compartido_pertenece(compartido, NULL));
+    print_test("Prueba hash compartido borrar clave NULL, es false", !hash_compartido_borrar(compartido, NULL));
+
+    hash_compartido_cerrar(compartido);
+    print_test("Prueba hash compartido eliminar la region", hash_compartido_eliminar(NOMBRE_PRUEBA));
+    print_test("Prueba hash compartido crear una region demasiado chica es NULL", !hash_compartido_crear(NOMBRE_PRUEBA, 64, 64));
+}
+
+static void prueba_hash_compartido_guardar()
+{
+    hash_compartido_t* compartido = hash_compartido_crear(NOMBRE_PRUEBA, 1 << 16, 64);
+    char buffer[2];
+    size_t largo;
+
+    print_test("Prueba hash compartido guardar perro", hash_compartido_guardar(compartido, "perro", "guau", 5));
+    print_test("Prueba hash compartido guardar clave vacia sin dato", hash_compartido_guardar(compartido, "", NULL, 0));
+    print_test("Prueba hash compartido obtener perro", obtener_cadena(compartido, "perro", "guau"));
+    print_test("Prueba hash compartido obtener con un buffer chico da el largo",
+               hash_compartido_obtener(compartido, "perro", buffer, sizeof(buffer), &largo) && largo == 5);
+    print_test("Prueba hash compartido obtener clave vacia",
+               hash_compartido_obtener(compartido, "", NULL, 0, &largo) && largo == 0);
+    print_test("Prueba hash compartido reemplazar perro", hash_compartido_guardar(compartido, "perro", "wof wof", 8));
+    print_test("Prueba hash compartido obtener perro reemplazado", obtener_cadena(compartido, "perro", "wof wof"));
+    print_test("Prueba hash compartido la cantidad de elementos es 2", hash_compartido_cantidad(compartido) == 2);
+    print_test("Prueba hash compartido borrar perro", hash_compartido_borrar(compartido, "perro"));
+    print_test("Prueba hash compartido perro ya no pertenece", !hash_compartido_pertenece(compartido, "perro"));
+    print_test("Prueba hash compartido la cantidad de elementos es 1", hash_compartido_cantidad(compartido) == 1);
+
+    hash_compartido_cerrar(compartido);
+    hash_compartido_eliminar(NOMBRE_PRUEBA);
+}
+
+static void prueba_hash_compartido_procesos()
+{
+    hash_compartido_t* compartido = hash_compartido_crear(NOMBRE_PRUEBA, 1 << 16, 64);
+
+    hash_compartido_guardar(compartido, "perro", "guau", 5);
+    hash_compartido_guardar(compartido, "gato", "miau", 5);
+    print_test("Prueba hash compartido otro proceso lee y escribe la tabla", en_otro_proceso(hijo_escribe));
+    print_test("Prueba hash compartido se ve lo que guardo el otro proceso", obtener_cadena(compartido, "hijo", "hola"));
+    print_test("Prueba hash compartido se ve lo que borro el otro proceso",
+               !hash_compartido_pertenece(compartido, "gato") && hash_compartido_cantidad(compartido) == 2);
+    print_test("Prueba hash compartido otro proceso abre de solo lectura", en_otro_proceso(hijo_lee));
+
+    print_test("Prueba hash compartido otro proceso muere con el mutex tomado", en_otro_proceso(hijo_muere_bloqueado));
+    print_test("Prueba hash compartido guardar despues de recuperar el mutex",
+               hash_compartido_guardar(compartido, "gato", "miau", 5) && hash_compartido_cantidad(compartido) == 3);
+    print_test("Prueba hash compartido bloquear varias operaciones", hash_compartido_bloquear(compartido) &&
+               hash_compartido_borrar(compartido, "gato") && hash_compartido_guardar(compartido, "raton", "iii", 4));
+    hash_compartido_desbloquear(compartido);
+    print_test("Prueba hash compartido las operaciones bloqueadas se aplicaron",
+               !hash_compartido_pertenece(compartido, "gato") && hash_compartido_pertenece(compartido, "raton"));
+
+    hash_compartido_cerrar(compartido);
+    hash_compartido_eliminar(NOMBRE_PRUEBA);
+}
+
+static void prueba_hash_compartido_llena()
+{
+    hash_compartido_t* compartido = hash_compartido_crear(NOMBRE_PRUEBA, 1 << 14, 16);
+    char clave[24];
+    size_t cantidad = 0;
+    bool ok = true;
+
+    while (hash_compartido_libre(compartido) > 0) {
+        sprintf(clave, "%08zu", cantidad);
+        if (!hash_compartido_guardar(compartido, clave, clave, 9))
+            break;
+        cantidad++;
+    }
+    print_test("Prueba hash compartido guardar hasta llenar la region",
+               cantidad > 0 && !hash_compartido_guardar(compartido, "otra", "x", 2));
+
+    /* Reemplazar pide el nodo nuevo antes de soltar el viejo: con la región
+     * llena hace falta un nodo libre, y cada reemplazo deja otro */
+    print_test("Prueba hash compartido borrar con la region llena", hash_compartido_borrar(compartido, "00000000"));
+    for (size_t i = 1; ok && i < cantidad; i++) {
+        sprintf(clave, "%08zu", i);
+        ok = hash_compartido_guardar(compartido, clave, "reemplazo", 10) && obtener_cadena(compartido, clave, "reemplazo");
+    }
+    print_test("Prueba hash compartido reemplazar reutiliza los nodos liberados", ok);
+    print_test("Prueba hash compartido guardar en el ultimo nodo libre", hash_compartido_guardar(compartido, "otra", "x", 2));
+    print_test("Prueba hash compartido la cantidad de elementos es correcta", hash_compartido_cantidad(compartido) == cantidad);
+
+    hash_compartido_cerrar(compartido);
+    hash_compartido_eliminar(NOMBRE_PRUEBA);
+}
+
+static void prueba_hash_compartido_volumen(size_t largo)
+{
+    hash_compartido_t* compartido = hash_compartido_crear(NOMBRE_PRUEBA, 1 << 20, largo / 2);
+    char clave[16];
+    unsigned valor;
+    size_t largo_dato;
+    bool ok = true;
+
+    for (unsigned i = 0; ok && i < largo; i++) {
+        sprintf(clave, "%08u", i);
+        ok = hash_compartido_guardar(compartido, clave, &i, sizeof(i));
+    }
+    print_test("Prueba hash compartido almacenar muchos elementos", ok && hash_compartido_cantidad(compartido) == largo);
+    for (unsigned i = 0; ok && i < largo; i++) {
+        sprintf(clave, "%08u", i);
+        ok = hash_compartido_obtener(compartido, clave, &valor, sizeof(valor), &largo_dato) &&
+             largo_dato == sizeof(valor) && valor == i;
+    }
+    print_test("Prueba hash compartido obtener muchos elementos", ok);
+    for (unsigned i = 0; ok && i < largo; i++) {
+        sprintf(clave, "%08u", i);
+        ok = hash_compartido_borrar(compartido, clave);
+    }
+    print_test("Prueba hash compartido borrar muchos elementos", ok && hash_compartido_cantidad(compartido) == 0);
+
+    hash_compartido_cerrar(compartido);
+    hash_compartido_eliminar(NOMBRE_PRUEBA);
+}
+
+/* ******************************************************************
+ *                        FUNCIÓN PRINCIPAL
+ * *****************************************************************/
+
+void pruebas_hash_compartido_alumno()
+{
+    /* Ejecuta todas las pruebas unitarias. */
+    prueba_hash_compartido_vacio();
+    prueba_hash_compartido_guardar();
+    prueba_hash_compartido_procesos();
+    prueba_hash_compartido_llena();
+    prueba_hash_compartido_volumen(5000);
+}
@@ -0,0 +1,95 @@
+#include "hash.h"
+#include "hash_congelado.h"
+#include "testing.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/* ******************************************************************
+ *                        PRUEBAS UNITARIAS
+ * *****************************************************************/
+
+static void prueba_hash_congelado_vacio()
+{
+    hash_t* hash = hash_crear(NULL);
+    hash_congelado_t* congelado = hash_congelar(hash);
+
+    print_test("Prueba hash congelado congelar hash vacio", congelado);
+    print_test("Prueba hash congelado la cantidad de elementos es 0", hash_congelado_cantidad(congelado) == 0);
+    print_test("Prueba hash congelado obtener clave A, es NULL", !hash_congelado_obtener(congelado, "A"));
+    print_test("Prueba hash congelado pertenece clave A, es false", !hash_congelado_pertenece(congelado, "A"));
+
+    hash_congelado_destruir(congelado);
+    hash_destruir(hash);
+}
+
+static void prueba_hash_congelado_pocos()
+{
+    hash_t* hash = hash_crear(NULL);
+    hash_congelado_t* congelado;
+    char *clave1 = "perro", *valor1 = "guau";
+    char *clave2 = "", *valor2 = NULL;
+
+    hash_guardar(hash, clave1, valor1);
+    hash_guardar(hash, clave2, valor2);
+    congelado = hash_congelar(hash);
+    print_test("Prueba hash congelado congelar 2 elementos", congelado);
+    print_test("Prueba hash congelado la cantidad de elementos es 2", hash_congelado_cantidad(congelado) == 2);
+    print_test("Prueba hash congelado obtener clave1 es valor1", hash_congelado_obtener(congelado, clave1) == valor1);
+    print_test("Prueba hash congelado pertenece clave vacia con valor NULL", hash_congelado_pertenece(congelado, clave2));
+    print_test("Prueba hash congelado pertenece gato, es false", !hash_congelado_pertenece(congelado, "gato"));
+
+    /* La tabla congelada no cambia con el hash original */
+    hash_borrar(hash, clave1);
+    print_test("Prueba hash congelado no cambia al borrar del hash", hash_congelado_obtener(congelado, clave1) == valor1);
+
+    hash_congelado_destruir(congelado);
+    hash_destruir(hash);
+}
+
+static void prueba_hash_congelado_volumen(size_t largo)
+{
+    hash_t* hash = hash_crear(free);
+    hash_congelado_t* congelado;
+    char clave[16];
+    unsigned *valor;
+    bool ok = true;
+
+    for (unsigned i = 0; i < largo; i++) {
+        sprintf(clave, "%08u", i);
+        valor = malloc(sizeof(unsigned));
+        *valor = i;
+        ok &= hash_guardar(hash, clave, valor);
+    }
+    congelado = hash_congelar(hash);
+    print_test("Prueba hash congelado congelar muchos elementos", ok && congelado);
+    print_test("Prueba hash congelado la cantidad de elementos es correcta", hash_congelado_cantidad(congelado) == largo);
+
+    for (unsigned i = 0; ok && i < largo; i++) {
+        sprintf(clave, "%08u", i);
+        valor = hash_congelado_obtener(congelado, clave);
+        ok = valor && *valor == i && valor == hash_obtener(hash, clave);
+    }
+    print_test("Prueba hash congelado obtener muchos elementos", ok);
+
+    for (unsigned i = (unsigned) largo; ok && i < 2 * largo; i++) {
+        sprintf(clave, "%08u", i);
+        ok = !hash_congelado_pertenece(congelado, clave);
+    }
+    print_test("Prueba hash congelado las claves que no estan no pertenecen", ok);
+
+    hash_congelado_destruir(congelado);
+    hash_destruir(hash);
+}
+
+/* ******************************************************************
+ *                        FUNCIÓN PRINCIPAL
+ * *****************************************************************/
+
+void pruebas_hash_congelado_alumno()
+{
+    /* Ejecuta todas las pruebas unitarias. */
+    prueba_hash_congelado_vacio();
+    prueba_hash_congelado_pocos();
+    prueba_hash_congelado_volumen(5000);
+}
@@ -0,0 +1,143 @@
+#include "hash_conjunto.h"
+#include "testing.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/* ******************************************************************
+ *                        PRUEBAS UNITARIAS
+ * *****************************************************************/
+
+static void prueba_hash_conjunto_vacio()
+{
+    hash_conjunto_t* conjunto = hash_conjunto_crear();
+
+    print_test("Prueba hash conjunto crear conjunto vacio", conjunto);
+    print_test("Prueba hash conjunto la cantidad de claves es 0", hash_conjunto_cantidad(conjunto) == 0);
+    print_test("Prueba hash conjunto pertenece clave A, es false", !hash_conjunto_pertenece(conjunto, "A"));
+    print_test("Prueba hash conjunto borrar clave A, es false", !hash_conjunto_borrar(conjunto, "A"));
+    print_test("Prueba hash conjunto guardar clave NULL, es false", !hash_conjunto_guardar(conjunto, NULL));
+    print_test("Prueba hash conjunto pertenece clave NULL, es false", !hash_conjunto_pertenece(conjunto, NULL));
+    print_test("Prueba hash conjunto borrar clave NULL, es false", !hash_conjunto_borrar(conjunto, NULL));
+
+    hash_conjunto_destruir(conjunto);
+}
+
+static void prueba_hash_conjunto_guardar()
+{
+    hash_conjunto_t* conjunto = hash_conjunto_crear();
+    char clave[] = "perro";
+
+    print_test("Prueba hash conjunto guardar perro", hash_conjunto_guardar(conjunto, clave));
+    print_test("Prueba hash conjunto guardar clave vacia", hash_conjunto_guardar(conjunto, ""));
+    print_test("Prueba hash conjunto guardar perro otra vez", hash_conjunto_guardar(conjunto, "perro"));
+    print_test("Prueba hash conjunto la cantidad de claves es 2", hash_conjunto_cantidad(conjunto) == 2);
+
+    /* El conjunto guarda una copia de la clave */
+    clave[0] = 'g';
+    print_test("Prueba hash conjunto la clave se copia", hash_conjunto_pertenece(conjunto, "perro") &&
+                                                         !hash_conjunto_pertenece(conjunto, clave));
+    print_test("Prueba hash conjunto borrar perro", hash_conjunto_borrar(conjunto, "perro"));
+    print_test("Prueba hash conjunto perro ya no pertenece", !hash_conjunto_pertenece(conjunto, "perro"));
+    print_test("Prueba hash conjunto la cantidad de claves es 1", hash_conjunto_cantidad(conjunto) == 1);
+
+    hash_conjunto_destruir(conjunto);
+}
+
+static bool contar_pares(const char *clave, void *extra)
+{
+    size_t *cuenta = extra;
+    cuenta[0]++;
+    cuenta[1] += (size_t) (atoi(clave) % 2 == 0);
+    return true;
+}
+
+/* a tiene los números de 0 a largo, b los pares de largo / 2 a 3 * largo / 2 */
+static void prueba_hash_conjunto_operaciones(int largo)
+{
+    hash_conjunto_t *a = hash_conjunto_crear(), *b = hash_conjunto_crear();
+    hash_conjunto_t *uni, *inter, *dif;
+    char clave[16];
+    size_t cuenta[2] = {0, 0};
+    bool ok = true;
+
+    for (int i = 0; ok && i < largo; i++) {
+        sprintf(clave, "%d", i);
+        ok = hash_conjunto_guardar(a, clave);
+    }
+    for (int i = largo / 2; ok && i < largo + largo / 2; i += 2) {
+        sprintf(clave, "%d", i);
+        ok = hash_conjunto_guardar(b, clave);
+    }
+    print_test("Prueba hash conjunto armar los conjuntos", ok);
+
+    uni = hash_conjunto_union(a, b);
+    inter = hash_conjunto_interseccion(a, b);
+    dif = hash_conjunto_diferencia(a, b);
+    print_test("Prueba hash conjunto crear union, interseccion y diferencia", uni && inter && dif);
+    print_test("Prueba hash conjunto la union tiene la cantidad correcta",
+               hash_conjunto_cantidad(uni) == (size_t) (largo + largo / 4));
+    print_test("Prueba hash conjunto la interseccion tiene la cantidad correcta",
+               hash_conjunto_cantidad(inter) == (size_t) (largo / 4));
+    print_test("Prueba hash conjunto la diferencia tiene la cantidad correcta",
+               hash_conjunto_cantidad(dif) == (size_t) (largo - largo / 4));
+
+    for (int i = 0; ok && i < largo + largo / 2; i++) {
+        sprintf(clave, "%d", i);
+        ok = hash_conjunto_pertenece(uni, clave) == (hash_conjunto_pertenece(a, clave) || hash_conjunto_pertenece(b, clave)) &&
+             hash_conjunto_pertenece(inter, clave) == (hash_conjunto_pertenece(a, clave) && hash_conjunto_pertenece(b, clave)) &&
+             hash_conjunto_pertenece(dif, clave) == (hash_conjunto_pertenece(a, clave) && !hash_conjunto_pertenece(b, clave));
+    }
+    print_test("Prueba hash conjunto cada clave esta donde corresponde", ok);
+
+    hash_conjunto_iterar(inter, contar_pares, cuenta);
+    print_test("Prueba hash conjunto iterar la interseccion ve solo pares", cuenta[0] == cuenta[1] && cuenta[0] == (size_t) (largo / 4));
+
+    /* Los resultados son independientes de los originales */
+    hash_conjunto_destruir(a);
+    hash_conjunto_destruir(b);
+    print_test("Prueba hash conjunto los resultados sobreviven a los originales",
+               hash_conjunto_pertenece(uni, "0") && hash_conjunto_pertenece(dif, "1"));
+
+    hash_conjunto_destruir(uni);
+    hash_conjunto_destruir(inter);
+    hash_conjunto_destruir(dif);
+}
+
+static void prueba_hash_conjunto_volumen(size_t largo)
+{
+    hash_conjunto_t* conjunto = hash_conjunto_crear();
+    char clave[16];
+    bool ok = true;
+
+    for (unsigned i = 0; ok && i < largo; i++) {
+        sprintf(clave, "%08u", i);
+        ok = hash_conjunto_guardar(conjunto, clave);
+    }
+    print_test("Prueba hash conjunto almacenar muchas claves", ok && hash_conjunto_cantidad(conjunto) == largo);
+    for (unsigned i = 0; ok && i < largo; i += 2) {
+        sprintf(clave, "%08u", i);
+        ok = hash_conjunto_borrar(conjunto, clave);
+    }
+    for (unsigned i = 0; ok && i < largo; i++) {
+        sprintf(clave, "%08u", i);
+        ok = (hash_conjunto_pertenece(conjunto, clave) == (i % 2 == 1));
+    }
+    print_test("Prueba hash conjunto borrar la mitad de las claves", ok);
+
+    /* Se destruye el conjunto con claves, libera sus copias */
+    hash_conjunto_destruir(conjunto);
+}
+
+/* ******************************************************************
+ *                        FUNCIÓN PRINCIPAL
+ * *****************************************************************/
+
+void pruebas_hash_conjunto_alumno()
+{
+    /* Ejecuta todas las pruebas unitarias. */
+    prueba_hash_conjunto_vacio();
+    prueba_hash_conjunto_guardar();
+    prueba_hash_conjunto_operaciones(2000);
+    prueba_hash_conjunto_volumen(5000);
+}
@@ -0,0 +1,205 @@
+#include "hash_cuckoo.h"
+#include "testing.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* ******************************************************************
+ *                        PRUEBAS UNITARIAS
+ * *****************************************************************/
+
+static void prueba_hash_cuckoo_vacio()
+{
+    hash_cuckoo_t* hash = hash_cuckoo_crear(NULL);
+
+    print_test("Prueba hash cuckoo crear hash vacio", hash);
+    print_test("Prueba hash cuckoo la cantidad de elementos es 0", hash_cuckoo_cantidad(hash) == 0);
+    print_test("Prueba hash cuckoo obtener clave A, es NULL", !hash_cuckoo_obtener(hash, "A"));
+    print_test("Prueba hash cuckoo pertenece clave A, es false", !hash_cuckoo_pertenece(hash, "A"));
+    print_test("Prueba hash cuckoo borrar clave A, es NULL", !hash_cuckoo_borrar(hash, "A"));
+    print_test("Prueba hash cuckoo guardar clave NULL, es false", !hash_cuckoo_guardar(hash, NULL, NULL));
+
+    hash_cuckoo_destruir(hash);
+}
+
+static void prueba_hash_cuckoo_reemplazar_con_destruir()
+{
+    hash_cuckoo_t* hash = hash_cuckoo_crear(free);
+    char *clave1 = "perro", *valor1a = malloc(10), *valor1b = malloc(10);
+    char *clave2 = "", *valor2 = malloc(10);
+
+    print_test("Prueba hash cuckoo insertar clave1", hash_cuckoo_guardar(hash, clave1, valor1a));
+    print_test("Prueba hash cuckoo insertar clave vacia", hash_cuckoo_guardar(hash, clave2, valor2));
+    print_test("Prueba hash cuckoo obtener clave1 es valor1a", hash_cuckoo_obtener(hash, clave1) == valor1a);
+    print_test("Prueba hash cuckoo reemplazar clave1 libera valor1a", hash_cuckoo_guardar(hash, clave1, valor1b));
+    print_test("Prueba hash cuckoo obtener clave1 es valor1b", hash_cuckoo_obtener(hash, clave1) == valor1b);
+    print_test("Prueba hash cuckoo la cantidad de elementos es 2", hash_cuckoo_cantidad(hash) == 2);
+    print_test("Prueba hash cuckoo pertenece clave vacia", hash_cuckoo_pertenece(hash, clave2));
+
+    /* Se destruye el hash con elementos, libera valor1b y valor2 */
+    hash_cuckoo_destruir(hash);
+}
+
+static void prueba_hash_cuckoo_volumen(size_t largo)
+{
+    hash_cuckoo_t* hash = hash_cuckoo_crear(free);
+    char clave[16];
+    unsigned *valor;
+    bool ok = true;
+
+    for (unsigned i = 0; ok && i < largo; i++) {
+        sprintf(clave, "%08u", i);
+        valor = malloc(sizeof(unsigned));
+        *valor = i;
+        ok = hash_cuckoo_guardar(hash, clave, valor);
+    }
+    print_test("Prueba hash cuckoo almacenar muchos elementos", ok);
+    print_test("Prueba hash cuckoo la cantidad de elementos es correcta", hash_cuckoo_cantidad(hash) == largo);
+
+    for (unsigned i = 0; ok && i < largo; i++) {
+        sprintf(clave, "%08u", i);
+        valor = hash_cuckoo_obtener(hash, clave);
+        ok = valor && *valor == i;
+    }
+    print_test("Prueba hash cuckoo obtener muchos elementos", ok);
+
+    for (unsigned i = (unsigned) largo; ok && i < 2 * largo; i++) {
+        sprintf(clave, "%08u", i);
+        ok = !hash_cuckoo_pertenece(hash, clave);
+    }
+    print_test("Prueba hash cuckoo las claves que no estan no pertenecen", ok);
+
+    /* Borrar las claves pares libera celdas en todos los baldes */
+    for (unsigned i = 0; ok && i < largo; i += 2) {
+        sprintf(clave, "%08u", i);
+        valor = hash_cuckoo_borrar(hash, clave);
+        ok = valor && *valor == i;
+        free(valor);
+    }
+    print_test("Prueba hash cuckoo borrar la mitad de los elementos", ok);
+    for (unsigned i = 0; ok && i < largo; i++) {
+        sprintf(clave, "%08u", i);
+        ok = (hash_cuckoo_pertenece(hash, clave) == (i % 2 == 1));
+    }
+    print_test("Prueba hash cuckoo siguen las claves impares y no las pares", ok);
+
+    /* Volver a guardar las pares reutiliza las celdas liberadas */
+    for (unsigned i = 0; ok && i < largo; i += 2) {
+        sprintf(clave, "%08u", i);
+        valor = malloc(sizeof(unsigned));
+        *valor = i;
+        ok = hash_cuckoo_guardar(hash, clave, valor);
+    }
+    for (unsigned i = 0; ok && i < largo; i++) {
+        sprintf(clave, "%08u", i);
+        valor = hash_cuckoo_obtener(hash, clave);
+        ok = valor && *valor == i;
+    }
+    print_test("Prueba hash cuckoo volver a guardar las claves borradas", ok && hash_cuckoo_cantidad(hash) == largo);
+
+    /* Borrar todo achica la tabla */
+    for (unsigned i = 0; ok && i < largo; i++) {
+        sprintf(clave, "%08u", i);
+        free(hash_cuckoo_borrar(hash, clave));
+    }
+    print_test("Prueba hash cuckoo borrar todos los elementos", hash_cuckoo_cantidad(hash) == 0);
+    print_test("Prueba hash cuckoo la tabla vacia ocupa poca memoria", hash_cuckoo_memoria(hash) < 1024);
+
+    hash_cuckoo_destruir(hash);
+}
+
+/* Guarda y borra muchas veces pocas claves distintas, sin que la tabla crezca */
+static void prueba_hash_cuckoo_rotacion(size_t vueltas)
+{
+    hash_cuckoo_t* hash = hash_cuckoo_crear(NULL);
+    char clave[16];
+    size_t memoria;
+    bool ok = true;
+
+    for (unsigned i = 0; i < 10; i++) {
+        sprintf(clave, "fija%u", i);
+        hash_cuckoo_guardar(hash, clave, NULL);
+    }
+    memoria = hash_cuckoo_memoria(hash);
+    for (unsigned i = 0; ok && i < vueltas; i++) {
+        sprintf(clave, "%08u", i);
+        ok = hash_cuckoo_guardar(hash, clave, NULL) && hash_cuckoo_pertenece(hash, "fija3");
+        hash_cuckoo_borrar(hash, clave);
+    }
+    print_test("Prueba hash cuckoo guardar y borrar muchas claves distintas", ok && hash_cuckoo_cantidad(hash) == 10);
+    print_test("Prueba hash cuckoo las celdas liberadas no agrandan la tabla", hash_cuckoo_memoria(hash) < 2 * memoria);
+
+    hash_cuckoo_destruir(hash);
+}
+
+/* Llena la tabla hasta justo antes de agrandarse: los desalojos tienen que
+ * ubicar todas las claves aunque casi no queden celdas libres */
+static void prueba_hash_cuckoo_carga_alta(size_t largo)
+{
+    hash_cuckoo_t* hash = hash_cuckoo_crear(NULL);
+    char clave[16];
+    double carga, carga_max = 0;
+    bool ok = true;
+
+    for (unsigned i = 0; ok && i < largo; i++) {
+        sprintf(clave, "k%u", i);
+        ok = hash_cuckoo_guardar(hash, clave, NULL);
+        carga = hash_cuckoo_carga(hash);
+        if (carga > carga_max)
+            carga_max = carga;
+    }
+    print_test("Prueba hash cuckoo guardar con carga alta", ok && hash_cuckoo_cantidad(hash) == largo);
+    print_test("Prueba hash cuckoo la carga llega a mas de 85%", carga_max > 0.85);
+    print_test("Prueba hash cuckoo la carga no pasa de 90%", carga_max <= 0.9);
+
+    for (unsigned i = 0; ok && i < largo; i++) {
+        sprintf(clave, "k%u", i);
+        ok = hash_cuckoo_pertenece(hash, clave);
+    }
+    print_test("Prueba hash cuckoo con carga alta estan todas las claves", ok);
+
+    hash_cuckoo_destruir(hash);
+}
+
+static void prueba_hash_cuckoo_iterar(size_t largo)
+{
+    hash_cuckoo_t* hash = hash_cuckoo_crear(NULL);
+    hash_cuckoo_iter_t* iter;
+    char clave[16];
+    size_t recorridos = 0;
+    bool ok = true;
+
+    for (unsigned i = 0; i < largo; i++) {
+        sprintf(clave, "%08u", i);
+        hash_cuckoo_guardar(hash, clave, hash);
+    }
+    iter = hash_cuckoo_iter_crear(hash);
+    print_test("Prueba hash cuckoo crear iterador", iter);
+    while (!hash_cuckoo_iter_al_final(iter)) {
+        ok = ok && hash_cuckoo_pertenece(hash, hash_cuckoo_iter_ver_actual(iter)) && hash_cuckoo_iter_ver_dato(iter) == hash;
+        recorridos++;
+        hash_cuckoo_iter_avanzar(iter);
+    }
+    print_test("Prueba hash cuckoo iterador recorre todas las claves", ok && recorridos == largo);
+    print_test("Prueba hash cuckoo iterador al final, ver actual es NULL", !hash_cuckoo_iter_ver_actual(iter));
+    print_test("Prueba hash cuckoo iterador al final, avanzar es false", !hash_cuckoo_iter_avanzar(iter));
+
+    hash_cuckoo_iter_destruir(iter);
+    hash_cuckoo_destruir(hash);
+}
+
+/* ******************************************************************
+ *                        FUNCIÓN PRINCIPAL
+ * *****************************************************************/
+
+void pruebas_hash_cuckoo_alumno()
+{
+    /* Ejecuta todas las pruebas unitarias. */
+    prueba_hash_cuckoo_vacio();
+    prueba_hash_cuckoo_reemplazar_con_destruir();
+    prueba_hash_cuckoo_volumen(5000);
+    prueba_hash_cuckoo_rotacion(5000);
+    prueba_hash_cuckoo_carga_alta(20000);
+    prueba_hash_cuckoo_iterar(1000);
+}
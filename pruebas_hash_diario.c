@@ -0,0 +1,363 @@
+#define _XOPEN_SOURCE 700
+#include "hash.h"
+#include "hash_diario.h"
+#include "testing.h"
+
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+
+#define RUTA_PRUEBA "prueba_hash_diario.log"
+#define RUTA_CORTADO "prueba_hash_diario_cortado.log"
+#define INSTANTANEA_PRUEBA "prueba_hash_diario.log.snap"
+#define CLAVES_PRUEBA 16
+#define OPERACIONES_PRUEBA 200
+
+/* ******************************************************************
+ *                        FUNCIONES AUXILIARES
+ * *****************************************************************/
+
+/* Los datos de las pruebas son cadenas, se serializan con su '\0' */
+static size_t serializar_cadena(const void *dato, void *buffer, size_t capacidad)
+{
+    size_t largo = strlen(dato) + 1;
+    if (largo <= capacidad)
+        memcpy(buffer, dato, largo);
+    return largo;
+}
+
+static void *deserializar_cadena(const void *bytes, size_t largo)
+{
+    char *cadena = malloc(largo);
+    if (cadena)
+        memcpy(cadena, bytes, largo);
+    return cadena;
+}
+
+static char *copiar_cadena(const char *cadena)
+{
+    return deserializar_cadena(cadena, strlen(cadena) + 1);
+}
+
+static hash_diario_t *abrir_diario(const char *ruta, hash_diario_sincronizar_t sincronizar)
+{
+    return hash_diario_abrir(ruta, serializar_cadena, deserializar_cadena, free, sincronizar);
+}
+
+static long tam_archivo(const char *ruta)
+{
+    FILE *archivo = fopen(ruta, "rb");
+    long tam;
+    if (!archivo)
+        return -1;
+    fseek(archivo, 0, SEEK_END);
+    tam = ftell(archivo);
+    fclose(archivo);
+    return tam;
+}
+
+/* Copia los primeros largo bytes de origen a destino, como si el proceso
+ * hubiera muerto con el diario escrito hasta ahí */
+static void copiar_cortado(const char *origen, const char *destino, long largo)
+{
+    FILE *entrada = fopen(origen, "rb"), *salida = fopen(destino, "wb");
+    int byte;
+    for (long i = 0; i < largo && (byte = fgetc(entrada)) != EOF; i++)
+        fputc(byte, salida);
+    fclose(entrada);
+    fclose(salida);
+}
+
+static void corromper_byte(const char *ruta, long posicion)
+{
+    FILE *archivo = fopen(ruta, "r+b");
+    int byte;
+    fseek(archivo, posicion, SEEK_SET);
+    byte = fgetc(archivo);
+    fseek(archivo, -1, SEEK_CUR);
+    fputc(byte ^ 0x55, archivo);
+    fclose(archivo);
+}
+
+/* La operación i guarda "v<i>" en la clave i * 7 % CLAVES_PRUEBA, o la
+ * borra si i % 4 == 3. Aplica las primeras cantidad al modelo esperado, donde
+ * -1 es una clave que no está */
+static void modelo_aplicar(int *esperado, size_t cantidad)
+{
+    for (int i = 0; i < CLAVES_PRUEBA; i++)
+        esperado[i] = -1;
+    for (size_t i = 0; i < cantidad; i++)
+        esperado[i * 7 % CLAVES_PRUEBA] = (i % 4 == 3 ? -1 : (int) i);
+}
+
+static bool operacion_aplicar(hash_diario_t *diario, size_t i)
+{
+    char clave[16], valor[16];
+    sprintf(clave, "c%zu", i * 7 % CLAVES_PRUEBA);
+    sprintf(valor, "v%zu", i);
+    if (i % 4 == 3) {
+        free(hash_diario_borrar(diario, clave));
+        return true;
+    }
+    return hash_diario_guardar(diario, clave, copiar_cadena(valor));
+}
+
+static bool estado_coincide(const hash_t *hash, const int *esperado)
+{
+    char clave[16], valor[16];
+    const char *dato;
+    size_t cantidad = 0;
+
+    for (int i = 0; i < CLAVES_PRUEBA; i++) {
+        sprintf(clave, "c%d", i);
+        dato = hash_obtener(hash, clave);
+        if (esperado[i] < 0) {
+            if (hash_pertenece(hash, clave))
+                return false;
+            continue;
+        }
+        sprintf(valor, "v%d", esperado[i]);
+        if (!dato || strcmp(dato, valor))
+            return false;
+        cantidad++;
+    }
+    return hash_cantidad(hash) == cantidad;
+}
+
+/* ******************************************************************
+ *                        PRUEBAS UNITARIAS
+ * *****************************************************************/
+
+static void prueba_hash_diario_vacio()
+{
+    hash_diario_t* diario;
+
+    remove(RUTA_PRUEBA);
+    remove(INSTANTANEA_PRUEBA);
+    diario = abrir_diario(RUTA_PRUEBA, HASH_DIARIO_SINCRONIZAR_SIEMPRE);
+    print_test("Prueba hash diario abrir un diario nuevo", diario);
+    print_test("Prueba hash diario el hash esta vacio", hash_cantidad(hash_diario_hash(diario)) == 0);
+    print_test("Prueba hash diario el diario esta vacio", hash_diario_bytes(diario) == 0 && tam_archivo(RUTA_PRUEBA) == 0);
+    print_test("Prueba hash diario borrar clave A, es NULL y no escribe",
+               !hash_diario_borrar(diario, "A") && hash_diario_bytes(diario) == 0);
+    print_test("Prueba hash diario guardar clave NULL, es false", !hash_diario_guardar(diario, NULL, NULL));
+    print_test("Prueba hash diario borrar clave NULL, es NULL", !hash_diario_borrar(diario, NULL));
+    hash_diario_cerrar(diario);
+
+    diario = abrir_diario(RUTA_PRUEBA, HASH_DIARIO_SINCRONIZAR_SIEMPRE);
+    print_test("Prueba hash diario reabrir un diario vacio", diario && hash_cantidad(hash_diario_hash(diario)) == 0);
+    hash_diario_cerrar(diario);
+    remove(RUTA_PRUEBA);
+}
+
+static void prueba_hash_diario_recuperar()
+{
+    hash_diario_t* diario = abrir_diario(RUTA_PRUEBA, HASH_DIARIO_SINCRONIZAR_SIEMPRE);
+    int esperado[CLAVES_PRUEBA];
+    bool ok = true;
+
+    for (size_t i = 0; ok && i < OPERACIONES_PRUEBA; i++)
+        ok = operacion_aplicar(diario, i);
+    print_test("Prueba hash diario aplicar muchas operaciones", ok);
+    print_test("Prueba hash diario con SIEMPRE todo esta escrito",
+               tam_archivo(RUTA_PRUEBA) == (long) hash_diario_bytes(diario));
+    hash_diario_cerrar(diario);
+
+    modelo_aplicar(esperado, OPERACIONES_PRUEBA);
+    diario = abrir_diario(RUTA_PRUEBA, HASH_DIARIO_SINCRONIZAR_SIEMPRE);
+    print_test("Prueba hash diario reabrir recupera el hash", diario && estado_coincide(hash_diario_hash(diario), esperado));
+    print_test("Prueba hash diario seguir escribiendo despues de recuperar",
+               hash_diario_guardar(diario, "c0", copiar_cadena("v1000")));
+    hash_diario_cerrar(diario);
+
+    esperado[0] = 1000;
+    diario = abrir_diario(RUTA_PRUEBA, HASH_DIARIO_SINCRONIZAR_SIEMPRE);
+    print_test("Prueba hash diario reabrir otra vez ve lo ultimo", diario && estado_coincide(hash_diario_hash(diario), esperado));
+    hash_diario_cerrar(diario);
+    remove(RUTA_PRUEBA);
+}
+
+static void prueba_hash_diario_cortes()
+{
+    hash_diario_t* diario = abrir_diario(RUTA_PRUEBA, HASH_DIARIO_SINCRONIZAR_SIEMPRE);
+    long fin[OPERACIONES_PRUEBA], total;
+    int esperado[CLAVES_PRUEBA];
+    size_t completas;
+    bool ok = true;
+
+    /* Se anota dónde termina el diario después de cada operación */
+    for (size_t i = 0; ok && i < OPERACIONES_PRUEBA; i++) {
+        ok = operacion_aplicar(diario, i);
+        fin[i] = (long) hash_diario_bytes(diario);
+    }
+    hash_diario_cerrar(diario);
+    total = tam_archivo(RUTA_PRUEBA);
+
+    /* Cortado en cualquier byte, se recuperan exactamente las operaciones
+     * cuyo registro quedó completo */
+    for (long corte = 0; ok && corte <= total; corte++) {
+        copiar_cortado(RUTA_PRUEBA, RUTA_CORTADO, corte);
+        for (completas = 0; completas < OPERACIONES_PRUEBA && fin[completas] <= corte; completas++)
+            ;
+        modelo_aplicar(esperado, completas);
+        diario = abrir_diario(RUTA_CORTADO, HASH_DIARIO_SINCRONIZAR_SIEMPRE);
+        ok = diario && estado_coincide(hash_diario_hash(diario), esperado) &&
+             hash_diario_bytes(diario) == (size_t) (completas ? fin[completas - 1] : 0);
+        if (diario)
+            hash_diario_cerrar(diario);
+    }
+    print_test("Prueba hash diario recuperar el diario cortado en cada byte", ok);
+
+    /* Después de un corte a mitad de un registro se sigue escribiendo a
+     * continuación del último válido */
+    copiar_cortado(RUTA_PRUEBA, RUTA_CORTADO, fin[OPERACIONES_PRUEBA / 2] + 5);
+    diario = abrir_diario(RUTA_CORTADO, HASH_DIARIO_SINCRONIZAR_SIEMPRE);
+    ok = diario && hash_diario_guardar(diario, "c1", copiar_cadena("v2000"));
+    if (diario)
+        hash_diario_cerrar(diario);
+    modelo_aplicar(esperado, OPERACIONES_PRUEBA / 2 + 1);
+    esperado[1] = 2000;
+    diario = abrir_diario(RUTA_CORTADO, HASH_DIARIO_SINCRONIZAR_SIEMPRE);
+    print_test("Prueba hash diario escribir despues de un registro cortado",
+               ok && diario && estado_coincide(hash_diario_hash(diario), esperado));
+    if (diario)
+        hash_diario_cerrar(diario);
+
+    /* Un byte cambiado en un registro lo invalida a él y a los siguientes */
+    copiar_cortado(RUTA_PRUEBA, RUTA_CORTADO, total);
+    corromper_byte(RUTA_CORTADO, fin[9] + 20);
+    modelo_aplicar(esperado, 10);
+    diario = abrir_diario(RUTA_CORTADO, HASH_DIARIO_SINCRONIZAR_SIEMPRE);
+    print_test("Prueba hash diario un registro corrupto corta el diario",
+               diario && estado_coincide(hash_diario_hash(diario), esperado));
+    if (diario)
+        hash_diario_cerrar(diario);
+
+    remove(RUTA_PRUEBA);
+    remove(RUTA_CORTADO);
+}
+
+static void prueba_hash_diario_lote()
+{
+    hash_diario_t* diario = abrir_diario(RUTA_PRUEBA, HASH_DIARIO_SINCRONIZAR_POR_LOTE);
+    int esperado[CLAVES_PRUEBA];
+    bool ok = true;
+
+    for (size_t i = 0; ok && i < 20; i++)
+        ok = operacion_aplicar(diario, i);
+    print_test("Prueba hash diario con POR_LOTE las operaciones esperan en el lote",
+               ok && hash_diario_bytes(diario) > 0 && tam_archivo(RUTA_PRUEBA) == 0);
+    print_test("Prueba hash diario confirmar escribe el lote", hash_diario_confirmar(diario) &&
+               tam_archivo(RUTA_PRUEBA) == (long) hash_diario_bytes(diario));
+    print_test("Prueba hash diario confirmar sin nada pendiente", hash_diario_confirmar(diario));
+    for (size_t i = 20; ok && i < 30; i++)
+        ok = operacion_aplicar(diario, i);
+    /* Cerrar confirma lo pendiente */
+    hash_diario_cerrar(diario);
+
+    modelo_aplicar(esperado, 30);
+    diario = abrir_diario(RUTA_PRUEBA, HASH_DIARIO_SINCRONIZAR_POR_LOTE);
+    print_test("Prueba hash diario cerrar escribe el lote pendiente",
+               ok && diario && estado_coincide(hash_diario_hash(diario), esperado));
+    hash_diario_cerrar(diario);
+    remove(RUTA_PRUEBA);
+}
+
+static void prueba_hash_diario_falla_escritura()
+{
+    hash_diario_t* diario = abrir_diario(RUTA_PRUEBA, HASH_DIARIO_SINCRONIZAR_SIEMPRE);
+    struct rlimit limite, anterior;
+    void (*senial_anterior)(int);
+    char *dato;
+    bool guardado;
+
+    /* Con el tamaño de archivo limitado a 0, write falla con EFBIG */
+    getrlimit(RLIMIT_FSIZE, &anterior);
+    limite = anterior;
+    limite.rlim_cur = 0;
+    senial_anterior = signal(SIGXFSZ, SIG_IGN);
+    setrlimit(RLIMIT_FSIZE, &limite);
+
+    guardado = hash_diario_guardar(diario, "A", copiar_cadena("v1"));
+    print_test("Prueba hash diario guardar sin poder escribir aplica la operacion",
+               guardado && hash_pertenece(hash_diario_hash(diario), "A") && tam_archivo(RUTA_PRUEBA) == 0);
+    print_test("Prueba hash diario confirmar informa que no pudo escribir", !hash_diario_confirmar(diario));
+    dato = hash_diario_borrar(diario, "A");
+    print_test("Prueba hash diario borrar sin poder escribir devuelve el dato", dato && !strcmp(dato, "v1"));
+    free(dato);
+    print_test("Prueba hash diario confirmar informa el error del borrar", !hash_diario_confirmar(diario));
+
+    setrlimit(RLIMIT_FSIZE, &anterior);
+    signal(SIGXFSZ, senial_anterior);
+    print_test("Prueba hash diario confirmar escribe el lote pendiente", hash_diario_confirmar(diario) &&
+               tam_archivo(RUTA_PRUEBA) == (long) hash_diario_bytes(diario) && hash_diario_bytes(diario) > 0);
+    print_test("Prueba hash diario confirmar sin errores nuevos", hash_diario_confirmar(diario));
+    hash_diario_cerrar(diario);
+
+    diario = abrir_diario(RUTA_PRUEBA, HASH_DIARIO_SINCRONIZAR_SIEMPRE);
+    print_test("Prueba hash diario recuperar lo escrito despues del error",
+               diario && hash_cantidad(hash_diario_hash(diario)) == 0);
+    hash_diario_cerrar(diario);
+    remove(RUTA_PRUEBA);
+}
+
+static void prueba_hash_diario_compactar()
+{
+    hash_diario_t* diario = abrir_diario(RUTA_PRUEBA, HASH_DIARIO_SINCRONIZAR_NUNCA);
+    int esperado[CLAVES_PRUEBA];
+    size_t maximo = 0;
+    bool ok = true;
+
+    for (size_t i = 0; ok && i < OPERACIONES_PRUEBA / 2; i++)
+        ok = operacion_aplicar(diario, i);
+    print_test("Prueba hash diario compactar", ok && hash_diario_compactar(diario));
+    print_test("Prueba hash diario compactar vacia el diario",
+               hash_diario_bytes(diario) == 0 && tam_archivo(RUTA_PRUEBA) == 0 && tam_archivo(INSTANTANEA_PRUEBA) > 0);
+    for (size_t i = OPERACIONES_PRUEBA / 2; ok && i < OPERACIONES_PRUEBA; i++)
+        ok = operacion_aplicar(diario, i);
+    hash_diario_cerrar(diario);
+
+    modelo_aplicar(esperado, OPERACIONES_PRUEBA);
+    diario = abrir_diario(RUTA_PRUEBA, HASH_DIARIO_SINCRONIZAR_NUNCA);
+    print_test("Prueba hash diario recuperar la instantanea y el diario",
+               ok && diario && estado_coincide(hash_diario_hash(diario), esperado));
+
+    /* Con compactar_desde el diario no crece más allá del límite y un lote */
+    hash_diario_compactar_desde(diario, 256);
+    for (size_t i = 0; ok && i < OPERACIONES_PRUEBA; i++) {
+        ok = operacion_aplicar(diario, i) && hash_diario_confirmar(diario);
+        if (hash_diario_bytes(diario) > maximo)
+            maximo = hash_diario_bytes(diario);
+    }
+    print_test("Prueba hash diario compactar solo al pasar el limite", ok && maximo <= 256);
+    hash_diario_cerrar(diario);
+
+    diario = abrir_diario(RUTA_PRUEBA, HASH_DIARIO_SINCRONIZAR_NUNCA);
+    print_test("Prueba hash diario recuperar despues de compactar solo",
+               diario && estado_coincide(hash_diario_hash(diario), esperado));
+    hash_diario_cerrar(diario);
+
+    /* Una instantánea corrupta no se toma como un hash vacío */
+    corromper_byte(INSTANTANEA_PRUEBA, 0);
+    print_test("Prueba hash diario no abrir con una instantanea corrupta", !abrir_diario(RUTA_PRUEBA, HASH_DIARIO_SINCRONIZAR_NUNCA));
+
+    remove(RUTA_PRUEBA);
+    remove(INSTANTANEA_PRUEBA);
+}
+
+/* ******************************************************************
+ *                        FUNCIÓN PRINCIPAL
+ * *****************************************************************/
+
+void pruebas_hash_diario_alumno()
+{
+    /* Ejecuta todas las pruebas unitarias. */
+    prueba_hash_diario_vacio();
+    prueba_hash_diario_recuperar();
+    prueba_hash_diario_cortes();
+    prueba_hash_diario_lote();
+    prueba_hash_diario_falla_escritura();
+    prueba_hash_diario_compactar();
+}
@@ -0,0 +1,299 @@
+#include "hash_lineal.h"
+#include "testing.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* ******************************************************************
+ *                        PRUEBAS UNITARIAS
+ * *****************************************************************/
+
+static void prueba_hash_lineal_vacio()
+{
+    hash_lineal_t* hash = hash_lineal_crear(NULL);
+
+    print_test("Prueba hash lineal crear hash vacio", hash);
+    print_test("Prueba hash lineal la cantidad de elementos es 0", hash_lineal_cantidad(hash) == 0);
+    print_test("Prueba hash lineal obtener clave A, es NULL", !hash_lineal_obtener(hash, "A"));
+    print_test("Prueba hash lineal pertenece clave A, es false", !hash_lineal_pertenece(hash, "A"));
+    print_test("Prueba hash lineal borrar clave A, es NULL", !hash_lineal_borrar(hash, "A"));
+    print_test("Prueba hash lineal guardar clave NULL, es false", !hash_lineal_guardar(hash, NULL, NULL));
+
+    hash_lineal_destruir(hash);
+}
+
+static void prueba_hash_lineal_reemplazar_con_destruir()
+{
+    hash_lineal_t* hash = hash_lineal_crear(free);
+    char *clave1 = "perro", *valor1a = malloc(10), *valor1b = malloc(10);
+    char *clave2 = "", *valor2 = malloc(10);
+
+    print_test("Prueba hash lineal insertar clave1", hash_lineal_guardar(hash, clave1, valor1a));
+    print_test("Prueba hash lineal insertar clave vacia", hash_lineal_guardar(hash, clave2, valor2));
+    print_test("Prueba hash lineal obtener clave1 es valor1a", hash_lineal_obtener(hash, clave1) == valor1a);
+    print_test("Prueba hash lineal reemplazar clave1 libera valor1a", hash_lineal_guardar(hash, clave1, valor1b));
+    print_test("Prueba hash lineal obtener clave1 es valor1b", hash_lineal_obtener(hash, clave1) == valor1b);
+    print_test("Prueba hash lineal la cantidad de elementos es 2", hash_lineal_cantidad(hash) == 2);
+    print_test("Prueba hash lineal pertenece clave vacia", hash_lineal_pertenece(hash, clave2));
+
+    /* Se destruye el hash con elementos, libera valor1b y valor2 */
+    hash_lineal_destruir(hash);
+}
+
+static void prueba_hash_lineal_volumen(size_t largo)
+{
+    hash_lineal_t* hash = hash_lineal_crear(free);
+    char clave[16];
+    unsigned *valor;
+    bool ok = true;
+
+    for (unsigned i = 0; ok && i < largo; i++) {
+        sprintf(clave, "%08u", i);
+        valor = malloc(sizeof(unsigned));
+        *valor = i;
+        ok = hash_lineal_guardar(hash, clave, valor);
+    }
+    print_test("Prueba hash lineal almacenar muchos elementos", ok);
+    print_test("Prueba hash lineal la cantidad de elementos es correcta", hash_lineal_cantidad(hash) == largo);
+
+    for (unsigned i = 0; ok && i < largo; i++) {
+        sprintf(clave, "%08u", i);
+        valor = hash_lineal_obtener(hash, clave);
+        ok = valor && *valor == i;
+    }
+    print_test("Prueba hash lineal obtener muchos elementos", ok);
+
+    for (unsigned i = (unsigned) largo; ok && i < 2 * largo; i++) {
+        sprintf(clave, "%08u", i);
+        ok = !hash_lineal_pertenece(hash, clave);
+    }
+    print_test("Prueba hash lineal las claves que no estan no pertenecen", ok);
+
+    /* Borrar las claves pares junta baldes mientras se sigue buscando en ellos */
+    for (unsigned i = 0; ok && i < largo; i += 2) {
+        sprintf(clave, "%08u", i);
+        valor = hash_lineal_borrar(hash, clave);
+        ok = valor && *valor == i;
+        free(valor);
+    }
+    print_test("Prueba hash lineal borrar la mitad de los elementos", ok);
+    for (unsigned i = 0; ok && i < largo; i++) {
+        sprintf(clave, "%08u", i);
+        ok = (hash_lineal_pertenece(hash, clave) == (i % 2 == 1));
+    }
+    print_test("Prueba hash lineal siguen las claves impares y no las pares", ok);
+
+    /* Volver a guardar las pares vuelve a partir los baldes */
+    for (unsigned i = 0; ok && i < largo; i += 2) {
+        sprintf(clave, "%08u", i);
+        valor = malloc(sizeof(unsigned));
+        *valor = i;
+        ok = hash_lineal_guardar(hash, clave, valor);
+    }
+    for (unsigned i = 0; ok && i < largo; i++) {
+        sprintf(clave, "%08u", i);
+        valor = hash_lineal_obtener(hash, clave);
+        ok = valor && *valor == i;
+    }
+    print_test("Prueba hash lineal volver a guardar las claves borradas", ok && hash_lineal_cantidad(hash) == largo);
+
+    /* Borrar todo achica la tabla */
+    for (unsigned i = 0; ok && i < largo; i++) {
+        sprintf(clave, "%08u", i);
+        free(hash_lineal_borrar(hash, clave));
+    }
+    print_test("Prueba hash lineal borrar todos los elementos", hash_lineal_cantidad(hash) == 0);
+    /* Queda solo el primer segmento de baldes */
+    print_test("Prueba hash lineal la tabla vacia ocupa poca memoria", hash_lineal_memoria(hash) < 8 * 1024);
+
+    hash_lineal_destruir(hash);
+}
+
+/* Guarda y borra muchas veces pocas claves distintas, sin que la tabla crezca */
+static void prueba_hash_lineal_rotacion(size_t vueltas)
+{
+    hash_lineal_t* hash = hash_lineal_crear(NULL);
+    char clave[16];
+    size_t memoria;
+    bool ok = true;
+
+    for (unsigned i = 0; i < 10; i++) {
+        sprintf(clave, "fija%u", i);
+        hash_lineal_guardar(hash, clave, NULL);
+    }
+    memoria = hash_lineal_memoria(hash);
+    for (unsigned i = 0; ok && i < vueltas; i++) {
+        sprintf(clave, "%08u", i);
+        ok = hash_lineal_guardar(hash, clave, NULL) && hash_lineal_pertenece(hash, "fija3");
+        hash_lineal_borrar(hash, clave);
+    }
+    print_test("Prueba hash lineal guardar y borrar muchas claves distintas", ok && hash_lineal_cantidad(hash) == 10);
+    print_test("Prueba hash lineal guardar y borrar no agranda la tabla", hash_lineal_memoria(hash) < 2 * memoria);
+
+    hash_lineal_destruir(hash);
+}
+
+/* La tabla tiene que crecer y achicarse de a poco, sin rehashear todo */
+static void prueba_hash_lineal_crecimiento(size_t largo)
+{
+    hash_lineal_t* hash = hash_lineal_crear(NULL);
+    char clave[16];
+    size_t baldes;
+    bool ok = true, de_a_uno = true;
+
+    for (unsigned i = 0; ok && i < largo; i++) {
+        sprintf(clave, "k%u", i);
+        baldes = hash_lineal_baldes(hash);
+        ok = hash_lineal_guardar(hash, clave, NULL);
+        de_a_uno = de_a_uno && hash_lineal_baldes(hash) - baldes <= 1;
+    }
+    print_test("Prueba hash lineal guardar muchas claves", ok && hash_lineal_cantidad(hash) == largo);
+    print_test("Prueba hash lineal guardar agrega a lo sumo un balde", de_a_uno);
+    print_test("Prueba hash lineal la carga queda en 2 claves por balde",
+               hash_lineal_baldes(hash) * 2 >= largo && hash_lineal_baldes(hash) * 2 < largo + 2);
+
+    for (unsigned i = 0; ok && i < largo; i++) {
+        sprintf(clave, "k%u", i);
+        ok = hash_lineal_pertenece(hash, clave);
+    }
+    print_test("Prueba hash lineal despues de partir estan todas las claves", ok);
+
+    for (unsigned i = 0; i < largo; i++) {
+        sprintf(clave, "k%u", i);
+        baldes = hash_lineal_baldes(hash);
+        hash_lineal_borrar(hash, clave);
+        de_a_uno = de_a_uno && baldes - hash_lineal_baldes(hash) <= 2;
+    }
+    print_test("Prueba hash lineal borrar saca a lo sumo dos baldes", de_a_uno);
+    print_test("Prueba hash lineal vacia vuelve a los baldes iniciales", hash_lineal_baldes(hash) <= 8);
+
+    hash_lineal_destruir(hash);
+}
+
+/* Un clon ve los datos del momento en que se hizo, aunque después cambien
+ * el original o el clon, y los datos compartidos se destruyen una sola vez */
+static void prueba_hash_lineal_clonar(size_t largo)
+{
+    hash_lineal_t* hash = hash_lineal_crear(free);
+    hash_lineal_t* clon;
+    void **entregados = malloc(largo * sizeof(void *)), *compartido;
+    size_t memoria, cant_entregados = 0;
+    char clave[16];
+    unsigned *valor;
+    bool ok = true;
+
+    for (unsigned i = 0; i < largo; i++) {
+        sprintf(clave, "%08u", i);
+        valor = malloc(sizeof(unsigned));
+        *valor = i;
+        hash_lineal_guardar(hash, clave, valor);
+    }
+    memoria = hash_lineal_memoria(hash);
+    clon = hash_lineal_clonar(hash);
+    print_test("Prueba hash lineal clonar", clon && hash_lineal_cantidad(clon) == largo);
+    print_test("Prueba hash lineal el clon comparte casi toda la memoria",
+               hash_lineal_memoria(hash) - memoria < 1024);
+
+    /* El original reemplaza las claves múltiplo de 3, borra las múltiplo de 5 y agrega otras */
+    for (unsigned i = 0; i < largo; i += 3) {
+        sprintf(clave, "%08u", i);
+        valor = malloc(sizeof(unsigned));
+        *valor = i + 1;
+        hash_lineal_guardar(hash, clave, valor);
+    }
+    for (unsigned i = 0; i < largo; i += 5) {
+        sprintf(clave, "%08u", i);
+        valor = hash_lineal_borrar(hash, clave);
+        ok = ok && valor && *valor == i + (i % 3 == 0);
+        /* Los que el clon todavía ve se liberan después de destruirlo */
+        if (i % 3 == 0)
+            free(valor);
+        else
+            entregados[cant_entregados++] = valor;
+    }
+    for (unsigned i = (unsigned) largo; i < 2 * largo; i++) {
+        sprintf(clave, "%08u", i);
+        hash_lineal_guardar(hash, clave, NULL);
+    }
+    print_test("Prueba hash lineal el original cambia despues de clonar", ok);
+
+    for (unsigned i = 0; ok && i < largo; i++) {
+        sprintf(clave, "%08u", i);
+        valor = hash_lineal_obtener(clon, clave);
+        ok = valor && *valor == i;
+    }
+    print_test("Prueba hash lineal el clon conserva los datos del momento de clonar", ok);
+    for (unsigned i = (unsigned) largo; ok && i < 2 * largo; i++) {
+        sprintf(clave, "%08u", i);
+        ok = !hash_lineal_pertenece(clon, clave);
+    }
+    print_test("Prueba hash lineal el clon no ve las claves nuevas", ok && hash_lineal_cantidad(clon) == largo);
+
+    /* Los cambios del clon tampoco llegan al original */
+    hash_lineal_guardar(clon, "solo en el clon", NULL);
+    compartido = hash_lineal_borrar(clon, "00000001");
+    print_test("Prueba hash lineal el original no ve los cambios del clon",
+               !hash_lineal_pertenece(hash, "solo en el clon") && hash_lineal_pertenece(hash, "00000001"));
+    valor = hash_lineal_obtener(hash, "00000002");
+    print_test("Prueba hash lineal el original sigue con sus datos", valor && *valor == 2);
+
+    /* El clon destruye los datos viejos que ya no ve el original */
+    hash_lineal_destruir(clon);
+    for (size_t i = 0; i < cant_entregados; i++)
+        free(entregados[i]);
+    for (unsigned i = 0; ok && i < largo; i++) {
+        sprintf(clave, "%08u", i);
+        valor = hash_lineal_obtener(hash, clave);
+        ok = (i % 5 == 0 ? !valor : valor && *valor == i + (i % 3 == 0));
+    }
+    print_test("Prueba hash lineal destruir el clon no cambia el original", ok);
+
+    /* El dato que borró el clon ya no lo destruye el original */
+    hash_lineal_destruir(hash);
+    free(compartido);
+    free(entregados);
+}
+
+static void prueba_hash_lineal_iterar(size_t largo)
+{
+    hash_lineal_t* hash = hash_lineal_crear(NULL);
+    hash_lineal_iter_t* iter;
+    char clave[16];
+    size_t recorridos = 0;
+    bool ok = true;
+
+    for (unsigned i = 0; i < largo; i++) {
+        sprintf(clave, "%08u", i);
+        hash_lineal_guardar(hash, clave, hash);
+    }
+    iter = hash_lineal_iter_crear(hash);
+    print_test("Prueba hash lineal crear iterador", iter);
+    while (!hash_lineal_iter_al_final(iter)) {
+        ok = ok && hash_lineal_pertenece(hash, hash_lineal_iter_ver_actual(iter)) && hash_lineal_iter_ver_dato(iter) == hash;
+        recorridos++;
+        hash_lineal_iter_avanzar(iter);
+    }
+    print_test("Prueba hash lineal iterador recorre todas las claves", ok && recorridos == largo);
+    print_test("Prueba hash lineal iterador al final, ver actual es NULL", !hash_lineal_iter_ver_actual(iter));
+    print_test("Prueba hash lineal iterador al final, avanzar es false", !hash_lineal_iter_avanzar(iter));
+
+    hash_lineal_iter_destruir(iter);
+    hash_lineal_destruir(hash);
+}
+
+/* ******************************************************************
+ *                        FUNCIÓN PRINCIPAL
+ * *****************************************************************/
+
+void pruebas_hash_lineal_alumno()
+{
+    /* Ejecuta todas las pruebas unitarias. */
+    prueba_hash_lineal_vacio();
+    prueba_hash_lineal_reemplazar_con_destruir();
+    prueba_hash_lineal_volumen(5000);
+    prueba_hash_lineal_rotacion(5000);
+    prueba_hash_lineal_crecimiento(20000);
+    prueba_hash_lineal_clonar(5000);
+    prueba_hash_lineal_iterar(1000);
+}
@@ -0,0 +1,88 @@
+#include "hash.h"
+#include "hash_medido.h"
+#include "testing.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* ******************************************************************
+ *                        PRUEBAS UNITARIAS
+ * *****************************************************************/
+
+static void prueba_hash_medido_operaciones()
+{
+    hash_t* hash = hash_crear(NULL);
+    hash_medido_t* medido = hash_medido_crear(hash);
+    char *clave1 = "perro", *valor1 = "guau";
+    char *clave2 = "gato", *valor2 = "miau";
+
+    print_test("Prueba hash medido crear envoltorio", medido);
+    print_test("Prueba hash medido el hash envuelto es el original", hash_medido_hash(medido) == hash);
+    print_test("Prueba hash medido guardar clave1", hash_medido_guardar(medido, clave1, valor1));
+    print_test("Prueba hash medido guardar clave2", hash_medido_guardar(medido, clave2, valor2));
+    print_test("Prueba hash medido obtener clave1 es valor1", hash_medido_obtener(medido, clave1) == valor1);
+    print_test("Prueba hash medido obtener vaca es NULL", !hash_medido_obtener(medido, "vaca"));
+    print_test("Prueba hash medido pertenece clave2", hash_medido_pertenece(medido, clave2));
+    print_test("Prueba hash medido borrar clave2 devuelve valor2", hash_medido_borrar(medido, clave2) == valor2);
+    print_test("Prueba hash medido el hash tiene 1 elemento", hash_cantidad(hash) == 1);
+
+    print_test("Prueba hash medido se midieron 2 guardar",
+               histograma_cantidad(hash_medido_histograma(medido, HASH_MEDIDO_GUARDAR)) == 2);
+    print_test("Prueba hash medido se midieron 2 obtener",
+               histograma_cantidad(hash_medido_histograma(medido, HASH_MEDIDO_OBTENER)) == 2);
+    print_test("Prueba hash medido se midio 1 pertenece",
+               histograma_cantidad(hash_medido_histograma(medido, HASH_MEDIDO_PERTENECE)) == 1);
+    print_test("Prueba hash medido se midio 1 borrar",
+               histograma_cantidad(hash_medido_histograma(medido, HASH_MEDIDO_BORRAR)) == 1);
+
+    /* Las operaciones directas sobre el hash no se miden */
+    hash_obtener(hash, clave1);
+    print_test("Prueba hash medido usar el hash directo no se mide",
+               histograma_cantidad(hash_medido_histograma(medido, HASH_MEDIDO_OBTENER)) == 2);
+
+    hash_medido_reiniciar(medido);
+    print_test("Prueba hash medido reiniciar vacia los histogramas",
+               histograma_cantidad(hash_medido_histograma(medido, HASH_MEDIDO_GUARDAR)) == 0);
+
+    hash_medido_destruir(medido);
+    hash_destruir(hash);
+}
+
+static void prueba_hash_medido_imprimir()
+{
+    hash_t* hash = hash_crear(NULL);
+    hash_medido_t* medido = hash_medido_crear(hash);
+    FILE* archivo = tmpfile();
+    char linea[128];
+    size_t lineas = 0;
+    bool ok = true;
+
+    hash_medido_guardar(medido, "A", NULL);
+    hash_medido_obtener(medido, "A");
+    hash_medido_imprimir(medido, archivo);
+    rewind(archivo);
+    while (fgets(linea, sizeof(linea), archivo)) {
+        if (lineas == 1)
+            ok &= !strncmp(linea, "guardar,1,", strlen("guardar,1,"));
+        if (lineas == 2)
+            ok &= !strncmp(linea, "obtener,1,", strlen("obtener,1,"));
+        lineas++;
+    }
+    print_test("Prueba hash medido imprimir solo las operaciones medidas", lineas == 3 && ok);
+
+    fclose(archivo);
+    hash_medido_destruir(medido);
+    hash_destruir(hash);
+}
+
+/* ******************************************************************
+ *                        FUNCIÓN PRINCIPAL
+ * *****************************************************************/
+
+void pruebas_hash_medido_alumno()
+{
+    /* Ejecuta todas las pruebas unitarias. */
+    prueba_hash_medido_operaciones();
+    prueba_hash_medido_imprimir();
+}
@@ -0,0 +1,142 @@
+#include "hash_multimapa.h"
+#include "testing.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/* ******************************************************************
+ *                        PRUEBAS UNITARIAS
+ * *****************************************************************/
+
+static void prueba_hash_multimapa_vacio()
+{
+    hash_multimapa_t* multimapa = hash_multimapa_crear(NULL);
+    size_t cantidad = 1;
+
+    print_test("Prueba hash multimapa crear multimapa vacio", multimapa);
+    print_test("Prueba hash multimapa la cantidad de claves es 0", hash_multimapa_cantidad(multimapa) == 0);
+    print_test("Prueba hash multimapa obtener clave A, es NULL",
+               !hash_multimapa_obtener(multimapa, "A", &cantidad) && cantidad == 0);
+    print_test("Prueba hash multimapa pertenece clave A, es false", !hash_multimapa_pertenece(multimapa, "A"));
+    print_test("Prueba hash multimapa borrar clave A, es false", !hash_multimapa_borrar(multimapa, "A"));
+    print_test("Prueba hash multimapa agregar clave NULL, es false", !hash_multimapa_agregar(multimapa, NULL, NULL));
+    cantidad = 1;
+    print_test("Prueba hash multimapa obtener clave NULL, es NULL",
+               !hash_multimapa_obtener(multimapa, NULL, &cantidad) && cantidad == 0);
+    print_test("Prueba hash multimapa pertenece clave NULL, es false", !hash_multimapa_pertenece(multimapa, NULL));
+    print_test("Prueba hash multimapa borrar clave NULL, es false", !hash_multimapa_borrar(multimapa, NULL));
+    print_test("Prueba hash multimapa borrar dato de clave NULL, es false",
+               !hash_multimapa_borrar_dato(multimapa, NULL, NULL));
+
+    hash_multimapa_destruir(multimapa);
+}
+
+static void prueba_hash_multimapa_varios_datos()
+{
+    hash_multimapa_t* multimapa = hash_multimapa_crear(NULL);
+    int valores[10];
+    void *const *datos;
+    size_t cantidad;
+    bool ok = true;
+
+    print_test("Prueba hash multimapa agregar un dato", hash_multimapa_agregar(multimapa, "perro", &valores[0]));
+    datos = hash_multimapa_obtener(multimapa, "perro", &cantidad);
+    print_test("Prueba hash multimapa obtener el unico dato", datos && cantidad == 1 && datos[0] == &valores[0]);
+
+    for (int i = 1; ok && i < 10; i++)
+        ok = hash_multimapa_agregar(multimapa, "perro", &valores[i]);
+    print_test("Prueba hash multimapa agregar mas datos a la misma clave", ok);
+    print_test("Prueba hash multimapa sigue habiendo una clave", hash_multimapa_cantidad(multimapa) == 1);
+    print_test("Prueba hash multimapa hay 10 datos", hash_multimapa_cantidad_datos(multimapa) == 10);
+    datos = hash_multimapa_obtener(multimapa, "perro", &cantidad);
+    for (int i = 0; ok && i < 10; i++)
+        ok = (datos[i] == &valores[i]);
+    print_test("Prueba hash multimapa los datos estan en orden", ok && cantidad == 10);
+
+    print_test("Prueba hash multimapa borrar un dato del medio", hash_multimapa_borrar_dato(multimapa, "perro", &valores[4]));
+    print_test("Prueba hash multimapa borrar un dato que no esta", !hash_multimapa_borrar_dato(multimapa, "perro", &valores[4]));
+    datos = hash_multimapa_obtener(multimapa, "perro", &cantidad);
+    print_test("Prueba hash multimapa los demas datos conservan su orden",
+               cantidad == 9 && datos[3] == &valores[3] && datos[4] == &valores[5] && datos[8] == &valores[9]);
+
+    for (int i = 0; ok && i < 10; i++) {
+        if (i != 4)
+            ok = hash_multimapa_borrar_dato(multimapa, "perro", &valores[i]);
+    }
+    print_test("Prueba hash multimapa borrar todos los datos", ok);
+    print_test("Prueba hash multimapa la clave sin datos no pertenece", !hash_multimapa_pertenece(multimapa, "perro"));
+    print_test("Prueba hash multimapa la cantidad de claves es 0",
+               hash_multimapa_cantidad(multimapa) == 0 && hash_multimapa_cantidad_datos(multimapa) == 0);
+
+    hash_multimapa_destruir(multimapa);
+}
+
+static void prueba_hash_multimapa_borrar_con_destruir()
+{
+    hash_multimapa_t* multimapa = hash_multimapa_crear(free);
+    bool ok = true;
+
+    for (int i = 0; ok && i < 5; i++)
+        ok = hash_multimapa_agregar(multimapa, "perro", malloc(10)) && hash_multimapa_agregar(multimapa, "gato", malloc(10));
+    print_test("Prueba hash multimapa agregar datos con destruir", ok);
+    print_test("Prueba hash multimapa borrar perro destruye sus datos", hash_multimapa_borrar(multimapa, "perro"));
+    print_test("Prueba hash multimapa quedan los datos de gato",
+               hash_multimapa_cantidad(multimapa) == 1 && hash_multimapa_cantidad_datos(multimapa) == 5);
+
+    /* Se destruye el multimapa con datos, libera los de gato */
+    hash_multimapa_destruir(multimapa);
+}
+
+static bool sumar_datos(const char *clave, void *const *datos, size_t cantidad, void *extra)
+{
+    for (size_t i = 0; i < cantidad; i++)
+        *(size_t *) extra += *(unsigned *) datos[i];
+    return true;
+}
+
+static void prueba_hash_multimapa_volumen(size_t largo)
+{
+    hash_multimapa_t* multimapa = hash_multimapa_crear(free);
+    char clave[16];
+    unsigned *valor;
+    void *const *datos;
+    size_t cantidad, suma = 0;
+    bool ok = true;
+
+    /* Cada clave i % 100 recibe los valores i */
+    for (unsigned i = 0; ok && i < largo; i++) {
+        sprintf(clave, "%08u", i % 100);
+        valor = malloc(sizeof(unsigned));
+        *valor = i;
+        ok = hash_multimapa_agregar(multimapa, clave, valor);
+    }
+    print_test("Prueba hash multimapa almacenar muchos datos", ok && hash_multimapa_cantidad_datos(multimapa) == largo);
+    print_test("Prueba hash multimapa la cantidad de claves es 100", hash_multimapa_cantidad(multimapa) == 100);
+
+    for (unsigned i = 0; ok && i < 100; i++) {
+        sprintf(clave, "%08u", i);
+        datos = hash_multimapa_obtener(multimapa, clave, &cantidad);
+        ok = datos && cantidad == largo / 100;
+        for (size_t j = 0; ok && j < cantidad; j++)
+            ok = (*(unsigned *) datos[j] == i + j * 100);
+    }
+    print_test("Prueba hash multimapa obtener los datos de cada clave", ok);
+
+    hash_multimapa_iterar(multimapa, sumar_datos, &suma);
+    print_test("Prueba hash multimapa iterar visita todos los datos", suma == largo * (largo - 1) / 2);
+
+    hash_multimapa_destruir(multimapa);
+}
+
+/* ******************************************************************
+ *                        FUNCIÓN PRINCIPAL
+ * *****************************************************************/
+
+void pruebas_hash_multimapa_alumno()
+{
+    /* Ejecuta todas las pruebas unitarias. */
+    prueba_hash_multimapa_vacio();
+    prueba_hash_multimapa_varios_datos();
+    prueba_hash_multimapa_borrar_con_destruir();
+    prueba_hash_multimapa_volumen(5000);
+}
@@ -0,0 +1,175 @@
+#include "hash_swiss.h"
+#include "testing.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* ******************************************************************
+ *                        PRUEBAS UNITARIAS
+ * *****************************************************************/
+
+static void prueba_hash_swiss_vacio()
+{
+    hash_swiss_t* hash = hash_swiss_crear(NULL);
+
+    print_test("Prueba hash swiss crear hash vacio", hash);
+    print_test("Prueba hash swiss la cantidad de elementos es 0", hash_swiss_cantidad(hash) == 0);
+    print_test("Prueba hash swiss obtener clave A, es NULL", !hash_swiss_obtener(hash, "A"));
+    print_test("Prueba hash swiss pertenece clave A, es false", !hash_swiss_pertenece(hash, "A"));
+    print_test("Prueba hash swiss borrar clave A, es NULL", !hash_swiss_borrar(hash, "A"));
+    print_test("Prueba hash swiss guardar clave NULL, es false", !hash_swiss_guardar(hash, NULL, NULL));
+
+    hash_swiss_destruir(hash);
+}
+
+static void prueba_hash_swiss_reemplazar_con_destruir()
+{
+    hash_swiss_t* hash = hash_swiss_crear(free);
+    char *clave1 = "perro", *valor1a = malloc(10), *valor1b = malloc(10);
+    char *clave2 = "", *valor2 = malloc(10);
+
+    print_test("Prueba hash swiss insertar clave1", hash_swiss_guardar(hash, clave1, valor1a));
+    print_test("Prueba hash swiss insertar clave vacia", hash_swiss_guardar(hash, clave2, valor2));
+    print_test("Prueba hash swiss obtener clave1 es valor1a", hash_swiss_obtener(hash, clave1) == valor1a);
+    print_test("Prueba hash swiss reemplazar clave1 libera valor1a", hash_swiss_guardar(hash, clave1, valor1b));
+    print_test("Prueba hash swiss obtener clave1 es valor1b", hash_swiss_obtener(hash, clave1) == valor1b);
+    print_test("Prueba hash swiss la cantidad de elementos es 2", hash_swiss_cantidad(hash) == 2);
+    print_test("Prueba hash swiss pertenece clave vacia", hash_swiss_pertenece(hash, clave2));
+
+    /* Se destruye el hash con elementos, libera valor1b y valor2 */
+    hash_swiss_destruir(hash);
+}
+
+static void prueba_hash_swiss_volumen(size_t largo)
+{
+    hash_swiss_t* hash = hash_swiss_crear(free);
+    char clave[16];
+    unsigned *valor;
+    bool ok = true;
+
+    for (unsigned i = 0; ok && i < largo; i++) {
+        sprintf(clave, "%08u", i);
+        valor = malloc(sizeof(unsigned));
+        *valor = i;
+        ok = hash_swiss_guardar(hash, clave, valor);
+    }
+    print_test("Prueba hash swiss almacenar muchos elementos", ok);
+    print_test("Prueba hash swiss la cantidad de elementos es correcta", hash_swiss_cantidad(hash) == largo);
+
+    for (unsigned i = 0; ok && i < largo; i++) {
+        sprintf(clave, "%08u", i);
+        valor = hash_swiss_obtener(hash, clave);
+        ok = valor && *valor == i;
+    }
+    print_test("Prueba hash swiss obtener muchos elementos", ok);
+
+    for (unsigned i = (unsigned) largo; ok && i < 2 * largo; i++) {
+        sprintf(clave, "%08u", i);
+        ok = !hash_swiss_pertenece(hash, clave);
+    }
+    print_test("Prueba hash swiss las claves que no estan no pertenecen", ok);
+
+    /* Borrar las claves pares deja ranuras borradas en medio de los sondeos */
+    for (unsigned i = 0; ok && i < largo; i += 2) {
+        sprintf(clave, "%08u", i);
+        valor = hash_swiss_borrar(hash, clave);
+        ok = valor && *valor == i;
+        free(valor);
+    }
+    print_test("Prueba hash swiss borrar la mitad de los elementos", ok);
+    for (unsigned i = 0; ok && i < largo; i++) {
+        sprintf(clave, "%08u", i);
+        ok = (hash_swiss_pertenece(hash, clave) == (i % 2 == 1));
+    }
+    print_test("Prueba hash swiss siguen las claves impares y no las pares", ok);
+
+    /* Volver a guardar las pares reutiliza las ranuras borradas */
+    for (unsigned i = 0; ok && i < largo; i += 2) {
+        sprintf(clave, "%08u", i);
+        valor = malloc(sizeof(unsigned));
+        *valor = i;
+        ok = hash_swiss_guardar(hash, clave, valor);
+    }
+    for (unsigned i = 0; ok && i < largo; i++) {
+        sprintf(clave, "%08u", i);
+        valor = hash_swiss_obtener(hash, clave);
+        ok = valor && *valor == i;
+    }
+    print_test("Prueba hash swiss volver a guardar las claves borradas", ok && hash_swiss_cantidad(hash) == largo);
+
+    /* Borrar todo achica la tabla */
+    for (unsigned i = 0; ok && i < largo; i++) {
+        sprintf(clave, "%08u", i);
+        free(hash_swiss_borrar(hash, clave));
+    }
+    print_test("Prueba hash swiss borrar todos los elementos", hash_swiss_cantidad(hash) == 0);
+    print_test("Prueba hash swiss la tabla vacia ocupa poca memoria", hash_swiss_memoria(hash) < 1024);
+
+    hash_swiss_destruir(hash);
+}
+
+/* Guarda y borra muchas veces pocas claves distintas, sin que la tabla crezca */
+static void prueba_hash_swiss_rotacion(size_t vueltas)
+{
+    hash_swiss_t* hash = hash_swiss_crear(NULL);
+    char clave[16];
+    size_t memoria;
+    bool ok = true;
+
+    for (unsigned i = 0; i < 10; i++) {
+        sprintf(clave, "fija%u", i);
+        hash_swiss_guardar(hash, clave, NULL);
+    }
+    memoria = hash_swiss_memoria(hash);
+    for (unsigned i = 0; ok && i < vueltas; i++) {
+        sprintf(clave, "%08u", i);
+        ok = hash_swiss_guardar(hash, clave, NULL) && hash_swiss_pertenece(hash, "fija3");
+        hash_swiss_borrar(hash, clave);
+    }
+    print_test("Prueba hash swiss guardar y borrar muchas claves distintas", ok && hash_swiss_cantidad(hash) == 10);
+    print_test("Prueba hash swiss las ranuras borradas no agrandan la tabla", hash_swiss_memoria(hash) < 2 * memoria);
+
+    hash_swiss_destruir(hash);
+}
+
+static void prueba_hash_swiss_iterar(size_t largo)
+{
+    hash_swiss_t* hash = hash_swiss_crear(NULL);
+    hash_swiss_iter_t* iter;
+    char clave[16];
+    size_t recorridos = 0;
+    bool ok = true;
+
+    for (unsigned i = 0; i < largo; i++) {
+        sprintf(clave, "%08u", i);
+        hash_swiss_guardar(hash, clave, hash);
+    }
+    iter = hash_swiss_iter_crear(hash);
+    print_test("Prueba hash swiss crear iterador", iter);
+    while (!hash_swiss_iter_al_final(iter)) {
+        ok = ok && hash_swiss_pertenece(hash, hash_swiss_iter_ver_actual(iter)) && hash_swiss_iter_ver_dato(iter) == hash;
+        recorridos++;
+        hash_swiss_iter_avanzar(iter);
+    }
+    print_test("Prueba hash swiss iterador recorre todas las claves", ok && recorridos == largo);
+    print_test("Prueba hash swiss iterador al final, ver actual es NULL", !hash_swiss_iter_ver_actual(iter));
+    print_test("Prueba hash swiss iterador al final, avanzar es false", !hash_swiss_iter_avanzar(iter));
+
+    hash_swiss_iter_destruir(iter);
+    hash_swiss_destruir(hash);
+}
+
+/* ******************************************************************
+ *                        FUNCIÓN PRINCIPAL
+ * *****************************************************************/
+
+void pruebas_hash_swiss_alumno()
+{
+    /* Ejecuta todas las pruebas unitarias. */
+    prueba_hash_swiss_vacio();
+    prueba_hash_swiss_reemplazar_con_destruir();
+    prueba_hash_swiss_volumen(5000);
+    prueba_hash_swiss_rotacion(5000);
+    prueba_hash_swiss_iterar(1000);
+}
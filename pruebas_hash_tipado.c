@@ -0,0 +1,195 @@
+#include "hash_tipado.h"
+#include "testing.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/* ******************************************************************
+ *                        TABLAS DE PRUEBA
+ * *****************************************************************/
+
+typedef struct punto {
+    int32_t x, y;
+} punto_t;
+
+static inline uint64_t punto_hash(punto_t punto)
+{
+    return hash_tipado_mezclar(((uint64_t) (uint32_t) punto.x << 32) | (uint32_t) punto.y);
+}
+
+static inline bool punto_igual(punto_t a, punto_t b)
+{
+    return a.x == b.x && a.y == b.y;
+}
+
+/* Todas las claves caen en la misma posición, cerca del final del arreglo */
+static inline uint64_t hash_constante(uint64_t clave)
+{
+    return 13;
+}
+
+HASH_DEFINIR(tabla_u64, uint64_t, double, hash_tipado_hash_u64, hash_tipado_igual_u64)
+HASH_DEFINIR(tabla_cadena, const char *, int, hash_tipado_hash_cadena, hash_tipado_igual_cadena)
+HASH_DEFINIR(tabla_punto, punto_t, uint32_t, punto_hash, punto_igual)
+HASH_DEFINIR(tabla_colision, uint64_t, uint64_t, hash_constante, hash_tipado_igual_u64)
+HASH_DEFINIR_CONJUNTO(conjunto_guardado, hash_tipado_cadena_t, hash_tipado_hash_guardado, hash_tipado_igual_guardado)
+
+/* ******************************************************************
+ *                        PRUEBAS UNITARIAS
+ * *****************************************************************/
+
+static void prueba_hash_tipado_cadenas()
+{
+    tabla_cadena_t* tabla = tabla_cadena_crear();
+    int valor = 0;
+
+    print_test("Prueba hash tipado crear tabla de cadenas", tabla);
+    print_test("Prueba hash tipado la cantidad de elementos es 0", tabla_cadena_cantidad(tabla) == 0);
+    print_test("Prueba hash tipado obtener clave inexistente es NULL", !tabla_cadena_obtener(tabla, "perro"));
+    print_test("Prueba hash tipado guardar perro", tabla_cadena_guardar(tabla, "perro", 1));
+    print_test("Prueba hash tipado guardar clave vacia", tabla_cadena_guardar(tabla, "", 2));
+    print_test("Prueba hash tipado obtener perro es 1", *tabla_cadena_obtener(tabla, "perro") == 1);
+    print_test("Prueba hash tipado reemplazar perro", tabla_cadena_guardar(tabla, "perro", 3));
+    print_test("Prueba hash tipado obtener perro es 3", *tabla_cadena_obtener(tabla, "perro") == 3);
+    print_test("Prueba hash tipado la cantidad de elementos es 2", tabla_cadena_cantidad(tabla) == 2);
+
+    /* El valor se puede modificar en la tabla a través del puntero */
+    (*tabla_cadena_obtener(tabla, ""))++;
+    print_test("Prueba hash tipado modificar el valor en la tabla", *tabla_cadena_obtener(tabla, "") == 3);
+
+    print_test("Prueba hash tipado borrar perro devuelve su valor", tabla_cadena_borrar(tabla, "perro", &valor) && valor == 3);
+    print_test("Prueba hash tipado perro ya no pertenece", !tabla_cadena_pertenece(tabla, "perro"));
+    print_test("Prueba hash tipado borrar perro otra vez es false", !tabla_cadena_borrar(tabla, "perro", NULL));
+    print_test("Prueba hash tipado la cantidad de elementos es 1", tabla_cadena_cantidad(tabla) == 1);
+
+    tabla_cadena_destruir(tabla);
+}
+
+static void prueba_hash_tipado_claves_compuestas()
+{
+    tabla_punto_t* tabla = tabla_punto_crear();
+    punto_t origen = { 0, 0 }, p = { -3, 7 }, q = { 7, -3 };
+
+    tabla_punto_guardar(tabla, origen, 10);
+    tabla_punto_guardar(tabla, p, 20);
+    print_test("Prueba hash tipado obtener clave compuesta", *tabla_punto_obtener(tabla, p) == 20);
+    print_test("Prueba hash tipado clave con los campos al reves no pertenece", !tabla_punto_pertenece(tabla, q));
+    print_test("Prueba hash tipado pertenece el origen", tabla_punto_pertenece(tabla, origen));
+
+    tabla_punto_destruir(tabla);
+}
+
+static void prueba_hash_tipado_colisiones(size_t largo)
+{
+    tabla_colision_t* tabla = tabla_colision_crear();
+    uint64_t valor;
+    bool ok = true;
+
+    /* Con todas las claves en el mismo lugar el sondeo da la vuelta al arreglo */
+    for (uint64_t i = 0; i < largo; i++)
+        ok = ok && tabla_colision_guardar(tabla, i, i * 2);
+    print_test("Prueba hash tipado guardar claves que colisionan", ok);
+
+    /* Borrar del medio de la secuencia de sondeo corre hacia atrás las siguientes */
+    for (uint64_t i = 0; ok && i < largo; i += 3)
+        ok = tabla_colision_borrar(tabla, i, &valor) && valor == i * 2;
+    print_test("Prueba hash tipado borrar claves que colisionan", ok);
+    for (uint64_t i = 0; ok && i < largo; i++) {
+        uint64_t *actual = tabla_colision_obtener(tabla, i);
+        ok = (i % 3 == 0) ? !actual : (actual && *actual == i * 2);
+    }
+    print_test("Prueba hash tipado las demas claves siguen estando", ok);
+
+    tabla_colision_destruir(tabla);
+}
+
+static bool sumar(uint64_t clave, double *valor, void *extra)
+{
+    *(double *) extra += *valor;
+    return true;
+}
+
+static void prueba_hash_tipado_volumen(size_t largo)
+{
+    tabla_u64_t* tabla = tabla_u64_crear();
+    double suma = 0, *valor;
+    bool ok = true;
+
+    for (uint64_t i = 0; ok && i < largo; i++)
+        ok = tabla_u64_guardar(tabla, i * 7919, (double) i);
+    print_test("Prueba hash tipado almacenar muchos elementos", ok && tabla_u64_cantidad(tabla) == largo);
+    for (uint64_t i = 0; ok && i < largo; i++) {
+        valor = tabla_u64_obtener(tabla, i * 7919);
+        ok = valor && *valor == (double) i && !tabla_u64_pertenece(tabla, i * 7919 + 1);
+    }
+    print_test("Prueba hash tipado obtener muchos elementos", ok);
+
+    tabla_u64_iterar(tabla, sumar, &suma);
+    print_test("Prueba hash tipado iterar visita todos los valores",
+               suma == (double) largo * (double) (largo - 1) / 2);
+
+    for (uint64_t i = 0; ok && i < largo; i += 2)
+        ok = tabla_u64_borrar(tabla, i * 7919, NULL);
+    for (uint64_t i = 0; ok && i < largo; i++)
+        ok = (tabla_u64_pertenece(tabla, i * 7919) == (i % 2 == 1));
+    print_test("Prueba hash tipado borrar la mitad de los elementos", ok);
+    for (uint64_t i = 1; ok && i < largo; i += 2)
+        ok = tabla_u64_borrar(tabla, i * 7919, NULL);
+    print_test("Prueba hash tipado borrar todos los elementos", ok && tabla_u64_cantidad(tabla) == 0);
+
+    tabla_u64_destruir(tabla);
+}
+
+static bool contar(hash_tipado_cadena_t clave, void *extra)
+{
+    (*(size_t *) extra)++;
+    return true;
+}
+
+static void prueba_hash_tipado_conjunto(size_t largo)
+{
+    conjunto_guardado_t* conjunto = conjunto_guardado_crear();
+    char (*claves)[10] = malloc(largo * sizeof(*claves));
+    size_t capacidad, visitadas = 0;
+    bool ok = true;
+
+    print_test("Prueba hash tipado conjunto asegurar lugar", conjunto_guardado_asegurar(conjunto, largo));
+    capacidad = conjunto->capacidad;
+    for (size_t i = 0; ok && i < largo; i++) {
+        sprintf(claves[i], "%08zu", i);
+        ok = conjunto_guardado_agregar(conjunto, hash_tipado_cadena_crear(claves[i]));
+    }
+    print_test("Prueba hash tipado conjunto agregar muchas claves", ok && conjunto_guardado_cantidad(conjunto) == largo);
+    print_test("Prueba hash tipado conjunto no redimensiona despues de asegurar", conjunto->capacidad == capacidad);
+    print_test("Prueba hash tipado conjunto agregar una clave repetida",
+               conjunto_guardado_agregar(conjunto, hash_tipado_cadena_crear("00000000")) &&
+               conjunto_guardado_cantidad(conjunto) == largo);
+    print_test("Prueba hash tipado conjunto pertenece", conjunto_guardado_pertenece(conjunto, hash_tipado_cadena_crear("00000001")));
+    print_test("Prueba hash tipado conjunto no pertenece", !conjunto_guardado_pertenece(conjunto, hash_tipado_cadena_crear("perro")));
+
+    conjunto_guardado_iterar(conjunto, contar, &visitadas);
+    print_test("Prueba hash tipado conjunto iterar visita todas las claves", visitadas == largo);
+
+    for (size_t i = 0; ok && i < largo; i++)
+        ok = conjunto_guardado_sacar(conjunto, hash_tipado_cadena_crear(claves[i]));
+    print_test("Prueba hash tipado conjunto sacar todas las claves", ok && conjunto_guardado_cantidad(conjunto) == 0);
+    print_test("Prueba hash tipado conjunto sacar una clave que no esta",
+               !conjunto_guardado_sacar(conjunto, hash_tipado_cadena_crear("00000000")));
+
+    conjunto_guardado_destruir(conjunto);
+    free(claves);
+}
+
+/* ******************************************************************
+ *                        FUNCIÓN PRINCIPAL
+ * *****************************************************************/
+
+void pruebas_hash_tipado_alumno()
+{
+    /* Ejecuta todas las pruebas unitarias. */
+    prueba_hash_tipado_cadenas();
+    prueba_hash_tipado_claves_compuestas();
+    prueba_hash_tipado_colisiones(200);
+    prueba_hash_tipado_volumen(50000);
+    prueba_hash_tipado_conjunto(5000);
+}
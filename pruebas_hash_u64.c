@@ -0,0 +1,95 @@
+#include "hash_u64.h"
+#include "testing.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/* ******************************************************************
+ *                        PRUEBAS UNITARIAS
+ * *****************************************************************/
+
+static void prueba_hash_u64_vacio()
+{
+    hash_u64_t* hash = hash_u64_crear(NULL);
+    hash_u64_iter_t* iter = hash_u64_iter_crear(hash);
+
+    print_test("Prueba hash u64 crear hash vacio", hash);
+    print_test("Prueba hash u64 la cantidad de elementos es 0", hash_u64_cantidad(hash) == 0);
+    print_test("Prueba hash u64 obtener clave 0, es NULL", !hash_u64_obtener(hash, 0));
+    print_test("Prueba hash u64 pertenece clave 0, es false", !hash_u64_pertenece(hash, 0));
+    print_test("Prueba hash u64 borrar clave 0, es NULL", !hash_u64_borrar(hash, 0));
+    print_test("Prueba hash u64 iterador de hash vacio esta al final", iter && hash_u64_iter_al_final(iter));
+
+    hash_u64_iter_destruir(iter);
+    hash_u64_destruir(hash);
+}
+
+static void prueba_hash_u64_reemplazar_con_destruir()
+{
+    hash_u64_t* hash = hash_u64_crear(free);
+    char *valor1a = malloc(10), *valor1b = malloc(10), *valor2 = malloc(10);
+
+    print_test("Prueba hash u64 insertar clave 0", hash_u64_guardar(hash, 0, valor1a));
+    print_test("Prueba hash u64 insertar clave maxima", hash_u64_guardar(hash, UINT64_MAX, valor2));
+    print_test("Prueba hash u64 reemplazar clave 0 libera el dato anterior", hash_u64_guardar(hash, 0, valor1b));
+    print_test("Prueba hash u64 obtener clave 0 es el dato nuevo", hash_u64_obtener(hash, 0) == valor1b);
+    print_test("Prueba hash u64 obtener clave maxima", hash_u64_obtener(hash, UINT64_MAX) == valor2);
+    print_test("Prueba hash u64 la cantidad de elementos es 2", hash_u64_cantidad(hash) == 2);
+
+    /* Se destruye el hash con elementos, libera valor1b y valor2 */
+    hash_u64_destruir(hash);
+}
+
+static void prueba_hash_u64_volumen(size_t largo)
+{
+    hash_u64_t* hash = hash_u64_crear(free);
+    hash_u64_iter_t* iter;
+    uint64_t *valor, suma = 0;
+    size_t recorridos = 0;
+    bool ok = true;
+
+    /* Identificadores grandes y espaciados, como los de una base de datos */
+    for (uint64_t i = 0; ok && i < largo; i++) {
+        valor = malloc(sizeof(uint64_t));
+        *valor = i;
+        ok = hash_u64_guardar(hash, i << 32 | 17, valor);
+    }
+    print_test("Prueba hash u64 almacenar muchos elementos", ok && hash_u64_cantidad(hash) == largo);
+    for (uint64_t i = 0; ok && i < largo; i++) {
+        valor = hash_u64_obtener(hash, i << 32 | 17);
+        ok = valor && *valor == i && !hash_u64_pertenece(hash, i << 32 | 18);
+    }
+    print_test("Prueba hash u64 obtener muchos elementos", ok);
+
+    iter = hash_u64_iter_crear(hash);
+    for (; !hash_u64_iter_al_final(iter); hash_u64_iter_avanzar(iter)) {
+        ok = ok && *(uint64_t *) hash_u64_iter_ver_dato(iter) == hash_u64_iter_ver_actual(iter) >> 32;
+        suma += hash_u64_iter_ver_actual(iter) >> 32;
+        recorridos++;
+    }
+    hash_u64_iter_destruir(iter);
+    print_test("Prueba hash u64 iterador recorre todos los pares", ok && recorridos == largo &&
+               suma == (uint64_t) largo * (largo - 1) / 2);
+
+    for (uint64_t i = 0; ok && i < largo; i += 2) {
+        valor = hash_u64_borrar(hash, i << 32 | 17);
+        ok = valor && *valor == i;
+        free(valor);
+    }
+    print_test("Prueba hash u64 borrar la mitad de los elementos", ok && hash_u64_cantidad(hash) == largo / 2);
+
+    /* Se destruye el hash con la otra mitad, que libera destruir_dato */
+    hash_u64_destruir(hash);
+}
+
+/* ******************************************************************
+ *                        FUNCIÓN PRINCIPAL
+ * *****************************************************************/
+
+void pruebas_hash_u64_alumno()
+{
+    /* Ejecuta todas las pruebas unitarias. */
+    prueba_hash_u64_vacio();
+    prueba_hash_u64_reemplazar_con_destruir();
+    prueba_hash_u64_volumen(10000);
+}
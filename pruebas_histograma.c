@@ -0,0 +1,84 @@
+#include "histograma.h"
+#include "testing.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/* ******************************************************************
+ *                        PRUEBAS UNITARIAS
+ * *****************************************************************/
+
+/* Determina si el valor está a menos de una parte en 10^3 del esperado */
+static bool cerca(uint64_t valor, uint64_t esperado)
+{
+    uint64_t diferencia = (valor > esperado ? valor - esperado : esperado - valor);
+    return diferencia * 1000 <= esperado;
+}
+
+static void prueba_histograma_vacio()
+{
+    histograma_t* histograma = histograma_crear(1000000, 3);
+
+    print_test("Prueba histograma no se crea con 0 digitos", !histograma_crear(1000, 0));
+    print_test("Prueba histograma no se crea con 6 digitos", !histograma_crear(1000, 6));
+    print_test("Prueba histograma crear histograma vacio", histograma);
+    print_test("Prueba histograma la cantidad es 0", histograma_cantidad(histograma) == 0);
+    print_test("Prueba histograma la media es 0", histograma_media(histograma) == 0);
+    print_test("Prueba histograma el percentil 50 es 0", histograma_percentil(histograma, 50) == 0);
+    print_test("Prueba histograma el maximo es 0", histograma_maximo(histograma) == 0);
+
+    histograma_destruir(histograma);
+}
+
+static void prueba_histograma_percentiles()
+{
+    histograma_t* histograma = histograma_crear(1000000, 3);
+
+    for (uint64_t i = 1; i <= 100000; i++)
+        histograma_registrar(histograma, i);
+    print_test("Prueba histograma la cantidad es 100000", histograma_cantidad(histograma) == 100000);
+    print_test("Prueba histograma la media es exacta", histograma_media(histograma) == 50000.5);
+    print_test("Prueba histograma el minimo es 1", histograma_minimo(histograma) == 1);
+    print_test("Prueba histograma el maximo es 100000", histograma_maximo(histograma) == 100000);
+    print_test("Prueba histograma p50 con 3 digitos de precision", cerca(histograma_percentil(histograma, 50), 50000));
+    print_test("Prueba histograma p99 con 3 digitos de precision", cerca(histograma_percentil(histograma, 99), 99000));
+    print_test("Prueba histograma p999 con 3 digitos de precision",
+               cerca(histograma_percentil(histograma, 99.9), 99900));
+    print_test("Prueba histograma p100 es el maximo", histograma_percentil(histograma, 100) == 100000);
+
+    /* Los valores chicos se cuentan de a uno */
+    histograma_reiniciar(histograma);
+    print_test("Prueba histograma reiniciar lo deja vacio", histograma_cantidad(histograma) == 0);
+    for (uint64_t i = 0; i < 100; i++)
+        histograma_registrar(histograma, i % 10);
+    print_test("Prueba histograma p50 de valores chicos es exacto", histograma_percentil(histograma, 50) == 4);
+    print_test("Prueba histograma p0 es el minimo", histograma_percentil(histograma, 0) == 0);
+
+    histograma_destruir(histograma);
+}
+
+static void prueba_histograma_fuera_de_rango()
+{
+    histograma_t* histograma = histograma_crear(1000, 2);
+
+    histograma_registrar(histograma, 10);
+    histograma_registrar(histograma, 5000000);
+    print_test("Prueba histograma valor fuera de rango se cuenta", histograma_cantidad(histograma) == 2);
+    print_test("Prueba histograma el maximo fuera de rango es exacto", histograma_maximo(histograma) == 5000000);
+    print_test("Prueba histograma p100 fuera de rango queda en el ultimo balde",
+               histograma_percentil(histograma, 100) >= 1000);
+
+    histograma_destruir(histograma);
+}
+
+/* ******************************************************************
+ *                        FUNCIÓN PRINCIPAL
+ * *****************************************************************/
+
+void pruebas_histograma_alumno()
+{
+    /* Ejecuta todas las pruebas unitarias. */
+    prueba_histograma_vacio();
+    prueba_histograma_percentiles();
+    prueba_histograma_fuera_de_rango();
+}
@@ -0,0 +1,115 @@
+#include "hash.h"
+#include "internador.h"
+#include "testing.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* ******************************************************************
+ *                        PRUEBAS UNITARIAS
+ * *****************************************************************/
+
+static void prueba_internador_basico()
+{
+    internador_t* internador = internador_crear();
+    char copia[] = "perro";
+    const char *interna1, *interna2;
+
+    print_test("Prueba internador crear", internador);
+    print_test("Prueba internador vacio, buscar es NULL", !internador_buscar(internador, "perro"));
+    interna1 = internador_internar(internador, "perro");
+    interna2 = internador_internar(internador, copia);
+    print_test("Prueba internador internar devuelve una copia", interna1 && interna1 != copia && !strcmp(interna1, "perro"));
+    print_test("Prueba internador cadenas iguales dan el mismo puntero", interna1 == interna2);
+    print_test("Prueba internador la copia tiene 2 referencias", internador_referencias(internador, interna1) == 2);
+    print_test("Prueba internador buscar devuelve la copia", internador_buscar(internador, "perro") == interna1);
+    print_test("Prueba internador buscar no suma referencias", internador_referencias(internador, interna1) == 2);
+    print_test("Prueba internador internar la cadena vacia", internador_internar(internador, "") != interna1);
+    print_test("Prueba internador hay 2 cadenas", internador_cantidad(internador) == 2);
+
+    internador_soltar(internador, interna1);
+    print_test("Prueba internador soltar una referencia mantiene la copia", internador_buscar(internador, "perro") == interna1);
+    internador_soltar(internador, interna2);
+    print_test("Prueba internador soltar la ultima referencia libera la copia", !internador_buscar(internador, "perro"));
+    print_test("Prueba internador queda 1 cadena", internador_cantidad(internador) == 1);
+
+    /* Se destruye con la cadena vacía todavía internada */
+    internador_destruir(internador);
+}
+
+static void prueba_internador_hashes(size_t largo)
+{
+    internador_t* internador = internador_crear();
+    hash_t *hash1 = hash_crear_con_internador(NULL, internador);
+    hash_t *hash2 = hash_crear_con_internador(free, internador);
+    hash_t *propio = hash_crear(NULL);
+    hash_iter_t *iter;
+    char clave[16];
+    unsigned *valor;
+    bool ok = true;
+
+    for (unsigned i = 0; ok && i < largo; i++) {
+        sprintf(clave, "%08u", i);
+        valor = malloc(sizeof(unsigned));
+        *valor = i;
+        ok = hash_guardar(hash1, clave, NULL) && hash_guardar(hash2, clave, valor) && hash_guardar(propio, clave, NULL);
+    }
+    print_test("Prueba internador guardar en dos hashes", ok);
+    print_test("Prueba internador cada clave se interna una sola vez", internador_cantidad(internador) == largo);
+    print_test("Prueba internador los hashes no cuentan las claves internadas", hash_memoria(hash1) < hash_memoria(propio));
+
+    /* Las claves de los dos hashes son las mismas copias */
+    iter = hash_iter_crear(hash1);
+    for (; ok && !hash_iter_al_final(iter); hash_iter_avanzar(iter))
+        ok = internador_buscar(internador, hash_iter_ver_actual(iter)) == hash_iter_ver_actual(iter) &&
+             internador_referencias(internador, hash_iter_ver_actual(iter)) == 2;
+    hash_iter_destruir(iter);
+    print_test("Prueba internador los hashes comparten las claves", ok);
+
+    for (unsigned i = 0; ok && i < largo; i++) {
+        sprintf(clave, "%08u", i);
+        valor = hash_obtener(hash2, clave);
+        ok = valor && *valor == i && hash_pertenece(hash1, clave);
+    }
+    print_test("Prueba internador obtener con una copia de la clave", ok);
+    print_test("Prueba internador clave no internada no pertenece", !hash_pertenece(hash1, "no esta") &&
+               !hash_obtener(hash2, "no esta") && !hash_borrar(hash2, "no esta"));
+
+    /* Una clave internada por otro hash no pertenece a este */
+    internador_internar(internador, "solo del internador");
+    print_test("Prueba internador clave internada que no esta en el hash", !hash_pertenece(hash1, "solo del internador"));
+    internador_soltar(internador, internador_buscar(internador, "solo del internador"));
+
+    /* Reemplazar no suma referencias */
+    hash_guardar(hash1, "00000000", hash1);
+    print_test("Prueba internador reemplazar mantiene las referencias",
+               internador_referencias(internador, internador_buscar(internador, "00000000")) == 2);
+
+    for (unsigned i = 0; ok && i < largo; i += 2) {
+        sprintf(clave, "%08u", i);
+        hash_borrar(hash1, clave);
+    }
+    sprintf(clave, "%08u", 0);
+    print_test("Prueba internador borrar de un hash suelta su referencia",
+               internador_referencias(internador, internador_buscar(internador, clave)) == 1);
+
+    hash_destruir(hash2);
+    print_test("Prueba internador destruir un hash suelta sus claves", internador_cantidad(internador) == largo / 2);
+    hash_destruir(hash1);
+    print_test("Prueba internador destruir los dos hashes vacia el internador", internador_cantidad(internador) == 0);
+
+    hash_destruir(propio);
+    internador_destruir(internador);
+}
+
+/* ******************************************************************
+ *                        FUNCIÓN PRINCIPAL
+ * *****************************************************************/
+
+void pruebas_internador_alumno()
+{
+    /* Ejecuta todas las pruebas unitarias. */
+    prueba_internador_basico();
+    prueba_internador_hashes(5000);
+}
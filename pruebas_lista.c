@@ -0,0 +1,241 @@
+#include "lista.h"
+#include "testing.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/* ******************************************************************
+ *                        FUNCIONES AUXILIARES
+ * *****************************************************************/
+
+/* Compara la lista, recorrida con el iterador externo, con el arreglo */
+static bool lista_es_igual(lista_t *lista, void **esperados, size_t largo)
+{
+    lista_iter_t *iter = lista_iter_crear(lista);
+    size_t i = 0;
+    bool ok = iter && lista_largo(lista) == largo;
+
+    for (; ok && !lista_iter_al_final(iter); lista_iter_avanzar(iter), i++)
+        ok = i < largo && lista_iter_ver_actual(iter) == esperados[i];
+    lista_iter_destruir(iter);
+    return ok && i == largo;
+}
+
+static bool contar(void *dato, void *extra)
+{
+    (*(size_t *) extra)++;
+    return true;
+}
+
+/* ******************************************************************
+ *                        PRUEBAS UNITARIAS
+ * *****************************************************************/
+
+static void prueba_lista_vacia()
+{
+    lista_t* lista = lista_crear();
+    lista_iter_t* iter = lista_iter_crear(lista);
+
+    print_test("Prueba lista crear lista vacia", lista && lista_esta_vacia(lista));
+    print_test("Prueba lista vacia, ver primero es NULL", !lista_ver_primero(lista));
+    print_test("Prueba lista vacia, borrar primero es NULL", !lista_borrar_primero(lista));
+    print_test("Prueba lista vacia, iterador al principio y al final", lista_iter_al_principio(iter) && lista_iter_al_final(iter));
+    print_test("Prueba lista vacia, borrar con iterador es NULL", !lista_iter_borrar(iter));
+
+    lista_iter_destruir(iter);
+    lista_destruir(lista, NULL);
+}
+
+/* Inserta y borra con el iterador en posiciones variadas, así se parten y se
+ * vacían nodos, y compara contra un arreglo con los mismos elementos */
+static void prueba_lista_iterador_en_el_medio(size_t largo)
+{
+    lista_t* lista = lista_crear();
+    size_t *valores = malloc(largo * sizeof(size_t)), cantidad = 0, pos;
+    void **esperados = malloc(largo * sizeof(void *));
+    lista_iter_t* iter;
+    bool ok = true;
+
+    for (size_t i = 0; ok && i < largo; i++) {
+        /* Cada elemento se inserta en una posición pseudoaleatoria */
+        pos = (i * 7919) % (cantidad + 1);
+        iter = lista_iter_crear(lista);
+        for (size_t j = 0; j < pos; j++)
+            lista_iter_avanzar(iter);
+        ok = lista_iter_insertar(iter, &valores[i]) && lista_iter_ver_actual(iter) == &valores[i]
+             && lista_iter_al_principio(iter) == (pos == 0);
+        lista_iter_destruir(iter);
+        for (size_t j = cantidad; j > pos; j--)
+            esperados[j] = esperados[j - 1];
+        esperados[pos] = &valores[i];
+        cantidad++;
+    }
+    print_test("Prueba lista insertar con el iterador en el medio", ok && lista_es_igual(lista, esperados, cantidad));
+
+    /* Se borra uno de cada tres con el iterador */
+    iter = lista_iter_crear(lista);
+    cantidad = 0;
+    for (size_t i = 0; ok && i < largo; i++) {
+        if (i % 3 == 0) {
+            ok = lista_iter_borrar(iter) == esperados[i];
+        } else {
+            esperados[cantidad++] = esperados[i];
+            lista_iter_avanzar(iter);
+        }
+    }
+    ok = ok && lista_iter_al_final(iter) && !lista_iter_al_principio(iter);
+    lista_iter_destruir(iter);
+    print_test("Prueba lista borrar con el iterador en el medio", ok && lista_es_igual(lista, esperados, cantidad));
+
+    /* Borrar todo desde el principio vacía la lista */
+    iter = lista_iter_crear(lista);
+    for (size_t i = 0; ok && i < cantidad; i++)
+        ok = lista_iter_borrar(iter) == esperados[i];
+    print_test("Prueba lista borrar todo con el iterador", ok && lista_esta_vacia(lista) && lista_iter_al_final(iter));
+    lista_iter_destruir(iter);
+
+    free(valores);
+    free(esperados);
+    lista_destruir(lista, NULL);
+}
+
+static void prueba_lista_extremos(size_t largo)
+{
+    lista_t* lista = lista_crear();
+    size_t *valores = malloc(largo * sizeof(size_t)), visitados = 0;
+    void **esperados = malloc(largo * sizeof(void *));
+    bool ok = true;
+
+    for (size_t i = 0; i < largo; i++)
+        esperados[i] = &valores[i];
+
+    /* La primera mitad se inserta al principio, al revés, y la segunda al final */
+    for (size_t i = largo / 2; ok && i > 0; i--)
+        ok = lista_insertar_primero(lista, &valores[i - 1]);
+    for (size_t i = largo / 2; ok && i < largo; i++)
+        ok = lista_insertar_ultimo(lista, &valores[i]);
+    print_test("Prueba lista insertar al principio y al final", ok && lista_es_igual(lista, esperados, largo));
+    lista_iterar(lista, contar, &visitados);
+    print_test("Prueba lista iterar visita todos los elementos", visitados == largo);
+    print_test("Prueba lista ver primero", lista_ver_primero(lista) == &valores[0]);
+
+    free(valores);
+    free(esperados);
+    lista_destruir(lista, NULL);
+}
+
+static void prueba_lista_transferir_reservado(size_t largo)
+{
+    lista_t *origen = lista_crear(), *destino = lista_crear();
+    size_t *valores = malloc(largo * sizeof(size_t)), memoria;
+    bool ok = true;
+
+    for (size_t i = 0; i < largo; i++)
+        lista_insertar_ultimo(origen, &valores[i]);
+    print_test("Prueba lista reservar lugar", lista_reservar(destino, largo / 2) && lista_reservar(destino, largo - largo / 2));
+
+    /* Con el lugar reservado transferir no cambia la memoria de destino */
+    memoria = lista_memoria(destino);
+    for (size_t i = 0; ok && i < largo; i++)
+        ok = lista_transferir_primero(origen, destino);
+    print_test("Prueba lista transferir todos los elementos", ok && lista_esta_vacia(origen) && lista_largo(destino) == largo);
+    print_test("Prueba lista transferir usa el lugar reservado", lista_memoria(destino) == memoria);
+    print_test("Prueba lista transferir de lista vacia es false", !lista_transferir_primero(origen, destino));
+    for (size_t i = largo; ok && i > 0; i--)
+        ok = lista_borrar_primero(destino) == &valores[i - 1];
+    print_test("Prueba lista transferir invierte el orden", ok);
+
+    free(valores);
+    lista_destruir(origen, NULL);
+    lista_destruir(destino, NULL);
+}
+
+typedef struct buscado {
+    void *dato;
+    size_t llamadas;
+} buscado_t;
+
+/* Cuenta las llamadas y coincide con el dato buscado */
+static bool coincide_contando(void *dato, void *extra)
+{
+    buscado_t *buscado = extra;
+    buscado->llamadas++;
+    return dato == buscado->dato;
+}
+
+static void prueba_lista_etiquetas(size_t largo)
+{
+    lista_t *lista = lista_crear(), *destino = lista_crear();
+    lista_iter_t *iter;
+    size_t *valores = malloc(largo * sizeof(size_t));
+    buscado_t buscado;
+    bool ok = true;
+
+    /* La mitad se inserta por el iterador en el medio, así se parten nodos llenos */
+    for (size_t i = 0; i < largo / 2; i++)
+        ok &= lista_insertar_ultimo_con_etiqueta(lista, &valores[i], (uint8_t) (i % 4));
+    iter = lista_iter_crear(lista);
+    for (size_t i = 0; i < largo / 4; i++)
+        lista_iter_avanzar(iter);
+    for (size_t i = largo / 2; i < largo; i++)
+        ok &= lista_iter_insertar_con_etiqueta(iter, &valores[i], (uint8_t) (i % 4));
+    lista_iter_destruir(iter);
+    print_test("Prueba lista insertar con etiqueta", ok && lista_largo(lista) == largo);
+
+    /* Cada elemento se encuentra, y solo se miran los de su etiqueta */
+    for (size_t i = 0; ok && i < largo; i++) {
+        buscado = (buscado_t) { &valores[i], 0 };
+        iter = lista_iter_crear(lista);
+        ok = lista_iter_buscar(iter, (uint8_t) (i % 4), coincide_contando, &buscado)
+             && lista_iter_ver_actual(iter) == &valores[i] && buscado.llamadas <= (largo + 3) / 4;
+        lista_iter_destruir(iter);
+    }
+    print_test("Prueba lista buscar saltea las otras etiquetas", ok);
+
+    buscado = (buscado_t) { &valores[1], 0 };
+    iter = lista_iter_crear(lista);
+    print_test("Prueba lista buscar con otra etiqueta no lo encuentra",
+               !lista_iter_buscar(iter, 0, coincide_contando, &buscado) && lista_iter_al_final(iter));
+    lista_iter_destruir(iter);
+
+    /* Transferir conserva la etiqueta */
+    while (lista_transferir_primero(lista, destino));
+    buscado = (buscado_t) { &valores[largo - 1], 0 };
+    iter = lista_iter_crear(destino);
+    print_test("Prueba lista transferir conserva la etiqueta",
+               lista_iter_buscar(iter, (uint8_t) ((largo - 1) % 4), coincide_contando, &buscado));
+    lista_iter_destruir(iter);
+
+    free(valores);
+    lista_destruir(lista, NULL);
+    lista_destruir(destino, NULL);
+}
+
+static void prueba_lista_destruir_larga(size_t largo)
+{
+    lista_t* lista = lista_crear();
+    bool ok = true;
+
+    for (size_t i = 0; ok && i < largo; i++)
+        ok = lista_insertar_ultimo(lista, malloc(sizeof(size_t)));
+    print_test("Prueba lista insertar muchos elementos", ok && lista_largo(lista) == largo);
+
+    /* Destruir no es recursivo, así una lista larga no agota la pila */
+    lista_destruir(lista, free);
+    print_test("Prueba lista destruir una lista larga", true);
+}
+
+/* ******************************************************************
+ *                        FUNCIÓN PRINCIPAL
+ * *****************************************************************/
+
+void pruebas_lista_alumno()
+{
+    /* Ejecuta todas las pruebas unitarias. */
+    prueba_lista_vacia();
+    prueba_lista_iterador_en_el_medio(500);
+    prueba_lista_extremos(1000);
+    prueba_lista_transferir_reservado(1000);
+    prueba_lista_etiquetas(1000);
+    prueba_lista_destruir_larga(1000000);
+}
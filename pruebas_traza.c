@@ -0,0 +1,103 @@
+#include "testing.h"
+#include "traza.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define RUTA_TRAZA "prueba_traza.traza"
+
+/* ******************************************************************
+ *                        PRUEBAS UNITARIAS
+ * *****************************************************************/
+
+static bool escribir_archivo(const char *contenido)
+{
+    FILE* archivo = fopen(RUTA_TRAZA, "w");
+    if (!archivo)
+        return false;
+    fputs(contenido, archivo);
+    return fclose(archivo) == 0;
+}
+
+/* Lee la traza y verifica que tenga exactamente las operaciones esperadas */
+static bool leer_todo(bool mapear, const traza_operacion_t *operaciones, const char **claves, size_t cantidad)
+{
+    traza_t* traza = traza_abrir(RUTA_TRAZA, mapear);
+    traza_operacion_t operacion;
+    const char *clave;
+    size_t i = 0;
+    bool ok = traza != NULL;
+
+    while (ok && traza_siguiente(traza, &operacion, &clave)) {
+        ok = i < cantidad && operacion == operaciones[i] && !strcmp(clave, claves[i]);
+        i++;
+    }
+    ok = ok && i == cantidad && !traza_error(traza);
+    if (traza)
+        traza_cerrar(traza);
+    return ok;
+}
+
+static void prueba_traza_escribir_y_leer()
+{
+    traza_operacion_t operaciones[] = { TRAZA_GUARDAR, TRAZA_OBTENER, TRAZA_PERTENECE, TRAZA_BORRAR, TRAZA_GUARDAR };
+    const char *claves[] = { "perro", "clave con espacios", "", "perro", "ultima" };
+    FILE* archivo = fopen(RUTA_TRAZA, "w");
+    bool ok = archivo != NULL;
+
+    fputs("# comentario\n\n", archivo);
+    for (size_t i = 0; ok && i < 5; i++)
+        ok = traza_escribir(archivo, operaciones[i], claves[i]);
+    print_test("Prueba traza escribir operaciones", ok);
+    print_test("Prueba traza no se escribe una clave con salto de linea", !traza_escribir(archivo, TRAZA_GUARDAR, "a\nb"));
+    fclose(archivo);
+
+    print_test("Prueba traza leer con mmap", leer_todo(true, operaciones, claves, 5));
+    print_test("Prueba traza leer con buffer", leer_todo(false, operaciones, claves, 5));
+
+    /* Fin de línea de Windows y última línea sin salto */
+    escribir_archivo("g perro\r\no gato");
+    print_test("Prueba traza CRLF y sin salto final con mmap",
+               leer_todo(true, (traza_operacion_t[]) { TRAZA_GUARDAR, TRAZA_OBTENER },
+                         (const char *[]) { "perro", "gato" }, 2));
+    print_test("Prueba traza CRLF y sin salto final con buffer",
+               leer_todo(false, (traza_operacion_t[]) { TRAZA_GUARDAR, TRAZA_OBTENER },
+                         (const char *[]) { "perro", "gato" }, 2));
+
+    escribir_archivo("");
+    print_test("Prueba traza vacia con mmap", leer_todo(true, NULL, NULL, 0));
+    print_test("Prueba traza vacia con buffer", leer_todo(false, NULL, NULL, 0));
+    remove(RUTA_TRAZA);
+}
+
+static void prueba_traza_invalida()
+{
+    traza_t* traza;
+    traza_operacion_t operacion;
+    const char *clave;
+
+    print_test("Prueba traza abrir archivo inexistente es NULL", !traza_abrir("no_existe.traza", true));
+
+    escribir_archivo("g perro\n# comentario\nx gato\no perro\n");
+    for (int mapear = 0; mapear < 2; mapear++) {
+        traza = traza_abrir(RUTA_TRAZA, mapear);
+        print_test("Prueba traza la primera linea es valida", traza_siguiente(traza, &operacion, &clave));
+        print_test("Prueba traza se detiene en la linea invalida", !traza_siguiente(traza, &operacion, &clave));
+        print_test("Prueba traza reporta el error y su linea", traza_error(traza) && traza_linea(traza) == 3);
+        print_test("Prueba traza no sigue despues del error", !traza_siguiente(traza, &operacion, &clave));
+        traza_cerrar(traza);
+    }
+    remove(RUTA_TRAZA);
+}
+
+/* ******************************************************************
+ *                        FUNCIÓN PRINCIPAL
+ * *****************************************************************/
+
+void pruebas_traza_alumno()
+{
+    /* Ejecuta todas las pruebas unitarias. */
+    prueba_traza_escribir_y_leer();
+    prueba_traza_invalida();
+}
@@ -0,0 +1,26 @@
+#define _POSIX_C_SOURCE 199309L
+#include "reloj.h"
+#include <time.h>
+#define CALIBRACIONES 10000
+
+uint64_t reloj_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000u + (uint64_t) ts.tv_nsec;
+}
+
+uint64_t reloj_calibrar(void) {
+    uint64_t minimo = UINT64_MAX, inicio, fin;
+    for (int i = 0; i < CALIBRACIONES; i++) {
+        inicio = reloj_ns();
+        fin = reloj_ns();
+        if (fin - inicio < minimo)
+            minimo = fin - inicio;
+    }
+    return minimo;
+}
+
+void reloj_registrar(histograma_t *histograma, uint64_t inicio, uint64_t costo_reloj) {
+    uint64_t transcurrido = reloj_ns() - inicio;
+    histograma_registrar(histograma, transcurrido > costo_reloj ? transcurrido - costo_reloj : 0);
+}
@@ -0,0 +1,30 @@
+#ifndef RELOJ_H
+#define RELOJ_H
+
+#include "histograma.h"
+#include <stdint.h>
+
+/* Medición de latencias con el reloj monotónico, compartida por el
+ * envoltorio hash_medido y el benchmark.
+ *
+ * Se usa clock_gettime y no rdtsc: los ciclos del TSC necesitarían calibrar
+ * la frecuencia de cada máquina para informar nanosegundos, y leer el reloj
+ * por el vDSO ya cuesta pocas decenas de nanosegundos. Ese costo se calibra
+ * una vez y se descuenta de cada medición.
+ */
+
+/* Devuelve el instante actual del reloj monotónico en nanosegundos */
+uint64_t reloj_ns(void);
+
+/* Devuelve lo que tarda leer el reloj dos veces seguidas, el mínimo de
+ * varias pruebas, para descontarlo de cada medición.
+ */
+uint64_t reloj_calibrar(void);
+
+/* Registra en el histograma los nanosegundos transcurridos desde inicio,
+ * descontando costo_reloj (sin bajar de 0).
+ * Pre: el histograma fue creado, inicio fue leído con reloj_ns
+ */
+void reloj_registrar(histograma_t *histograma, uint64_t inicio, uint64_t costo_reloj);
+
+#endif // RELOJ_H
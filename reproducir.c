@@ -0,0 +1,138 @@
+/*
+ * reproducir.c
+ * Reproduce una traza de operaciones (ver traza.h) sobre un hash y reporta
+ * el throughput, la distribución de latencias por operación y la memoria a
+ * lo largo de la reproducción, en CSV.
+ *
+ * Uso: ./reproducir traza [-b] [-i intervalo]
+ *   -b            lee la traza con E/S con buffer en lugar de mmap
+ *   -i intervalo  cantidad de operaciones entre reportes de memoria (100000)
+ */
+#define _POSIX_C_SOURCE 199309L
+#include "hash.h"
+#include "hash_medido.h"
+#include "reloj.h"
+#include "traza.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+#define INTERVALO_POR_OMISION 100000
+
+/* ******************************************************************
+ *                        FUNCIONES AUXILIARES
+ * *****************************************************************/
+
+static double ahora_segundos(void) {
+    return (double) reloj_ns() / 1e9;
+}
+
+/* Memoria residente actual en KB, o la máxima si no se puede leer /proc */
+static long rss_kb(void) {
+    FILE *statm = fopen("/proc/self/statm", "r");
+    struct rusage uso;
+    long paginas;
+
+    if (statm) {
+        if (fscanf(statm, "%*s %ld", &paginas) == 1) {
+            fclose(statm);
+            return paginas * (sysconf(_SC_PAGESIZE) / 1024);
+        }
+        fclose(statm);
+    }
+    getrusage(RUSAGE_SELF, &uso);
+    return uso.ru_maxrss;
+}
+
+static void reportar_intervalo(const hash_t *hash, size_t ops, double segundos, size_t ops_intervalo,
+                               double segundos_intervalo) {
+    printf("%zu,%.6f,%.0f,%zu,%zu,%ld\n", ops, segundos,
+           segundos_intervalo > 0 ? (double) ops_intervalo / segundos_intervalo : 0,
+           hash_cantidad(hash), hash_memoria(hash), rss_kb());
+}
+
+/* ******************************************************************
+ *                        PROGRAMA PRINCIPAL
+ * *****************************************************************/
+
+int main(int argc, char *argv[]) {
+    const char *ruta = NULL, *clave;
+    bool mapear = true;
+    size_t intervalo = INTERVALO_POR_OMISION, ops = 0, ops_anteriores = 0;
+    traza_operacion_t operacion;
+    traza_t *traza;
+    hash_t *hash;
+    hash_medido_t *medido;
+    double inicio, anterior, ahora;
+    bool error;
+    static char dato;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-b"))
+            mapear = false;
+        else if (!strcmp(argv[i], "-i") && i + 1 < argc)
+            intervalo = (size_t) strtoull(argv[++i], NULL, 10);
+        else
+            ruta = argv[i];
+    }
+    if (!ruta || !intervalo) {
+        fprintf(stderr, "Uso: %s traza [-b] [-i intervalo]\n", argv[0]);
+        return 1;
+    }
+    if (!(traza = traza_abrir(ruta, mapear))) {
+        fprintf(stderr, "No se pudo abrir la traza %s\n", ruta);
+        return 1;
+    }
+    hash = hash_crear(NULL);
+    medido = hash ? hash_medido_crear(hash) : NULL;
+    if (!medido) {
+        fprintf(stderr, "Sin memoria\n");
+        return 1;
+    }
+
+    printf("ops,segundos,ops_por_segundo,cantidad,bytes_hash,rss_kb\n");
+    inicio = anterior = ahora_segundos();
+    while (traza_siguiente(traza, &operacion, &clave)) {
+        switch (operacion) {
+        case TRAZA_GUARDAR:
+            hash_medido_guardar(medido, clave, &dato);
+            break;
+        case TRAZA_OBTENER:
+            hash_medido_obtener(medido, clave);
+            break;
+        case TRAZA_BORRAR:
+            hash_medido_borrar(medido, clave);
+            break;
+        case TRAZA_PERTENECE:
+            hash_medido_pertenece(medido, clave);
+            break;
+        }
+        if (++ops % intervalo == 0) {
+            ahora = ahora_segundos();
+            reportar_intervalo(hash, ops, ahora - inicio, ops - ops_anteriores, ahora - anterior);
+            ops_anteriores = ops;
+            /* Leer /proc/self/statm para el reporte no se cuenta en el próximo intervalo */
+            anterior = ahora_segundos();
+            inicio += anterior - ahora;
+        }
+    }
+    ahora = ahora_segundos();
+    if (ops != ops_anteriores)
+        reportar_intervalo(hash, ops, ahora - inicio, ops - ops_anteriores, ahora - anterior);
+    error = traza_error(traza);
+    if (error)
+        fprintf(stderr, "Línea %zu inválida, la reproducción se detuvo\n", traza_linea(traza));
+
+    printf("\nops,segundos,ops_por_segundo\n%zu,%.6f,%.0f\n\n", ops, ahora - inicio,
+           ahora > inicio ? (double) ops / (ahora - inicio) : 0);
+    hash_medido_imprimir(medido, stdout);
+
+    hash_medido_destruir(medido);
+    hash_destruir(hash);
+    traza_cerrar(traza);
+    return error ? 1 : 0;
+}
@@ -0,0 +1,222 @@
+#include "rueda.h"
+#define RUEDA_NIVELES 4
+#define RUEDA_BITS 8
+#define RUEDA_RANURAS (1 << RUEDA_BITS)
+#define RUEDA_MASCARA ((uint64_t) RUEDA_RANURAS - 1)
+/* Nivel especial para las entradas que ya vencieron y esperan ser entregadas */
+#define NIVEL_VENCIDAS RUEDA_NIVELES
+
+/* Definicion de las estructuras de la rueda */
+struct rueda_entrada {
+    uint64_t vencimiento;
+    void *dato;
+    rueda_entrada_t *ant;
+    rueda_entrada_t *sig;
+    unsigned char nivel;    // Nivel de la rueda en el que está la entrada
+    unsigned char indice;   // Ranura dentro del nivel
+};
+
+struct rueda {
+    /* Cada nivel tiene RUEDA_RANURAS ranuras, la ranura i del nivel n agrupa
+     * las entradas cuyo vencimiento tiene los bits [BITS*n, BITS*(n+1)) iguales a i */
+    rueda_entrada_t *ranuras[RUEDA_NIVELES][RUEDA_RANURAS];
+    rueda_entrada_t *vencidas;
+    size_t cantidad_nivel[RUEDA_NIVELES + 1];
+    size_t cantidad;
+    uint64_t actual;   // Último tick alcanzado por la rueda
+    const alocador_t *alocador;
+};
+
+/* Funciones auxiliares */
+
+/* Devuelve la primera potencia de la rueda que no entra en el nivel dado */
+static uint64_t rango_nivel(unsigned nivel) {
+    return (uint64_t) 1 << (RUEDA_BITS * (nivel + 1));
+}
+
+static rueda_entrada_t **ranura_de(rueda_t *rueda, unsigned nivel, unsigned indice) {
+    return (nivel == NIVEL_VENCIDAS ? &rueda->vencidas : &rueda->ranuras[nivel][indice]);
+}
+
+static void enlazar(rueda_t *rueda, rueda_entrada_t *entrada, unsigned nivel, unsigned indice) {
+    rueda_entrada_t **ranura = ranura_de(rueda, nivel, indice);
+    entrada->ant = NULL;
+    entrada->sig = *ranura;
+    if (*ranura)
+        (*ranura)->ant = entrada;
+    *ranura = entrada;
+    entrada->nivel = (unsigned char) nivel;
+    entrada->indice = (unsigned char) indice;
+    ++(rueda->cantidad_nivel[nivel]);
+}
+
+static void desenlazar(rueda_t *rueda, rueda_entrada_t *entrada) {
+    if (entrada->ant)
+        entrada->ant->sig = entrada->sig;
+    else
+        *ranura_de(rueda, entrada->nivel, entrada->indice) = entrada->sig;
+    if (entrada->sig)
+        entrada->sig->ant = entrada->ant;
+    --(rueda->cantidad_nivel[entrada->nivel]);
+}
+
+/* Ubica la entrada en el nivel más bajo que puede representar su distancia al tick actual */
+static void colocar(rueda_t *rueda, rueda_entrada_t *entrada) {
+    uint64_t vencimiento = entrada->vencimiento;
+    uint64_t distancia;
+    unsigned nivel = 0;
+
+    if (vencimiento <= rueda->actual) {
+        enlazar(rueda, entrada, NIVEL_VENCIDAS, 0);
+        return;
+    }
+    distancia = vencimiento - rueda->actual;
+    while (nivel < RUEDA_NIVELES - 1 && distancia >= rango_nivel(nivel))
+        nivel++;
+    /* Los vencimientos fuera del alcance de la rueda se ubican en la última
+     * ranura del nivel superior, y se vuelven a ubicar al bajar en cascada */
+    if (distancia >= rango_nivel(nivel))
+        vencimiento = rueda->actual + rango_nivel(nivel) - 1;
+    enlazar(rueda, entrada, nivel, (unsigned) ((vencimiento >> (RUEDA_BITS * nivel)) & RUEDA_MASCARA));
+}
+
+/* Reubica todas las entradas de una ranura de un nivel superior, devuelve cuántas movió */
+static size_t cascada(rueda_t *rueda, unsigned nivel, unsigned indice) {
+    rueda_entrada_t *entrada = rueda->ranuras[nivel][indice];
+    rueda_entrada_t *sig;
+    size_t movidas = 0;
+
+    rueda->ranuras[nivel][indice] = NULL;
+    for (; entrada; entrada = sig) {
+        sig = entrada->sig;
+        --(rueda->cantidad_nivel[nivel]);
+        colocar(rueda, entrada);
+        movidas++;
+    }
+    return movidas;
+}
+
+/* Vence las entradas de una ranura mientras alcance el trabajo.
+ * Devuelve true si la ranura quedó vacía.
+ */
+static bool vaciar_ranura(rueda_t *rueda, rueda_entrada_t **ranura, size_t *trabajo, size_t max_trabajo,
+                          size_t *vencidos, rueda_vencer_t vencer, void *extra) {
+    rueda_entrada_t *entrada;
+    void *dato;
+
+    while ((entrada = *ranura)) {
+        if (*trabajo >= max_trabajo)
+            return false;
+        desenlazar(rueda, entrada);
+        --(rueda->cantidad);
+        dato = entrada->dato;
+        alocador_liberar(rueda->alocador, entrada, sizeof(*entrada));
+        vencer(dato, extra);
+        ++(*trabajo);
+        ++(*vencidos);
+    }
+    return true;
+}
+
+/* Saltea los ticks en los que no puede pasar nada: si los niveles más bajos
+ * están vacíos, el próximo evento es la cascada del nivel ocupado más bajo */
+static void saltar_ticks_vacios(rueda_t *rueda, uint64_t ahora) {
+    unsigned nivel = 0;
+    uint64_t previo_a_cascada;
+
+    while (nivel < RUEDA_NIVELES && !rueda->cantidad_nivel[nivel])
+        nivel++;
+    if (nivel == 0)
+        return;
+    if (nivel == RUEDA_NIVELES) {
+        rueda->actual = ahora;
+        return;
+    }
+    previo_a_cascada = rueda->actual | (rango_nivel(nivel - 1) - 1);
+    rueda->actual = (previo_a_cascada < ahora ? previo_a_cascada : ahora);
+}
+
+/* Primitivas de la rueda */
+
+rueda_t *rueda_crear(uint64_t ahora) {
+    return rueda_crear_con_alocador(ahora, alocador_estandar());
+}
+
+rueda_t *rueda_crear_con_alocador(uint64_t ahora, const alocador_t *alocador) {
+    rueda_t *rueda = alocador_reservar_ceros(alocador, sizeof(*rueda));
+    if (!rueda)
+        return NULL;
+    rueda->actual = ahora;
+    rueda->alocador = alocador;
+    return rueda;
+}
+
+rueda_entrada_t *rueda_agregar(rueda_t *rueda, uint64_t vencimiento, void *dato) {
+    rueda_entrada_t *entrada = alocador_reservar(rueda->alocador, sizeof(*entrada));
+    if (!entrada)
+        return NULL;
+    entrada->vencimiento = vencimiento;
+    entrada->dato = dato;
+    colocar(rueda, entrada);
+    ++(rueda->cantidad);
+    return entrada;
+}
+
+void rueda_quitar(rueda_t *rueda, rueda_entrada_t *entrada) {
+    desenlazar(rueda, entrada);
+    --(rueda->cantidad);
+    alocador_liberar(rueda->alocador, entrada, sizeof(*entrada));
+}
+
+uint64_t rueda_entrada_vencimiento(const rueda_entrada_t *entrada) {
+    return entrada->vencimiento;
+}
+
+size_t rueda_cantidad(const rueda_t *rueda) {
+    return rueda->cantidad;
+}
+
+size_t rueda_avanzar(rueda_t *rueda, uint64_t ahora, size_t max_trabajo,
+                     rueda_vencer_t vencer, void *extra) {
+    size_t trabajo = 0, vencidos = 0;
+    unsigned nivel;
+
+    for (;;) {
+        /* Primero se entregan las pendientes: las ya vencidas y las del tick actual */
+        if (!vaciar_ranura(rueda, &rueda->vencidas, &trabajo, max_trabajo, &vencidos, vencer, extra))
+            break;
+        if (!vaciar_ranura(rueda, &rueda->ranuras[0][rueda->actual & RUEDA_MASCARA],
+                           &trabajo, max_trabajo, &vencidos, vencer, extra))
+            break;
+        if (rueda->actual >= ahora || trabajo >= max_trabajo)
+            break;
+        saltar_ticks_vacios(rueda, ahora);
+        if (rueda->actual >= ahora)
+            continue;
+        /* Avanza un tick, bajando en cascada los niveles que completaron una vuelta */
+        ++(rueda->actual);
+        ++trabajo;
+        for (nivel = 1; nivel < RUEDA_NIVELES; nivel++) {
+            if (rueda->actual & (rango_nivel(nivel - 1) - 1))
+                break;
+            trabajo += cascada(rueda, nivel,
+                               (unsigned) ((rueda->actual >> (RUEDA_BITS * nivel)) & RUEDA_MASCARA));
+        }
+    }
+    return vencidos;
+}
+
+void rueda_destruir(rueda_t *rueda) {
+    unsigned nivel, indice;
+    rueda_entrada_t *entrada, *sig;
+
+    for (nivel = 0; nivel <= NIVEL_VENCIDAS; nivel++) {
+        for (indice = 0; indice < (nivel == NIVEL_VENCIDAS ? 1 : RUEDA_RANURAS); indice++) {
+            for (entrada = *ranura_de(rueda, nivel, indice); entrada; entrada = sig) {
+                sig = entrada->sig;
+                alocador_liberar(rueda->alocador, entrada, sizeof(*entrada));
+            }
+        }
+    }
+    alocador_liberar(rueda->alocador, rueda, sizeof(*rueda));
+}
@@ -0,0 +1,73 @@
+#ifndef RUEDA_H
+#define RUEDA_H
+
+#include "alocador.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* Rueda de temporizadores jerárquica: agenda datos con un vencimiento
+ * (en unidades de tiempo arbitrarias, "ticks") y los entrega cuando el
+ * tiempo de la rueda los alcanza. Agregar y quitar son O(1); avanzar tiene
+ * un costo acotado por el parámetro max_trabajo.
+ */
+
+/* Declaraciones de estructuras */
+typedef struct rueda rueda_t;
+typedef struct rueda_entrada rueda_entrada_t;
+
+/* Función que recibe cada dato vencido. La entrada ya fue quitada y liberada
+ * de la rueda cuando se la llama.
+ */
+typedef void (*rueda_vencer_t)(void *dato, void *extra);
+
+/* Crea una rueda cuyo tiempo actual es ahora. Devuelve NULL en caso de error.
+ * Post: devuelve una rueda vacía.
+ */
+rueda_t *rueda_crear(uint64_t ahora);
+
+/* Crea una rueda que pide su memoria y la de sus entradas al alocador, que
+ * debe vivir al menos tanto como la rueda. Devuelve NULL en caso de error.
+ * Post: devuelve una rueda vacía.
+ */
+rueda_t *rueda_crear_con_alocador(uint64_t ahora, const alocador_t *alocador);
+
+/* Agenda dato para que venza en el tick vencimiento. Devuelve la entrada
+ * creada, o NULL en caso de error. Si vencimiento ya pasó, el dato vence en
+ * la próxima llamada a rueda_avanzar.
+ * Pre: la rueda fue creada.
+ */
+rueda_entrada_t *rueda_agregar(rueda_t *rueda, uint64_t vencimiento, void *dato);
+
+/* Quita la entrada de la rueda y la libera, sin vencer su dato.
+ * Pre: la rueda fue creada, entrada pertenece a la rueda.
+ */
+void rueda_quitar(rueda_t *rueda, rueda_entrada_t *entrada);
+
+/* Devuelve el tick en el que vence la entrada.
+ * Pre: entrada pertenece a una rueda.
+ */
+uint64_t rueda_entrada_vencimiento(const rueda_entrada_t *entrada);
+
+/* Devuelve la cantidad de entradas agendadas.
+ * Pre: la rueda fue creada.
+ */
+size_t rueda_cantidad(const rueda_t *rueda);
+
+/* Avanza el tiempo de la rueda hasta ahora, llamando a vencer para cada dato
+ * cuyo vencimiento sea menor o igual a ahora. Hace a lo sumo max_trabajo
+ * unidades de trabajo (avanzar un tick, reubicar una entrada o vencerla); si
+ * el trabajo no alcanza, la siguiente llamada continúa desde donde quedó.
+ * Devuelve la cantidad de datos vencidos.
+ * Pre: la rueda fue creada. vencer puede quitar otras entradas de la rueda,
+ * pero no destruirla.
+ */
+size_t rueda_avanzar(rueda_t *rueda, uint64_t ahora, size_t max_trabajo,
+                     rueda_vencer_t vencer, void *extra);
+
+/* Destruye la rueda y todas sus entradas, sin vencer sus datos.
+ * Pre: la rueda fue creada.
+ */
+void rueda_destruir(rueda_t *rueda);
+
+#endif // RUEDA_H
@@ -0,0 +1,164 @@
+#define _POSIX_C_SOURCE 200809L
+#include "traza.h"
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+#define TAM_BUFFER_LECTURA (1 << 20)
+
+static const char LETRAS_OPERACION[] = { 'g', 'o', 'b', 'p' };
+
+/* Definición de la estructura de la traza */
+struct traza {
+    /* Lectura con mmap */
+    const char *base;
+    size_t tam;
+    size_t posicion;
+    /* Lectura con buffer */
+    FILE *archivo;
+    char *buffer_archivo;
+    /* Línea actual, terminada en '\0' */
+    char *linea;
+    size_t capacidad_linea;
+    size_t numero_linea;
+    bool error;
+};
+
+/* Funciones auxiliares */
+
+/* Copia la próxima línea del mapeo a la línea actual */
+static bool leer_linea_mapeada(traza_t *traza, size_t *largo) {
+    const char *inicio = traza->base + traza->posicion, *fin;
+    char *nueva;
+
+    if (traza->posicion >= traza->tam)
+        return false;
+    fin = memchr(inicio, '\n', traza->tam - traza->posicion);
+    *largo = (size_t) ((fin ? fin : traza->base + traza->tam) - inicio);
+    traza->posicion += *largo + 1;
+    if (*largo + 1 > traza->capacidad_linea) {
+        nueva = realloc(traza->linea, *largo + 1);
+        if (!nueva) {
+            traza->error = true;
+            return false;
+        }
+        traza->linea = nueva;
+        traza->capacidad_linea = *largo + 1;
+    }
+    memcpy(traza->linea, inicio, *largo);
+    traza->linea[*largo] = '\0';
+    return true;
+}
+
+static bool leer_linea(traza_t *traza, size_t *largo) {
+    ssize_t leidos;
+
+    if (traza->base)
+        return leer_linea_mapeada(traza, largo);
+    if (!traza->archivo)
+        return false;
+    leidos = getline(&traza->linea, &traza->capacidad_linea, traza->archivo);
+    if (leidos < 0)
+        return false;
+    *largo = (size_t) leidos;
+    if (*largo && traza->linea[*largo - 1] == '\n')
+        traza->linea[--(*largo)] = '\0';
+    return true;
+}
+
+/* Primitivas de la traza */
+
+traza_t *traza_abrir(const char *ruta, bool mapear) {
+    traza_t *traza = calloc(1, sizeof(*traza));
+    struct stat estado;
+    void *base;
+    int fd;
+
+    if (!traza)
+        return NULL;
+    if (!mapear) {
+        traza->archivo = fopen(ruta, "r");
+        traza->buffer_archivo = malloc(TAM_BUFFER_LECTURA);
+        if (!traza->archivo || !traza->buffer_archivo) {
+            traza_cerrar(traza);
+            return NULL;
+        }
+        setvbuf(traza->archivo, traza->buffer_archivo, _IOFBF, TAM_BUFFER_LECTURA);
+        return traza;
+    }
+    if ((fd = open(ruta, O_RDONLY)) == -1) {
+        free(traza);
+        return NULL;
+    }
+    if (fstat(fd, &estado)) {
+        close(fd);
+        free(traza);
+        return NULL;
+    }
+    /* Un archivo vacío no se puede mapear, pero es una traza válida sin operaciones */
+    if (estado.st_size > 0) {
+        base = mmap(NULL, (size_t) estado.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (base == MAP_FAILED) {
+            close(fd);
+            free(traza);
+            return NULL;
+        }
+        posix_madvise(base, (size_t) estado.st_size, POSIX_MADV_SEQUENTIAL);
+        traza->base = base;
+        traza->tam = (size_t) estado.st_size;
+    }
+    close(fd);
+    return traza;
+}
+
+bool traza_siguiente(traza_t *traza, traza_operacion_t *operacion, const char **clave) {
+    size_t largo;
+    int i;
+
+    while (!traza->error && leer_linea(traza, &largo)) {
+        traza->numero_linea++;
+        if (largo && traza->linea[largo - 1] == '\r')
+            traza->linea[--largo] = '\0';
+        if (!largo || traza->linea[0] == '#')
+            continue;
+        for (i = 0; i < (int) sizeof(LETRAS_OPERACION); i++) {
+            if (traza->linea[0] == LETRAS_OPERACION[i])
+                break;
+        }
+        if (i == (int) sizeof(LETRAS_OPERACION) || largo < 2 || traza->linea[1] != ' ') {
+            traza->error = true;
+            return false;
+        }
+        *operacion = (traza_operacion_t) i;
+        *clave = traza->linea + 2;
+        return true;
+    }
+    return false;
+}
+
+bool traza_error(const traza_t *traza) {
+    return traza->error;
+}
+
+size_t traza_linea(const traza_t *traza) {
+    return traza->numero_linea;
+}
+
+void traza_cerrar(traza_t *traza) {
+    if (traza->base)
+        munmap((void *) traza->base, traza->tam);
+    if (traza->archivo)
+        fclose(traza->archivo);
+    free(traza->buffer_archivo);
+    free(traza->linea);
+    free(traza);
+}
+
+bool traza_escribir(FILE *archivo, traza_operacion_t operacion, const char *clave) {
+    if (strchr(clave, '\n'))
+        return false;
+    return fprintf(archivo, "%c %s\n", LETRAS_OPERACION[operacion], clave) > 0;
+}
@@ -0,0 +1,62 @@
+#ifndef TRAZA_H
+#define TRAZA_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+/* Trazas de operaciones sobre una tabla de hash.
+ *
+ * Una traza es un archivo de texto con una operación por línea: una letra
+ * ('g' guardar, 'o' obtener, 'b' borrar, 'p' pertenece), un espacio y la
+ * clave hasta el fin de línea, que puede contener espacios pero no saltos de
+ * línea. Las líneas vacías y las que empiezan con '#' se ignoran.
+ *
+ *     # capturada el 2026-10-19
+ *     g usuario:1234
+ *     o usuario:1234
+ *     b usuario:1234
+ */
+
+typedef struct traza traza_t;
+
+typedef enum {
+    TRAZA_GUARDAR,
+    TRAZA_OBTENER,
+    TRAZA_BORRAR,
+    TRAZA_PERTENECE
+} traza_operacion_t;
+
+/* Abre la traza de la ruta para leerla de principio a fin. Si mapear es
+ * true se lee con mmap, si no con E/S con buffer.
+ * Post: devuelve la traza abierta, o NULL si no se pudo abrir.
+ */
+traza_t *traza_abrir(const char *ruta, bool mapear);
+
+/* Lee la siguiente operación. La clave vive hasta la próxima llamada.
+ * Devuelve false al llegar al final o al encontrar una línea inválida.
+ * Pre: la traza fue abierta
+ */
+bool traza_siguiente(traza_t *traza, traza_operacion_t *operacion, const char **clave);
+
+/* Devuelve true si la lectura se detuvo por una línea inválida.
+ * Pre: la traza fue abierta
+ */
+bool traza_error(const traza_t *traza);
+
+/* Devuelve el número de la última línea leída, empezando en 1.
+ * Pre: la traza fue abierta
+ */
+size_t traza_linea(const traza_t *traza);
+
+/* Cierra la traza.
+ * Pre: la traza fue abierta
+ */
+void traza_cerrar(traza_t *traza);
+
+/* Escribe una operación en el formato de las trazas. Devuelve false si la
+ * clave contiene un salto de línea o si falló la escritura.
+ */
+bool traza_escribir(FILE *archivo, traza_operacion_t operacion, const char *clave);
+
+#endif // TRAZA_H